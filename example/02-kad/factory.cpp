@@ -15,10 +15,13 @@
 #include <libp2p/host/basic_host.hpp>
 #include <libp2p/muxer/mplex.hpp>
 #include <libp2p/muxer/yamux.hpp>
+#include <libp2p/network/impl/blocklist_gater.hpp>
 #include <libp2p/network/impl/connection_manager_impl.hpp>
 #include <libp2p/network/impl/dialer_impl.hpp>
 #include <libp2p/network/impl/listener_manager_impl.hpp>
 #include <libp2p/network/impl/network_impl.hpp>
+#include <libp2p/network/impl/peer_scorer_impl.hpp>
+#include <libp2p/network/impl/resource_manager_impl.hpp>
 #include <libp2p/network/impl/router_impl.hpp>
 #include <libp2p/network/impl/transport_manager_impl.hpp>
 #include <libp2p/peer/address_repository/inmem_address_repository.hpp>
@@ -98,8 +101,14 @@ namespace libp2p::protocol::kademlia::example {
         // internal
         di::bind<network::Router>().template to<network::RouterImpl>(),
         di::bind<network::ConnectionManager>().template to<network::ConnectionManagerImpl>(),
+        di::bind<network::ConnectionManagerConfig>().template to(network::ConnectionManagerConfig{}),
+        di::bind<network::PeerScorer>().template to<network::PeerScorerImpl>(),
+        di::bind<network::ResourceManager>().template to<network::ResourceManagerImpl>(),
+        di::bind<network::ResourceManagerConfig>().template to(network::ResourceManagerConfig{}),
+        di::bind<network::ConnectionGater>().template to<network::BlocklistGater>(),
         di::bind<network::ListenerManager>().template to<network::ListenerManagerImpl>(),
         di::bind<network::Dialer>().template to<network::DialerImpl>(),
+        di::bind<network::DialerConfig>().template to(network::DialerConfig{}),
         di::bind<network::Network>().template to<network::NetworkImpl>(),
         di::bind<network::TransportManager>().template to<network::TransportManagerImpl>(),
         di::bind<transport::Upgrader>().template to<transport::UpgraderImpl>(),
@@ -6,6 +6,8 @@
 #ifndef LIBP2P_GARBAGE_COLLECTABLE_HPP
 #define LIBP2P_GARBAGE_COLLECTABLE_HPP
 
+#include <cstddef>
+
 namespace libp2p::basic {
 
   /**
@@ -24,6 +26,20 @@ namespace libp2p::basic {
      * thread only.
      */
     virtual void collectGarbage() = 0;
+
+    /**
+     * @brief Cleanup a bounded part of the garbage, continuing from where the
+     * previous step has stopped, so that a large structure does not block
+     * the caller for long
+     * @param max_entries - how many entries may be visited by this step
+     * @return true, if the step has completed a pass over the structure
+     *
+     * @note the default implementation does a full pass at once
+     */
+    virtual bool collectGarbageStep(size_t max_entries) {
+      collectGarbage();
+      return true;
+    }
   };
 
 }  // namespace libp2p::basic
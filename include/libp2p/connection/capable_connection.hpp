@@ -56,6 +56,9 @@ namespace libp2p::connection {
      * reset
      */
     virtual void onStream(NewStreamHandlerFunc cb) = 0;
+
+    /// @return how many streams are open over this connection now
+    virtual size_t streamsCount() const = 0;
   };
 
 }  // namespace libp2p::connection
@@ -21,15 +21,15 @@ namespace libp2p::connection {
 
     /**
      * Get a PeerId of our local peer
-     * @return peer id
+     * @return peer id, which is known since the handshake
      */
-    virtual outcome::result<peer::PeerId> localPeer() const = 0;
+    virtual const peer::PeerId &localPeer() const = 0;
 
     /**
      * Get a PeerId of peer this connection is established with
-     * @return peer id
+     * @return peer id, which is known since the handshake
      */
-    virtual outcome::result<peer::PeerId> remotePeer() const = 0;
+    virtual const peer::PeerId &remotePeer() const = 0;
 
     /**
      * Get a public key of peer this connection is established with
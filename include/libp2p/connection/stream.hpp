@@ -86,9 +86,9 @@ namespace libp2p::connection {
 
     /**
      * Get a peer, which the stream is connected to
-     * @return id of the peer
+     * @return id of the peer; valid, while the stream is alive
      */
-    virtual outcome::result<peer::PeerId> remotePeerId() const = 0;
+    virtual const peer::PeerId &remotePeerId() const = 0;
 
     /**
      * Get a local multiaddress
@@ -0,0 +1,130 @@
+/**
+ * Copyright Soramitsu Co., Ltd. All Rights Reserved.
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#ifndef LIBP2P_CRYPTO_AES_STREAM_HPP
+#define LIBP2P_CRYPTO_AES_STREAM_HPP
+
+#include <memory>
+
+#include <gsl/span>
+#include <libp2p/crypto/common.hpp>
+#include <libp2p/outcome/outcome.hpp>
+
+struct evp_cipher_ctx_st;
+struct evp_cipher_st;
+
+namespace libp2p::crypto::aes {
+
+  /// direction of a stateful cipher
+  enum class Mode { ENCRYPT, DECRYPT };
+
+  /**
+   * Base of stateful AES ciphers, which keep their OpenSSL context between
+   * calls: the key schedule runs once, and the data goes in place or to the
+   * memory of the caller, so that nothing is allocated per call.
+   */
+  class AesStream {
+   public:
+    AesStream(AesStream &&other) noexcept;
+
+    AesStream &operator=(AesStream &&other) noexcept;
+
+    ~AesStream();
+
+    Mode mode() const;
+
+    /**
+     * Continue the cipher on the next part of the data
+     * @param in - input data
+     * @param out - output, not smaller than the input; may be the same memory
+     * @return number of bytes written to the output
+     */
+    outcome::result<size_t> update(gsl::span<const uint8_t> in,
+                                   gsl::span<uint8_t> out);
+
+    /**
+     * Continue the cipher on the next part of the data in place
+     * @param data - input, which is replaced by the output
+     */
+    outcome::result<void> update(gsl::span<uint8_t> data);
+
+   protected:
+    struct CtxDeleter {
+      void operator()(evp_cipher_ctx_st *ctx) const;
+    };
+
+    using Ctx = std::unique_ptr<evp_cipher_ctx_st, CtxDeleter>;
+
+    AesStream(Ctx ctx, Mode mode);
+
+    /// create a context, which is set up with the cipher and the key
+    static outcome::result<Ctx> makeCtx(const evp_cipher_st *cipher,
+                                        const uint8_t *key, const uint8_t *iv,
+                                        Mode mode);
+
+    Ctx ctx_;
+    Mode mode_;
+  };
+
+  /**
+   * AES-CTR, which keeps the keystream position across calls: a sequence of
+   * updates gives the same result as one call on the concatenated data.
+   * Suits a channel, where each direction is one continuous stream.
+   */
+  class AesCtr : public AesStream {
+    using Aes128Secret = libp2p::crypto::common::Aes128Secret;
+    using Aes256Secret = libp2p::crypto::common::Aes256Secret;
+
+   public:
+    static outcome::result<AesCtr> create(const Aes128Secret &secret,
+                                          Mode mode);
+
+    static outcome::result<AesCtr> create(const Aes256Secret &secret,
+                                          Mode mode);
+
+   private:
+    using AesStream::AesStream;
+  };
+
+  /**
+   * AES-GCM, which keeps the key between messages: each message is started
+   * by begin() with its iv and associated data, goes through any number of
+   * updates, and is completed by finish() with the tag.
+   */
+  class AesGcm : public AesStream {
+   public:
+    static constexpr size_t kIvSize = 12;
+    static constexpr size_t kTagSize = 16;
+
+    /**
+     * @param key - key of 16 or 32 bytes for AES-128 or AES-256
+     * @param mode - direction
+     */
+    static outcome::result<AesGcm> create(gsl::span<const uint8_t> key,
+                                          Mode mode);
+
+    /**
+     * Start a message
+     * @param iv - iv of kIvSize bytes, unique for the key
+     * @param ad - associated data, which is authenticated, but not encrypted
+     */
+    outcome::result<void> begin(gsl::span<const uint8_t> iv,
+                                gsl::span<const uint8_t> ad = {});
+
+    /**
+     * Complete a message
+     * @param tag - kTagSize bytes; the tag is written on encryption and is
+     * checked on decryption
+     * @return error, if the tag does not match on decryption
+     */
+    outcome::result<void> finish(gsl::span<uint8_t> tag);
+
+   private:
+    using AesStream::AesStream;
+  };
+
+}  // namespace libp2p::crypto::aes
+
+#endif  // LIBP2P_CRYPTO_AES_STREAM_HPP
@@ -6,6 +6,8 @@
 #ifndef LIBP2P_CRYPTO_PROVIDER_HPP
 #define LIBP2P_CRYPTO_PROVIDER_HPP
 
+#include <functional>
+
 #include <boost/filesystem.hpp>
 #include <gsl/span>
 #include <libp2p/crypto/common.hpp>
@@ -22,6 +24,13 @@ namespace libp2p::crypto {
    public:
     using Buffer = std::vector<uint8_t>;
 
+    /// a message with its signature and the key to check it against
+    struct SignedMessage {
+      gsl::span<const uint8_t> message;
+      gsl::span<const uint8_t> signature;
+      std::reference_wrapper<const PublicKey> public_key;
+    };
+
     virtual ~CryptoProvider() = default;
 
     /**
@@ -59,6 +68,17 @@ namespace libp2p::crypto {
     virtual outcome::result<bool> verify(gsl::span<uint8_t> message,
                                          gsl::span<uint8_t> signature,
                                          const PublicKey &public_key) const = 0;
+
+    /**
+     * @brief verifies signatures of many messages, which is cheaper than
+     * verifying them one by one
+     * @param messages - messages with their signatures and public keys
+     * @return for each message in order - true, if its signature is valid;
+     * signatures, which cannot be verified, are reported as invalid
+     */
+    virtual std::vector<bool> verifyBatch(
+        gsl::span<const SignedMessage> messages) const = 0;
+
     /**
      * Generate an ephemeral public key and return a function that will
      * compute the shared secret key
@@ -68,6 +88,13 @@ namespace libp2p::crypto {
     virtual outcome::result<EphemeralKeyPair> generateEphemeralKeyPair(
         common::CurveType curve) const = 0;
 
+    /**
+     * Generate an ephemeral X25519 key pair for the Noise handshake
+     * @return raw private and public keys
+     */
+    virtual outcome::result<X25519KeyPair> generateEphemeralX25519KeyPair()
+        const = 0;
+
     /**
      * Generate a set of keys for each party by stretching the shared key
      * @param cipher_type to be used
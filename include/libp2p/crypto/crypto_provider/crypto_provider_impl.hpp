@@ -7,6 +7,8 @@
 #define LIBP2P_CRYPTO_PROVIDER_CRYPTO_PROVIDER_IMPL_HPP
 
 #include <libp2p/crypto/crypto_provider.hpp>
+#include <libp2p/crypto/crypto_provider/ephemeral_key_pool.hpp>
+#include <libp2p/crypto/crypto_provider/verification_cache.hpp>
 
 namespace libp2p::crypto {
   namespace random {
@@ -18,11 +20,24 @@ namespace libp2p::crypto {
 
   class CryptoProviderImpl : public CryptoProvider {
    public:
+    /// how many successful verifications are remembered
+    static constexpr size_t kVerificationCacheSize = 4096;
+
+    /// how many ephemeral keys are generated ahead for each used curve
+    static constexpr size_t kEphemeralKeyPoolSize = 16;
+
     ~CryptoProviderImpl() override = default;
 
+    /**
+     * @param random_provider - source of randomness for the keys
+     * @param ed25519_provider - generator and signer of Ed25519 keys
+     * @param registry, where the hits and the misses of the ephemeral key
+     * pool are counted; may be null
+     */
     explicit CryptoProviderImpl(
         std::shared_ptr<random::CSPRNG> random_provider,
-        std::shared_ptr<ed25519::Ed25519Provider> ed25519_provider);
+        std::shared_ptr<ed25519::Ed25519Provider> ed25519_provider,
+        std::shared_ptr<metrics::Registry> registry = nullptr);
 
     outcome::result<KeyPair> generateKeys(Key::Type key_type) const override;
 
@@ -36,13 +51,22 @@ namespace libp2p::crypto {
                                  gsl::span<uint8_t> signature,
                                  const PublicKey &public_key) const override;
 
+    std::vector<bool> verifyBatch(
+        gsl::span<const SignedMessage> messages) const override;
+
     outcome::result<EphemeralKeyPair> generateEphemeralKeyPair(
         common::CurveType curve) const override;
 
+    outcome::result<X25519KeyPair> generateEphemeralX25519KeyPair()
+        const override;
+
     std::vector<StretchedKey> stretchKey(common::CipherType cipher_type,
                                          common::HashType hash_type,
                                          const Buffer &secret) const override;
 
+    /// @return hits and misses of the ephemeral key pool
+    EphemeralKeyPool::Stats ephemeralKeyPoolStats() const;
+
    private:
     void initialize();
 
@@ -55,8 +79,12 @@ namespace libp2p::crypto {
     outcome::result<PublicKey> deriveEd25519(const PrivateKey &key) const;
     outcome::result<Buffer> signEd25519(gsl::span<uint8_t> message,
                                         const PrivateKey &private_key) const;
-    outcome::result<bool> verifyEd25519(gsl::span<uint8_t> message,
-                                        gsl::span<uint8_t> signature,
+    /// verify the signature without looking into the cache
+    outcome::result<bool> verifyUncached(gsl::span<const uint8_t> message,
+                                         gsl::span<const uint8_t> signature,
+                                         const PublicKey &public_key) const;
+    outcome::result<bool> verifyEd25519(gsl::span<const uint8_t> message,
+                                        gsl::span<const uint8_t> signature,
                                         const PublicKey &public_key) const;
 
     outcome::result<KeyPair> generateEcdsa256WithCurve(Key::Type key_type,
@@ -64,6 +92,11 @@ namespace libp2p::crypto {
 
     std::shared_ptr<random::CSPRNG> random_provider_;
     std::shared_ptr<ed25519::Ed25519Provider> ed25519_provider_;
+    /// signed records are often seen many times, so successful
+    /// verifications are remembered
+    mutable VerificationCache verification_cache_{kVerificationCacheSize};
+    /// handshakes take ephemeral keys, which were generated in background
+    mutable EphemeralKeyPool ephemeral_keys_;
   };
 }  // namespace libp2p::crypto
 
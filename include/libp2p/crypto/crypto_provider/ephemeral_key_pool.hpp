@@ -0,0 +1,117 @@
+/**
+ * Copyright Soramitsu Co., Ltd. All Rights Reserved.
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#ifndef LIBP2P_CRYPTO_PROVIDER_EPHEMERAL_KEY_POOL_HPP
+#define LIBP2P_CRYPTO_PROVIDER_EPHEMERAL_KEY_POOL_HPP
+
+#include <array>
+#include <condition_variable>
+#include <deque>
+#include <memory>
+#include <mutex>
+#include <thread>
+
+#include <libp2p/crypto/common.hpp>
+#include <libp2p/crypto/key.hpp>
+#include <libp2p/metrics/registry.hpp>
+#include <libp2p/outcome/outcome.hpp>
+
+struct ec_key_st;
+
+namespace libp2p::crypto {
+
+  /**
+   * Pool of ephemeral keys for the handshakes: EC keys for SECIO and X25519
+   * keys for Noise. The keys are generated ahead of time on a background
+   * thread, so that a handshake takes a key in O(1) instead of generating
+   * it on the network thread.
+   *
+   * The thread starts on the first request, and keeps only the key types,
+   * which were requested, filled up to the size of the pool. If a type has
+   * no keys left, the key is generated on the calling thread.
+   */
+  class EphemeralKeyPool {
+   public:
+    /// key pair on a curve
+    struct EcKey {
+      std::shared_ptr<ec_key_st> key;
+      /// public key as an uncompressed point
+      Buffer public_key;
+    };
+
+    /// counters of the pool
+    struct Stats {
+      /// keys, which were taken from the pool
+      size_t hits = 0;
+      /// keys, which were generated on the calling thread
+      size_t misses = 0;
+    };
+
+    /**
+     * @param size - number of keys, which are kept for each used key type
+     * @param registry, where the hits and the misses are counted; may be null
+     */
+    explicit EphemeralKeyPool(
+        size_t size, std::shared_ptr<metrics::Registry> registry = nullptr);
+
+    EphemeralKeyPool(const EphemeralKeyPool &) = delete;
+
+    EphemeralKeyPool &operator=(const EphemeralKeyPool &) = delete;
+
+    /// stops the background thread
+    ~EphemeralKeyPool();
+
+    /**
+     * Take a pre-generated key of the curve, or generate one, if the pool is
+     * empty; refill of the pool is requested in both cases
+     */
+    outcome::result<EcKey> take(common::CurveType curve);
+
+    /**
+     * Take a pre-generated X25519 key pair, or generate one, if the pool is
+     * empty; refill of the pool is requested in both cases
+     */
+    outcome::result<X25519KeyPair> takeX25519();
+
+    Stats stats() const;
+
+    /**
+     * Generate a key on the calling thread
+     */
+    static outcome::result<EcKey> generate(common::CurveType curve);
+
+    /**
+     * Generate an X25519 key pair on the calling thread
+     */
+    static outcome::result<X25519KeyPair> generateX25519();
+
+   private:
+    static constexpr size_t kCurves = 3;
+
+    /// take a key from the queue of its type, which is marked as used
+    template <typename Key, typename Generate>
+    outcome::result<Key> takeFrom(std::deque<Key> &keys, bool &used,
+                                  const Generate &generate);
+
+    /// generate keys of the used types, until the pool is full or stopped
+    void refill();
+
+    size_t size_;
+    std::array<std::deque<EcKey>, kCurves> keys_;
+    std::array<bool, kCurves> used_{};
+    std::deque<X25519KeyPair> x25519_keys_;
+    bool x25519_used_ = false;
+    mutable std::mutex mutex_;
+    std::condition_variable refill_cv_;
+    bool stopped_ = false;
+    std::thread thread_;
+    /// the counters are kept out of the registry, if there is none
+    std::shared_ptr<metrics::Counter> hits_;
+    std::shared_ptr<metrics::Counter> misses_;
+  };
+
+}  // namespace libp2p::crypto
+
+#endif  // LIBP2P_CRYPTO_PROVIDER_EPHEMERAL_KEY_POOL_HPP
@@ -0,0 +1,71 @@
+/**
+ * Copyright Soramitsu Co., Ltd. All Rights Reserved.
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#ifndef LIBP2P_CRYPTO_PROVIDER_VERIFICATION_CACHE_HPP
+#define LIBP2P_CRYPTO_PROVIDER_VERIFICATION_CACHE_HPP
+
+#include <list>
+#include <mutex>
+#include <unordered_map>
+
+#include <gsl/span>
+#include <libp2p/common/types.hpp>
+#include <libp2p/crypto/key.hpp>
+
+namespace libp2p::crypto {
+
+  /**
+   * Bounded LRU set of signatures, which were successfully verified. Entries
+   * are SHA-256 digests of (key type, key, message, signature), so that
+   * neither messages nor keys are kept; when the cache is full, the least
+   * recently used entry is dropped. Failed verifications are not cached.
+   */
+  class VerificationCache {
+   public:
+    /// digest of a verified (key, message, signature) triple
+    using Entry = libp2p::common::Hash256;
+
+    explicit VerificationCache(size_t capacity);
+
+    /**
+     * Compute an entry for the given signature
+     * @param message, which was signed
+     * @param signature of the message
+     * @param public_key, against which the signature is checked
+     */
+    static Entry makeEntry(gsl::span<const uint8_t> message,
+                           gsl::span<const uint8_t> signature,
+                           const PublicKey &public_key);
+
+    /**
+     * Check if the entry is in the cache and mark it as recently used
+     * @return true, if the signature was verified before
+     */
+    bool contains(const Entry &entry);
+
+    /// remember a successfully verified signature
+    void insert(const Entry &entry);
+
+    size_t size() const;
+
+    size_t capacity() const;
+
+   private:
+    struct EntryHash {
+      size_t operator()(const Entry &entry) const;
+    };
+
+    using LruList = std::list<Entry>;
+
+    size_t capacity_;
+    /// most recently used entries are at the front
+    LruList lru_;
+    std::unordered_map<Entry, LruList::iterator, EntryHash> entries_;
+    mutable std::mutex mutex_;
+  };
+
+}  // namespace libp2p::crypto
+
+#endif  // LIBP2P_CRYPTO_PROVIDER_VERIFICATION_CACHE_HPP
@@ -7,6 +7,7 @@
 #define LIBP2P_ED25519_PROVIDER_HPP
 
 #include <array>
+#include <vector>
 
 #include <gsl/span>
 #include <libp2p/outcome/outcome.hpp>
@@ -21,6 +22,13 @@ namespace libp2p::crypto::ed25519 {
   };
   using Signature = std::array<uint8_t, 64u>;
 
+  /// a message with its signature and the key to check it against
+  struct SignedMessage {
+    gsl::span<const uint8_t> message;
+    Signature signature;
+    PublicKey public_key;
+  };
+
   /**
    * An interface for Ed25519 private/public key cryptography operations.
    */
@@ -56,10 +64,20 @@ namespace libp2p::crypto::ed25519 {
      * @param public_key - public key bytes
      * @return - true when signature is valid, false - otherwise
      */
-    virtual outcome::result<bool> verify(gsl::span<uint8_t> message,
+    virtual outcome::result<bool> verify(gsl::span<const uint8_t> message,
                                          const Signature &signature,
                                          const PublicKey &public_key) const = 0;
 
+    /**
+     * Verify signatures of many messages at once: each distinct public key is
+     * decoded once, and one verification context serves the whole batch
+     * @param messages - messages with their signatures and public keys
+     * @return for each message in order - true, when its signature is valid;
+     * error, if the batch could not be processed at all
+     */
+    virtual outcome::result<std::vector<bool>> verifyBatch(
+        gsl::span<const SignedMessage> messages) const = 0;
+
     virtual ~Ed25519Provider() = default;
   };
 
@@ -21,9 +21,12 @@ namespace libp2p::crypto::ed25519 {
         gsl::span<uint8_t> message,
         const PrivateKey &private_key) const override;
 
-    outcome::result<bool> verify(gsl::span<uint8_t> message,
+    outcome::result<bool> verify(gsl::span<const uint8_t> message,
                                  const Signature &signature,
                                  const PublicKey &public_key) const override;
+
+    outcome::result<std::vector<bool>> verifyBatch(
+        gsl::span<const SignedMessage> messages) const override;
   };
 
 }  // namespace libp2p::crypto::ed25519
@@ -25,6 +25,8 @@ namespace libp2p::crypto {
     FAILED_ENCRYPT_FINALIZE,        ///< failed to finalize encryption
     FAILED_DECRYPT_FINALIZE,        ///< failed to finalize decryption
     WRONG_IV_SIZE,                  ///< wrong iv size
+    WRONG_KEY_SIZE,                 ///< wrong key size
+    WRONG_TAG_SIZE,                 ///< wrong authentication tag size
   };
 
   enum class HmacProviderError {
@@ -0,0 +1,69 @@
+/**
+ * Copyright Soramitsu Co., Ltd. All Rights Reserved.
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#ifndef LIBP2P_CRYPTO_HMAC_STREAM_HPP
+#define LIBP2P_CRYPTO_HMAC_STREAM_HPP
+
+#include <memory>
+
+#include <gsl/span>
+#include <libp2p/crypto/common.hpp>
+#include <libp2p/outcome/outcome.hpp>
+
+struct hmac_ctx_st;
+
+namespace libp2p::crypto::hmac {
+
+  /**
+   * HMAC, which keeps its OpenSSL context and key between messages: the key
+   * is set up once, and each finish() writes the digest to the memory of the
+   * caller and starts the next message, so that nothing is allocated per
+   * message.
+   */
+  class HmacStream {
+   public:
+    /// maximum digest size of the supported hashes
+    static constexpr size_t kMaxDigestSize = 64;
+
+    /**
+     * @param hash_type - hash function
+     * @param key - secret key
+     */
+    static outcome::result<HmacStream> create(common::HashType hash_type,
+                                              gsl::span<const uint8_t> key);
+
+    HmacStream(HmacStream &&other) noexcept;
+
+    HmacStream &operator=(HmacStream &&other) noexcept;
+
+    ~HmacStream();
+
+    size_t digestSize() const;
+
+    /// add the next part of the message
+    outcome::result<void> update(gsl::span<const uint8_t> data);
+
+    /**
+     * Complete the message, and start the next one with the same key
+     * @param digest - output of digestSize() bytes
+     */
+    outcome::result<void> finish(gsl::span<uint8_t> digest);
+
+   private:
+    struct CtxDeleter {
+      void operator()(hmac_ctx_st *ctx) const;
+    };
+
+    using Ctx = std::unique_ptr<hmac_ctx_st, CtxDeleter>;
+
+    HmacStream(Ctx ctx, size_t digest_size);
+
+    Ctx ctx_;
+    size_t digest_size_;
+  };
+
+}  // namespace libp2p::crypto::hmac
+
+#endif  // LIBP2P_CRYPTO_HMAC_STREAM_HPP
@@ -8,7 +8,9 @@
 
 #include <functional>
 
+#include <gsl/span>
 #include <libp2p/common/types.hpp>
+#include <libp2p/outcome/outcome.hpp>
 
 namespace libp2p::crypto {
 
@@ -55,8 +57,19 @@ namespace libp2p::crypto {
    * Result of ephemeral key generation
    */
   struct EphemeralKeyPair {
+    /// public key as an uncompressed point on the curve
     Buffer ephemeral_public_key;
-    std::function<PrivateKey()> private_key_generator;
+    /// computes the shared secret from the ephemeral public key of the peer
+    std::function<outcome::result<Buffer>(gsl::span<const uint8_t>)>
+        shared_secret_generator;
+  };
+
+  /**
+   * X25519 key pair of raw keys, as the Noise handshake uses them
+   */
+  struct X25519KeyPair {
+    std::array<uint8_t, 32> private_key;
+    std::array<uint8_t, 32> public_key;
   };
 
   /**
@@ -10,8 +10,20 @@
 
 #include <gsl/span>
 #include <libp2p/common/types.hpp>
+#include <libp2p/crypto/sha/sha_hasher.hpp>
 
 namespace libp2p::crypto {
+  /**
+   * Streaming SHA-256
+   */
+  class Sha256 : public ShaHasher {
+   public:
+    Sha256();
+
+    /// complete the message, and start the next one
+    libp2p::common::Hash256 digest();
+  };
+
   /**
    * Take a SHA-256 hash from string
    * @param input to be hashed
@@ -25,6 +37,15 @@ namespace libp2p::crypto {
    * @return hashed bytes
    */
   libp2p::common::Hash256 sha256(gsl::span<const uint8_t> input);
+
+  /**
+   * Take SHA-256 hashes from many short inputs at once, such as all peer ids
+   * of a bucket, with one context
+   * @param inputs to be hashed
+   * @param out - hash of each input; not smaller than the inputs
+   */
+  void sha256Batch(gsl::span<const gsl::span<const uint8_t>> inputs,
+                   gsl::span<libp2p::common::Hash256> out);
 }  // namespace libp2p::crypto
 
 #endif  // LIBP2P_SHA256_HPP
@@ -10,8 +10,20 @@
 
 #include <gsl/span>
 #include <libp2p/common/types.hpp>
+#include <libp2p/crypto/sha/sha_hasher.hpp>
 
 namespace libp2p::crypto {
+  /**
+   * Streaming SHA-512
+   */
+  class Sha512 : public ShaHasher {
+   public:
+    Sha512();
+
+    /// complete the message, and start the next one
+    libp2p::common::Hash512 digest();
+  };
+
   /**
    * Take a SHA-512 hash from string
    * @param input to be hashed
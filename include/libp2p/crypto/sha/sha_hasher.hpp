@@ -0,0 +1,59 @@
+/**
+ * Copyright Soramitsu Co., Ltd. All Rights Reserved.
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#ifndef LIBP2P_CRYPTO_SHA_HASHER_HPP
+#define LIBP2P_CRYPTO_SHA_HASHER_HPP
+
+#include <memory>
+#include <string_view>
+
+#include <gsl/span>
+
+struct evp_md_ctx_st;
+struct evp_md_st;
+
+namespace libp2p::crypto {
+
+  /**
+   * Base of streaming SHA hashers, which go through the EVP interface of
+   * OpenSSL, so that the digest runs on SHA-NI or ARMv8 instructions, when
+   * the CPU has them. The context is allocated once and is reused by each
+   * next message, so that hashing allocates nothing.
+   */
+  class ShaHasher {
+   public:
+    ShaHasher(ShaHasher &&other) noexcept;
+
+    ShaHasher &operator=(ShaHasher &&other) noexcept;
+
+    ~ShaHasher();
+
+    /// add the next part of the message
+    ShaHasher &update(gsl::span<const uint8_t> input);
+
+    /// add the next part of the message
+    ShaHasher &update(std::string_view input);
+
+   protected:
+    explicit ShaHasher(const evp_md_st *md);
+
+    /**
+     * Complete the message, and start the next one
+     * @param out - output of the digest size
+     */
+    void finish(uint8_t *out);
+
+   private:
+    struct CtxDeleter {
+      void operator()(evp_md_ctx_st *ctx) const;
+    };
+
+    std::unique_ptr<evp_md_ctx_st, CtxDeleter> ctx_;
+    const evp_md_st *md_;
+  };
+
+}  // namespace libp2p::crypto
+
+#endif  // LIBP2P_CRYPTO_SHA_HASHER_HPP
@@ -6,7 +6,11 @@
 #ifndef LIBP2P_BASIC_HOST_HPP
 #define LIBP2P_BASIC_HOST_HPP
 
+#include <boost/asio/io_context.hpp>
 #include <libp2p/event/bus.hpp>
+#include <libp2p/host/basic_host/connection_prewarmer.hpp>
+#include <libp2p/host/basic_host/maintenance_scheduler.hpp>
+#include <libp2p/host/basic_host/stream_pool.hpp>
 #include <libp2p/host/host.hpp>
 #include <libp2p/peer/identity_manager.hpp>
 
@@ -23,10 +27,16 @@ namespace libp2p::host {
    public:
     ~BasicHost() override = default;
 
+    /**
+     * @param context - io context of the host's periodic tasks; without it,
+     * warm connections are established once and not maintained, and garbage
+     * of the repositories and idle pooled streams are not collected
+     */
     BasicHost(std::shared_ptr<peer::IdentityManager> idmgr,
               std::unique_ptr<network::Network> network,
               std::unique_ptr<peer::PeerRepository> repo,
-              std::shared_ptr<event::Bus> bus);
+              std::shared_ptr<event::Bus> bus,
+              std::shared_ptr<boost::asio::io_context> context = nullptr);
 
     std::string_view getLibp2pVersion() const override;
 
@@ -44,6 +54,9 @@ namespace libp2p::host {
 
     void connect(const peer::PeerInfo &p) override;
 
+    void keepWarm(std::vector<peer::PeerInfo> peers,
+                  size_t connections) override;
+
     void setProtocolHandler(
         const peer::Protocol &proto,
         const std::function<connection::Stream::Handler> &handler) override;
@@ -56,6 +69,12 @@ namespace libp2p::host {
     void newStream(const peer::PeerInfo &p, const peer::Protocol &protocol,
                    const StreamResultHandler &handler) override;
 
+    void acquireStream(const peer::PeerInfo &p, const peer::Protocol &protocol,
+                       const StreamResultHandler &handler) override;
+
+    void releaseStream(const peer::Protocol &protocol,
+                       std::shared_ptr<connection::Stream> stream) override;
+
     outcome::result<void> listen(const multi::Multiaddress &ma) override;
 
     outcome::result<void> closeListener(const multi::Multiaddress &ma) override;
@@ -80,6 +99,10 @@ namespace libp2p::host {
     std::unique_ptr<network::Network> network_;
     std::unique_ptr<peer::PeerRepository> repo_;
     std::shared_ptr<event::Bus> bus_;
+    std::shared_ptr<boost::asio::io_context> context_;
+    std::shared_ptr<ConnectionPrewarmer> prewarmer_;
+    std::shared_ptr<MaintenanceScheduler> maintenance_;
+    StreamPool stream_pool_;
   };
 
 }  // namespace libp2p::host
@@ -0,0 +1,71 @@
+/**
+ * Copyright Soramitsu Co., Ltd. All Rights Reserved.
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#ifndef LIBP2P_CONNECTION_PREWARMER_HPP
+#define LIBP2P_CONNECTION_PREWARMER_HPP
+
+#include <chrono>
+#include <unordered_set>
+#include <vector>
+
+#include <boost/asio/io_context.hpp>
+#include <boost/asio/steady_timer.hpp>
+#include <libp2p/network/network.hpp>
+#include <libp2p/peer/peer_info.hpp>
+
+namespace libp2p::host {
+
+  /**
+   * Keeps upgraded connections to some peers of a configured set, so that new
+   * streams to them do not wait for transport, security and muxer handshakes
+   */
+  class ConnectionPrewarmer
+      : public std::enable_shared_from_this<ConnectionPrewarmer> {
+   public:
+    /**
+     * @param network - network to dial the peers with
+     * @param context - io context of the periodic check; if null, the peers
+     * are dialed only once, on start
+     * @param peers - peers to be kept warm, in order of preference
+     * @param connections - how many of the peers are kept connected
+     * @param check_interval - how often closed connections are redialed
+     */
+    ConnectionPrewarmer(network::Network &network,
+                        std::shared_ptr<boost::asio::io_context> context,
+                        std::vector<peer::PeerInfo> peers, size_t connections,
+                        std::chrono::milliseconds check_interval);
+
+    /// dial the peers and start checking the connections
+    void start();
+
+    /// stop checking the connections; the established ones are not closed
+    void stop();
+
+    /// @return how many peers of the set are connected now
+    size_t warmConnections() const;
+
+   private:
+    bool isConnected(const peer::PeerId &peer) const;
+
+    void check();
+
+    /// move the peer, which has failed to connect, to the end of the set
+    void demote(const peer::PeerId &peer);
+
+    void scheduleCheck();
+
+    network::Network &network_;
+    std::shared_ptr<boost::asio::io_context> context_;
+    std::vector<peer::PeerInfo> peers_;
+    size_t connections_;
+    std::chrono::milliseconds check_interval_;
+    std::unique_ptr<boost::asio::steady_timer> timer_;
+    std::unordered_set<peer::PeerId> dialing_;
+    bool started_ = false;
+  };
+
+}  // namespace libp2p::host
+
+#endif  // LIBP2P_CONNECTION_PREWARMER_HPP
@@ -0,0 +1,80 @@
+/**
+ * Copyright Soramitsu Co., Ltd. All Rights Reserved.
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#ifndef LIBP2P_MAINTENANCE_SCHEDULER_HPP
+#define LIBP2P_MAINTENANCE_SCHEDULER_HPP
+
+#include <chrono>
+#include <vector>
+
+#include <boost/asio/io_context.hpp>
+#include <boost/asio/steady_timer.hpp>
+#include <libp2p/basic/garbage_collectable.hpp>
+
+namespace libp2p::host {
+
+  /**
+   * Collects garbage of the host's components in background: once per
+   * interval each component makes a pass over its data, in steps of a bounded
+   * number of entries, and the steps are run in time slices, between which
+   * the io context serves other handlers
+   */
+  class MaintenanceScheduler
+      : public std::enable_shared_from_this<MaintenanceScheduler> {
+   public:
+    /**
+     * @param context - io context, in which garbage is collected
+     * @param interval - how often the passes are started
+     * @param time_slice - how long the steps may run without a break; at
+     * least one step is made per slice
+     * @param step_entries - how many entries a single step may visit
+     */
+    MaintenanceScheduler(std::shared_ptr<boost::asio::io_context> context,
+                         std::chrono::milliseconds interval,
+                         std::chrono::microseconds time_slice,
+                         size_t step_entries);
+
+    /**
+     * Add a component, which must outlive the scheduler
+     * @param collectable - component to be collected
+     */
+    void add(basic::GarbageCollectable &collectable);
+
+    /// start the passes
+    void start();
+
+    /// stop the passes; the current one is not completed
+    void stop();
+
+    /**
+     * Make steps of the current pass for one time slice
+     * @return true, if all components have completed the pass
+     */
+    bool runSlice();
+
+   private:
+    struct Component {
+      basic::GarbageCollectable *collectable;
+      bool pass_completed;
+    };
+
+    void schedule(std::chrono::steady_clock::duration delay);
+
+    /// start a new pass over all components
+    void startPass();
+
+    std::shared_ptr<boost::asio::io_context> context_;
+    std::chrono::milliseconds interval_;
+    std::chrono::microseconds time_slice_;
+    size_t step_entries_;
+    boost::asio::steady_timer timer_;
+    std::vector<Component> components_;
+    size_t next_component_ = 0;
+    bool started_ = false;
+  };
+
+}  // namespace libp2p::host
+
+#endif  // LIBP2P_MAINTENANCE_SCHEDULER_HPP
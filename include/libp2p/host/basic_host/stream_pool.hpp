@@ -0,0 +1,93 @@
+/**
+ * Copyright Soramitsu Co., Ltd. All Rights Reserved.
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#ifndef LIBP2P_STREAM_POOL_HPP
+#define LIBP2P_STREAM_POOL_HPP
+
+#include <chrono>
+#include <unordered_map>
+#include <vector>
+
+#include <libp2p/basic/garbage_collectable.hpp>
+#include <libp2p/network/network.hpp>
+#include <libp2p/peer/peer_info.hpp>
+#include <libp2p/peer/protocol.hpp>
+
+namespace libp2p::host {
+
+  /**
+   * Keeps idle streams, whose protocols are already negotiated, so that a
+   * request to a peer reuses one of them instead of paying for the stream
+   * opening, the protocol negotiation and the teardown each time; the streams
+   * are expected to carry request-response protocols, in which a stream is
+   * idle between a response and the next request
+   * @note not thread-safe; is expected to be used from the network's
+   * io_context only
+   */
+  class StreamPool : public basic::GarbageCollectable {
+   public:
+    using Clock = std::chrono::steady_clock;
+    using StreamResultFunc = std::function<void(
+        outcome::result<std::shared_ptr<connection::Stream>>)>;
+
+    /**
+     * @param network - network to open new streams with
+     * @param idle_timeout - how long a stream may stay idle, before it is
+     * closed
+     * @param max_idle_per_peer - how many idle streams are kept to a peer
+     * over all protocols; the oldest one is closed to make room for a new one
+     */
+    StreamPool(network::Network &network,
+               std::chrono::milliseconds idle_timeout,
+               size_t max_idle_per_peer);
+
+    /**
+     * Get an idle stream to the peer with the protocol or open a new one, if
+     * there is none
+     * @param p - peer to get the stream to
+     * @param protocol of the stream
+     * @param cb - callback with the stream or an error
+     */
+    void acquire(const peer::PeerInfo &p, const peer::Protocol &protocol,
+                 StreamResultFunc cb);
+
+    /**
+     * Return the stream, which has been acquired, to the pool; the stream is
+     * closed instead, if it is closed by the other side, or if the pool has no
+     * room for it
+     * @param protocol of the stream
+     * @param stream to be returned; its last response must be read completely
+     */
+    void release(const peer::Protocol &protocol,
+                 std::shared_ptr<connection::Stream> stream);
+
+    /// @return how many idle streams are kept now
+    size_t idleStreams() const;
+
+    /// close the expired streams and forget the closed ones
+    void collectGarbage() override;
+
+   private:
+    struct IdleStream {
+      peer::Protocol protocol;
+      std::shared_ptr<connection::Stream> stream;
+      Clock::time_point expires;
+    };
+
+    static bool isUsable(const IdleStream &idle, Clock::time_point now);
+
+    static void close(std::shared_ptr<connection::Stream> stream);
+
+    network::Network &network_;
+    std::chrono::milliseconds idle_timeout_;
+    size_t max_idle_per_peer_;
+
+    /// idle streams of each peer, from the least recently released
+    std::unordered_map<peer::PeerId, std::vector<IdleStream>> idle_;
+  };
+
+}  // namespace libp2p::host
+
+#endif  // LIBP2P_STREAM_POOL_HPP
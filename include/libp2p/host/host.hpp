@@ -107,6 +107,17 @@ namespace libp2p {
      */
     virtual void connect(const peer::PeerInfo &p) = 0;
 
+    /**
+     * @brief Keep upgraded connections to {@param connections} peers of
+     * {@param peers}, so that new streams to them do not wait for handshakes.
+     * Closed connections are replaced periodically. Replaces the previously
+     * set peers.
+     * @param peers to be kept connected, in order of preference
+     * @param connections - how many of the peers are kept connected
+     */
+    virtual void keepWarm(std::vector<peer::PeerInfo> peers,
+                          size_t connections) = 0;
+
     /**
      * @brief Open new stream to the peer {@param p} with protocol {@param
      * protocol}.
@@ -118,6 +129,30 @@ namespace libp2p {
                            const peer::Protocol &protocol,
                            const StreamResultHandler &handler) = 0;
 
+    /**
+     * @brief Get an idle stream to the peer {@param p} with protocol {@param
+     * protocol}, which has been released to the host's pool, or open a new
+     * one, if there is none. The protocol of a pooled stream is already
+     * negotiated, so a request can be written to it at once.
+     * @param p stream will be opened to this peer
+     * @param protocol "speak" using this protocol
+     * @param handler callback, will be executed on success or fail
+     */
+    virtual void acquireStream(const peer::PeerInfo &p,
+                               const peer::Protocol &protocol,
+                               const StreamResultHandler &handler) = 0;
+
+    /**
+     * @brief Return the stream {@param stream}, acquired before, to the pool,
+     * so that the next request with the same protocol reuses it. The stream
+     * must have no unread data. It is closed, if it stays idle for too long,
+     * or if the pool has no room for it.
+     * @param protocol of the stream
+     * @param stream to be returned
+     */
+    virtual void releaseStream(const peer::Protocol &protocol,
+                               std::shared_ptr<connection::Stream> stream) = 0;
+
     /**
      * @brief Create listener on given multiaddress.
      * @param ma address
@@ -14,7 +14,6 @@
 #include <libp2p/peer/address_repository/inmem_address_repository.hpp>
 #include <libp2p/peer/impl/peer_repository_impl.hpp>
 #include <libp2p/peer/key_repository/inmem_key_repository.hpp>
-#include <libp2p/peer/protocol_repository/inmem_protocol_repository.hpp>
 
 namespace libp2p::injector {
 
@@ -34,7 +33,6 @@ namespace libp2p::injector {
         di::bind<peer::PeerRepository>.template to<peer::PeerRepositoryImpl>(),
         di::bind<peer::AddressRepository>.template to<peer::InmemAddressRepository>(),
         di::bind<peer::KeyRepository>.template to<peer::InmemKeyRepository>(),
-        di::bind<peer::ProtocolRepository>.template to<peer::InmemProtocolRepository>(),
 
         // user-defined overrides...
         std::forward<decltype(args)>(args)...
@@ -16,18 +16,25 @@
 #include <libp2p/crypto/random_generator/boost_generator.hpp>
 #include <libp2p/muxer/mplex.hpp>
 #include <libp2p/muxer/yamux.hpp>
+#include <libp2p/network/impl/blocklist_gater.hpp>
 #include <libp2p/network/impl/connection_manager_impl.hpp>
 #include <libp2p/network/impl/dialer_impl.hpp>
 #include <libp2p/network/impl/listener_manager_impl.hpp>
 #include <libp2p/network/impl/network_impl.hpp>
+#include <libp2p/network/impl/peer_scorer_impl.hpp>
+#include <libp2p/network/impl/resource_manager_impl.hpp>
 #include <libp2p/network/impl/router_impl.hpp>
 #include <libp2p/network/impl/transport_manager_impl.hpp>
 #include <libp2p/peer/impl/identity_manager_impl.hpp>
+#include <libp2p/peer/protocol_repository/inmem_protocol_repository.hpp>
 #include <libp2p/protocol_muxer/multiselect.hpp>
+#include <libp2p/security/noise.hpp>
 #include <libp2p/security/plaintext.hpp>
 #include <libp2p/security/plaintext/exchange_message_marshaller_impl.hpp>
+#include <libp2p/security/secio.hpp>
 #include <libp2p/transport/impl/upgrader_impl.hpp>
 #include <libp2p/transport/tcp.hpp>
+#include <libp2p/transport/unix.hpp>
 
 // clang-format off
 /**
@@ -41,14 +48,18 @@
  *
  * By default:
  * - TCP is used as transport
- * - Plaintext as security
+ * - Noise, SECIO and Plaintext as security
  * - Yamux as muxer
  * - Random keypair is generated
+ * - Metrics are kept in a single metrics::Registry, which can be created from
+ *   the injector, e.g. to be served with metrics::PrometheusExporter
  *
  * List of libraries that should be linked to your lib/exe:
  *  - libp2p_network
  *  - libp2p_tcp
  *  - libp2p_yamux
+ *  - libp2p_noise
+ *  - libp2p_secio
  *  - libp2p_plaintext
  *  - libp2p_connection_manager
  *  - libp2p_transport_manager
@@ -61,7 +72,7 @@
  *  - key_generator
  *  - marshaller
  *
- * <b>Example 1</b>: Make default network with Yamux as muxer, Plaintext as
+ * <b>Example 1</b>: Make default network with Yamux as muxer, Noise as
  * security, TCP as transport.
  * @code
  * auto injector = makeNetworkInjector();
@@ -178,7 +189,7 @@ namespace libp2p::injector {
    * struct SomeNewAdaptor : public SecurityAdaptor {...};
    *
    * auto injector = makeNetworkInjector(
-   *   useSecurityAdaptors<Plaintext, SomeNewAdaptor, SecioAdaptor>()
+   *   useSecurityAdaptors<Plaintext, SomeNewAdaptor, Secio>()
    * );
    * @endcode
    */
@@ -246,21 +257,31 @@ namespace libp2p::injector {
         di::bind<peer::IdentityManager>().template to<peer::IdentityManagerImpl>(),
         di::bind<crypto::validator::KeyValidator>().template to<crypto::validator::KeyValidatorImpl>(),
         di::bind<security::plaintext::ExchangeMessageMarshaller>().template to<security::plaintext::ExchangeMessageMarshallerImpl>(),
+        di::bind<security::noise::NoiseConfig>().template to(security::noise::NoiseConfig{}),
+        di::bind<transport::TransportConfig>().template to(transport::TransportConfig{}),
+        di::bind<transport::UnixConfig>().template to(transport::UnixConfig{}),
+        di::bind<peer::ProtocolRepository>().template to<peer::InmemProtocolRepository>(),
 
         // internal
         di::bind<network::Router>().template to<network::RouterImpl>(),
         di::bind<network::ConnectionManager>().template to<network::ConnectionManagerImpl>(),
+        di::bind<network::ConnectionManagerConfig>().template to(network::ConnectionManagerConfig{}),
+        di::bind<network::PeerScorer>().template to<network::PeerScorerImpl>(),
+        di::bind<network::ResourceManager>().template to<network::ResourceManagerImpl>(),
+        di::bind<network::ResourceManagerConfig>().template to(network::ResourceManagerConfig{}),
+        di::bind<network::ConnectionGater>().template to<network::BlocklistGater>(),
         di::bind<network::ListenerManager>().template to<network::ListenerManagerImpl>(),
         di::bind<network::Dialer>().template to<network::DialerImpl>(),
+        di::bind<network::DialerConfig>().template to(network::DialerConfig{}),
         di::bind<network::Network>().template to<network::NetworkImpl>(),
         di::bind<network::TransportManager>().template to<network::TransportManagerImpl>(),
         di::bind<transport::Upgrader>().template to<transport::UpgraderImpl>(),
         di::bind<protocol_muxer::ProtocolMuxer>().template to<protocol_muxer::Multiselect>(),
 
         // default adaptors
-        di::bind<security::SecurityAdaptor *[]>().template to<security::Plaintext>(),  // NOLINT
+        di::bind<security::SecurityAdaptor *[]>().template to<security::Noise, security::Secio, security::Plaintext>(),  // NOLINT
         di::bind<muxer::MuxerAdaptor *[]>().template to<muxer::Yamux, muxer::Mplex>(),  // NOLINT
-        di::bind<transport::TransportAdaptor *[]>().template to<transport::TcpTransport>(),  // NOLINT
+        di::bind<transport::TransportAdaptor *[]>().template to<transport::TcpTransport, transport::UnixTransport>(),  // NOLINT
 
         // user-defined overrides...
         std::forward<decltype(args)>(args)...
@@ -0,0 +1,33 @@
+/**
+ * Copyright Soramitsu Co., Ltd. All Rights Reserved.
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#ifndef LIBP2P_METRICS_COUNTER_HPP
+#define LIBP2P_METRICS_COUNTER_HPP
+
+#include <atomic>
+#include <cstdint>
+
+namespace libp2p::metrics {
+
+  /**
+   * Value, which only grows, e.g. number of bytes sent
+   */
+  class Counter {
+   public:
+    void inc(uint64_t delta = 1) {
+      value_.fetch_add(delta, std::memory_order_relaxed);
+    }
+
+    uint64_t value() const {
+      return value_.load(std::memory_order_relaxed);
+    }
+
+   private:
+    std::atomic<uint64_t> value_{0};
+  };
+
+}  // namespace libp2p::metrics
+
+#endif  // LIBP2P_METRICS_COUNTER_HPP
@@ -0,0 +1,41 @@
+/**
+ * Copyright Soramitsu Co., Ltd. All Rights Reserved.
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#ifndef LIBP2P_METRICS_GAUGE_HPP
+#define LIBP2P_METRICS_GAUGE_HPP
+
+#include <atomic>
+#include <cstdint>
+
+namespace libp2p::metrics {
+
+  /**
+   * Value, which goes up and down, e.g. number of open streams
+   */
+  class Gauge {
+   public:
+    void inc(int64_t delta = 1) {
+      value_.fetch_add(delta, std::memory_order_relaxed);
+    }
+
+    void dec(int64_t delta = 1) {
+      value_.fetch_sub(delta, std::memory_order_relaxed);
+    }
+
+    void set(int64_t value) {
+      value_.store(value, std::memory_order_relaxed);
+    }
+
+    int64_t value() const {
+      return value_.load(std::memory_order_relaxed);
+    }
+
+   private:
+    std::atomic<int64_t> value_{0};
+  };
+
+}  // namespace libp2p::metrics
+
+#endif  // LIBP2P_METRICS_GAUGE_HPP
@@ -0,0 +1,77 @@
+/**
+ * Copyright Soramitsu Co., Ltd. All Rights Reserved.
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#ifndef LIBP2P_METRICS_HISTOGRAM_HPP
+#define LIBP2P_METRICS_HISTOGRAM_HPP
+
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <vector>
+
+namespace libp2p::metrics {
+
+  /**
+   * Distribution of integer values, e.g. latencies in microseconds, in the
+   * log-linear buckets of HdrHistogram: each power of two is split into
+   * kSubBuckets equal buckets, so that any value is known with the relative
+   * error below 1 / kSubBuckets, while the memory is fixed and a value is
+   * recorded with a few relaxed atomic additions
+   */
+  class Histogram {
+   public:
+    using Clock = std::chrono::steady_clock;
+
+    static constexpr size_t kSubBucketBits = 3;
+    static constexpr size_t kSubBuckets = 1u << kSubBucketBits;
+
+    /// values below kSubBuckets get a bucket each, and so does the rest of
+    /// each of the powers of two up to 2^63
+    static constexpr size_t kBuckets = (65 - kSubBucketBits) * kSubBuckets;
+
+    /// bucket, which has values
+    struct Bucket {
+      /// the biggest value of the bucket
+      uint64_t upper_bound;
+      /// number of the values in the bucket
+      uint64_t count;
+    };
+
+    void record(uint64_t value);
+
+    /// record microseconds, passed since the moment
+    void recordSince(Clock::time_point start);
+
+    /// @return number of the recorded values
+    uint64_t count() const;
+
+    /// @return sum of the recorded values
+    uint64_t sum() const;
+
+    /**
+     * Estimate a quantile of the recorded values
+     * @param q - quantile from 0 to 1, e.g. 0.99
+     * @return the biggest value of the bucket, where the quantile is; 0, if
+     * nothing was recorded
+     */
+    uint64_t quantile(double q) const;
+
+    /// @return buckets, which have values, in the ascending order
+    std::vector<Bucket> buckets() const;
+
+    static size_t bucketIndex(uint64_t value);
+
+    static uint64_t bucketUpperBound(size_t index);
+
+   private:
+    std::array<std::atomic<uint64_t>, kBuckets> buckets_{};
+    std::atomic<uint64_t> count_{0};
+    std::atomic<uint64_t> sum_{0};
+  };
+
+}  // namespace libp2p::metrics
+
+#endif  // LIBP2P_METRICS_HISTOGRAM_HPP
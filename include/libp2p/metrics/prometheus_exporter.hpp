@@ -0,0 +1,70 @@
+/**
+ * Copyright Soramitsu Co., Ltd. All Rights Reserved.
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#ifndef LIBP2P_METRICS_PROMETHEUS_EXPORTER_HPP
+#define LIBP2P_METRICS_PROMETHEUS_EXPORTER_HPP
+
+#include <boost/asio/io_context.hpp>
+#include <boost/asio/ip/tcp.hpp>
+#include <libp2p/metrics/registry.hpp>
+#include <libp2p/outcome/outcome.hpp>
+
+namespace libp2p::metrics {
+
+  /**
+   * HTTP endpoint, which serves the metrics of a registry at /metrics in the
+   * Prometheus text format; each request is answered and the connection is
+   * closed
+   * @note there are no limits on the clients, so the endpoint is expected to
+   * be local
+   */
+  class PrometheusExporter
+      : public std::enable_shared_from_this<PrometheusExporter> {
+   public:
+    /**
+     * @param context - io_context of the sockets
+     * @param registry, whose metrics are served
+     */
+    PrometheusExporter(boost::asio::io_context &context,
+                       std::shared_ptr<const Registry> registry);
+
+    /**
+     * Start serving the metrics
+     * @param endpoint to be listened to, e.g. 127.0.0.1:9100; a port is
+     * chosen by the system, if it is 0
+     */
+    outcome::result<void> listen(
+        const boost::asio::ip::tcp::endpoint &endpoint);
+
+    /// @return endpoint, which is listened to
+    outcome::result<boost::asio::ip::tcp::endpoint> localEndpoint() const;
+
+    /// stop accepting the requests
+    void close();
+
+    /// @return the families in the Prometheus text exposition format
+    static std::string format(const std::vector<MetricFamily> &families);
+
+   private:
+    struct Session;
+
+    /// requests are a single line with a few headers
+    static constexpr size_t kMaxRequestSize = 8192;
+
+    void doAccept();
+
+    void serve(std::shared_ptr<Session> session);
+
+    /// @return HTTP response to the request line
+    std::string respond(const std::string &method,
+                        const std::string &target) const;
+
+    boost::asio::ip::tcp::acceptor acceptor_;
+    std::shared_ptr<const Registry> registry_;
+  };
+
+}  // namespace libp2p::metrics
+
+#endif  // LIBP2P_METRICS_PROMETHEUS_EXPORTER_HPP
@@ -0,0 +1,82 @@
+/**
+ * Copyright Soramitsu Co., Ltd. All Rights Reserved.
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#ifndef LIBP2P_METRICS_REGISTRY_HPP
+#define LIBP2P_METRICS_REGISTRY_HPP
+
+#include <map>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <variant>
+#include <vector>
+
+#include <libp2p/metrics/counter.hpp>
+#include <libp2p/metrics/gauge.hpp>
+#include <libp2p/metrics/histogram.hpp>
+
+namespace libp2p::metrics {
+
+  /// names and values of the labels of a metric, e.g. {{"direction", "in"}}
+  using Labels = std::map<std::string, std::string>;
+
+  enum class MetricType { COUNTER, GAUGE, HISTOGRAM };
+
+  using Metric = std::variant<std::shared_ptr<Counter>, std::shared_ptr<Gauge>,
+                              std::shared_ptr<Histogram>>;
+
+  /// metrics of one name, which differ by their labels
+  struct MetricFamily {
+    std::string name;
+    std::string help;
+    MetricType type;
+    std::map<Labels, Metric> metrics;
+  };
+
+  /**
+   * Named metrics of the stack. A metric is looked up here once, usually
+   * when its owner is created, and is updated by the owner without any locks
+   * after that
+   * @note thread-safe
+   */
+  class Registry {
+   public:
+    /**
+     * Get a counter, creating it on the first call
+     * @param name of the family, e.g. "libp2p_dial_failures_total"
+     * @param help - description of the family; the first one is kept
+     * @param labels, which tell the counter from the others of the family
+     * @note a metric, whose name is taken by a family of another type, is
+     * returned, but is not exported
+     */
+    std::shared_ptr<Counter> counter(const std::string &name,
+                                     const std::string &help,
+                                     const Labels &labels = {});
+
+    /// get a gauge, creating it on the first call
+    std::shared_ptr<Gauge> gauge(const std::string &name,
+                                 const std::string &help,
+                                 const Labels &labels = {});
+
+    /// get a histogram, creating it on the first call
+    std::shared_ptr<Histogram> histogram(const std::string &name,
+                                         const std::string &help,
+                                         const Labels &labels = {});
+
+    /// @return copy of the families, ordered by their names
+    std::vector<MetricFamily> collect() const;
+
+   private:
+    template <typename T>
+    std::shared_ptr<T> get(const std::string &name, const std::string &help,
+                           MetricType type, const Labels &labels);
+
+    mutable std::mutex mutex_;
+    std::map<std::string, MetricFamily> families_;
+  };
+
+}  // namespace libp2p::metrics
+
+#endif  // LIBP2P_METRICS_REGISTRY_HPP
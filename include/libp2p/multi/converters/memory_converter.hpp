@@ -0,0 +1,25 @@
+/**
+ * Copyright Soramitsu Co., Ltd. All Rights Reserved.
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#ifndef LIBP2P_MEMORYCONVERTER_HPP
+#define LIBP2P_MEMORYCONVERTER_HPP
+
+#include <libp2p/outcome/outcome.hpp>
+
+namespace libp2p::multi::converters {
+
+  /**
+   * Converts a memory part of a multiaddress (an in-process listener id)
+   * to bytes representation as a hex string
+   */
+  class MemoryConverter {
+   public:
+    static auto addressToHex(std::string_view addr)
+        -> outcome::result<std::string>;
+  };
+
+}  // namespace libp2p::multi::converters
+
+#endif  // LIBP2P_MEMORYCONVERTER_HPP
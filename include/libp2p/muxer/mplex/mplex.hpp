@@ -6,13 +6,27 @@
 #ifndef LIBP2P_MPLEX_IMPL_HPP
 #define LIBP2P_MPLEX_IMPL_HPP
 
+#include <libp2p/event/bus.hpp>
 #include <libp2p/muxer/muxed_connection_config.hpp>
 #include <libp2p/muxer/muxer_adaptor.hpp>
+#include <libp2p/muxer/muxer_metrics.hpp>
+#include <libp2p/network/resource_manager.hpp>
 
 namespace libp2p::muxer {
   class Mplex : public MuxerAdaptor {
    public:
-    explicit Mplex(MuxedConnectionConfig config);
+    /**
+     * Create a muxer with Mplex protocol
+     * @param config of muxers to be created over the connections
+     * @param bus, to which the connections publish their termination
+     * @param rmgr - resource manager, which accounts the streams
+     * @param registry, where the metrics of the connections are kept; may be
+     * null
+     */
+    Mplex(MuxedConnectionConfig config,
+          std::shared_ptr<libp2p::event::Bus> bus,
+          std::shared_ptr<network::ResourceManager> rmgr,
+          std::shared_ptr<metrics::Registry> registry = nullptr);
 
     peer::Protocol getProtocolId() const noexcept override;
 
@@ -21,6 +35,9 @@ namespace libp2p::muxer {
 
    private:
     MuxedConnectionConfig config_;
+    std::shared_ptr<libp2p::event::Bus> bus_;
+    std::shared_ptr<network::ResourceManager> rmgr_;
+    std::shared_ptr<MuxerMetrics> metrics_;
   };
 }  // namespace libp2p::muxer
 
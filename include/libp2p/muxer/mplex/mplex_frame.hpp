@@ -42,6 +42,12 @@ namespace libp2p::connection {
      * @return bytes representation of the frame
      */
     common::ByteArray toBytes() const;
+
+    /**
+     * Get size of the frame without converting it
+     * @return number of bytes in the representation of the frame
+     */
+    size_t size() const;
   };
 
   /**
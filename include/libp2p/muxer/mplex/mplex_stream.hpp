@@ -27,6 +27,10 @@ namespace libp2p::connection {
      * were opened from two different sides
      */
     using StreamNumber = uint32_t;
+
+    /// how much unread data a new stream can have
+    static constexpr uint32_t kInitialWindowSize = 256 * 1024;
+
     struct StreamId {
       StreamNumber number;
       bool initiator;
@@ -41,9 +45,12 @@ namespace libp2p::connection {
      * Create an instance of Mplex stream
      * @param connection, over which this stream is opened
      * @param stream_id of this stream
+     * @param remote_peer - id of the peer, shared by streams of the
+     * connection
      */
     MplexStream(std::weak_ptr<MplexedConnection> connection,
-                StreamId stream_id);
+                StreamId stream_id,
+                std::shared_ptr<const peer::PeerId> remote_peer);
 
     ~MplexStream() override = default;
 
@@ -84,7 +91,7 @@ namespace libp2p::connection {
 
     void adjustWindowSize(uint32_t new_size, VoidResultHandlerFunc cb) override;
 
-    outcome::result<peer::PeerId> remotePeerId() const override;
+    const peer::PeerId &remotePeerId() const override;
 
     outcome::result<bool> isInitiator() const override;
 
@@ -102,6 +109,7 @@ namespace libp2p::connection {
 
     std::weak_ptr<MplexedConnection> connection_;
     StreamId stream_id_;
+    std::shared_ptr<const peer::PeerId> remote_peer_;
     common::Logger log_ = common::createLogger("MplexStream");
 
     /// data, received for this stream, comes here
@@ -124,7 +132,7 @@ namespace libp2p::connection {
 
     /// how much unread data can be in this stream at one time; if new data
     /// exceeding this value is received, the stream is reset
-    uint32_t receive_window_size_ = 256 * 1024;  // 256 MB
+    uint32_t receive_window_size_ = kInitialWindowSize;
 
     /// MplexedConnection API starts here
     friend class MplexedConnection;
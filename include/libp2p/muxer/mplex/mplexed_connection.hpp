@@ -12,8 +12,11 @@
 
 #include <libp2p/common/logger.hpp>
 #include <libp2p/connection/capable_connection.hpp>
+#include <libp2p/event/bus.hpp>
+#include <libp2p/network/resource_manager.hpp>
 #include <libp2p/muxer/mplex/mplex_stream.hpp>
 #include <libp2p/muxer/muxed_connection_config.hpp>
+#include <libp2p/muxer/muxer_metrics.hpp>
 
 namespace libp2p::connection {
   struct MplexFrame;
@@ -32,15 +35,23 @@ namespace libp2p::connection {
      * Create a new instance of MplexedConnection
      * @param connection to be multiplexed
      * @param config of the multiplexer
-     */
-    MplexedConnection(std::shared_ptr<SecureConnection> connection,
-                      muxer::MuxedConnectionConfig config);
+     * @param bus, to which termination of the connection is published; may
+     * be null
+     * @param rmgr - resource manager, which accounts the streams; may be null
+     * @param metrics, which the connection updates; may be null
+     */
+    MplexedConnection(
+        std::shared_ptr<SecureConnection> connection,
+        muxer::MuxedConnectionConfig config,
+        std::shared_ptr<libp2p::event::Bus> bus = nullptr,
+        std::shared_ptr<network::ResourceManager> rmgr = nullptr,
+        std::shared_ptr<muxer::MuxerMetrics> metrics = nullptr);
 
     MplexedConnection(const MplexedConnection &other) = delete;
     MplexedConnection &operator=(const MplexedConnection &other) = delete;
     MplexedConnection(MplexedConnection &&other) noexcept = delete;
     MplexedConnection &operator=(MplexedConnection &&other) noexcept = delete;
-    ~MplexedConnection() override = default;
+    ~MplexedConnection() override;
 
     void start() override;
 
@@ -50,9 +61,11 @@ namespace libp2p::connection {
 
     void onStream(NewStreamHandlerFunc cb) override;
 
-    outcome::result<peer::PeerId> localPeer() const override;
+    size_t streamsCount() const override;
+
+    const peer::PeerId &localPeer() const override;
 
-    outcome::result<peer::PeerId> remotePeer() const override;
+    const peer::PeerId &remotePeer() const override;
 
     outcome::result<crypto::PublicKey> remotePublicKey() const override;
 
@@ -162,7 +175,18 @@ namespace libp2p::connection {
      */
     void closeSession();
 
+    /// publish termination of the connection, once
+    void publishClosed();
+
+    /// account a new stream in the resource manager
+    outcome::result<void> reserveStream();
+
+    /// release a stream, accounted before
+    void releaseStream();
+
     std::shared_ptr<SecureConnection> connection_;
+    /// id of the remote peer, which is shared with the streams
+    std::shared_ptr<const peer::PeerId> remote_peer_;
     muxer::MuxedConnectionConfig config_;
 
     std::unordered_map<MplexStream::StreamId, std::shared_ptr<MplexStream>>
@@ -170,6 +194,12 @@ namespace libp2p::connection {
     MplexStream::StreamNumber last_issued_stream_number_ = 1;
     NewStreamHandlerFunc new_stream_handler_;
 
+    std::shared_ptr<libp2p::event::Bus> bus_;
+    bool closed_published_ = false;
+
+    std::shared_ptr<network::ResourceManager> rmgr_;
+    std::shared_ptr<muxer::MuxerMetrics> metrics_;
+
     bool is_active_ = false;
     common::Logger log_ = common::createLogger("MplexedConnection");
 
@@ -0,0 +1,35 @@
+/**
+ * Copyright Soramitsu Co., Ltd. All Rights Reserved.
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#ifndef LIBP2P_MUXER_METRICS_HPP
+#define LIBP2P_MUXER_METRICS_HPP
+
+#include <libp2p/metrics/registry.hpp>
+
+namespace libp2p::muxer {
+
+  /**
+   * Metrics, which the connections of a muxer share
+   */
+  struct MuxerMetrics {
+    /**
+     * Get the metrics from the registry
+     * @param registry of the metrics
+     * @param muxer - name of the muxer to label them with, e.g. "yamux"
+     */
+    MuxerMetrics(metrics::Registry &registry, const std::string &muxer);
+
+    std::shared_ptr<metrics::Counter> bytes_in;
+    std::shared_ptr<metrics::Counter> bytes_out;
+    std::shared_ptr<metrics::Counter> frames_in;
+    std::shared_ptr<metrics::Counter> frames_out;
+
+    /// open streams of all the connections
+    std::shared_ptr<metrics::Gauge> streams;
+  };
+
+}  // namespace libp2p::muxer
+
+#endif  // LIBP2P_MUXER_METRICS_HPP
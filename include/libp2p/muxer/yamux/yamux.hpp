@@ -6,8 +6,11 @@
 #ifndef LIBP2P_YAMUX_IMPL_HPP
 #define LIBP2P_YAMUX_IMPL_HPP
 
+#include <libp2p/event/bus.hpp>
 #include <libp2p/muxer/muxed_connection_config.hpp>
 #include <libp2p/muxer/muxer_adaptor.hpp>
+#include <libp2p/muxer/muxer_metrics.hpp>
+#include <libp2p/network/resource_manager.hpp>
 
 namespace libp2p::muxer {
   class Yamux : public MuxerAdaptor {
@@ -17,8 +20,15 @@ namespace libp2p::muxer {
     /**
      * Create a muxer with Yamux protocol
      * @param config of muxers to be created over the connections
+     * @param bus, to which the connections publish their termination
+     * @param rmgr - resource manager, which accounts the streams
+     * @param registry, where the metrics of the connections are kept; may be
+     * null
      */
-    explicit Yamux(MuxedConnectionConfig config);
+    Yamux(MuxedConnectionConfig config,
+          std::shared_ptr<libp2p::event::Bus> bus,
+          std::shared_ptr<network::ResourceManager> rmgr,
+          std::shared_ptr<metrics::Registry> registry = nullptr);
 
     peer::Protocol getProtocolId() const noexcept override;
 
@@ -27,6 +37,9 @@ namespace libp2p::muxer {
 
    private:
     MuxedConnectionConfig config_;
+    std::shared_ptr<libp2p::event::Bus> bus_;
+    std::shared_ptr<network::ResourceManager> rmgr_;
+    std::shared_ptr<MuxerMetrics> metrics_;
   };
 }  // namespace libp2p::muxer
 
@@ -26,10 +26,13 @@ namespace libp2p::connection {
      * @param yamuxed_connection, over which this stream is created
      * @param stream_id - id of this stream
      * @param maximum_window_size - maximum size of the stream's window
+     * @param remote_peer - id of the peer, shared by streams of the
+     * connection
      */
     YamuxStream(std::weak_ptr<YamuxedConnection> yamuxed_connection,
                 YamuxedConnection::StreamId stream_id,
-                uint32_t maximum_window_size);
+                uint32_t maximum_window_size,
+                std::shared_ptr<const peer::PeerId> remote_peer);
 
     enum class Error {
       NOT_WRITABLE = 1,
@@ -67,7 +70,7 @@ namespace libp2p::connection {
 
     void adjustWindowSize(uint32_t new_size, VoidResultHandlerFunc cb) override;
 
-    outcome::result<peer::PeerId> remotePeerId() const override;
+    const peer::PeerId &remotePeerId() const override;
 
     outcome::result<bool> isInitiator() const override;
 
@@ -92,6 +95,7 @@ namespace libp2p::connection {
 
     std::weak_ptr<YamuxedConnection> yamuxed_connection_;
     YamuxedConnection::StreamId stream_id_;
+    std::shared_ptr<const peer::PeerId> remote_peer_;
 
     /// is the stream opened for reads?
     bool is_readable_ = true;
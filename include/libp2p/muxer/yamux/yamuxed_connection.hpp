@@ -14,7 +14,10 @@
 #include <libp2p/common/logger.hpp>
 #include <libp2p/common/types.hpp>
 #include <libp2p/connection/capable_connection.hpp>
+#include <libp2p/event/bus.hpp>
 #include <libp2p/muxer/muxed_connection_config.hpp>
+#include <libp2p/muxer/muxer_metrics.hpp>
+#include <libp2p/network/resource_manager.hpp>
 
 namespace libp2p::connection {
   struct YamuxFrame;
@@ -46,16 +49,23 @@ namespace libp2p::connection {
      * Create a new YamuxedConnection instance
      * @param connection to be multiplexed by this instance
      * @param config to configure this instance
-     * @param logger to output messages
+     * @param bus, to which termination of the connection is published; may
+     * be null
+     * @param rmgr - resource manager, which accounts the streams; may be null
+     * @param metrics, which the connection updates; may be null
      */
-    explicit YamuxedConnection(std::shared_ptr<SecureConnection> connection,
-                               muxer::MuxedConnectionConfig config = {});
+    explicit YamuxedConnection(
+        std::shared_ptr<SecureConnection> connection,
+        muxer::MuxedConnectionConfig config = {},
+        std::shared_ptr<libp2p::event::Bus> bus = nullptr,
+        std::shared_ptr<network::ResourceManager> rmgr = nullptr,
+        std::shared_ptr<muxer::MuxerMetrics> metrics = nullptr);
 
     YamuxedConnection(const YamuxedConnection &other) = delete;
     YamuxedConnection &operator=(const YamuxedConnection &other) = delete;
     YamuxedConnection(YamuxedConnection &&other) noexcept = delete;
     YamuxedConnection &operator=(YamuxedConnection &&other) noexcept = delete;
-    ~YamuxedConnection() override = default;
+    ~YamuxedConnection() override;
 
     void start() override;
 
@@ -65,9 +75,11 @@ namespace libp2p::connection {
 
     void onStream(NewStreamHandlerFunc cb) override;
 
-    outcome::result<peer::PeerId> localPeer() const override;
+    size_t streamsCount() const override;
 
-    outcome::result<peer::PeerId> remotePeer() const override;
+    const peer::PeerId &localPeer() const override;
+
+    const peer::PeerId &remotePeer() const override;
 
     outcome::result<crypto::PublicKey> remotePublicKey() const override;
 
@@ -104,9 +116,6 @@ namespace libp2p::connection {
     // indicates whether start() has been executed or not
     bool started_ = false;
 
-    // XXX
-    bool new_stream_pending_ = false;
-
     /**
      * Write message to the connection; ensures no more than one wright
      * would be executed at one time
@@ -238,13 +247,30 @@ namespace libp2p::connection {
      */
     void closeSession();
 
+    /// publish termination of the connection, once
+    void publishClosed();
+
+    /// account a new stream in the resource manager
+    outcome::result<void> reserveStream();
+
+    /// release a stream, accounted before
+    void releaseStream();
+
     std::shared_ptr<SecureConnection> connection_;
+    /// id of the remote peer, which is shared with the streams
+    std::shared_ptr<const peer::PeerId> remote_peer_;
     NewStreamHandlerFunc new_stream_handler_;
     muxer::MuxedConnectionConfig config_;
 
     uint32_t last_created_stream_id_;
     std::unordered_map<StreamId, std::shared_ptr<YamuxStream>> streams_;
 
+    std::shared_ptr<libp2p::event::Bus> bus_;
+    bool closed_published_ = false;
+
+    std::shared_ptr<network::ResourceManager> rmgr_;
+    std::shared_ptr<muxer::MuxerMetrics> metrics_;
+
     libp2p::common::Logger log_ = libp2p::common::createLogger("yx-conn");
 
     /// YAMUX STREAM API
@@ -0,0 +1,54 @@
+/**
+ * Copyright Soramitsu Co., Ltd. All Rights Reserved.
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#ifndef LIBP2P_CONNECTION_GATER_HPP
+#define LIBP2P_CONNECTION_GATER_HPP
+
+#include <boost/asio/ip/address.hpp>
+#include <libp2p/connection/capable_connection.hpp>
+#include <libp2p/peer/peer_id.hpp>
+
+namespace libp2p::network {
+
+  /**
+   * Policy, which decides whether to keep a connection at each stage of its
+   * upgrade; a connection is dropped at the first stage, which rejects it, so
+   * that no further work is done for it
+   * @note the hooks are called often and should be cheap
+   */
+  struct ConnectionGater {
+    virtual ~ConnectionGater() = default;
+
+    /**
+     * Called, when an inbound connection is accepted, before any byte is
+     * read from it
+     * @param remote - address of the other side
+     * @return false, if the connection is to be dropped
+     */
+    virtual bool interceptAccept(
+        const boost::asio::ip::address &remote) const = 0;
+
+    /**
+     * Called with the peer of an inbound connection after the security
+     * handshake, and with the peer of an outbound one before the handshake or
+     * even before it is dialed, as the latter is known in advance
+     * @param peer - the other side
+     * @return false, if the connection is to be dropped
+     */
+    virtual bool interceptSecured(const peer::PeerId &peer) const = 0;
+
+    /**
+     * Called, when an inbound connection is muxed, before any stream is
+     * accepted over it
+     * @param conn - the connection
+     * @return false, if the connection is to be closed
+     */
+    virtual bool interceptUpgraded(
+        const connection::CapableConnection &conn) const = 0;
+  };
+
+}  // namespace libp2p::network
+
+#endif  // LIBP2P_CONNECTION_GATER_HPP
@@ -6,6 +6,7 @@
 #ifndef LIBP2P_CONNECTION_MANAGER_HPP
 #define LIBP2P_CONNECTION_MANAGER_HPP
 
+#include <chrono>
 #include <memory>
 
 #include <libp2p/basic/garbage_collectable.hpp>
@@ -20,10 +21,13 @@ namespace libp2p::network {
     struct OnNewConnection {};
     using OnNewConnectionChannel = libp2p::event::channel_decl<
         OnNewConnection, std::weak_ptr<connection::CapableConnection>>;
-  }  // namespace event
 
-  // TODO(warchant): when connection is closed ('onDisconnected' event fired),
-  // manager should remove it from storage PRE-212
+    /// fired when a muxed connection, in or outbound, is terminated by either
+    /// side
+    struct OnConnectionClosed {};
+    using OnConnectionClosedChannel = libp2p::event::channel_decl<
+        OnConnectionClosed, std::weak_ptr<connection::CapableConnection>>;
+  }  // namespace event
 
   /**
    * @brief Connection Manager stores all known connections, and is capable of
@@ -50,10 +54,15 @@ namespace libp2p::network {
     virtual std::vector<ConnectionSPtr> getConnectionsToPeer(
         const peer::PeerId &p) const = 0;
 
-    // get best connection to a given peer
+    // get best connection to a given peer: an open one with the least
+    // streams, then with the lowest RTT, outbound one preferred
     virtual ConnectionSPtr getBestConnectionForPeer(
         const peer::PeerId &p) const = 0;
 
+    // report round trip time, measured over the connection
+    virtual void reportRtt(const ConnectionSPtr &c,
+                           std::chrono::microseconds rtt) = 0;
+
     // get connectedness information for given peer p
     virtual Connectedness connectedness(const peer::PeerInfo &p) const = 0;
 
@@ -0,0 +1,36 @@
+/**
+ * Copyright Soramitsu Co., Ltd. All Rights Reserved.
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#ifndef LIBP2P_CONNECTION_MANAGER_CONFIG_HPP
+#define LIBP2P_CONNECTION_MANAGER_CONFIG_HPP
+
+#include <chrono>
+#include <cstddef>
+
+namespace libp2p::network {
+
+  /**
+   * Watermarks of the connection manager: when there are more connections
+   * than the high watermark, connections of the lowest scored peers are
+   * closed in background, until the low watermark is reached
+   * @note zero high watermark disables trimming
+   */
+  struct ConnectionManagerConfig {
+    /// how many connections may be open before trimming starts
+    size_t high_watermark = 0;
+
+    /// how many connections are left open after trimming
+    size_t low_watermark = 0;
+
+    /// peers, connected for less than that, are not trimmed
+    std::chrono::milliseconds grace_period = std::chrono::seconds(20);
+
+    /// minimum interval between two trims
+    std::chrono::milliseconds silence_period = std::chrono::seconds(10);
+  };
+
+}  // namespace libp2p::network
+
+#endif  // LIBP2P_CONNECTION_MANAGER_CONFIG_HPP
@@ -0,0 +1,24 @@
+/**
+ * Copyright Soramitsu Co., Ltd. All Rights Reserved.
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#ifndef LIBP2P_DIALER_CONFIG_HPP
+#define LIBP2P_DIALER_CONFIG_HPP
+
+namespace libp2p::network {
+
+  /// options of the outbound streams, opened by the dialer
+  struct DialerConfig {
+    /**
+     * select the protocol of a new stream without waiting for the other side
+     * to accept it, so that the proposal goes with the first bytes of the
+     * caller; the stream then reports a rejected protocol on its first read
+     * instead of failing to open
+     */
+    bool optimistic_select = false;
+  };
+
+}  // namespace libp2p::network
+
+#endif  // LIBP2P_DIALER_CONFIG_HPP
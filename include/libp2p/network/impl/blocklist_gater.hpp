@@ -0,0 +1,57 @@
+/**
+ * Copyright Soramitsu Co., Ltd. All Rights Reserved.
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#ifndef LIBP2P_BLOCKLIST_GATER_HPP
+#define LIBP2P_BLOCKLIST_GATER_HPP
+
+#include <unordered_set>
+
+#include <libp2p/network/connection_gater.hpp>
+#include <libp2p/network/impl/cidr_trie.hpp>
+
+namespace libp2p::network {
+
+  /**
+   * Gater, which drops connections from the blocked subnets at once after
+   * they are accepted, and connections of the blocked peers as soon as the
+   * peers are known
+   * @note not thread-safe; is expected to be used from the network's
+   * io_context only
+   */
+  class BlocklistGater : public ConnectionGater {
+   public:
+    /**
+     * Block the subnet
+     * @param address - any address of the subnet
+     * @param prefix_length - number of the leading bits of the subnet
+     * @return false, if the prefix is longer than the address
+     */
+    bool blockSubnet(const boost::asio::ip::address &address,
+                     uint8_t prefix_length);
+
+    /// unblock the subnet, blocked before with the same prefix
+    bool unblockSubnet(const boost::asio::ip::address &address,
+                       uint8_t prefix_length);
+
+    void blockPeer(const peer::PeerId &peer);
+
+    void unblockPeer(const peer::PeerId &peer);
+
+    bool interceptAccept(
+        const boost::asio::ip::address &remote) const override;
+
+    bool interceptSecured(const peer::PeerId &peer) const override;
+
+    bool interceptUpgraded(
+        const connection::CapableConnection &conn) const override;
+
+   private:
+    CidrTrie subnets_;
+    std::unordered_set<peer::PeerId> peers_;
+  };
+
+}  // namespace libp2p::network
+
+#endif  // LIBP2P_BLOCKLIST_GATER_HPP
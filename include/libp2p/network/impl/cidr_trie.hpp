@@ -0,0 +1,88 @@
+/**
+ * Copyright Soramitsu Co., Ltd. All Rights Reserved.
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#ifndef LIBP2P_CIDR_TRIE_HPP
+#define LIBP2P_CIDR_TRIE_HPP
+
+#include <array>
+#include <cstdint>
+#include <vector>
+
+#include <boost/asio/ip/address.hpp>
+
+namespace libp2p::network {
+
+  /**
+   * Set of IP subnets, stored as a binary trie over the address bits; IPv4
+   * addresses are kept as IPv4-mapped IPv6 ones, so that both families share
+   * the trie, and a lookup takes at most 128 steps without any allocation
+   */
+  class CidrTrie {
+   public:
+    CidrTrie();
+
+    /**
+     * Add a subnet
+     * @param address - any address of the subnet
+     * @param prefix_length - number of the leading bits of the subnet
+     * @return false, if the prefix is longer than the address
+     */
+    bool insert(const boost::asio::ip::address &address,
+                uint8_t prefix_length);
+
+    /**
+     * Remove a subnet, added before with the same prefix; the subnets, added
+     * inside or around it, are kept
+     * @return false, if there was no such subnet
+     */
+    bool erase(const boost::asio::ip::address &address, uint8_t prefix_length);
+
+    /// @return true, if the address belongs to any of the subnets
+    bool contains(const boost::asio::ip::address &address) const;
+
+    /// @return true, if there are no subnets
+    bool empty() const;
+
+   private:
+    using Key = std::array<uint8_t, 16>;
+
+    /// the root is never a child, so its index means no child
+    static constexpr uint32_t kNoChild = 0;
+
+    static constexpr uint32_t kNotFound = UINT32_MAX;
+
+    struct Node {
+      /// indices of the nodes for the bits 0 and 1
+      std::array<uint32_t, 2> children{kNoChild, kNoChild};
+
+      /// a subnet ends here
+      bool terminal = false;
+    };
+
+    static Key makeKey(const boost::asio::ip::address &address);
+
+    /**
+     * Convert the prefix length of the address family to the one of the key
+     * @return false, if the prefix is longer than the address
+     */
+    static bool keyPrefix(const boost::asio::ip::address &address,
+                          uint8_t prefix_length, size_t &key_prefix);
+
+    /**
+     * Find the node, where the subnet ends
+     * @return index of the node or kNotFound, if there is no such node
+     */
+    uint32_t find(const Key &key, size_t key_prefix) const;
+
+    static uint8_t bitAt(const Key &key, size_t index);
+
+    /// the first one is the root
+    std::vector<Node> nodes_;
+    size_t subnets_ = 0;
+  };
+
+}  // namespace libp2p::network
+
+#endif  // LIBP2P_CIDR_TRIE_HPP
@@ -6,18 +6,36 @@
 #ifndef LIBP2P_CONNECTION_MANAGER_IMPL_HPP
 #define LIBP2P_CONNECTION_MANAGER_IMPL_HPP
 
+#include <chrono>
+#include <optional>
+
+#include <boost/asio/io_context.hpp>
+#include <boost/asio/steady_timer.hpp>
 #include <libp2p/network/connection_manager.hpp>
+#include <libp2p/network/connection_manager_config.hpp>
+#include <libp2p/network/peer_scorer.hpp>
 #include <libp2p/network/transport_manager.hpp>
 #include <libp2p/peer/peer_id.hpp>
 #include <libp2p/event/bus.hpp>
 
 namespace libp2p::network {
 
-  class ConnectionManagerImpl : public ConnectionManager {
+  class ConnectionManagerImpl
+      : public ConnectionManager,
+        public std::enable_shared_from_this<ConnectionManagerImpl> {
    public:
-    explicit ConnectionManagerImpl(
-        std::shared_ptr<libp2p::event::Bus> bus,
-        std::shared_ptr<network::TransportManager> tmgr);
+    /**
+     * @param bus - bus, to which new connections are published
+     * @param tmgr - transports, by which connectedness is determined
+     * @param context - io context, in which connections are trimmed
+     * @param scorer - policy of trimming
+     * @param config - watermarks of trimming
+     */
+    ConnectionManagerImpl(std::shared_ptr<libp2p::event::Bus> bus,
+                          std::shared_ptr<network::TransportManager> tmgr,
+                          std::shared_ptr<boost::asio::io_context> context,
+                          std::shared_ptr<PeerScorer> scorer,
+                          ConnectionManagerConfig config);
 
     std::vector<ConnectionSPtr> getConnections() const override;
 
@@ -27,20 +45,69 @@ namespace libp2p::network {
     ConnectionSPtr getBestConnectionForPeer(
         const peer::PeerId &p) const override;
 
+    void reportRtt(const ConnectionSPtr &c,
+                   std::chrono::microseconds rtt) override;
+
     Connectedness connectedness(const peer::PeerInfo &p) const override;
 
     void addConnectionToPeer(const peer::PeerId &p, ConnectionSPtr c) override;
 
     void collectGarbage() override;
 
+    bool collectGarbageStep(size_t max_entries) override;
+
     void closeConnectionsToPeer(const peer::PeerId &p) override;
 
    private:
+    using Clock = std::chrono::steady_clock;
+    using PeerConnections =
+        std::unordered_map<peer::PeerId, std::vector<ConnectionSPtr>>;
+
+    size_t connectionsCount() const;
+
+    /// forget the connection, which has been terminated
+    void onConnectionClosed(const ConnectionSPtr &conn);
+
+    /**
+     * Remove closed connections of the peer, and the peer, if it has no
+     * connections left
+     * @return iterator to the next peer
+     */
+    PeerConnections::iterator collectPeerGarbage(
+        PeerConnections::iterator peer);
+
+    /// @return true, if the first connection is preferred to the second one
+    bool isBetter(const Connection &lhs, const Connection &rhs) const;
+
+    /// schedule a trim in background, if none is scheduled yet
+    void scheduleTrim();
+
+    /// close connections of the lowest scored peers down to the low watermark
+    void trim();
+
     std::shared_ptr<network::TransportManager> transport_manager_;
 
-    std::unordered_map<peer::PeerId, std::vector<ConnectionSPtr>> connections_;
+    PeerConnections connections_;
 
     std::shared_ptr<libp2p::event::Bus> bus_;
+
+    std::shared_ptr<boost::asio::io_context> context_;
+    std::shared_ptr<PeerScorer> scorer_;
+    ConnectionManagerConfig config_;
+    boost::asio::steady_timer trim_timer_;
+    bool trim_scheduled_ = false;
+    Clock::time_point last_trim_;
+
+    /// when each peer has been connected, for the grace period
+    std::unordered_map<peer::PeerId, Clock::time_point> connected_since_;
+
+    /// smoothed RTTs of the connections, for which they have been reported
+    std::unordered_map<const Connection *, std::chrono::microseconds> rtts_;
+
+    /// peer, from which the next garbage collection step starts
+    std::optional<peer::PeerId> gc_cursor_;
+
+    libp2p::event::Handle closed_sub_;
   };
 
 }  // namespace libp2p::network
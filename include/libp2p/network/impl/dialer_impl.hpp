@@ -6,8 +6,13 @@
 #ifndef LIBP2P_DIALER_IMPL_HPP
 #define LIBP2P_DIALER_IMPL_HPP
 
+#include <unordered_map>
+
+#include <libp2p/metrics/registry.hpp>
 #include <libp2p/network/connection_manager.hpp>
+#include <libp2p/network/dialer_config.hpp>
 #include <libp2p/network/dialer.hpp>
+#include <libp2p/network/resource_manager.hpp>
 #include <libp2p/network/transport_manager.hpp>
 #include <libp2p/protocol_muxer/protocol_muxer.hpp>
 
@@ -17,9 +22,22 @@ namespace libp2p::network {
    public:
     ~DialerImpl() override = default;
 
+    /**
+     * @param multiselect - protocol muxer of the outbound streams
+     * @param tmgr - transports to dial the peers with
+     * @param cmgr - connections to be reused and where the new ones are kept
+     * @param rmgr - resource manager, which accounts the connections and the
+     * streams
+     * @param config - how the protocols of the new streams are selected
+     * @param registry, where the metrics of the dials and of the streams are
+     * kept; may be null
+     */
     DialerImpl(std::shared_ptr<protocol_muxer::ProtocolMuxer> multiselect,
                std::shared_ptr<TransportManager> tmgr,
-               std::shared_ptr<ConnectionManager> cmgr);
+               std::shared_ptr<ConnectionManager> cmgr,
+               std::shared_ptr<ResourceManager> rmgr,
+               DialerConfig config = {},
+               std::shared_ptr<metrics::Registry> registry = nullptr);
 
     // Establishes a connection to a given peer
     void dial(const peer::PeerInfo &p, DialResultFunc cb) override;
@@ -30,9 +48,24 @@ namespace libp2p::network {
                    StreamResultFunc cb) override;
 
    private:
+    /// count a stream, opened for the protocol
+    void countStream(const peer::Protocol &protocol);
+
     std::shared_ptr<protocol_muxer::ProtocolMuxer> multiselect_;
     std::shared_ptr<TransportManager> tmgr_;
     std::shared_ptr<ConnectionManager> cmgr_;
+    std::shared_ptr<ResourceManager> rmgr_;
+    DialerConfig config_;
+
+    /// the metrics are null, if there is no registry
+    std::shared_ptr<metrics::Registry> registry_;
+    std::shared_ptr<metrics::Counter> dials_;
+    std::shared_ptr<metrics::Counter> dial_failures_;
+    std::shared_ptr<metrics::Histogram> dial_duration_;
+    /// counters of the streams by their protocols, so that the registry is
+    /// not locked for each stream
+    std::unordered_map<peer::Protocol, std::shared_ptr<metrics::Counter>>
+        protocol_streams_;
 
     common::Logger log_ = common::createLogger("debug"); // XXX
   };
@@ -7,8 +7,10 @@
 #define LIBP2P_LISTENER_MANAGER_IMPL_HPP
 
 #include <libp2p/connection/capable_connection.hpp>
+#include <libp2p/network/connection_gater.hpp>
 #include <libp2p/network/connection_manager.hpp>
 #include <libp2p/network/listener_manager.hpp>
+#include <libp2p/network/resource_manager.hpp>
 #include <libp2p/network/transport_manager.hpp>
 #include <libp2p/peer/address_repository.hpp>
 #include <libp2p/protocol_muxer/protocol_muxer.hpp>
@@ -22,7 +24,9 @@ namespace libp2p::network {
     ListenerManagerImpl(
         std::shared_ptr<protocol_muxer::ProtocolMuxer> multiselect,
         std::shared_ptr<Router> router, std::shared_ptr<TransportManager> tmgr,
-        std::shared_ptr<ConnectionManager> cmgr);
+        std::shared_ptr<ConnectionManager> cmgr,
+        std::shared_ptr<ResourceManager> rmgr,
+        std::shared_ptr<ConnectionGater> gater = nullptr);
 
     bool isStarted() const override;
 
@@ -61,6 +65,8 @@ namespace libp2p::network {
     std::shared_ptr<network::Router> router_;
     std::shared_ptr<TransportManager> tmgr_;
     std::shared_ptr<ConnectionManager> cmgr_;
+    std::shared_ptr<ResourceManager> rmgr_;
+    std::shared_ptr<ConnectionGater> gater_;
 
     void onConnection(
         outcome::result<std::shared_ptr<connection::CapableConnection>> rconn);
@@ -0,0 +1,58 @@
+/**
+ * Copyright Soramitsu Co., Ltd. All Rights Reserved.
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#ifndef LIBP2P_PEER_SCORER_IMPL_HPP
+#define LIBP2P_PEER_SCORER_IMPL_HPP
+
+#include <unordered_map>
+#include <unordered_set>
+
+#include <libp2p/event/bus.hpp>
+#include <libp2p/network/peer_scorer.hpp>
+
+namespace libp2p::network {
+
+  /**
+   * Scores a peer by the sum of its tags, its open streams and its membership
+   * in the routing table, which is tracked by the routing events on the bus
+   */
+  class PeerScorerImpl : public PeerScorer {
+   public:
+    /// score of each open stream to the peer
+    static constexpr int64_t kStreamValue = 2;
+
+    /// score of a peer in the routing table
+    static constexpr int64_t kRoutingTableValue = 5;
+
+    explicit PeerScorerImpl(std::shared_ptr<libp2p::event::Bus> bus);
+
+    void tagPeer(const peer::PeerId &peer, const std::string &tag,
+                 int64_t value) override;
+
+    void untagPeer(const peer::PeerId &peer, const std::string &tag) override;
+
+    void protect(const peer::PeerId &peer, const std::string &tag) override;
+
+    bool unprotect(const peer::PeerId &peer, const std::string &tag) override;
+
+    bool isProtected(const peer::PeerId &peer) const override;
+
+    int64_t score(const peer::PeerId &peer,
+                  gsl::span<const ConnectionSPtr> connections) const override;
+
+   private:
+    std::shared_ptr<libp2p::event::Bus> bus_;
+    std::unordered_map<peer::PeerId, std::unordered_map<std::string, int64_t>>
+        tags_;
+    std::unordered_map<peer::PeerId, std::unordered_set<std::string>>
+        protections_;
+    std::unordered_set<peer::PeerId> routing_table_peers_;
+    libp2p::event::Handle peer_added_sub_;
+    libp2p::event::Handle peer_removed_sub_;
+  };
+
+}  // namespace libp2p::network
+
+#endif  // LIBP2P_PEER_SCORER_IMPL_HPP
@@ -0,0 +1,111 @@
+/**
+ * Copyright Soramitsu Co., Ltd. All Rights Reserved.
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#ifndef LIBP2P_RESOURCE_MANAGER_IMPL_HPP
+#define LIBP2P_RESOURCE_MANAGER_IMPL_HPP
+
+#include <map>
+#include <unordered_map>
+#include <vector>
+
+#include <libp2p/event/bus.hpp>
+#include <libp2p/network/resource_manager.hpp>
+#include <libp2p/network/resource_manager_config.hpp>
+
+namespace libp2p::network {
+
+  /**
+   * Keeps counters of the global scope and of each peer; connections and
+   * streams of a protocol are kept as weak pointers, from which the released
+   * ones are dropped lazily, when a limit is reached or the list doubles in
+   * size
+   */
+  class ResourceManagerImpl : public ResourceManager {
+   public:
+    enum class Error {
+      CONNECTION_LIMIT_EXCEEDED = 1,
+      STREAM_LIMIT_EXCEEDED,
+      MEMORY_LIMIT_EXCEEDED
+    };
+
+    /**
+     * @param bus, to which connections publish their termination
+     * @param config - limits of the scopes
+     */
+    ResourceManagerImpl(std::shared_ptr<libp2p::event::Bus> bus,
+                        ResourceManagerConfig config);
+
+    outcome::result<void> checkConnection(
+        const peer::PeerId &peer) const override;
+
+    outcome::result<void> reserveConnection(
+        const std::shared_ptr<connection::CapableConnection> &conn) override;
+
+    void releaseConnection(
+        const std::weak_ptr<connection::CapableConnection> &conn) override;
+
+    outcome::result<void> reserveStream(const peer::PeerId &peer,
+                                        size_t memory) override;
+
+    void releaseStream(const peer::PeerId &peer, size_t memory) override;
+
+    outcome::result<void> reserveProtocolStream(
+        const peer::Protocol &protocol,
+        const std::shared_ptr<connection::Stream> &stream) override;
+
+    ResourceUsage globalUsage() const override;
+
+    ResourceUsage peerUsage(const peer::PeerId &peer) const override;
+
+    ResourceUsage protocolUsage(const peer::Protocol &protocol) const override;
+
+   private:
+    /// streams of a protocol, some of which may be closed already
+    struct ProtocolStreams {
+      std::vector<std::weak_ptr<connection::Stream>> streams;
+      size_t purge_at = kMinPurgeSize;
+    };
+
+    /// accounted connections with their peers; the weak pointers tell a new
+    /// connection from a destroyed one, which had the same address
+    using Connections =
+        std::map<std::weak_ptr<connection::CapableConnection>, peer::PeerId,
+                 std::owner_less<std::weak_ptr<connection::CapableConnection>>>;
+
+    /// size of a protocol or connection list, below which it is not purged without need
+    static constexpr size_t kMinPurgeSize = 16;
+
+    /// @return limit of open streams of the protocol
+    size_t protocolStreamsLimit(const peer::Protocol &protocol) const;
+
+    /// drop the closed streams from the list
+    static void purge(ProtocolStreams &entry);
+
+    /// release the connection @return iterator to the next one
+    Connections::iterator releaseConnection(Connections::iterator it);
+
+    /// release the connections, which were destroyed without being released
+    void purgeConnections();
+
+    /// forget the peer, if it uses nothing
+    void erasePeerIfUnused(
+        std::unordered_map<peer::PeerId, ResourceUsage>::iterator it);
+
+    ResourceManagerConfig config_;
+
+    ResourceUsage global_;
+    std::unordered_map<peer::PeerId, ResourceUsage> peers_;
+    Connections connections_;
+    size_t connections_purge_at_ = kMinPurgeSize;
+    std::unordered_map<peer::Protocol, ProtocolStreams> protocols_;
+
+    libp2p::event::Handle closed_sub_;
+  };
+
+}  // namespace libp2p::network
+
+OUTCOME_HPP_DECLARE_ERROR(libp2p::network, ResourceManagerImpl::Error)
+
+#endif  // LIBP2P_RESOURCE_MANAGER_IMPL_HPP
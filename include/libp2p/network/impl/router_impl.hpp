@@ -6,13 +6,25 @@
 #ifndef LIBP2P_ROUTER_IMPL_HPP
 #define LIBP2P_ROUTER_IMPL_HPP
 
+#include <string_view>
+#include <unordered_set>
+
 #include <tsl/htrie_map.h>
+#include <libp2p/network/resource_manager.hpp>
 #include <libp2p/network/router.hpp>
 
 namespace libp2p::network {
 
   class RouterImpl : public Router {
    public:
+    RouterImpl() = default;
+
+    /**
+     * @param rmgr - resource manager, which accounts the streams of the
+     * protocols, before they are handled
+     */
+    explicit RouterImpl(std::shared_ptr<ResourceManager> rmgr);
+
     ~RouterImpl() override = default;
 
     void setProtocolHandler(const peer::Protocol &protocol,
@@ -24,6 +36,11 @@ namespace libp2p::network {
 
     std::vector<peer::Protocol> getSupportedProtocols() const override;
 
+    std::shared_ptr<const ProtocolsSnapshot> getProtocolsSnapshot()
+        const override;
+
+    bool canHandle(const peer::Protocol &p) const override;
+
     void removeProtocolHandlers(const peer::Protocol &protocol) override;
 
     void removeAll() override;
@@ -39,7 +56,24 @@ namespace libp2p::network {
       ProtoPredicate predicate;
       ProtoHandler handler;
     };
+
+    /// find the handler, which handle(p, ...) is going to call
+    const ProtoHandler *findHandler(const peer::Protocol &p) const;
+
+    /// rebuild the snapshot and the index after the handlers are changed
+    void onHandlersChanged();
+
     tsl::htrie_map<char, PredicateAndHandler> proto_handlers_;
+
+    /// handled protocols, shared with the negotiations in progress
+    std::shared_ptr<const ProtocolsSnapshot> snapshot_ =
+        std::make_shared<const ProtocolsSnapshot>();
+
+    /// protocols of the snapshot for the exact match in O(1)
+    std::unordered_set<std::string_view> exact_protocols_;
+
+    /// may be null, if nothing is limited
+    std::shared_ptr<ResourceManager> rmgr_;
   };
 
 }  // namespace libp2p::network
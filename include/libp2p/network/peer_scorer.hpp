@@ -0,0 +1,72 @@
+/**
+ * Copyright Soramitsu Co., Ltd. All Rights Reserved.
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#ifndef LIBP2P_PEER_SCORER_HPP
+#define LIBP2P_PEER_SCORER_HPP
+
+#include <memory>
+#include <string>
+
+#include <gsl/span>
+#include <libp2p/connection/capable_connection.hpp>
+#include <libp2p/peer/peer_id.hpp>
+
+namespace libp2p::network {
+
+  /**
+   * Policy, by which the connection manager selects peers to be disconnected,
+   * when there are too many connections: protected peers are never
+   * disconnected, the other ones are disconnected in order of their scores,
+   * the lowest first
+   */
+  struct PeerScorer {
+    using ConnectionSPtr = std::shared_ptr<connection::CapableConnection>;
+
+    virtual ~PeerScorer() = default;
+
+    /**
+     * Set a value of the peer, which adds to its score
+     * @param peer - peer to be tagged
+     * @param tag - name of the value, so that it can be changed or removed
+     * @param value - the value; the previous one of the tag is replaced
+     */
+    virtual void tagPeer(const peer::PeerId &peer, const std::string &tag,
+                         int64_t value) = 0;
+
+    /// remove the value of the peer, set with the tag
+    virtual void untagPeer(const peer::PeerId &peer,
+                           const std::string &tag) = 0;
+
+    /**
+     * Keep connections to the peer, until all its protections are removed
+     * @param peer - peer to be protected
+     * @param tag - name of the protection, so that several components may
+     * protect the same peer independently
+     */
+    virtual void protect(const peer::PeerId &peer, const std::string &tag) = 0;
+
+    /**
+     * Remove protection of the peer, set with the tag
+     * @return true, if the peer is still protected with other tags
+     */
+    virtual bool unprotect(const peer::PeerId &peer,
+                           const std::string &tag) = 0;
+
+    /// @return true, if connections to the peer must not be trimmed
+    virtual bool isProtected(const peer::PeerId &peer) const = 0;
+
+    /**
+     * @param peer - peer to be scored
+     * @param connections - its open connections
+     * @return score of the peer; the higher, the longer its connections live
+     */
+    virtual int64_t score(
+        const peer::PeerId &peer,
+        gsl::span<const ConnectionSPtr> connections) const = 0;
+  };
+
+}  // namespace libp2p::network
+
+#endif  // LIBP2P_PEER_SCORER_HPP
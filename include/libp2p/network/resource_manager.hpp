@@ -0,0 +1,99 @@
+/**
+ * Copyright Soramitsu Co., Ltd. All Rights Reserved.
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#ifndef LIBP2P_RESOURCE_MANAGER_HPP
+#define LIBP2P_RESOURCE_MANAGER_HPP
+
+#include <memory>
+
+#include <libp2p/connection/capable_connection.hpp>
+#include <libp2p/connection/stream.hpp>
+#include <libp2p/outcome/outcome.hpp>
+#include <libp2p/peer/peer_id.hpp>
+#include <libp2p/peer/protocol.hpp>
+
+namespace libp2p::network {
+
+  /// resources, used in some scope
+  struct ResourceUsage {
+    size_t connections = 0;
+    size_t streams = 0;
+
+    /// bytes, which the streams may buffer
+    size_t memory = 0;
+  };
+
+  /**
+   * Accountant of connections, streams and their buffers, which are limited
+   * in the global scope, in the scope of each peer and in the scope of each
+   * protocol; the work, which does not fit the limits, is to be rejected
+   * before it is done
+   * @note a stream is accounted twice: for its peer, when it is registered in
+   * a muxed connection, and for its protocol, when the latter is negotiated
+   */
+  struct ResourceManager {
+    virtual ~ResourceManager() = default;
+
+    /**
+     * Check, if one more connection to the peer fits the limits, so that it
+     * may be dialed
+     * @param peer - peer to be dialed
+     */
+    virtual outcome::result<void> checkConnection(
+        const peer::PeerId &peer) const = 0;
+
+    /**
+     * Account an established connection; it is released, when it publishes
+     * its termination, with releaseConnection(), or at the latest, when a
+     * limit is reached after it has been destroyed
+     * @param conn - the connection, which should be closed, if an error is
+     * returned
+     */
+    virtual outcome::result<void> reserveConnection(
+        const std::shared_ptr<connection::CapableConnection> &conn) = 0;
+
+    /**
+     * Release a connection, accounted before; does nothing for other ones
+     * @param conn - the connection, which may be expired already, as it is
+     * when released from its destructor
+     */
+    virtual void releaseConnection(
+        const std::weak_ptr<connection::CapableConnection> &conn) = 0;
+
+    /**
+     * Account a stream of the peer before it is registered in a muxed
+     * connection
+     * @param peer - remote peer of the stream
+     * @param memory - how many bytes the stream may buffer
+     */
+    virtual outcome::result<void> reserveStream(const peer::PeerId &peer,
+                                                size_t memory) = 0;
+
+    /// release a stream with the same values, as it was reserved with
+    virtual void releaseStream(const peer::PeerId &peer, size_t memory) = 0;
+
+    /**
+     * Account a stream for the protocol, negotiated over it; it is released,
+     * when the stream is closed or destroyed
+     * @param protocol of the stream
+     * @param stream - the stream, which should be reset, if an error is
+     * returned
+     */
+    virtual outcome::result<void> reserveProtocolStream(
+        const peer::Protocol &protocol,
+        const std::shared_ptr<connection::Stream> &stream) = 0;
+
+    virtual ResourceUsage globalUsage() const = 0;
+
+    virtual ResourceUsage peerUsage(const peer::PeerId &peer) const = 0;
+
+    /// @return usage of the protocol, in which only streams are accounted
+    virtual ResourceUsage protocolUsage(
+        const peer::Protocol &protocol) const = 0;
+  };
+
+}  // namespace libp2p::network
+
+#endif  // LIBP2P_RESOURCE_MANAGER_HPP
@@ -0,0 +1,46 @@
+/**
+ * Copyright Soramitsu Co., Ltd. All Rights Reserved.
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#ifndef LIBP2P_RESOURCE_MANAGER_CONFIG_HPP
+#define LIBP2P_RESOURCE_MANAGER_CONFIG_HPP
+
+#include <cstddef>
+#include <unordered_map>
+
+#include <libp2p/peer/protocol.hpp>
+
+namespace libp2p::network {
+
+  /// limits of resources in some scope; zero means no limit
+  struct ResourceLimits {
+    size_t connections = 0;
+    size_t streams = 0;
+
+    /// bytes, which the streams may buffer
+    size_t memory = 0;
+  };
+
+  /**
+   * Limits of the resource manager; a reservation must fit the limits of all
+   * scopes it is made in
+   * @note by default nothing is limited
+   */
+  struct ResourceManagerConfig {
+    /// limits of all the resources together
+    ResourceLimits global;
+
+    /// limits of each peer
+    ResourceLimits peer;
+
+    /// open streams of each protocol
+    size_t protocol_streams = 0;
+
+    /// open streams of the listed protocols instead of the value above
+    std::unordered_map<peer::Protocol, size_t> protocol_streams_overrides;
+  };
+
+}  // namespace libp2p::network
+
+#endif  // LIBP2P_RESOURCE_MANAGER_CONFIG_HPP
@@ -38,6 +38,13 @@ namespace libp2p::network {
     using ProtoHandler = std::function<connection::Stream::Handler>;
     using ProtoPredicate = std::function<bool(const peer::Protocol &)>;
 
+    /// immutable list of the handled protocols
+    struct ProtocolsSnapshot {
+      /// increased each time the handlers change
+      uint64_t version;
+      std::vector<peer::Protocol> protocols;
+    };
+
     virtual ~Router() = default;
 
     /**
@@ -71,6 +78,21 @@ namespace libp2p::network {
      */
     virtual std::vector<peer::Protocol> getSupportedProtocols() const = 0;
 
+    /**
+     * Get the handled protocols without copying them
+     * @return snapshot, which is rebuilt only when the handlers change
+     */
+    virtual std::shared_ptr<const ProtocolsSnapshot> getProtocolsSnapshot()
+        const = 0;
+
+    /**
+     * Check, if there is a handler for the protocol, including the predicate
+     * ones
+     * @param p - protocol to be checked
+     * @return true, if handle(p, ...) is going to find a handler
+     */
+    virtual bool canHandle(const peer::Protocol &p) const = 0;
+
     /**
      * Remove handlers, associated with the given protocol prefix
      * @param protocol prefix, for which the handlers are to be removed
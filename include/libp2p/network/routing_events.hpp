@@ -0,0 +1,27 @@
+/**
+ * Copyright Soramitsu Co., Ltd. All Rights Reserved.
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#ifndef LIBP2P_NETWORK_ROUTING_EVENTS_HPP
+#define LIBP2P_NETWORK_ROUTING_EVENTS_HPP
+
+#include <libp2p/event/bus.hpp>
+#include <libp2p/peer/peer_id.hpp>
+
+namespace libp2p::network::event {
+
+  /// fired when a peer enters the routing table of a routing protocol, such
+  /// as Kademlia
+  struct RoutingPeerAdded {};
+  using RoutingPeerAddedChannel =
+      libp2p::event::channel_decl<RoutingPeerAdded, peer::PeerId>;
+
+  /// fired when a peer leaves the routing table
+  struct RoutingPeerRemoved {};
+  using RoutingPeerRemovedChannel =
+      libp2p::event::channel_decl<RoutingPeerRemoved, peer::PeerId>;
+
+}  // namespace libp2p::network::event
+
+#endif  // LIBP2P_NETWORK_ROUTING_EVENTS_HPP
@@ -6,6 +6,7 @@
 #ifndef LIBP2P_INMEM_ADDRESS_REPOSITORY_HPP
 #define LIBP2P_INMEM_ADDRESS_REPOSITORY_HPP
 
+#include <optional>
 #include <unordered_map>
 #include <vector>
 
@@ -40,6 +41,8 @@ namespace libp2p::peer {
 
     void collectGarbage() override;
 
+    bool collectGarbageStep(size_t max_entries) override;
+
     void clear(const PeerId &p) override;
 
     std::unordered_set<PeerId> getPeers() const override;
@@ -47,8 +50,20 @@ namespace libp2p::peer {
    private:
     using ttlmap = std::unordered_map<multi::Multiaddress, Clock::time_point>;
     using ttlmap_ptr = std::shared_ptr<ttlmap>;
+    using db_t = std::unordered_map<PeerId, ttlmap_ptr>;
+
+    /**
+     * Remove expired addresses of the peer, and the peer, if it has no
+     * addresses left
+     * @return iterator to the next peer
+     */
+    db_t::iterator collectPeerGarbage(db_t::iterator peer,
+                                      Clock::time_point now);
+
+    db_t db_;
 
-    std::unordered_map<PeerId, ttlmap_ptr> db_;
+    /// peer, from which the next garbage collection step starts
+    std::optional<PeerId> gc_cursor_;
   };
 
 }  // namespace libp2p::peer
@@ -6,6 +6,7 @@
 #ifndef LIBP2P_INMEM_PROTOCOL_REPOSITORY_HPP
 #define LIBP2P_INMEM_PROTOCOL_REPOSITORY_HPP
 
+#include <optional>
 #include <set>
 #include <unordered_map>
 
@@ -37,6 +38,8 @@ namespace libp2p::peer {
 
     void collectGarbage() override;
 
+    bool collectGarbageStep(size_t max_entries) override;
+
     std::unordered_set<PeerId> getPeers() const override;
 
    private:
@@ -47,6 +50,9 @@ namespace libp2p::peer {
     set_ptr getOrAllocateProtocolSet(const PeerId &p);
 
     std::unordered_map<PeerId, set_ptr> db_;
+
+    /// peer, from which the next garbage collection step starts
+    std::optional<PeerId> gc_cursor_;
   };
 
 }  // namespace libp2p::peer
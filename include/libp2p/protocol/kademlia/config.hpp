@@ -47,6 +47,11 @@ namespace libp2p::protocol::kademlia {
 
     std::chrono::seconds read_message_timeout = 10s;
 
+    /// How long a server session waits for the next request, before its
+    /// stream is closed; clients keep idle streams in a pool for 30s, so that
+    /// they drop the streams first
+    std::chrono::seconds server_idle_timeout = 1min;
+
     /// The number of records that will be retrieved on a call to getMany()
     size_t get_many_records_count = 16;
 
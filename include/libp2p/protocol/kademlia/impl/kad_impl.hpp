@@ -6,7 +6,10 @@
 #ifndef LIBP2P_KAD_IMPL_HPP
 #define LIBP2P_KAD_IMPL_HPP
 
+#include <set>
+
 #include <libp2p/host/host.hpp>
+#include <libp2p/metrics/registry.hpp>
 #include <libp2p/protocol/kademlia/impl/content_providers_store.hpp>
 #include <libp2p/protocol/kademlia/impl/helpers.hpp>
 #include <libp2p/protocol/kademlia/impl/kad_protocol_session.hpp>
@@ -27,7 +30,8 @@ namespace libp2p::protocol::kademlia {
    public:
     KadImpl(std::shared_ptr<Host> host, std::shared_ptr<Scheduler> scheduler,
             std::shared_ptr<RoutingTable> table,
-            std::unique_ptr<ValueStoreBackend> storage, KademliaConfig config);
+            std::unique_ptr<ValueStoreBackend> storage, KademliaConfig config,
+            std::shared_ptr<metrics::Registry> registry = nullptr);
 
     ~KadImpl() override;
 
@@ -78,6 +82,12 @@ namespace libp2p::protocol::kademlia {
 
       // nullptr for server sessions
       KadResponseHandler::Ptr response_handler;
+
+      // the request is sent again over a new stream, if the stream has been
+      // taken from the pool and fails before the response
+      peer::PeerInfo peer;
+      KadProtocolSession::Buffer request;
+      bool pooled = false;
     };
 
     Session *findSession(connection::Stream *from);
@@ -89,15 +99,38 @@ namespace libp2p::protocol::kademlia {
 
     void closeSession(connection::Stream *s);
 
+    /// return the stream of the session to the host's pool
+    void releaseSession(connection::Stream *s);
+
+    /// close the session, whose pooled stream has failed, and send its
+    /// request over a new stream
+    void retrySession(connection::Stream *s);
+
+    /**
+     * Send the request to the peer
+     * @param fresh - open a new stream instead of taking one from the pool
+     */
     void connect(const peer::PeerInfo &pi,
                  const std::shared_ptr<KadResponseHandler> &handler,
-                 const KadProtocolSession::Buffer &request);
+                 const KadProtocolSession::Buffer &request,
+                 bool fresh = false);
 
     void onConnected(
-        uint64_t id, const peer::PeerId &peerId,
+        uint64_t id, const peer::PeerInfo &pi,
         outcome::result<std::shared_ptr<connection::Stream>> stream_res,
         KadProtocolSession::Buffer request);
 
+    /// metrics of the queries of one kind, which are sent to the network
+    struct QueryMetrics {
+      QueryMetrics(metrics::Registry &registry, const std::string &query);
+
+      /// record the result of a query, which was started at the moment
+      void record(bool success, metrics::Histogram::Clock::time_point start);
+
+      std::shared_ptr<metrics::Histogram> duration;
+      std::shared_ptr<metrics::Counter> failures;
+    };
+
     KademliaConfig config_;
     const peer::Protocol protocol_;
     std::shared_ptr<Host> host_;
@@ -116,8 +149,21 @@ namespace libp2p::protocol::kademlia {
     ConnectingSessions connecting_sessions_;
     uint64_t connecting_sessions_counter_ = 0;
 
+    /// streams, which have been returned to the pool, so that a stream from
+    /// the pool is told from a new one; destroyed ones are dropped lazily
+    using ReleasedStreams =
+        std::set<std::weak_ptr<connection::Stream>,
+                 std::owner_less<std::weak_ptr<connection::Stream>>>;
+    static constexpr size_t kMinPurgeSize = 16;
+    ReleasedStreams released_streams_;
+    size_t released_streams_purge_at_ = kMinPurgeSize;
+
     event::Handle new_channel_subscription_;
     SubLogger log_;
+
+    /// both are null, if there is no registry
+    std::shared_ptr<QueryMetrics> find_peer_queries_;
+    std::shared_ptr<QueryMetrics> get_value_queries_;
   };
 
 }  // namespace libp2p::protocol::kademlia
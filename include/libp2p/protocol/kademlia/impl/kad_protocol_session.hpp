@@ -42,6 +42,10 @@ namespace libp2p::protocol::kademlia {
 
     void close();
 
+    /// stop the session without closing its stream, so that the stream can
+    /// be reused; nothing must be pending on the stream
+    std::shared_ptr<connection::Stream> detach();
+
    private:
     void onLengthRead(boost::optional<multi::UVarint> varint_opt);
 
@@ -53,13 +53,23 @@ namespace libp2p::protocol::kademlia {
 
     void closeSession(connection::Stream *s);
 
+    /// what is done with the stream after a request is handled
+    enum class Reply {
+      /// the response is in the message and is written back
+      RESPOND,
+      /// the request needs no response; the next request is read
+      NONE,
+      /// the request is malformed; the stream is closed
+      REJECT
+    };
+
     // request handlers
-    bool onPutValue(Message &msg);
-    bool onGetValue(Message &msg);
-    bool onAddProvider(Message &msg);
-    bool onGetProviders(Message &msg);
-    bool onFindNode(Message &msg);
-    bool onPing(Message &msg);
+    Reply onPutValue(Message &msg);
+    Reply onGetValue(Message &msg);
+    Reply onAddProvider(Message &msg);
+    Reply onGetProviders(Message &msg);
+    Reply onFindNode(Message &msg);
+    Reply onPing(Message &msg);
 
     Host &host_;
     KadImpl& kad_;
@@ -70,7 +80,7 @@ namespace libp2p::protocol::kademlia {
 
     SubLogger log_;
 
-    using RequestHandler = bool (KadServer::*)(Message &);
+    using RequestHandler = Reply (KadServer::*)(Message &);
     static std::array<RequestHandler, Message::kTableSize> request_handlers_table;
   };
 
@@ -7,6 +7,7 @@
 #define LIBP2P_KAD_ROUTING_TABLE_HPP
 
 #include <libp2p/event/bus.hpp>
+#include <libp2p/network/routing_events.hpp>
 #include <libp2p/protocol/kademlia/common.hpp>
 #include <libp2p/protocol/kademlia/config.hpp>
 #include <libp2p/protocol/kademlia/node_id.hpp>
@@ -14,11 +15,11 @@
 namespace libp2p::protocol::kademlia {
 
   namespace events {
-    using PeerAddedChannel =
-        event::channel_decl<struct PeerAdded, peer::PeerId>;
+    // declared by the network, so that its components follow the table
+    // without depending on Kademlia
+    using PeerAddedChannel = network::event::RoutingPeerAddedChannel;
 
-    using PeerRemovedChannel =
-        event::channel_decl<struct PeerRemoved, peer::PeerId>;
+    using PeerRemovedChannel = network::event::RoutingPeerRemovedChannel;
 
   }  // namespace events
 
@@ -13,6 +13,7 @@
 #include <libp2p/event/bus.hpp>
 #include <libp2p/host/host.hpp>
 #include <libp2p/protocol/base_protocol.hpp>
+#include <libp2p/protocol/ping/ping_client_session.hpp>
 #include <libp2p/protocol/ping/ping_config.hpp>
 #include <libp2p/outcome/outcome.hpp>
 
@@ -21,7 +22,6 @@ namespace libp2p::crypto::random {
 }
 
 namespace libp2p::protocol {
-  class PingClientSession;
 
   /**
    * Ping protocol, which is used to understand, if the peers are alive; will
@@ -38,7 +38,8 @@ namespace libp2p::protocol {
      * @param rand_gen - generator, which is used to generate Ping bytes
      * @param config, with which the instance is to be created
      */
-    Ping(Host &host, event::Bus &bus, boost::asio::io_context &io_context,
+    Ping(Host &host, libp2p::event::Bus &bus,
+         boost::asio::io_context &io_context,
          std::shared_ptr<crypto::random::RandomGenerator> rand_gen,
          PingConfig config = PingConfig{});
 
@@ -47,7 +48,8 @@ namespace libp2p::protocol {
     void handle(StreamResult res) override;
 
     /**
-     * Start pinging the peer
+     * Start pinging the peer; round trip times of the pings are reported to
+     * the connection manager, if the stream is opened over the connection
      * @param conn to the peer we want to ping
      * @param cb to be called, when a ping session is started, or error happens
      */
@@ -57,8 +59,14 @@ namespace libp2p::protocol {
             cb);
 
    private:
+    /// @return handler, which reports RTTs of the connection, if the stream
+    /// is carried by it, or an empty one
+    PingClientSession::RttHandler rttHandler(
+        const std::shared_ptr<connection::CapableConnection> &conn,
+        const connection::Stream &stream);
+
     Host &host_;
-    event::Bus &bus_;
+    libp2p::event::Bus &bus_;
     boost::asio::io_context &io_context_;
     std::shared_ptr<crypto::random::RandomGenerator> rand_gen_;
     PingConfig config_;
@@ -6,6 +6,8 @@
 #ifndef LIBP2P_PING_CLIENT_SESSION_HPP
 #define LIBP2P_PING_CLIENT_SESSION_HPP
 
+#include <chrono>
+#include <functional>
 #include <memory>
 #include <vector>
 
@@ -31,11 +33,14 @@ namespace libp2p::protocol {
   class PingClientSession
       : public std::enable_shared_from_this<PingClientSession> {
    public:
+    /// called with the round trip time of each Ping, which is echoed back
+    using RttHandler = std::function<void(std::chrono::microseconds)>;
+
     PingClientSession(boost::asio::io_service &io_service,
                       libp2p::event::Bus &bus,
                       std::shared_ptr<connection::Stream> stream,
                       std::shared_ptr<crypto::random::RandomGenerator> rand_gen,
-                      PingConfig config);
+                      PingConfig config, RttHandler rtt_handler = {});
 
     void start();
 
@@ -57,10 +62,14 @@ namespace libp2p::protocol {
     std::shared_ptr<connection::Stream> stream_;
     std::shared_ptr<crypto::random::RandomGenerator> rand_gen_;
     PingConfig config_;
+    RttHandler rtt_handler_;
 
     std::vector<uint8_t> write_buffer_, read_buffer_;
     boost::asio::deadline_timer timer_;
 
+    /// when the last Ping was sent and when its echo was read
+    std::chrono::steady_clock::time_point write_started_, read_completed_;
+
     bool last_op_completed_ = false;
     std::error_code last_error_;
 
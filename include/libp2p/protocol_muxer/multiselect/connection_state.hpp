@@ -37,11 +37,15 @@ namespace libp2p::protocol_muxer {
     std::shared_ptr<basic::ReadWriter> connection;
 
     /// protocols to be selected
-    std::shared_ptr<std::vector<peer::Protocol>> protocols;
+    ProtocolMuxer::Protocols protocols;
 
-    /// protocols, which were left for negotiation (if send one of the protocols
-    /// and receive NA, it's removed from this queue)
-    std::shared_ptr<std::vector<peer::Protocol>> left_protocols;
+    /// tells, if a protocol, proposed by the other side, is supported; if
+    /// empty, the protocol is searched in the list
+    ProtocolMuxer::ProtocolMatcher matcher;
+
+    /// index of the protocol, which is proposed next (if send one of the
+    /// protocols and receive NA, the next one is proposed)
+    size_t next_protocol = 0;
 
     /// callback, which is to be called, when a protocol is established over the
     /// connection
@@ -85,21 +89,18 @@ namespace libp2p::protocol_muxer {
         return handler(outcome::success());
       }
 
+      // read straight into the free space of the buffer, so that nothing is
+      // allocated or copied per read
       auto to_read = n - read_buffer->size();
-      auto buf = std::make_shared<common::ByteArray>(to_read, 0);
+      auto free_space = read_buffer->prepare(to_read);
       return connection->read(
-          *buf, to_read,
-          [self{shared_from_this()}, buf, h = std::move(handler),
+          gsl::make_span(static_cast<uint8_t *>(free_space.data()), to_read),
+          to_read,
+          [self{shared_from_this()}, h = std::move(handler),
            to_read](auto &&res) {
             if (!res) {
               return h(res.error());
             }
-            if (boost::asio::buffer_copy(
-                    self->read_buffer->prepare(to_read),
-                    boost::asio::const_buffer(buf->data(), to_read))
-                != to_read) {
-              return h(MultiselectError::INTERNAL_ERROR);
-            }
             self->read_buffer->commit(to_read);
             h(outcome::success());
           });
@@ -107,17 +108,16 @@ namespace libp2p::protocol_muxer {
 
     ConnectionState(
         std::shared_ptr<basic::ReadWriter> conn,
-        gsl::span<const peer::Protocol> protocols,
+        ProtocolMuxer::Protocols protocols,
+        ProtocolMuxer::ProtocolMatcher matcher,
         std::function<void(const outcome::result<peer::Protocol> &)> proto_cb,
         std::shared_ptr<common::ByteArray> write_buffer,
         std::shared_ptr<boost::asio::streambuf> read_buffer,
         size_t buffers_index, std::shared_ptr<Multiselect> multiselect,
         NegotiationStatus status = NegotiationStatus::NOTHING_SENT)
         : connection{std::move(conn)},
-          protocols{std::make_shared<std::vector<peer::Protocol>>(
-              protocols.begin(), protocols.end())},
-          left_protocols{
-              std::make_shared<std::vector<peer::Protocol>>(*this->protocols)},
+          protocols{std::move(protocols)},
+          matcher{std::move(matcher)},
           proto_callback{std::move(proto_cb)},
           write_buffer{std::move(write_buffer)},
           read_buffer{std::move(read_buffer)},
@@ -8,6 +8,7 @@
 
 #include <memory>
 #include <optional>
+#include <string_view>
 #include <vector>
 
 #include <gsl/span>
@@ -53,22 +54,22 @@ namespace libp2p::protocol_muxer {
         gsl::span<const uint8_t> bytes);
 
     /**
-     * Create an opening message
-     * @return created message
+     * Get an opening message
+     * @return message, encoded once per process
      */
-    static ByteArray openingMsg();
+    static const ByteArray &openingMsg();
 
     /**
-     * Create a message with an ls command
-     * @return created message
+     * Get a message with an ls command
+     * @return message, encoded once per process
      */
-    static ByteArray lsMsg();
+    static const ByteArray &lsMsg();
 
     /**
-     * Create a message telling the protocol is not supported
-     * @return created message
+     * Get a message telling the protocol is not supported
+     * @return message, encoded once per process
      */
-    static ByteArray naMsg();
+    static const ByteArray &naMsg();
 
     /**
      * Create a response message with a single protocol
@@ -77,6 +78,15 @@ namespace libp2p::protocol_muxer {
      */
     static ByteArray protocolMsg(const peer::Protocol &protocol);
 
+    /**
+     * Check, if the message body is the one of a protocol message
+     * @param body - message without its varint length
+     * @param protocol to be compared with
+     * @return true, if the body is the protocol and '\n'
+     */
+    static bool isProtocolMsg(gsl::span<const uint8_t> body,
+                              std::string_view protocol);
+
     /**
      * Create a response message with a list of protocols
      * @param protocols to be sent
@@ -33,9 +33,10 @@ namespace libp2p::protocol_muxer {
     /**
      * Read next varint from the connection
      * @param connection_state - state of the connection
+     * @param bytes - how much bytes are to be in the read buffer after that
      */
     static void readNextVarint(
-        std::shared_ptr<ConnectionState> connection_state);
+        std::shared_ptr<ConnectionState> connection_state, size_t bytes);
 
     /**
      * Completion handler of varint read operation
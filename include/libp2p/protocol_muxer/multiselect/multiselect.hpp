@@ -9,12 +9,14 @@
 #include <memory>
 #include <queue>
 #include <string_view>
+#include <unordered_map>
 #include <vector>
 
 #include <boost/core/noncopyable.hpp>
 #include <gsl/span>
 #include <libp2p/common/logger.hpp>
 #include <libp2p/common/types.hpp>
+#include <libp2p/metrics/registry.hpp>
 #include <libp2p/protocol_muxer/multiselect/message_manager.hpp>
 #include <libp2p/protocol_muxer/multiselect/message_reader.hpp>
 #include <libp2p/protocol_muxer/multiselect/message_writer.hpp>
@@ -33,22 +35,38 @@ namespace libp2p::protocol_muxer {
     friend MessageReader;
 
    public:
+    /**
+     * @param registry, where the metrics of the negotiations are kept; may be
+     * null
+     */
+    explicit Multiselect(std::shared_ptr<metrics::Registry> registry = nullptr);
+
     ~Multiselect() override = default;
 
     void selectOneOf(gsl::span<const peer::Protocol> protocols,
                      std::shared_ptr<basic::ReadWriter> connection,
                      bool is_initiator, ProtocolHandlerFunc cb) override;
 
+    void acceptOneOf(Protocols protocols, ProtocolMatcher matcher,
+                     std::shared_ptr<basic::ReadWriter> connection,
+                     ProtocolHandlerFunc cb) override;
+
+    std::shared_ptr<connection::Stream> selectOptimistically(
+        const peer::Protocol &protocol,
+        std::shared_ptr<connection::Stream> stream) override;
+
    private:
     /**
      * Negotiate about a protocol
      * @param connection to be negotiated over
-     * @param round, about which protocol the negotiation is to take place
+     * @param protocols, about which the negotiation is to take place
+     * @param matcher of the protocols, proposed by the other side; if empty,
+     * they are searched in the list
      * @return chosen protocol in case of success, error otherwise
      */
     void negotiate(const std::shared_ptr<basic::ReadWriter> &connection,
-                   gsl::span<const peer::Protocol> protocols, bool is_initiator,
-                   const ProtocolHandlerFunc &handler);
+                   Protocols protocols, ProtocolMatcher matcher,
+                   bool is_initiator, const ProtocolHandlerFunc &handler);
 
     /**
      * Triggered, when error happens during the negotiation round
@@ -109,10 +127,27 @@ namespace libp2p::protocol_muxer {
     void clearResources(
         const std::shared_ptr<ConnectionState> &connection_state);
 
+    /**
+     * Get a message with a single protocol, encoding it only once
+     * @param protocol to be sent
+     * @return message, ready to be sent
+     */
+    const common::ByteArray &protocolMsg(const peer::Protocol &protocol);
+
+    /// protocols are a few dozens at most, but are not trusted to be so
+    static constexpr size_t kMaxCachedProtocolMsgs = 1024;
+
     std::vector<std::shared_ptr<common::ByteArray>> write_buffers_;
     std::vector<std::shared_ptr<boost::asio::streambuf>> read_buffers_;
     std::queue<size_t> free_buffers_;
 
+    /// pre-encoded messages of the protocols, negotiated before
+    std::unordered_map<peer::Protocol, common::ByteArray> protocol_msgs_;
+
+    /// both are null, if there is no registry
+    std::shared_ptr<metrics::Histogram> negotiation_duration_;
+    std::shared_ptr<metrics::Counter> negotiation_failures_;
+
     // TODO(warchant): use logger interface here and inject it PRE-235
     libp2p::common::Logger log_ = libp2p::common::createLogger("multiselect");
   };
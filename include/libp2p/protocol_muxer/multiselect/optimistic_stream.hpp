@@ -0,0 +1,105 @@
+/**
+ * Copyright Soramitsu Co., Ltd. All Rights Reserved.
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#ifndef LIBP2P_PROTOCOL_MUXER_OPTIMISTIC_STREAM_HPP
+#define LIBP2P_PROTOCOL_MUXER_OPTIMISTIC_STREAM_HPP
+
+#include <memory>
+
+#include <libp2p/common/types.hpp>
+#include <libp2p/connection/stream.hpp>
+#include <libp2p/peer/protocol.hpp>
+
+namespace libp2p::protocol_muxer {
+
+  /**
+   * Stream of the initiator, which selects its only protocol without waiting
+   * for the other side ("lazy" multistream-select): the header and the
+   * protocol go in one write with the first bytes of the caller, and the
+   * echoes of the other side are checked before the first read, so the
+   * stream is ready at once, and there is no round trip before the data.
+   *
+   * If the other side does not support the protocol, the first read fails
+   * with NEGOTIATION_FAILED, as do all the following reads and writes.
+   */
+  class OptimisticStream
+      : public connection::Stream,
+        public std::enable_shared_from_this<OptimisticStream> {
+   public:
+    /**
+     * @param stream - stream, over which the protocol is selected
+     * @param protocol - protocol of the initiator
+     */
+    OptimisticStream(std::shared_ptr<connection::Stream> stream,
+                     peer::Protocol protocol);
+
+    ~OptimisticStream() override = default;
+
+    void read(gsl::span<uint8_t> out, size_t bytes,
+              ReadCallbackFunc cb) override;
+
+    void readSome(gsl::span<uint8_t> out, size_t bytes,
+                  ReadCallbackFunc cb) override;
+
+    void write(gsl::span<const uint8_t> in, size_t bytes,
+               WriteCallbackFunc cb) override;
+
+    void writeSome(gsl::span<const uint8_t> in, size_t bytes,
+                   WriteCallbackFunc cb) override;
+
+    bool isClosedForRead() const override;
+
+    bool isClosedForWrite() const override;
+
+    bool isClosed() const override;
+
+    void close(VoidResultHandlerFunc cb) override;
+
+    void reset() override;
+
+    void adjustWindowSize(uint32_t new_size,
+                          VoidResultHandlerFunc cb) override;
+
+    outcome::result<bool> isInitiator() const override;
+
+    const peer::PeerId &remotePeerId() const override;
+
+    outcome::result<multi::Multiaddress> localMultiaddr() const override;
+
+    outcome::result<multi::Multiaddress> remoteMultiaddr() const override;
+
+   private:
+    enum class Status { PENDING, ACCEPTED, FAILED };
+
+    using ThenFunc = std::function<void(outcome::result<void>)>;
+
+    /// header and protocol messages, which the initiator sends
+    common::ByteArray proposal() const;
+
+    /// send the proposal alone, if the caller reads before writing
+    void sendProposal(ThenFunc then);
+
+    /// read and check the echoes of the header and the protocol
+    void readEchoes(ThenFunc then);
+
+    /// read the length of the protocol response, one varint byte at a time
+    void readResponseLength(ThenFunc then);
+
+    void checkResponse(ThenFunc then);
+
+    /// make sure, the protocol is accepted, before reading
+    void negotiated(ThenFunc then);
+
+    std::shared_ptr<connection::Stream> stream_;
+    peer::Protocol protocol_;
+    bool proposal_sent_ = false;
+    Status status_ = Status::PENDING;
+    common::ByteArray write_buffer_;
+    common::ByteArray read_buffer_;
+  };
+
+}  // namespace libp2p::protocol_muxer
+
+#endif  // LIBP2P_PROTOCOL_MUXER_OPTIMISTIC_STREAM_HPP
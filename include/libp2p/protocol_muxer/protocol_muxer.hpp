@@ -7,10 +7,12 @@
 #define LIBP2P_PROTOCOL_MUXER_HPP
 
 #include <memory>
+#include <vector>
 
 #include <gsl/span>
 #include <libp2p/outcome/outcome.hpp>
 #include <libp2p/basic/readwriter.hpp>
+#include <libp2p/connection/stream.hpp>
 #include <libp2p/peer/protocol.hpp>
 
 namespace libp2p::protocol_muxer {
@@ -22,6 +24,8 @@ namespace libp2p::protocol_muxer {
    public:
     using ProtocolHandlerFunc =
         std::function<void(const outcome::result<peer::Protocol> &)>;
+    using ProtocolMatcher = std::function<bool(const peer::Protocol &)>;
+    using Protocols = std::shared_ptr<const std::vector<peer::Protocol>>;
     /**
      * Select a protocol for a given connection
      * @param protocols - set of protocols, one of which should be chosen during
@@ -36,6 +40,31 @@ namespace libp2p::protocol_muxer {
                              std::shared_ptr<basic::ReadWriter> connection,
                              bool is_initiator, ProtocolHandlerFunc cb) = 0;
 
+    /**
+     * Select a protocol as a responder, without copying the supported ones
+     * @param protocols - supported protocols, which are listed to the other
+     * side, if it asks for them
+     * @param matcher - tells, if a protocol, proposed by the other side, is
+     * supported; it may accept more protocols, than are listed
+     * @param connection, for which the protocol is being chosen
+     * @param cb - callback for handling negotiated protocol
+     */
+    virtual void acceptOneOf(Protocols protocols, ProtocolMatcher matcher,
+                             std::shared_ptr<basic::ReadWriter> connection,
+                             ProtocolHandlerFunc cb) = 0;
+
+    /**
+     * Select the only protocol of the initiator without waiting for the
+     * other side to accept it
+     * @param protocol to be used over the stream
+     * @param stream, for which the protocol is being chosen
+     * @return stream, which can be used at once; its first read fails, if
+     * the other side does not support the protocol
+     */
+    virtual std::shared_ptr<connection::Stream> selectOptimistically(
+        const peer::Protocol &protocol,
+        std::shared_ptr<connection::Stream> stream) = 0;
+
     virtual ~ProtocolMuxer() = default;
   };
 }  // namespace libp2p::protocol_muxer
@@ -0,0 +1,11 @@
+/**
+ * Copyright Soramitsu Co., Ltd. All Rights Reserved.
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#ifndef LIBP2P_NOISE_HPP
+#define LIBP2P_NOISE_HPP
+
+#include <libp2p/security/noise/noise.hpp>
+
+#endif  // LIBP2P_NOISE_HPP
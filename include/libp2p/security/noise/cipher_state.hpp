@@ -0,0 +1,90 @@
+/**
+ * Copyright Soramitsu Co., Ltd. All Rights Reserved.
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#ifndef LIBP2P_NOISE_CIPHER_STATE_HPP
+#define LIBP2P_NOISE_CIPHER_STATE_HPP
+
+#include <array>
+#include <memory>
+
+#include <gsl/span>
+#include <libp2p/outcome/outcome.hpp>
+#include <libp2p/security/noise/noise_config.hpp>
+
+struct evp_cipher_ctx_st;
+
+namespace libp2p::security::noise {
+
+  /**
+   * CipherState of the Noise spec: AEAD key with a nonce counter.
+   *
+   * OpenSSL context is set up with the key once and then gets only a new
+   * nonce per message, so that neither key schedule nor allocation is made on
+   * the data path. Messages are encrypted and decrypted in place.
+   */
+  class CipherState {
+   public:
+    static constexpr size_t kKeySize = 32;
+    static constexpr size_t kTagSize = 16;
+
+    using Key = std::array<uint8_t, kKeySize>;
+
+    explicit CipherState(CipherSuite suite);
+
+    CipherState(CipherState &&other) noexcept;
+
+    CipherState &operator=(CipherState &&other) noexcept;
+
+    ~CipherState();
+
+    /**
+     * Set the key and reset the nonce
+     * @param key - key of the AEAD
+     */
+    outcome::result<void> initializeKey(const Key &key);
+
+    bool hasKey() const;
+
+    uint64_t nonce() const;
+
+    /**
+     * Encrypt a message in place; plaintext is returned as is, if there is no
+     * key yet
+     * @param ad - associated data
+     * @param buffer - plaintext, followed by at least kTagSize bytes of space
+     * for the authentication tag
+     * @param size - size of the plaintext
+     * @return size of the ciphertext, which includes the tag
+     */
+    outcome::result<size_t> encrypt(gsl::span<const uint8_t> ad,
+                                     gsl::span<uint8_t> buffer, size_t size);
+
+    /**
+     * Decrypt a message in place; ciphertext is returned as is, if there is
+     * no key yet
+     * @param ad - associated data
+     * @param buffer - ciphertext, which includes the tag
+     * @return size of the plaintext at the beginning of the buffer
+     */
+    outcome::result<size_t> decrypt(gsl::span<const uint8_t> ad,
+                                    gsl::span<uint8_t> buffer);
+
+   private:
+    struct CtxDeleter {
+      void operator()(evp_cipher_ctx_st *ctx) const;
+    };
+
+    /// set the nonce and the direction of the next message
+    outcome::result<void> begin(gsl::span<const uint8_t> ad, bool encrypt);
+
+    CipherSuite suite_;
+    std::unique_ptr<evp_cipher_ctx_st, CtxDeleter> ctx_;
+    bool has_key_ = false;
+    uint64_t nonce_ = 0;
+  };
+
+}  // namespace libp2p::security::noise
+
+#endif  // LIBP2P_NOISE_CIPHER_STATE_HPP
@@ -0,0 +1,103 @@
+/**
+ * Copyright Soramitsu Co., Ltd. All Rights Reserved.
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#ifndef LIBP2P_NOISE_HANDSHAKE_HPP
+#define LIBP2P_NOISE_HANDSHAKE_HPP
+
+#include <boost/optional.hpp>
+#include <libp2p/common/logger.hpp>
+#include <libp2p/crypto/crypto_provider.hpp>
+#include <libp2p/crypto/key_marshaller.hpp>
+#include <libp2p/security/noise/handshake_state.hpp>
+#include <libp2p/security/security_adaptor.hpp>
+
+namespace libp2p::security::noise {
+
+  /**
+   * Keys of the local peer for the handshake
+   */
+  struct LocalIdentity {
+    crypto::PublicKey public_key;
+    peer::PeerId peer_id;
+    DhKeyPair static_keys;
+    /// payload with the identity key and its signature of the static key
+    std::vector<uint8_t> payload;
+  };
+
+  /// prefix of the static key in the signed message of the payload
+  constexpr std::string_view kPayloadSigningPrefix = "noise-libp2p-static-key:";
+
+  /**
+   * Generate a static key and sign it by the identity key
+   * @return local keys with the payload of the handshake
+   */
+  outcome::result<LocalIdentity> makeLocalIdentity(
+      const crypto::CryptoProvider &crypto_provider,
+      const crypto::marshaller::KeyMarshaller &key_marshaller,
+      const crypto::KeyPair &key_pair, const peer::PeerId &peer_id);
+
+  /**
+   * Noise XX handshake over a raw connection, which authenticates libp2p
+   * identities of the peers by the payloads of the last two messages.
+   *
+   * Each message is a 2-byte big-endian length, followed by the message.
+   */
+  class Handshake : public std::enable_shared_from_this<Handshake> {
+   public:
+    using SecConnCallbackFunc = SecurityAdaptor::SecConnCallbackFunc;
+
+    /**
+     * @param crypto_provider - verifier of the remote signature
+     * @param key_marshaller - decoder of the remote identity key
+     * @param identity - local keys
+     * @param ephemeral_keys - local ephemeral key pair of the handshake
+     * @param suite - cipher of the protocol
+     * @param conn - connection to be secured
+     * @param initiator - whether the local side dialed the connection
+     * @param remote_peer - expected remote peer, if known
+     * @param cb - called with the secured connection or error
+     */
+    Handshake(std::shared_ptr<crypto::CryptoProvider> crypto_provider,
+              std::shared_ptr<crypto::marshaller::KeyMarshaller> key_marshaller,
+              std::shared_ptr<const LocalIdentity> identity,
+              DhKeyPair ephemeral_keys, CipherSuite suite,
+              std::shared_ptr<connection::RawConnection> conn, bool initiator,
+              boost::optional<peer::PeerId> remote_peer,
+              SecConnCallbackFunc cb);
+
+    void connect();
+
+   private:
+    using ThenFunc = std::function<void()>;
+    using PayloadFunc = std::function<void(std::vector<uint8_t>)>;
+
+    void sendMessage(gsl::span<const uint8_t> payload, ThenFunc then);
+
+    void receiveMessage(PayloadFunc then);
+
+    /// authenticate the remote peer by its payload
+    outcome::result<void> verifyPayload(gsl::span<const uint8_t> payload);
+
+    void complete();
+
+    void fail(const std::error_code &error);
+
+    std::shared_ptr<crypto::CryptoProvider> crypto_provider_;
+    std::shared_ptr<crypto::marshaller::KeyMarshaller> key_marshaller_;
+    std::shared_ptr<const LocalIdentity> identity_;
+    std::shared_ptr<connection::RawConnection> conn_;
+    HandshakeState state_;
+    bool initiator_;
+    boost::optional<peer::PeerId> remote_peer_;
+    boost::optional<crypto::PublicKey> remote_pubkey_;
+    SecConnCallbackFunc cb_;
+
+    std::vector<uint8_t> buffer_;
+    common::Logger log_ = common::createLogger("NoiseHandshake");
+  };
+
+}  // namespace libp2p::security::noise
+
+#endif  // LIBP2P_NOISE_HANDSHAKE_HPP
@@ -0,0 +1,156 @@
+/**
+ * Copyright Soramitsu Co., Ltd. All Rights Reserved.
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#ifndef LIBP2P_NOISE_HANDSHAKE_STATE_HPP
+#define LIBP2P_NOISE_HANDSHAKE_STATE_HPP
+
+#include <optional>
+#include <string_view>
+#include <vector>
+
+#include <libp2p/common/types.hpp>
+#include <libp2p/crypto/key.hpp>
+#include <libp2p/crypto/sha/sha256.hpp>
+#include <libp2p/security/noise/cipher_state.hpp>
+
+namespace libp2p::security::noise {
+
+  /// maximum size of any Noise message, including the tag
+  constexpr size_t kMaxMessageSize = 65535;
+
+  constexpr size_t kDhSize = 32;
+
+  using DhKey = std::array<uint8_t, kDhSize>;
+
+  /// X25519 key pair
+  using DhKeyPair = crypto::X25519KeyPair;
+
+  /// @return new random X25519 key pair
+  outcome::result<DhKeyPair> generateDhKeyPair();
+
+  /// @return X25519 key pair, whose public key is derived from the private one
+  outcome::result<DhKeyPair> dhKeyPairFromPrivate(const DhKey &private_key);
+
+  /// @return X25519 shared secret of the local private and remote public keys
+  outcome::result<DhKey> dh(const DhKey &private_key, const DhKey &public_key);
+
+  /**
+   * SymmetricState of the Noise spec with SHA-256 as the hash
+   */
+  class SymmetricState {
+   public:
+    using Hash = common::Hash256;
+
+    SymmetricState(CipherSuite suite, std::string_view protocol_name);
+
+    void mixHash(gsl::span<const uint8_t> data);
+
+    outcome::result<void> mixKey(gsl::span<const uint8_t> input_key_material);
+
+    /**
+     * Encrypt the plaintext in place and mix the ciphertext into the hash
+     * @param buffer - plaintext with kTagSize bytes of space after it
+     * @param size - size of the plaintext
+     * @return size of the ciphertext
+     */
+    outcome::result<size_t> encryptAndHash(gsl::span<uint8_t> buffer,
+                                           size_t size);
+
+    /**
+     * Mix the ciphertext into the hash and decrypt it in place
+     * @return size of the plaintext
+     */
+    outcome::result<size_t> decryptAndHash(gsl::span<uint8_t> buffer);
+
+    bool hasKey() const;
+
+    const Hash &handshakeHash() const;
+
+    /// @return cipher states of the initiator and of the responder
+    outcome::result<std::pair<CipherState, CipherState>> split() const;
+
+   private:
+    CipherSuite suite_;
+    CipherState cipher_;
+    Hash ck_{};
+    Hash h_{};
+
+    /// reused by each mixHash()
+    crypto::Sha256 hasher_;
+  };
+
+  /**
+   * HandshakeState of the Noise spec for the XX pattern:
+   *   -> e
+   *   <- e, ee, s, es
+   *   -> s, se
+   * Each side learns the static key of the other one during the handshake.
+   */
+  class HandshakeState {
+   public:
+    /**
+     * @param suite - cipher of the protocol
+     * @param initiator - whether the local side writes the first message
+     * @param static_keys - local static key pair
+     * @param prologue - data, which both sides must agree on
+     * @param ephemeral_keys - local ephemeral key pair; generated with the
+     * first message, which carries it, if not set
+     */
+    HandshakeState(CipherSuite suite, bool initiator, DhKeyPair static_keys,
+                   gsl::span<const uint8_t> prologue = {},
+                   std::optional<DhKeyPair> ephemeral_keys = std::nullopt);
+
+    /**
+     * Make the next handshake message, which carries the payload
+     * @return the message
+     */
+    outcome::result<std::vector<uint8_t>> writeMessage(
+        gsl::span<const uint8_t> payload);
+
+    /**
+     * Process the next handshake message of the remote side
+     * @return payload of the message
+     */
+    outcome::result<std::vector<uint8_t>> readMessage(
+        gsl::span<const uint8_t> message);
+
+    /// whether the local side makes the next message
+    bool isMyTurn() const;
+
+    bool isComplete() const;
+
+    /// remote static key; valid after the message with it was read
+    const DhKey &remoteStaticKey() const;
+
+    const SymmetricState::Hash &handshakeHash() const;
+
+    /**
+     * Make the transport cipher states after the handshake is complete
+     * @return states, which encrypt outgoing and decrypt incoming messages
+     */
+    outcome::result<std::pair<CipherState, CipherState>> split() const;
+
+   private:
+    enum class Token { E, S, EE, ES, SE };
+
+    static constexpr size_t kMessages = 3;
+
+    /// tokens of the message of the pattern
+    static const std::vector<Token> &tokens(size_t message);
+
+    outcome::result<DhKey> dhToken(Token token) const;
+
+    bool initiator_;
+    size_t message_index_ = 0;
+    SymmetricState symmetric_;
+    DhKeyPair s_;
+    std::optional<DhKeyPair> e_;
+    DhKey rs_{};
+    DhKey re_{};
+  };
+
+}  // namespace libp2p::security::noise
+
+#endif  // LIBP2P_NOISE_HANDSHAKE_STATE_HPP
@@ -0,0 +1,66 @@
+/**
+ * Copyright Soramitsu Co., Ltd. All Rights Reserved.
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#ifndef LIBP2P_NOISE_ADAPTOR_HPP
+#define LIBP2P_NOISE_ADAPTOR_HPP
+
+#include <libp2p/common/logger.hpp>
+#include <libp2p/crypto/crypto_provider.hpp>
+#include <libp2p/crypto/key_marshaller.hpp>
+#include <libp2p/peer/identity_manager.hpp>
+#include <libp2p/security/noise/noise_config.hpp>
+#include <libp2p/security/security_adaptor.hpp>
+
+namespace libp2p::security {
+  namespace noise {
+    struct LocalIdentity;
+  }
+
+  /**
+   * Implementation of security adaptor, which creates connections, secured
+   * by the Noise protocol with the XX pattern, X25519 and SHA-256, as in the
+   * libp2p spec.
+   *
+   * The static key of the Noise protocol is generated once and is signed by
+   * the identity key of the host; the signature goes to the remote peer in
+   * the handshake payload, which binds its Noise session to the PeerId.
+   */
+  class Noise : public SecurityAdaptor,
+                public std::enable_shared_from_this<Noise> {
+   public:
+    ~Noise() override = default;
+
+    Noise(std::shared_ptr<peer::IdentityManager> idmgr,
+          std::shared_ptr<crypto::CryptoProvider> crypto_provider,
+          std::shared_ptr<crypto::marshaller::KeyMarshaller> key_marshaller,
+          noise::NoiseConfig config = {});
+
+    peer::Protocol getProtocolId() const override;
+
+    void secureInbound(std::shared_ptr<connection::RawConnection> inbound,
+                       SecConnCallbackFunc cb) override;
+
+    void secureOutbound(std::shared_ptr<connection::RawConnection> outbound,
+                        const peer::PeerId &p, SecConnCallbackFunc cb) override;
+
+   private:
+    /// @return keys of the local peer; made again, if the identity changed
+    outcome::result<std::shared_ptr<const noise::LocalIdentity>>
+    localIdentity();
+
+    void handshake(std::shared_ptr<connection::RawConnection> conn,
+                   bool initiator, boost::optional<peer::PeerId> remote_peer,
+                   SecConnCallbackFunc cb);
+
+    std::shared_ptr<peer::IdentityManager> idmgr_;
+    std::shared_ptr<crypto::CryptoProvider> crypto_provider_;
+    std::shared_ptr<crypto::marshaller::KeyMarshaller> key_marshaller_;
+    noise::NoiseConfig config_;
+    std::shared_ptr<const noise::LocalIdentity> identity_;
+    common::Logger log_ = common::createLogger("Noise");
+  };
+}  // namespace libp2p::security
+
+#endif  // LIBP2P_NOISE_ADAPTOR_HPP
@@ -0,0 +1,30 @@
+/**
+ * Copyright Soramitsu Co., Ltd. All Rights Reserved.
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#ifndef LIBP2P_NOISE_CONFIG_HPP
+#define LIBP2P_NOISE_CONFIG_HPP
+
+namespace libp2p::security::noise {
+
+  /**
+   * AEAD of the Noise protocol; as it is not negotiated, both ends must use
+   * the same one
+   */
+  enum class CipherSuite {
+    CHACHA_POLY,  ///< ChaChaPoly, which is mandated by the libp2p spec
+    AES_GCM,      ///< AESGCM, for hosts with AES-NI on both ends
+  };
+
+  /**
+   * Config of the Noise security adaptor
+   */
+  struct NoiseConfig {
+    /// cipher of the handshake and of the transport messages
+    CipherSuite cipher = CipherSuite::CHACHA_POLY;
+  };
+
+}  // namespace libp2p::security::noise
+
+#endif  // LIBP2P_NOISE_CONFIG_HPP
@@ -0,0 +1,116 @@
+/**
+ * Copyright Soramitsu Co., Ltd. All Rights Reserved.
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#ifndef LIBP2P_NOISE_CONNECTION_HPP
+#define LIBP2P_NOISE_CONNECTION_HPP
+
+#include <memory>
+#include <vector>
+
+#include <libp2p/connection/secure_connection.hpp>
+#include <libp2p/security/noise/cipher_state.hpp>
+
+namespace libp2p::connection {
+
+  /**
+   * Connection, secured by the Noise protocol.
+   *
+   * Each frame is a 2-byte big-endian length, followed by a transport message
+   * of at most 65535 bytes. Frames are encrypted and decrypted in place in
+   * two buffers, which are allocated once per connection, so that there is
+   * one AEAD call and no allocation per frame.
+   *
+   * As the buffers are reused, there may be one read and one write in flight
+   * at a time, like with the raw connection.
+   */
+  class NoiseConnection : public SecureConnection,
+                          public std::enable_shared_from_this<NoiseConnection> {
+   public:
+    /// maximum size of plaintext in one frame
+    static constexpr size_t kMaxPlaintextSize = 65535
+        - security::noise::CipherState::kTagSize;
+
+    /**
+     * @param raw_connection - connection, which was secured
+     * @param encoder - cipher state of the outgoing messages
+     * @param decoder - cipher state of the incoming messages
+     * @param local_pubkey - identity key of the local peer
+     * @param remote_pubkey - identity key of the remote peer
+     * @param local_peer - id of the local peer
+     * @param remote_peer - id of the remote peer
+     */
+    NoiseConnection(std::shared_ptr<RawConnection> raw_connection,
+                    security::noise::CipherState encoder,
+                    security::noise::CipherState decoder,
+                    crypto::PublicKey local_pubkey,
+                    crypto::PublicKey remote_pubkey, peer::PeerId local_peer,
+                    peer::PeerId remote_peer);
+
+    ~NoiseConnection() override = default;
+
+    const peer::PeerId &localPeer() const override;
+
+    const peer::PeerId &remotePeer() const override;
+
+    outcome::result<crypto::PublicKey> remotePublicKey() const override;
+
+    bool isInitiator() const noexcept override;
+
+    outcome::result<multi::Multiaddress> localMultiaddr() override;
+
+    outcome::result<multi::Multiaddress> remoteMultiaddr() override;
+
+    void read(gsl::span<uint8_t> out, size_t bytes,
+              ReadCallbackFunc cb) override;
+
+    void readSome(gsl::span<uint8_t> out, size_t bytes,
+                  ReadCallbackFunc cb) override;
+
+    void write(gsl::span<const uint8_t> in, size_t bytes,
+               WriteCallbackFunc cb) override;
+
+    void writeSome(gsl::span<const uint8_t> in, size_t bytes,
+                   WriteCallbackFunc cb) override;
+
+    bool isClosed() const override;
+
+    outcome::result<void> close() override;
+
+   private:
+    /// size of the length prefix of a frame
+    static constexpr size_t kLengthSize = 2;
+
+    /// copy decrypted bytes, which were not read yet, to the buffer
+    size_t popPlaintext(gsl::span<uint8_t> out);
+
+    /// read frames, until the buffer is full or, if not all, not empty
+    void readFrames(gsl::span<uint8_t> out, size_t done, bool all,
+                    ReadCallbackFunc cb);
+
+    /// read one frame and decrypt it into the read buffer
+    void readFrame(std::function<void(outcome::result<void>)> cb);
+
+    /// write frames, until all bytes or, if not all, one frame is written
+    void writeFrames(gsl::span<const uint8_t> in, size_t done, bool all,
+                     WriteCallbackFunc cb);
+
+    std::shared_ptr<RawConnection> raw_connection_;
+    security::noise::CipherState encoder_;
+    security::noise::CipherState decoder_;
+    crypto::PublicKey local_pubkey_;
+    crypto::PublicKey remote_pubkey_;
+    peer::PeerId local_peer_;
+    peer::PeerId remote_peer_;
+
+    std::array<uint8_t, kLengthSize> read_length_{};
+    std::vector<uint8_t> read_buffer_;
+    size_t read_offset_ = 0;
+    size_t read_end_ = 0;
+    std::vector<uint8_t> write_buffer_;
+  };
+
+}  // namespace libp2p::connection
+
+#endif  // LIBP2P_NOISE_CONNECTION_HPP
@@ -0,0 +1,32 @@
+/**
+ * Copyright Soramitsu Co., Ltd. All Rights Reserved.
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#ifndef LIBP2P_NOISE_ERROR_HPP
+#define LIBP2P_NOISE_ERROR_HPP
+
+#include <libp2p/outcome/outcome.hpp>
+
+namespace libp2p::security::noise {
+
+  enum class NoiseError {
+    CIPHER_INIT_FAILED = 1,  ///< OpenSSL failed to set up the AEAD
+    ENCRYPTION_FAILED,       ///< OpenSSL failed to encrypt
+    DECRYPTION_FAILED,       ///< authentication tag mismatch
+    NONCE_EXHAUSTED,         ///< 2^64-1 messages were sent with one key
+    DH_FAILED,               ///< X25519 key generation or agreement failed
+    MESSAGE_TOO_LARGE,       ///< message exceeds 65535 bytes
+    MESSAGE_TOO_SHORT,       ///< message lacks keys or authentication tag
+    HANDSHAKE_COMPLETE,      ///< all handshake messages were processed
+    HANDSHAKE_INCOMPLETE,    ///< split before the last handshake message
+    INVALID_PAYLOAD,         ///< handshake payload cannot be decoded
+    INVALID_SIGNATURE,       ///< static key is not signed by identity key
+    PEER_ID_MISMATCH,        ///< remote is not the peer, which was dialed
+  };
+
+}  // namespace libp2p::security::noise
+
+OUTCOME_HPP_DECLARE_ERROR(libp2p::security::noise, NoiseError);
+
+#endif  // LIBP2P_NOISE_ERROR_HPP
@@ -10,22 +10,29 @@
 #include <optional>
 
 #include <libp2p/connection/secure_connection.hpp>
-#include <libp2p/crypto/key_marshaller.hpp>
 
 namespace libp2p::connection {
   class PlaintextConnection : public SecureConnection {
    public:
-    PlaintextConnection(
-        std::shared_ptr<RawConnection> raw_connection,
-        crypto::PublicKey localPubkey,
-        crypto::PublicKey remotePubkey,
-        std::shared_ptr<crypto::marshaller::KeyMarshaller> key_marshaller);
+    /**
+     * Create an instance of PlaintextConnection
+     * @param raw_connection - connection to be wrapped
+     * @param localPubkey - public key of the local peer
+     * @param remotePubkey - public key of the remote peer
+     * @param localPeer - id of the local peer
+     * @param remotePeer - id of the remote peer, derived from its key
+     */
+    PlaintextConnection(std::shared_ptr<RawConnection> raw_connection,
+                        crypto::PublicKey localPubkey,
+                        crypto::PublicKey remotePubkey,
+                        peer::PeerId localPeer,
+                        peer::PeerId remotePeer);
 
     ~PlaintextConnection() override = default;
 
-    outcome::result<peer::PeerId> localPeer() const override;
+    const peer::PeerId &localPeer() const override;
 
-    outcome::result<peer::PeerId> remotePeer() const override;
+    const peer::PeerId &remotePeer() const override;
 
     outcome::result<crypto::PublicKey> remotePublicKey() const override;
 
@@ -61,7 +68,8 @@ namespace libp2p::connection {
     crypto::PublicKey local_;
     crypto::PublicKey remote_;
 
-    std::shared_ptr<crypto::marshaller::KeyMarshaller> key_marshaller_;
+    peer::PeerId local_peer_;
+    peer::PeerId remote_peer_;
   };
 }  // namespace libp2p::connection
 
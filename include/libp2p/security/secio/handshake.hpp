@@ -0,0 +1,125 @@
+/**
+ * Copyright Soramitsu Co., Ltd. All Rights Reserved.
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#ifndef LIBP2P_SECIO_HANDSHAKE_HPP
+#define LIBP2P_SECIO_HANDSHAKE_HPP
+
+#include <string_view>
+
+#include <boost/optional.hpp>
+#include <libp2p/common/logger.hpp>
+#include <libp2p/crypto/crypto_provider.hpp>
+#include <libp2p/crypto/key_marshaller.hpp>
+#include <libp2p/crypto/random_generator.hpp>
+#include <libp2p/security/security_adaptor.hpp>
+
+namespace libp2p::security::secio {
+
+  /// curves of ephemeral keys, offered by the local peer
+  constexpr std::string_view kExchanges = "P-256,P-384,P-521";
+
+  /// ciphers, offered by the local peer
+  constexpr std::string_view kCiphers = "AES-256,AES-128";
+
+  /// MAC hashes, offered by the local peer
+  constexpr std::string_view kHashes = "SHA256,SHA512";
+
+  /// size of the nonce in the propose message
+  constexpr size_t kNonceSize = 16;
+
+  /**
+   * Choose an algorithm, which both peers support, as go-libp2p does: the
+   * preferences of the peer with the greater order are tried first
+   * @param order - sign of comparison of the local and remote order hashes
+   * @param local - comma-separated algorithms of the local peer
+   * @param remote - comma-separated algorithms of the remote peer
+   * @return common algorithm, if any
+   */
+  boost::optional<std::string_view> selectBest(int order,
+                                               std::string_view local,
+                                               std::string_view remote);
+
+  /**
+   * SECIO handshake over a raw connection: the peers exchange proposals,
+   * then ephemeral keys, signed by their identity keys, and finally check
+   * the derived keys by sending the nonce of the other side back.
+   *
+   * Each message is a 4-byte big-endian length, followed by the message.
+   */
+  class Handshake : public std::enable_shared_from_this<Handshake> {
+   public:
+    using SecConnCallbackFunc = SecurityAdaptor::SecConnCallbackFunc;
+
+    /**
+     * @param crypto_provider - generator of ephemeral keys and signatures
+     * @param key_marshaller - codec of identity keys
+     * @param csprng - source of the nonce
+     * @param local_keys - identity keys of the local peer
+     * @param local_peer - id of the local peer
+     * @param conn - connection to be secured
+     * @param remote_peer - expected remote peer, if known
+     * @param cb - called with the secured connection or error
+     */
+    Handshake(std::shared_ptr<crypto::CryptoProvider> crypto_provider,
+              std::shared_ptr<crypto::marshaller::KeyMarshaller> key_marshaller,
+              std::shared_ptr<crypto::random::CSPRNG> csprng,
+              crypto::KeyPair local_keys, peer::PeerId local_peer,
+              std::shared_ptr<connection::RawConnection> conn,
+              boost::optional<peer::PeerId> remote_peer,
+              SecConnCallbackFunc cb);
+
+    void connect();
+
+   private:
+    using ThenFunc = std::function<void()>;
+    using MessageFunc = std::function<void(gsl::span<const uint8_t>)>;
+
+    /// make the propose message of the local peer
+    outcome::result<void> makePropose();
+
+    /// choose algorithms and make the signed exchange message
+    outcome::result<void> processPropose(gsl::span<const uint8_t> message);
+
+    /// authenticate the remote ephemeral key and derive the secure connection
+    outcome::result<std::shared_ptr<connection::SecureConnection>>
+    processExchange(gsl::span<const uint8_t> message);
+
+    /// send the remote nonce and wait for the local one over the connection
+    void checkNonce(std::shared_ptr<connection::SecureConnection> conn);
+
+    void sendMessage(gsl::span<const uint8_t> message, ThenFunc then);
+
+    void receiveMessage(MessageFunc then);
+
+    void fail(const std::error_code &error);
+
+    std::shared_ptr<crypto::CryptoProvider> crypto_provider_;
+    std::shared_ptr<crypto::marshaller::KeyMarshaller> key_marshaller_;
+    std::shared_ptr<crypto::random::CSPRNG> csprng_;
+    crypto::KeyPair local_keys_;
+    peer::PeerId local_peer_;
+    std::shared_ptr<connection::RawConnection> conn_;
+    boost::optional<peer::PeerId> remote_peer_;
+    SecConnCallbackFunc cb_;
+
+    std::vector<uint8_t> local_nonce_;
+    std::vector<uint8_t> local_pubkey_bytes_;
+    std::vector<uint8_t> local_propose_;
+    std::vector<uint8_t> remote_propose_;
+    std::vector<uint8_t> remote_nonce_;
+    boost::optional<crypto::PublicKey> remote_pubkey_;
+    int order_ = 0;
+    crypto::common::CipherType cipher_{};
+    crypto::common::HashType hash_{};
+    boost::optional<crypto::EphemeralKeyPair> ephemeral_;
+    std::vector<uint8_t> local_exchange_;
+
+    std::vector<uint8_t> buffer_;
+    common::Logger log_ = common::createLogger("SecioHandshake");
+  };
+
+}  // namespace libp2p::security::secio
+
+#endif  // LIBP2P_SECIO_HANDSHAKE_HPP
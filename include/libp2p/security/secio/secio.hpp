@@ -0,0 +1,57 @@
+/**
+ * Copyright Soramitsu Co., Ltd. All Rights Reserved.
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#ifndef LIBP2P_SECIO_ADAPTOR_HPP
+#define LIBP2P_SECIO_ADAPTOR_HPP
+
+#include <boost/optional.hpp>
+#include <libp2p/common/logger.hpp>
+#include <libp2p/crypto/crypto_provider.hpp>
+#include <libp2p/crypto/key_marshaller.hpp>
+#include <libp2p/crypto/random_generator.hpp>
+#include <libp2p/peer/identity_manager.hpp>
+#include <libp2p/security/security_adaptor.hpp>
+
+namespace libp2p::security {
+
+  /**
+   * Implementation of security adaptor, which creates connections, secured
+   * by the SECIO protocol: ECDH on P-256, P-384 or P-521, AES-CTR and
+   * HMAC-SHA256 or HMAC-SHA512.
+   *
+   * SECIO is superseded by Noise, but stays for older go and js nodes,
+   * which cannot negotiate Noise.
+   */
+  class Secio : public SecurityAdaptor {
+   public:
+    ~Secio() override = default;
+
+    Secio(std::shared_ptr<peer::IdentityManager> idmgr,
+          std::shared_ptr<crypto::CryptoProvider> crypto_provider,
+          std::shared_ptr<crypto::marshaller::KeyMarshaller> key_marshaller,
+          std::shared_ptr<crypto::random::CSPRNG> csprng);
+
+    peer::Protocol getProtocolId() const override;
+
+    void secureInbound(std::shared_ptr<connection::RawConnection> inbound,
+                       SecConnCallbackFunc cb) override;
+
+    void secureOutbound(std::shared_ptr<connection::RawConnection> outbound,
+                        const peer::PeerId &p, SecConnCallbackFunc cb) override;
+
+   private:
+    void handshake(std::shared_ptr<connection::RawConnection> conn,
+                   boost::optional<peer::PeerId> remote_peer,
+                   SecConnCallbackFunc cb);
+
+    std::shared_ptr<peer::IdentityManager> idmgr_;
+    std::shared_ptr<crypto::CryptoProvider> crypto_provider_;
+    std::shared_ptr<crypto::marshaller::KeyMarshaller> key_marshaller_;
+    std::shared_ptr<crypto::random::CSPRNG> csprng_;
+    common::Logger log_ = common::createLogger("Secio");
+  };
+}  // namespace libp2p::security
+
+#endif  // LIBP2P_SECIO_ADAPTOR_HPP
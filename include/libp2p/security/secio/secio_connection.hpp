@@ -0,0 +1,136 @@
+/**
+ * Copyright Soramitsu Co., Ltd. All Rights Reserved.
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#ifndef LIBP2P_SECIO_CONNECTION_HPP
+#define LIBP2P_SECIO_CONNECTION_HPP
+
+#include <array>
+#include <memory>
+#include <vector>
+
+#include <libp2p/connection/secure_connection.hpp>
+#include <libp2p/crypto/aes_provider/aes_stream.hpp>
+#include <libp2p/crypto/hmac_provider/hmac_stream.hpp>
+
+namespace libp2p::connection {
+
+  /**
+   * Connection, secured by the SECIO protocol.
+   *
+   * Each frame is a 4-byte big-endian length, followed by the AES-CTR
+   * ciphertext and its HMAC. The cipher and MAC contexts live as long as the
+   * connection, and frames are encrypted and decrypted in place in two
+   * buffers, so that a frame costs no allocation: the write buffer is
+   * allocated once, and the read buffer only grows to the largest frame of
+   * the remote peer.
+   *
+   * As the buffers are reused, there may be one read and one write in flight
+   * at a time, like with the raw connection.
+   */
+  class SecioConnection : public SecureConnection,
+                          public std::enable_shared_from_this<SecioConnection> {
+   public:
+    /// maximum size of plaintext in one outgoing frame
+    static constexpr size_t kMaxPlaintextSize = 65536;
+
+    /// maximum size of an incoming frame, as in go-libp2p
+    static constexpr size_t kMaxFrameSize = 8 * 1024 * 1024;
+
+    /**
+     * @param raw_connection - connection, which was secured
+     * @param encryptor - cipher of the outgoing frames
+     * @param local_mac - MAC of the outgoing frames
+     * @param decryptor - cipher of the incoming frames
+     * @param remote_mac - MAC of the incoming frames
+     * @param local_pubkey - identity key of the local peer
+     * @param remote_pubkey - identity key of the remote peer
+     * @param local_peer - id of the local peer
+     * @param remote_peer - id of the remote peer
+     */
+    SecioConnection(std::shared_ptr<RawConnection> raw_connection,
+                    crypto::aes::AesCtr encryptor,
+                    crypto::hmac::HmacStream local_mac,
+                    crypto::aes::AesCtr decryptor,
+                    crypto::hmac::HmacStream remote_mac,
+                    crypto::PublicKey local_pubkey,
+                    crypto::PublicKey remote_pubkey, peer::PeerId local_peer,
+                    peer::PeerId remote_peer);
+
+    ~SecioConnection() override = default;
+
+    const peer::PeerId &localPeer() const override;
+
+    const peer::PeerId &remotePeer() const override;
+
+    outcome::result<crypto::PublicKey> remotePublicKey() const override;
+
+    bool isInitiator() const noexcept override;
+
+    outcome::result<multi::Multiaddress> localMultiaddr() override;
+
+    outcome::result<multi::Multiaddress> remoteMultiaddr() override;
+
+    void read(gsl::span<uint8_t> out, size_t bytes,
+              ReadCallbackFunc cb) override;
+
+    void readSome(gsl::span<uint8_t> out, size_t bytes,
+                  ReadCallbackFunc cb) override;
+
+    void write(gsl::span<const uint8_t> in, size_t bytes,
+               WriteCallbackFunc cb) override;
+
+    void writeSome(gsl::span<const uint8_t> in, size_t bytes,
+                   WriteCallbackFunc cb) override;
+
+    bool isClosed() const override;
+
+    outcome::result<void> close() override;
+
+   private:
+    /// size of the length prefix of a frame
+    static constexpr size_t kLengthSize = 4;
+
+    /// copy decrypted bytes, which were not read yet, to the buffer
+    size_t popPlaintext(gsl::span<uint8_t> out);
+
+    /// read frames, until the buffer is full or, if not all, not empty
+    void readFrames(gsl::span<uint8_t> out, size_t done, bool all,
+                    ReadCallbackFunc cb);
+
+    /// read one frame, check its MAC and decrypt it into the read buffer
+    void readFrame(std::function<void(outcome::result<void>)> cb);
+
+    /// check MAC of the frame and decrypt it in place
+    outcome::result<size_t> decryptFrame(gsl::span<uint8_t> frame);
+
+    /// encrypt the plaintext into the write buffer
+    /// @return size of the frame with its length prefix
+    outcome::result<size_t> encryptFrame(gsl::span<const uint8_t> plaintext);
+
+    /// write frames, until all bytes or, if not all, one frame is written
+    void writeFrames(gsl::span<const uint8_t> in, size_t done, bool all,
+                     WriteCallbackFunc cb);
+
+    std::shared_ptr<RawConnection> raw_connection_;
+    crypto::aes::AesCtr encryptor_;
+    crypto::hmac::HmacStream local_mac_;
+    crypto::aes::AesCtr decryptor_;
+    crypto::hmac::HmacStream remote_mac_;
+    crypto::PublicKey local_pubkey_;
+    crypto::PublicKey remote_pubkey_;
+    peer::PeerId local_peer_;
+    peer::PeerId remote_peer_;
+
+    std::array<uint8_t, kLengthSize> read_length_{};
+    std::array<uint8_t, crypto::hmac::HmacStream::kMaxDigestSize> read_mac_{};
+    std::vector<uint8_t> read_buffer_;
+    size_t read_offset_ = 0;
+    size_t read_end_ = 0;
+    std::vector<uint8_t> write_buffer_;
+  };
+
+}  // namespace libp2p::connection
+
+#endif  // LIBP2P_SECIO_CONNECTION_HPP
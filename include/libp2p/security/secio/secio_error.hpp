@@ -0,0 +1,30 @@
+/**
+ * Copyright Soramitsu Co., Ltd. All Rights Reserved.
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#ifndef LIBP2P_SECIO_ERROR_HPP
+#define LIBP2P_SECIO_ERROR_HPP
+
+#include <libp2p/outcome/outcome.hpp>
+
+namespace libp2p::security::secio {
+
+  enum class SecioError {
+    INVALID_MESSAGE = 1,    ///< propose or exchange cannot be decoded
+    MESSAGE_TOO_LARGE,      ///< message exceeds the maximum frame size
+    MESSAGE_TOO_SHORT,      ///< frame is shorter than its MAC
+    SELF_DIAL,              ///< both peers have the same key and nonce
+    NO_COMMON_ALGORITHM,    ///< peers have no curve, cipher or hash in common
+    INVALID_SIGNATURE,      ///< ephemeral key is not signed by identity key
+    PEER_ID_MISMATCH,       ///< remote is not the peer, which was dialed
+    KEY_STRETCHING_FAILED,  ///< shared secret cannot be stretched
+    MAC_MISMATCH,           ///< frame is not authenticated by the remote key
+    NONCE_MISMATCH,         ///< remote did not return the local nonce
+  };
+
+}  // namespace libp2p::security::secio
+
+OUTCOME_HPP_DECLARE_ERROR(libp2p::security::secio, SecioError);
+
+#endif  // LIBP2P_SECIO_ERROR_HPP
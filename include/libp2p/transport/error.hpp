@@ -0,0 +1,29 @@
+/**
+ * Copyright Soramitsu Co., Ltd. All Rights Reserved.
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#ifndef LIBP2P_TRANSPORT_ERROR_HPP
+#define LIBP2P_TRANSPORT_ERROR_HPP
+
+#include <libp2p/outcome/outcome.hpp>
+
+namespace libp2p::transport {
+
+  /**
+   * Errors of the dial/accept -> upgrade pipeline; timeouts tell, which phase
+   * of the pipeline has not finished in time
+   */
+  enum class TransportError {
+    RESOLVE_TIMEOUT = 1,
+    CONNECT_TIMEOUT,
+    SECURITY_TIMEOUT,
+    MUXER_TIMEOUT,
+    CONNECTION_GATED
+  };
+
+}  // namespace libp2p::transport
+
+OUTCOME_HPP_DECLARE_ERROR(libp2p::transport, TransportError);
+
+#endif  // LIBP2P_TRANSPORT_ERROR_HPP
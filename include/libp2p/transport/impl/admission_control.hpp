@@ -0,0 +1,115 @@
+/**
+ * Copyright Soramitsu Co., Ltd. All Rights Reserved.
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#ifndef LIBP2P_TRANSPORT_ADMISSION_CONTROL_HPP
+#define LIBP2P_TRANSPORT_ADMISSION_CONTROL_HPP
+
+#include <array>
+#include <chrono>
+#include <memory>
+#include <unordered_map>
+#include <vector>
+
+#include <boost/asio/ip/address.hpp>
+#include <boost/container_hash/hash.hpp>
+#include <libp2p/connection/raw_connection.hpp>
+#include <libp2p/transport/transport_config.hpp>
+
+namespace libp2p::transport {
+
+  /**
+   * Decides, whether an accepted inbound socket may proceed to the upgrade;
+   * denied sockets are to be closed before any handshake work is done
+   * @note not thread-safe; is expected to be used from the listener's
+   * io_context only
+   */
+  class AdmissionControl {
+   public:
+    using Clock = std::chrono::steady_clock;
+
+    enum class Decision {
+      ACCEPT,    ///< connection may be upgraded
+      THROTTLE,  ///< source address or subnet exceeded its rate limit
+      REJECT     ///< listener is at its upgrades or connections capacity
+    };
+
+    struct Stats {
+      size_t accepted = 0;
+      size_t throttled = 0;
+      size_t rejected = 0;
+    };
+
+    explicit AdmissionControl(AdmissionConfig config);
+
+    /**
+     * Decide about a connection from the given address; on ACCEPT the
+     * connection occupies an upgrade slot until onUpgradeFinished() is called
+     * @param remote - address of the connected peer
+     * @param now - current time
+     * @return decision
+     */
+    Decision admit(const boost::asio::ip::address &remote,
+                   Clock::time_point now = Clock::now());
+
+    /**
+     * Count the admitted connection towards the inbound connections cap until
+     * it is closed
+     * @param conn - admitted connection
+     */
+    void track(const std::shared_ptr<connection::RawConnection> &conn);
+
+    /**
+     * Release an upgrade slot, taken by admit()
+     */
+    void onUpgradeFinished();
+
+    /**
+     * @return number of upgrades, which are in progress now
+     */
+    size_t upgradesInProgress() const;
+
+    /**
+     * @return counters of decisions made
+     */
+    const Stats &getStats() const;
+
+   private:
+    /// IPv6 or IPv4-mapped address bytes
+    using Key = std::array<uint8_t, 16>;
+
+    /// number of connections from some source in the current rate window
+    struct Window {
+      Clock::time_point start;
+      size_t count = 0;
+    };
+
+    using Windows = std::unordered_map<Key, Window, boost::hash<Key>>;
+
+    static Key makeKey(const boost::asio::ip::address &address);
+
+    Key subnetOf(const boost::asio::ip::address &address) const;
+
+    /// @return true, if one more connection fits into the source's window
+    bool fits(Windows &windows, const Key &key, size_t limit,
+              Clock::time_point now);
+
+    void bump(Windows &windows, const Key &key, Clock::time_point now);
+
+    void pruneWindows(Clock::time_point now);
+
+    size_t liveConnections();
+
+    AdmissionConfig config_;
+    Stats stats_;
+    size_t upgrades_in_progress_ = 0;
+    Windows ip_windows_;
+    Windows subnet_windows_;
+    Clock::time_point last_prune_;
+    std::vector<std::weak_ptr<connection::RawConnection>> connections_;
+  };
+
+}  // namespace libp2p::transport
+
+#endif  // LIBP2P_TRANSPORT_ADMISSION_CONTROL_HPP
@@ -0,0 +1,92 @@
+/**
+ * Copyright Soramitsu Co., Ltd. All Rights Reserved.
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#ifndef LIBP2P_TRANSPORT_DEADLINE_HPP
+#define LIBP2P_TRANSPORT_DEADLINE_HPP
+
+#include <chrono>
+#include <functional>
+#include <memory>
+
+#include <boost/asio/io_context.hpp>
+#include <boost/asio/steady_timer.hpp>
+
+namespace libp2p::transport::detail {
+
+  /**
+   * Timer, which aborts some asynchronous operation, if it does not complete
+   * in time
+   */
+  class Deadline : public std::enable_shared_from_this<Deadline> {
+   public:
+    using OnExpired = std::function<void()>;
+
+    explicit Deadline(boost::asio::io_context &context) : timer_{context} {}
+
+    /**
+     * Create a deadline and arm it
+     * @param context, in which the timer is run
+     * @param timeout - time, given to the operation; zero means no deadline
+     * @param on_expired - called, when the operation has not completed in time;
+     * it should abort the operation
+     * @return armed deadline
+     */
+    static std::shared_ptr<Deadline> start(boost::asio::io_context &context,
+                                           std::chrono::milliseconds timeout,
+                                           OnExpired on_expired) {
+      auto deadline = std::make_shared<Deadline>(context);
+      if (timeout <= std::chrono::milliseconds::zero()) {
+        return deadline;
+      }
+
+      deadline->on_expired_ = std::move(on_expired);
+      deadline->timer_.expires_after(timeout);
+      deadline->timer_.async_wait(
+          [self{deadline->shared_from_this()}](
+              const boost::system::error_code &ec) {
+            if (ec || self->stopped_) {
+              return;
+            }
+            self->expired_ = true;
+            auto on_expired = std::move(self->on_expired_);
+            self->on_expired_ = nullptr;
+            if (on_expired) {
+              on_expired();
+            }
+          });
+      return deadline;
+    }
+
+    /**
+     * Disarm the deadline; must be called, when the operation completes
+     * @return true, if the deadline has already expired - operation's result
+     * then must be treated as a timeout
+     */
+    bool stop() {
+      if (!stopped_) {
+        stopped_ = true;
+        timer_.cancel();
+        on_expired_ = nullptr;
+      }
+      return expired_;
+    }
+
+    /**
+     * @return true, if the operation has not completed in time
+     */
+    bool expired() const {
+      return expired_;
+    }
+
+   private:
+    boost::asio::steady_timer timer_;
+    OnExpired on_expired_;
+    bool stopped_ = false;
+    bool expired_ = false;
+  };
+
+}  // namespace libp2p::transport::detail
+
+#endif  // LIBP2P_TRANSPORT_DEADLINE_HPP
@@ -9,9 +9,12 @@
 #include <vector>
 
 #include <gsl/span>
+#include <libp2p/metrics/registry.hpp>
 #include <libp2p/muxer/muxer_adaptor.hpp>
+#include <libp2p/network/connection_gater.hpp>
 #include <libp2p/peer/peer_id.hpp>
 #include <libp2p/peer/protocol.hpp>
+#include <libp2p/peer/protocol_repository.hpp>
 #include <libp2p/protocol_muxer/protocol_muxer.hpp>
 #include <libp2p/security/security_adaptor.hpp>
 #include <libp2p/transport/upgrader.hpp>
@@ -27,14 +30,24 @@ namespace libp2p::transport {
      * Create an instance of upgrader
      * @param protocol_muxer - protocol wrapper, allowing to negotiate about the
      * protocols with the other side
+     * @param protocol_repo - remembers security and muxer protocols, which the
+     * peers have negotiated, so that they are proposed first next time
      * @param security_adaptors, which can be used to upgrade Raw connections to
      * the Secure ones
      * @param muxer_adaptors, which can be used to upgrade Secure connections to
      * the Muxed (Capable) ones
+     * @param gater, which may drop the connections of a peer before they are
+     * muxed; may be null
+     * @param registry, where the metrics of the handshakes are kept; may be
+     * null
      */
-    UpgraderImpl(std::shared_ptr<protocol_muxer::ProtocolMuxer> protocol_muxer,
-                 std::vector<SecAdaptorSPtr> security_adaptors,
-                 std::vector<MuxAdaptorSPtr> muxer_adaptors);
+    UpgraderImpl(
+        std::shared_ptr<protocol_muxer::ProtocolMuxer> protocol_muxer,
+        std::shared_ptr<peer::ProtocolRepository> protocol_repo,
+        std::vector<SecAdaptorSPtr> security_adaptors,
+        std::vector<MuxAdaptorSPtr> muxer_adaptors,
+        std::shared_ptr<network::ConnectionGater> gater = nullptr,
+        std::shared_ptr<metrics::Registry> registry = nullptr);
 
     ~UpgraderImpl() override = default;
 
@@ -49,13 +62,57 @@ namespace libp2p::transport {
     enum class Error { SUCCESS = 0, NO_ADAPTOR_FOUND = 1 };
 
    private:
+    /// metrics of the security handshakes in one direction
+    struct HandshakeMetrics {
+      HandshakeMetrics(metrics::Registry &registry,
+                       const std::string &direction);
+
+      std::shared_ptr<metrics::Histogram> duration;
+      std::shared_ptr<metrics::Counter> failures;
+    };
+
+    /**
+     * Wrap the callback, so that the handshake is measured
+     * @param cb - callback of the handshake
+     * @param handshakes - metrics of its direction; if null, the callback is
+     * not wrapped
+     */
+    static OnSecuredCallbackFunc measured(
+        OnSecuredCallbackFunc cb,
+        const std::shared_ptr<HandshakeMetrics> &handshakes);
+
+    /**
+     * Put the protocols, which the peer has negotiated before, first, so that
+     * there are no "na" rounds with it
+     * @param peer - the other side
+     * @param protocols of one family (security or muxer) in our order
+     * @return protocols in the order to be proposed
+     */
+    std::vector<peer::Protocol> preferNegotiated(
+        const peer::PeerId &peer,
+        const std::vector<peer::Protocol> &protocols) const;
+
+    /// remember the protocol, negotiated with the peer
+    void onNegotiated(const peer::PeerId &peer,
+                      const peer::Protocol &protocol);
+
+    /// @return true, if connections of the peer are not to be dropped
+    bool allowed(const peer::PeerId &peer) const;
+
     std::shared_ptr<protocol_muxer::ProtocolMuxer> protocol_muxer_;
+    std::shared_ptr<peer::ProtocolRepository> protocol_repo_;
 
     std::vector<SecAdaptorSPtr> security_adaptors_;
     std::vector<peer::Protocol> security_protocols_;
 
     std::vector<MuxAdaptorSPtr> muxer_adaptors_;
     std::vector<peer::Protocol> muxer_protocols_;
+
+    std::shared_ptr<network::ConnectionGater> gater_;
+
+    /// both are null, if there is no registry
+    std::shared_ptr<HandshakeMetrics> inbound_handshakes_;
+    std::shared_ptr<HandshakeMetrics> outbound_handshakes_;
   };
 }  // namespace libp2p::transport
 
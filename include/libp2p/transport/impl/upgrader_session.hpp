@@ -8,13 +8,20 @@
 
 #include <memory>
 
+#include <boost/asio/io_context.hpp>
 #include <libp2p/connection/capable_connection.hpp>
+#include <libp2p/security/security_adaptor.hpp>
+#include <libp2p/transport/error.hpp>
+#include <libp2p/transport/impl/deadline.hpp>
+#include <libp2p/transport/transport_config.hpp>
 #include <libp2p/transport/upgrader.hpp>
 
 namespace libp2p::transport {
 
   /**
    * @brief Class, which reduces callback hell in transport upgrader.
+   * @note each upgrade phase has a deadline; if it expires, the raw connection
+   * is closed and handler gets the corresponding TransportError
    */
   struct UpgraderSession
       : public std::enable_shared_from_this<UpgraderSession> {
@@ -24,19 +31,45 @@ namespace libp2p::transport {
 
     UpgraderSession(std::shared_ptr<transport::Upgrader> upgrader,
                     std::shared_ptr<connection::RawConnection> raw,
-                    HandlerFunc handler);
+                    HandlerFunc handler, boost::asio::io_context &context,
+                    const TransportConfig &config);
 
     void secureOutbound(const peer::PeerId &remoteId);
 
     void secureInbound();
 
+    /**
+     * Secure the connection with the given adaptor without negotiating it;
+     * the other side must use the same adaptor
+     */
+    void secureOutbound(
+        const peer::PeerId &remoteId,
+        const std::shared_ptr<security::SecurityAdaptor> &adaptor);
+
+    /**
+     * Secure the connection with the given adaptor without negotiating it;
+     * the other side must use the same adaptor
+     */
+    void secureInbound(
+        const std::shared_ptr<security::SecurityAdaptor> &adaptor);
+
    private:
     std::shared_ptr<transport::Upgrader> upgrader_;
     std::shared_ptr<connection::RawConnection> raw_;
     HandlerFunc handler_;
+    boost::asio::io_context &context_;
+    TransportConfig config_;
+    std::shared_ptr<detail::Deadline> deadline_;
 
     void onSecured(
         outcome::result<std::shared_ptr<connection::SecureConnection>> rsecure);
+
+    void onMuxed(
+        outcome::result<std::shared_ptr<connection::CapableConnection>> rmuxed);
+
+    void startPhase(std::chrono::milliseconds timeout, TransportError error);
+
+    void onPhaseTimeout(TransportError error);
   };
 
 }  // namespace libp2p::transport
@@ -0,0 +1,39 @@
+/**
+ * Copyright Soramitsu Co., Ltd. All Rights Reserved.
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#ifndef LIBP2P_MEMORY_CONFIG_HPP
+#define LIBP2P_MEMORY_CONFIG_HPP
+
+#include <chrono>
+#include <cstdint>
+
+namespace libp2p::transport {
+
+  /**
+   * Properties of the simulated link between two in-memory connections
+   * @note links are reliable, as TCP is: lost data is delivered after a
+   * retransmission delay, keeping the order of bytes
+   */
+  struct MemoryLinkConfig {
+    /// one-way delay of each written chunk
+    std::chrono::microseconds latency = std::chrono::microseconds::zero();
+
+    /// bytes per second, which can be sent in one direction; zero means
+    /// unlimited
+    uint64_t bandwidth = 0;
+
+    /// probability of a written chunk to be lost, from 0 to 1
+    double loss = 0;
+
+    /// additional delay of a lost chunk
+    std::chrono::microseconds retransmit_delay = std::chrono::milliseconds(200);
+
+    /// seed of the loss generator; same seed gives same losses
+    uint64_t seed = 0;
+  };
+
+}  // namespace libp2p::transport
+
+#endif  // LIBP2P_MEMORY_CONFIG_HPP
@@ -0,0 +1,136 @@
+/**
+ * Copyright Soramitsu Co., Ltd. All Rights Reserved.
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#ifndef LIBP2P_MEMORY_CONNECTION_HPP
+#define LIBP2P_MEMORY_CONNECTION_HPP
+
+#include <chrono>
+#include <deque>
+#include <memory>
+#include <optional>
+#include <random>
+#include <utility>
+#include <vector>
+
+#include <boost/asio/io_context.hpp>
+#include <boost/asio/steady_timer.hpp>
+#include <boost/noncopyable.hpp>
+#include <libp2p/connection/raw_connection.hpp>
+#include <libp2p/transport/memory/memory_config.hpp>
+
+namespace libp2p::transport {
+
+  /**
+   * One end of an in-process connection; bytes, written to it, appear at the
+   * other end after the delay, which the link config defines
+   */
+  class MemoryConnection : public connection::RawConnection,
+                           public std::enable_shared_from_this<MemoryConnection>,
+                           private boost::noncopyable {
+   public:
+    using Clock = std::chrono::steady_clock;
+
+    ~MemoryConnection() override = default;
+
+    MemoryConnection(boost::asio::io_context &context, MemoryLinkConfig config,
+                     bool initiator, multi::Multiaddress local,
+                     multi::Multiaddress remote);
+
+    /**
+     * Create two connected ends
+     * @param context - io context, in which both ends are run
+     * @param config - properties of the link; they apply to both directions
+     * @param initiator_address - address of the first (dialing) end
+     * @param responder_address - address of the second (listening) end
+     * @return pair of the initiator and responder ends
+     */
+    static std::pair<std::shared_ptr<MemoryConnection>,
+                     std::shared_ptr<MemoryConnection>>
+    makePair(boost::asio::io_context &context, const MemoryLinkConfig &config,
+             const multi::Multiaddress &initiator_address,
+             const multi::Multiaddress &responder_address);
+
+    void read(gsl::span<uint8_t> out, size_t bytes,
+              ReadCallbackFunc cb) override;
+
+    void readSome(gsl::span<uint8_t> out, size_t bytes,
+                  ReadCallbackFunc cb) override;
+
+    void write(gsl::span<const uint8_t> in, size_t bytes,
+               WriteCallbackFunc cb) override;
+
+    void writeSome(gsl::span<const uint8_t> in, size_t bytes,
+                   WriteCallbackFunc cb) override;
+
+    outcome::result<multi::Multiaddress> remoteMultiaddr() override;
+
+    outcome::result<multi::Multiaddress> localMultiaddr() override;
+
+    bool isInitiator() const noexcept override;
+
+    outcome::result<void> close() override;
+
+    bool isClosed() const override;
+
+   private:
+    /// bytes on their way to this end
+    struct Chunk {
+      Clock::time_point arrival;
+      std::vector<uint8_t> data;
+    };
+
+    /// read, which waits for the data
+    struct PendingRead {
+      gsl::span<uint8_t> out;
+      size_t bytes;
+      bool some;
+      ReadCallbackFunc cb;
+    };
+
+    void doRead(gsl::span<uint8_t> out, size_t bytes, bool some,
+                ReadCallbackFunc cb);
+
+    void doWrite(gsl::span<const uint8_t> in, size_t bytes,
+                 WriteCallbackFunc cb);
+
+    /// called by the other end
+    void enqueue(Clock::time_point arrival, std::vector<uint8_t> data);
+
+    /// called by the other end, when it is closed
+    void onRemoteClosed();
+
+    /// moves arrived chunks to the receive buffer and rearms the timer
+    void deliver();
+
+    /// completes pending read, if it can be completed
+    void serveRead();
+
+    /// @return duration of sending the given number of bytes
+    std::chrono::nanoseconds transmissionTime(size_t bytes) const;
+
+    boost::asio::io_context &context_;
+    MemoryLinkConfig config_;
+    bool initiator_;
+    multi::Multiaddress local_;
+    multi::Multiaddress remote_;
+    std::weak_ptr<MemoryConnection> other_;
+
+    bool closed_ = false;
+    bool remote_closed_ = false;
+
+    std::deque<uint8_t> received_;
+    std::deque<Chunk> in_flight_;
+    boost::asio::steady_timer delivery_timer_;
+    std::optional<PendingRead> pending_read_;
+
+    /// time, when the outgoing link becomes free
+    Clock::time_point link_free_at_;
+    std::mt19937_64 loss_generator_;
+    std::bernoulli_distribution loss_;
+  };
+
+}  // namespace libp2p::transport
+
+#endif  // LIBP2P_MEMORY_CONNECTION_HPP
@@ -0,0 +1,59 @@
+/**
+ * Copyright Soramitsu Co., Ltd. All Rights Reserved.
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#ifndef LIBP2P_MEMORY_HUB_HPP
+#define LIBP2P_MEMORY_HUB_HPP
+
+#include <memory>
+#include <unordered_map>
+
+#include <libp2p/outcome/outcome.hpp>
+#include <libp2p/transport/memory/memory_connection.hpp>
+
+namespace libp2p::transport {
+
+  /**
+   * Registry of in-memory listeners, which is shared by all memory
+   * transports of the process (or of a simulation), so they can reach each
+   * other by /memory/<id> addresses
+   */
+  class MemoryHub {
+   public:
+    using AcceptFunc =
+        std::function<void(std::shared_ptr<MemoryConnection> responder)>;
+
+    /**
+     * Start accepting connections at the given id
+     * @param id - address of the listener
+     * @param accept - called with the responder end of each new connection
+     * @return error, if the id is taken
+     */
+    outcome::result<void> bind(uint64_t id, AcceptFunc accept);
+
+    /**
+     * Stop accepting connections at the given id
+     */
+    void unbind(uint64_t id);
+
+    /**
+     * @return accept function of the listener at the given id, nullptr if
+     * nobody listens there
+     */
+    AcceptFunc find(uint64_t id) const;
+
+    /**
+     * @return id for the dialing end of a connection, which does not clash
+     * with listeners' ones in practice
+     */
+    uint64_t nextEphemeralId();
+
+   private:
+    std::unordered_map<uint64_t, AcceptFunc> listeners_;
+    uint64_t next_ephemeral_id_ = uint64_t{1} << 63u;
+  };
+
+}  // namespace libp2p::transport
+
+#endif  // LIBP2P_MEMORY_HUB_HPP
@@ -0,0 +1,57 @@
+/**
+ * Copyright Soramitsu Co., Ltd. All Rights Reserved.
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#ifndef LIBP2P_MEMORY_LISTENER_HPP
+#define LIBP2P_MEMORY_LISTENER_HPP
+
+#include <optional>
+
+#include <boost/asio/io_context.hpp>
+#include <libp2p/transport/memory/memory_hub.hpp>
+#include <libp2p/transport/transport_config.hpp>
+#include <libp2p/transport/transport_listener.hpp>
+#include <libp2p/transport/upgrader.hpp>
+
+namespace libp2p::transport {
+
+  /**
+   * @brief Listener of in-memory connections at /memory/<id> address
+   */
+  class MemoryListener : public TransportListener,
+                         public std::enable_shared_from_this<MemoryListener> {
+   public:
+    ~MemoryListener() override;
+
+    MemoryListener(boost::asio::io_context &context,
+                   std::shared_ptr<Upgrader> upgrader,
+                   std::shared_ptr<MemoryHub> hub,
+                   TransportListener::HandlerFunc handler,
+                   TransportConfig config = {});
+
+    outcome::result<void> listen(const multi::Multiaddress &address) override;
+
+    bool canListen(const multi::Multiaddress &ma) const override;
+
+    outcome::result<multi::Multiaddress> getListenMultiaddr() const override;
+
+    bool isClosed() const override;
+
+    outcome::result<void> close() override;
+
+   private:
+    void onAccepted(std::shared_ptr<MemoryConnection> conn);
+
+    boost::asio::io_context &context_;
+    std::shared_ptr<Upgrader> upgrader_;
+    std::shared_ptr<MemoryHub> hub_;
+    TransportListener::HandlerFunc handle_;
+    TransportConfig config_;
+    std::optional<uint64_t> id_;
+    std::optional<multi::Multiaddress> address_;
+  };
+
+}  // namespace libp2p::transport
+
+#endif  // LIBP2P_MEMORY_LISTENER_HPP
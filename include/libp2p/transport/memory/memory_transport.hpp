@@ -0,0 +1,55 @@
+/**
+ * Copyright Soramitsu Co., Ltd. All Rights Reserved.
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#ifndef LIBP2P_MEMORY_TRANSPORT_HPP
+#define LIBP2P_MEMORY_TRANSPORT_HPP
+
+#include <boost/asio/io_context.hpp>
+#include <libp2p/transport/memory/memory_config.hpp>
+#include <libp2p/transport/memory/memory_hub.hpp>
+#include <libp2p/transport/memory/memory_listener.hpp>
+#include <libp2p/transport/transport_adaptor.hpp>
+#include <libp2p/transport/transport_config.hpp>
+#include <libp2p/transport/upgrader.hpp>
+
+namespace libp2p::transport {
+
+  /**
+   * @brief In-process transport, which connects peers sharing the same hub
+   * through /memory/<id> addresses; connections are run on the same
+   * io_context and behave as the link config prescribes
+   */
+  class MemoryTransport : public TransportAdaptor,
+                          public std::enable_shared_from_this<MemoryTransport> {
+   public:
+    ~MemoryTransport() override = default;
+
+    MemoryTransport(std::shared_ptr<boost::asio::io_context> context,
+                    std::shared_ptr<Upgrader> upgrader,
+                    std::shared_ptr<MemoryHub> hub,
+                    MemoryLinkConfig link_config = {},
+                    TransportConfig config = {});
+
+    void dial(const peer::PeerId &remoteId, multi::Multiaddress address,
+              TransportAdaptor::HandlerFunc handler) override;
+
+    std::shared_ptr<TransportListener> createListener(
+        TransportListener::HandlerFunc handler) override;
+
+    bool canDial(const multi::Multiaddress &ma) const override;
+
+    peer::Protocol getProtocolId() const override;
+
+   private:
+    std::shared_ptr<boost::asio::io_context> context_;
+    std::shared_ptr<Upgrader> upgrader_;
+    std::shared_ptr<MemoryHub> hub_;
+    MemoryLinkConfig link_config_;
+    TransportConfig config_;
+  };
+
+}  // namespace libp2p::transport
+
+#endif  // LIBP2P_MEMORY_TRANSPORT_HPP
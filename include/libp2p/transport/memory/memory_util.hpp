@@ -0,0 +1,37 @@
+/**
+ * Copyright Soramitsu Co., Ltd. All Rights Reserved.
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#ifndef LIBP2P_MEMORY_UTIL_HPP
+#define LIBP2P_MEMORY_UTIL_HPP
+
+#include <string>
+
+#include <boost/lexical_cast.hpp>
+#include <libp2p/multi/multiaddress.hpp>
+#include <libp2p/outcome/outcome.hpp>
+
+namespace libp2p::transport::detail {
+
+  inline bool supportsMemory(const multi::Multiaddress &ma) {
+    return ma.hasProtocol(multi::Protocol::Code::MEMORY);
+  }
+
+  inline outcome::result<uint64_t> getMemoryId(const multi::Multiaddress &ma) {
+    OUTCOME_TRY(value,
+                ma.getFirstValueForProtocol(multi::Protocol::Code::MEMORY));
+    try {
+      return boost::lexical_cast<uint64_t>(value);
+    } catch (const boost::bad_lexical_cast & /* ignored */) {
+      return multi::Multiaddress::Error::INVALID_PROTOCOL_VALUE;
+    }
+  }
+
+  inline outcome::result<multi::Multiaddress> makeMemoryAddress(uint64_t id) {
+    return multi::Multiaddress::create("/memory/" + std::to_string(id));
+  }
+
+}  // namespace libp2p::transport::detail
+
+#endif  // LIBP2P_MEMORY_UTIL_HPP
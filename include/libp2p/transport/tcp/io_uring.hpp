@@ -0,0 +1,211 @@
+/**
+ * Copyright Soramitsu Co., Ltd. All Rights Reserved.
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#ifndef LIBP2P_IO_URING_HPP
+#define LIBP2P_IO_URING_HPP
+
+#include <functional>
+#include <memory>
+#include <vector>
+
+#include <boost/asio/io_context.hpp>
+#include <boost/asio/posix/stream_descriptor.hpp>
+#include <boost/noncopyable.hpp>
+#include <gsl/span>
+#include <libp2p/outcome/outcome.hpp>
+#include <libp2p/transport/transport_config.hpp>
+
+struct io_uring_sqe;
+struct io_uring_cqe;
+
+namespace libp2p::transport {
+
+  /**
+   * io_uring instance, which performs reads and writes of sockets and
+   * delivers their completions to the io context: the kernel signals an
+   * eventfd, which is waited for by the context like any other descriptor.
+   *
+   * Submissions, made during one handler of the context, are batched into a
+   * single io_uring_enter call. Reads go to registered buffers while there
+   * are free ones, and are copied to the caller's memory on completion; a
+   * buffer is owned by its read until the kernel completes it, so neither a
+   * canceled read nor a closed socket lets the kernel write into memory,
+   * which is freed or reused. Other reads go straight to the caller's memory,
+   * and data is sent straight from it. If the kernel refuses a submission,
+   * the submitted operations fail with its error.
+   *
+   * All methods must be called from the thread of the io context.
+   */
+  class IoUring : public std::enable_shared_from_this<IoUring>,
+                  private boost::noncopyable {
+   public:
+    using ErrorCode = boost::system::error_code;
+    using Callback = std::function<void(const ErrorCode &, size_t)>;
+
+    /**
+     * Create an instance
+     * @param context - io context, which gets the completions
+     * @param config - sizes of the queue and of the registered buffers
+     * @return the instance or error, if the kernel does not support io_uring
+     */
+    static outcome::result<std::shared_ptr<IoUring>> create(
+        boost::asio::io_context &context, const IoUringConfig &config);
+
+    ~IoUring();
+
+    /**
+     * Receive data from a socket
+     * @param fd - socket
+     * @param out - buffer, which must be alive until the callback is called
+     * @param all - if false, the callback is called after the first received
+     * chunk; otherwise, after the buffer is full
+     * @param cb - gets number of received bytes; boost::asio::error::eof, if
+     * the peer has closed the connection
+     */
+    void recv(int fd, gsl::span<uint8_t> out, bool all, Callback cb);
+
+    /**
+     * Send data to a socket
+     * @param fd - socket
+     * @param in - data, which must be alive until the callback is called
+     * @param all - if false, the callback is called after the first sent
+     * chunk; otherwise, after all the data is sent
+     * @param cb - gets number of sent bytes
+     */
+    void send(int fd, gsl::span<const uint8_t> in, bool all, Callback cb);
+
+    /**
+     * Submit the queued operations at once and cancel the ones of the socket,
+     * so that the socket can be closed right after the call: a submitted
+     * operation holds the file of the socket, not its descriptor, which may
+     * be reused, and a canceled one is not resubmitted
+     * @param fd - socket to be closed; its operations fail with
+     * boost::asio::error::operation_aborted, unless they complete before
+     */
+    void cancel(int fd);
+
+    /// number of io_uring_enter calls, made to submit operations
+    size_t submitCalls() const;
+
+    /// number of registered buffers, which are not owned by reads
+    size_t freeBuffers() const;
+
+   private:
+    struct Operation {
+      Callback cb;
+      int fd = -1;
+      uint8_t *data = nullptr;
+      size_t size = 0;
+      size_t done = 0;
+      bool all = false;
+      bool is_send = false;
+      bool canceled = false;
+      int buffer = -1;
+    };
+
+    struct Ring {
+      int fd = -1;
+      void *sq_ptr = nullptr;
+      size_t sq_size = 0;
+      void *cq_ptr = nullptr;
+      size_t cq_size = 0;
+      io_uring_sqe *sqes = nullptr;
+      size_t sqes_size = 0;
+
+      unsigned *sq_head = nullptr;
+      unsigned *sq_tail = nullptr;
+      unsigned *sq_mask = nullptr;
+      unsigned *sq_entries = nullptr;
+      unsigned *sq_array = nullptr;
+
+      unsigned *cq_head = nullptr;
+      unsigned *cq_tail = nullptr;
+      unsigned *cq_mask = nullptr;
+      io_uring_cqe *cqes = nullptr;
+    };
+
+    IoUring(boost::asio::io_context &context, IoUringConfig config);
+
+    outcome::result<void> init();
+
+    /// put the next step of the operation to the submission queue
+    void enqueue(size_t index);
+
+    /**
+     * Get a free submission queue entry, submitting the queue if it is full
+     * @return nullptr, if the queue stays full
+     */
+    io_uring_sqe *getSqe();
+
+    /// schedule submission of the queued entries after the current handler
+    void scheduleSubmit();
+
+    void submit();
+
+    /// take back the entries, which the kernel has not consumed, and fail
+    /// their operations
+    void failQueued(const ErrorCode &ec);
+
+    /// complete the operation with the error after the current handler
+    void fail(size_t index, const ErrorCode &ec);
+
+    void waitCompletions();
+
+    void drainCompletions();
+
+    void complete(size_t index, int res);
+
+    /// register buffers for reads, if the config asks for them and the
+    /// memory lock limit allows
+    void registerBuffers();
+
+    /// return the registered buffer of the operation to the free ones
+    void releaseBuffer(Operation &op);
+
+    size_t allocOperation();
+
+    boost::asio::io_context &context_;
+    IoUringConfig config_;
+    Ring ring_;
+    boost::asio::posix::stream_descriptor event_;
+    bool waiting_ = false;
+
+    std::vector<Operation> operations_;
+    std::vector<size_t> free_operations_;
+
+    /// registered buffers are mapped apart from the heap: the kernel pins
+    /// their pages until the ring is torn down, which may finish after the
+    /// destructor, and unmapping, unlike freeing to the heap, does not give
+    /// the pinned pages to other allocations
+    uint8_t *buffers_ = nullptr;
+    size_t buffers_size_ = 0;
+    std::vector<int> free_buffers_;
+
+    unsigned to_submit_ = 0;
+    bool submit_scheduled_ = false;
+    size_t submit_calls_ = 0;
+  };
+
+  namespace detail {
+    /**
+     * @return io_uring instance, if it is enabled by the config and supported
+     * by the kernel; nullptr otherwise, so that the asio reactor is used
+     */
+    inline std::shared_ptr<IoUring> makeIoUring(
+        boost::asio::io_context &context, const IoUringConfig &config) {
+      if (!config.enabled) {
+        return nullptr;
+      }
+      auto ring = IoUring::create(context, config);
+      if (!ring) {
+        return nullptr;
+      }
+      return std::move(ring.value());
+    }
+  }  // namespace detail
+
+}  // namespace libp2p::transport
+
+#endif  // LIBP2P_IO_URING_HPP
@@ -8,6 +8,8 @@
 
 #define BOOST_ASIO_NO_DEPRECATED
 
+#include <chrono>
+
 #include <boost/asio.hpp>
 #include <boost/noncopyable.hpp>
 #include <libp2p/connection/raw_connection.hpp>
@@ -15,6 +17,12 @@
 
 namespace libp2p::transport {
 
+  class IoUring;
+
+  namespace detail {
+    class Deadline;
+  }
+
   /**
    * @brief boost::asio implementation of TCP connection (socket).
    */
@@ -33,23 +41,44 @@ namespace libp2p::transport {
     using ConnectCallback = void(const ErrorCode &, const Tcp::endpoint &);
     using ConnectCallbackFunc = std::function<ConnectCallback>;
 
-    explicit TcpConnection(boost::asio::io_context &ctx);
+    /**
+     * @param ctx - io context
+     * @param ring - if set, reads and writes are done through it instead of
+     * the asio reactor
+     */
+    explicit TcpConnection(boost::asio::io_context &ctx,
+                           std::shared_ptr<IoUring> ring = nullptr);
 
-    TcpConnection(boost::asio::io_context &ctx, Tcp::socket &&socket);
+    TcpConnection(boost::asio::io_context &ctx, Tcp::socket &&socket,
+                  std::shared_ptr<IoUring> ring = nullptr);
 
     /**
      * @brief Resolve service name (DNS).
      * @param endpoint endpoint to resolve.
      * @param cb callback executed on operation completion.
+     * @param timeout - if resolution is not finished in that time, it is
+     * cancelled and callback gets boost::asio::error::timed_out; zero means no
+     * deadline
      */
-    void resolve(const Tcp::endpoint &endpoint, ResolveCallbackFunc cb);
+    void resolve(const Tcp::endpoint &endpoint, ResolveCallbackFunc cb,
+                 std::chrono::milliseconds timeout =
+                     std::chrono::milliseconds::zero());
 
     /**
      * @brief Connect to a remote service.
      * @param iterator list of resolved IP addresses of remote service.
      * @param cb callback executed on operation completion.
+     * @param timeout - if connection is not established in that time, the
+     * socket is closed and callback gets boost::asio::error::timed_out; zero
+     * means no deadline
+     * @param fast_open - use TCP Fast Open: the connection is reported as
+     * established at once, if there is a cookie for the remote, and the
+     * handshake is completed with the first write
      */
-    void connect(const ResolverResultsType &iterator, ConnectCallbackFunc cb);
+    void connect(const ResolverResultsType &iterator, ConnectCallbackFunc cb,
+                 std::chrono::milliseconds timeout =
+                     std::chrono::milliseconds::zero(),
+                 bool fast_open = false);
 
     void read(gsl::span<uint8_t> out, size_t bytes,
               ReadCallbackFunc cb) override;
@@ -74,8 +103,15 @@ namespace libp2p::transport {
     bool isClosed() const override;
 
    private:
+    /// try endpoints one by one, enabling Fast Open on each socket
+    void connectFastOpen(ResolverResultsType results,
+                         ResolverResultsType::const_iterator it,
+                         std::shared_ptr<detail::Deadline> deadline,
+                         ConnectCallbackFunc cb);
+
     boost::asio::io_context &context_;
     Tcp::socket socket_;
+    std::shared_ptr<IoUring> ring_;
     bool initiator_ = false;
 
     boost::system::error_code handle_errcode(
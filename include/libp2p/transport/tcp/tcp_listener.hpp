@@ -7,8 +7,11 @@
 #define LIBP2P_TCP_LISTENER_HPP
 
 #include <boost/asio.hpp>
+#include <libp2p/network/connection_gater.hpp>
+#include <libp2p/transport/impl/admission_control.hpp>
 #include <libp2p/transport/tcp/tcp_connection.hpp>
 #include <libp2p/transport/tcp/tcp_util.hpp>
+#include <libp2p/transport/transport_config.hpp>
 #include <libp2p/transport/transport_listener.hpp>
 #include <libp2p/transport/upgrader.hpp>
 
@@ -22,9 +25,19 @@ namespace libp2p::transport {
    public:
     ~TcpListener() override = default;
 
+    /**
+     * @param context - io_context of the sockets
+     * @param upgrader of the accepted connections
+     * @param handler of the upgraded connections
+     * @param config of the transport
+     * @param gater, which may drop the connections at once after they are
+     * accepted; may be null
+     */
     TcpListener(boost::asio::io_context &context,
                 std::shared_ptr<Upgrader> upgrader,
-                TransportListener::HandlerFunc handler);
+                TransportListener::HandlerFunc handler,
+                TransportConfig config = {},
+                std::shared_ptr<network::ConnectionGater> gater = nullptr);
 
     outcome::result<void> listen(const multi::Multiaddress &address) override;
 
@@ -36,11 +49,21 @@ namespace libp2p::transport {
 
     outcome::result<void> close() override;
 
+    /**
+     * @return how many inbound connections were accepted, throttled and
+     * rejected by the admission control
+     */
+    const AdmissionControl::Stats &getAdmissionStats() const;
+
    private:
     boost::asio::io_context &context_;
     boost::asio::ip::tcp::acceptor acceptor_;
     std::shared_ptr<Upgrader> upgrader_;
     TransportListener::HandlerFunc handle_;
+    TransportConfig config_;
+    std::shared_ptr<AdmissionControl> admission_;
+    std::shared_ptr<network::ConnectionGater> gater_;
+    std::shared_ptr<IoUring> ring_;
 
     void doAccept();
   };
@@ -12,6 +12,7 @@
 #include <libp2p/transport/tcp/tcp_listener.hpp>
 #include <libp2p/transport/tcp/tcp_util.hpp>
 #include <libp2p/transport/transport_adaptor.hpp>
+#include <libp2p/transport/transport_config.hpp>
 #include <libp2p/transport/upgrader.hpp>
 
 namespace libp2p::transport {
@@ -24,8 +25,17 @@ namespace libp2p::transport {
    public:
     ~TcpTransport() override = default;
 
+    /**
+     * @param context - io_context of the sockets
+     * @param upgrader of the connections
+     * @param config of the transport
+     * @param gater, which is consulted before a peer is dialed and is passed
+     * to the listeners; may be null
+     */
     TcpTransport(std::shared_ptr<boost::asio::io_context> context,
-                 std::shared_ptr<Upgrader> upgrader);
+                 std::shared_ptr<Upgrader> upgrader,
+                 TransportConfig config = {},
+                 std::shared_ptr<network::ConnectionGater> gater = nullptr);
 
     void dial(const peer::PeerId &remoteId, multi::Multiaddress address,
               TransportAdaptor::HandlerFunc handler) override;
@@ -40,6 +50,9 @@ namespace libp2p::transport {
    private:
     std::shared_ptr<boost::asio::io_context> context_;
     std::shared_ptr<Upgrader> upgrader_;
+    TransportConfig config_;
+    std::shared_ptr<network::ConnectionGater> gater_;
+    std::shared_ptr<IoUring> ring_;
   };  // namespace libp2p::transport
 
 }  // namespace libp2p::transport
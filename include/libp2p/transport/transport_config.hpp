@@ -0,0 +1,98 @@
+/**
+ * Copyright Soramitsu Co., Ltd. All Rights Reserved.
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#ifndef LIBP2P_TRANSPORT_CONFIG_HPP
+#define LIBP2P_TRANSPORT_CONFIG_HPP
+
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+
+namespace libp2p::transport {
+
+  /**
+   * Limits, which a listener applies to inbound connections before upgrading
+   * them
+   * @note zero limit means no limit
+   */
+  struct AdmissionConfig {
+    /// how many inbound connections may be upgraded simultaneously
+    size_t max_concurrent_upgrades = 256;
+
+    /// how many accepted inbound connections may be open simultaneously
+    size_t max_inbound_connections = 0;
+
+    /// how many connections a single IP address may open per rate_interval
+    size_t ip_rate_limit = 0;
+
+    /// how many connections a single subnet may open per rate_interval
+    size_t subnet_rate_limit = 0;
+
+    /// window of the rate limits
+    std::chrono::milliseconds rate_interval = std::chrono::seconds(1);
+
+    /// prefix length of IPv4 subnets for subnet_rate_limit
+    uint8_t ipv4_subnet_prefix = 24;
+
+    /// prefix length of IPv6 subnets for subnet_rate_limit
+    uint8_t ipv6_subnet_prefix = 48;
+  };
+
+  /**
+   * Config of the io_uring backend of TCP connections; it takes effect only
+   * if the library is built with IO_URING option, and the kernel supports
+   * io_uring; otherwise connections use the asio reactor
+   */
+  struct IoUringConfig {
+    /// use io_uring for reads and writes of TCP connections
+    bool enabled = false;
+
+    /// size of the submission queue
+    uint32_t entries = 256;
+
+    /// how many buffers are registered in the kernel for reads; a read,
+    /// which finds no free registered buffer, goes to the caller's memory
+    uint32_t registered_buffers = 64;
+
+    /// size of each registered buffer
+    size_t buffer_size = 16 * 1024;
+  };
+
+  /**
+   * Config of transports and of the upgrade pipeline, which turns their raw
+   * connections into capable ones
+   * @note zero timeout means the phase has no deadline
+   */
+  struct TransportConfig {
+    /// how long DNS resolution of the dialed address may take
+    std::chrono::milliseconds resolve_timeout = std::chrono::seconds(10);
+
+    /// how long establishment of the raw connection may take
+    std::chrono::milliseconds connect_timeout = std::chrono::seconds(10);
+
+    /// how long security protocol negotiation and handshake may take
+    std::chrono::milliseconds security_timeout = std::chrono::seconds(15);
+
+    /// how long muxer protocol negotiation and setup may take
+    std::chrono::milliseconds muxer_timeout = std::chrono::seconds(10);
+
+    /// limits of inbound connections
+    AdmissionConfig admission;
+
+    /// backend of TCP connections' reads and writes
+    IoUringConfig io_uring;
+
+    /// use TCP Fast Open, so that the first bytes of dialed connections ride
+    /// the SYN, if the remote has given a cookie before; the kernel must
+    /// allow it by net.ipv4.tcp_fastopen, otherwise ordinary handshake is done
+    bool tcp_fast_open = false;
+
+    /// how many pending Fast Open requests a TCP listener keeps
+    int tcp_fast_open_queue = 256;
+  };
+
+}  // namespace libp2p::transport
+
+#endif  // LIBP2P_TRANSPORT_CONFIG_HPP
@@ -0,0 +1,32 @@
+/**
+ * Copyright Soramitsu Co., Ltd. All Rights Reserved.
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#ifndef LIBP2P_UNIX_CONFIG_HPP
+#define LIBP2P_UNIX_CONFIG_HPP
+
+#include <cstdint>
+#include <vector>
+
+namespace libp2p::transport {
+
+  /**
+   * Config of the unix domain socket transport
+   */
+  struct UnixConfig {
+    /// if set, connections to trusted local processes are not negotiated and
+    /// run the plaintext exchange straight away; both ends must trust each
+    /// other, otherwise the handshake fails
+    bool skip_security_for_trusted = false;
+
+    /// processes of the same user are trusted
+    bool trust_same_user = true;
+
+    /// processes of these users are trusted as well
+    std::vector<uint32_t> trusted_uids;
+  };
+
+}  // namespace libp2p::transport
+
+#endif  // LIBP2P_UNIX_CONFIG_HPP
@@ -0,0 +1,104 @@
+/**
+ * Copyright Soramitsu Co., Ltd. All Rights Reserved.
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#ifndef LIBP2P_UNIX_CONNECTION_HPP
+#define LIBP2P_UNIX_CONNECTION_HPP
+
+#define BOOST_ASIO_NO_DEPRECATED
+
+#include <chrono>
+#include <optional>
+
+#include <boost/asio.hpp>
+#include <boost/noncopyable.hpp>
+#include <libp2p/connection/raw_connection.hpp>
+#include <libp2p/multi/multiaddress.hpp>
+
+namespace libp2p::transport {
+
+  /**
+   * Raw connection over a unix domain socket
+   */
+  class UnixConnection : public connection::RawConnection,
+                         public std::enable_shared_from_this<UnixConnection>,
+                         private boost::noncopyable {
+   public:
+    using Protocol = boost::asio::local::stream_protocol;
+    using ErrorCode = boost::system::error_code;
+    using ConnectCallback = void(const ErrorCode &);
+    using ConnectCallbackFunc = std::function<ConnectCallback>;
+
+    /// identity of the process at the other end of the socket
+    struct Credentials {
+      int32_t pid;
+      uint32_t uid;
+      uint32_t gid;
+    };
+
+    ~UnixConnection() override = default;
+
+    /**
+     * Create a connection to be connected
+     * @param ctx - io context
+     * @param address - address of the listener, which is reported both as
+     * local and remote one, since the dialing end is unnamed
+     */
+    UnixConnection(boost::asio::io_context &ctx, multi::Multiaddress address);
+
+    /**
+     * Create an accepted connection
+     */
+    UnixConnection(boost::asio::io_context &ctx, Protocol::socket &&socket,
+                   multi::Multiaddress address);
+
+    /**
+     * @brief Connect to the listener
+     * @param endpoint - path of the listener's socket
+     * @param cb - callback executed on operation completion; gets
+     * boost::asio::error::timed_out, if the connection was not established in
+     * time
+     * @param timeout - time, given to the operation; zero means no deadline
+     */
+    void connect(const Protocol::endpoint &endpoint, ConnectCallbackFunc cb,
+                 std::chrono::milliseconds timeout =
+                     std::chrono::milliseconds::zero());
+
+    /**
+     * @return credentials of the peer process, as the kernel reports them;
+     * none, if the platform does not support it
+     */
+    std::optional<Credentials> peerCredentials();
+
+    void read(gsl::span<uint8_t> out, size_t bytes,
+              ReadCallbackFunc cb) override;
+
+    void readSome(gsl::span<uint8_t> out, size_t bytes,
+                  ReadCallbackFunc cb) override;
+
+    void write(gsl::span<const uint8_t> in, size_t bytes,
+               WriteCallbackFunc cb) override;
+
+    void writeSome(gsl::span<const uint8_t> in, size_t bytes,
+                   WriteCallbackFunc cb) override;
+
+    outcome::result<multi::Multiaddress> remoteMultiaddr() override;
+
+    outcome::result<multi::Multiaddress> localMultiaddr() override;
+
+    bool isInitiator() const noexcept override;
+
+    outcome::result<void> close() override;
+
+    bool isClosed() const override;
+
+   private:
+    boost::asio::io_context &context_;
+    Protocol::socket socket_;
+    multi::Multiaddress address_;
+    bool initiator_ = false;
+  };
+}  // namespace libp2p::transport
+
+#endif  // LIBP2P_UNIX_CONNECTION_HPP
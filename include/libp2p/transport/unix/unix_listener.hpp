@@ -0,0 +1,70 @@
+/**
+ * Copyright Soramitsu Co., Ltd. All Rights Reserved.
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#ifndef LIBP2P_UNIX_LISTENER_HPP
+#define LIBP2P_UNIX_LISTENER_HPP
+
+#include <optional>
+
+#include <boost/asio.hpp>
+#include <libp2p/security/security_adaptor.hpp>
+#include <libp2p/transport/transport_config.hpp>
+#include <libp2p/transport/transport_listener.hpp>
+#include <libp2p/transport/unix/unix_config.hpp>
+#include <libp2p/transport/unix/unix_connection.hpp>
+#include <libp2p/transport/upgrader.hpp>
+
+namespace libp2p::transport {
+
+  /**
+   * @brief Unix domain socket listener; removes its socket file on close
+   */
+  class UnixListener : public TransportListener,
+                       public std::enable_shared_from_this<UnixListener> {
+   public:
+    ~UnixListener() override;
+
+    /**
+     * @param context - io context
+     * @param upgrader - upgrader of accepted connections
+     * @param trusted_security - adaptor, which is used without negotiation for
+     * trusted peers, if config allows
+     * @param handler - called with each upgraded connection
+     * @param unix_config - config of the unix transport
+     * @param config - config of the upgrade pipeline
+     */
+    UnixListener(boost::asio::io_context &context,
+                 std::shared_ptr<Upgrader> upgrader,
+                 std::shared_ptr<security::SecurityAdaptor> trusted_security,
+                 TransportListener::HandlerFunc handler,
+                 UnixConfig unix_config = {}, TransportConfig config = {});
+
+    outcome::result<void> listen(const multi::Multiaddress &address) override;
+
+    bool canListen(const multi::Multiaddress &ma) const override;
+
+    outcome::result<multi::Multiaddress> getListenMultiaddr() const override;
+
+    bool isClosed() const override;
+
+    outcome::result<void> close() override;
+
+   private:
+    boost::asio::io_context &context_;
+    boost::asio::local::stream_protocol::acceptor acceptor_;
+    std::shared_ptr<Upgrader> upgrader_;
+    std::shared_ptr<security::SecurityAdaptor> trusted_security_;
+    TransportListener::HandlerFunc handle_;
+    UnixConfig unix_config_;
+    TransportConfig config_;
+    std::optional<multi::Multiaddress> address_;
+    std::string path_;
+
+    void doAccept();
+  };
+
+}  // namespace libp2p::transport
+
+#endif  // LIBP2P_UNIX_LISTENER_HPP
@@ -0,0 +1,62 @@
+/**
+ * Copyright Soramitsu Co., Ltd. All Rights Reserved.
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#ifndef LIBP2P_UNIX_TRANSPORT_HPP
+#define LIBP2P_UNIX_TRANSPORT_HPP
+
+#define BOOST_ASIO_NO_DEPRECATED
+
+#include <boost/asio.hpp>
+#include <libp2p/security/plaintext.hpp>
+#include <libp2p/transport/transport_adaptor.hpp>
+#include <libp2p/transport/transport_config.hpp>
+#include <libp2p/transport/unix/unix_config.hpp>
+#include <libp2p/transport/unix/unix_listener.hpp>
+#include <libp2p/transport/upgrader.hpp>
+
+namespace libp2p::transport {
+
+  /**
+   * @brief Transport over unix domain sockets, for nodes on the same host;
+   * peers, trusted by their credentials, may skip security negotiation
+   */
+  class UnixTransport : public TransportAdaptor,
+                        public std::enable_shared_from_this<UnixTransport> {
+   public:
+    ~UnixTransport() override = default;
+
+    /**
+     * @param context - io context
+     * @param upgrader - upgrader of connections
+     * @param trusted_security - adaptor to be used for trusted peers
+     * @param unix_config - config of the transport
+     * @param config - config of the upgrade pipeline
+     */
+    UnixTransport(std::shared_ptr<boost::asio::io_context> context,
+                  std::shared_ptr<Upgrader> upgrader,
+                  std::shared_ptr<security::Plaintext> trusted_security,
+                  UnixConfig unix_config = {}, TransportConfig config = {});
+
+    void dial(const peer::PeerId &remoteId, multi::Multiaddress address,
+              TransportAdaptor::HandlerFunc handler) override;
+
+    std::shared_ptr<TransportListener> createListener(
+        TransportListener::HandlerFunc handler) override;
+
+    bool canDial(const multi::Multiaddress &ma) const override;
+
+    peer::Protocol getProtocolId() const override;
+
+   private:
+    std::shared_ptr<boost::asio::io_context> context_;
+    std::shared_ptr<Upgrader> upgrader_;
+    std::shared_ptr<security::Plaintext> trusted_security_;
+    UnixConfig unix_config_;
+    TransportConfig config_;
+  };
+
+}  // namespace libp2p::transport
+
+#endif  // LIBP2P_UNIX_TRANSPORT_HPP
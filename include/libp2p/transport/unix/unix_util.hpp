@@ -0,0 +1,68 @@
+/**
+ * Copyright Soramitsu Co., Ltd. All Rights Reserved.
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#ifndef LIBP2P_UNIX_UTIL_HPP
+#define LIBP2P_UNIX_UTIL_HPP
+
+#include <algorithm>
+#include <string>
+#include <system_error>  // for std::errc
+
+#include <unistd.h>
+
+#include <boost/asio/local/stream_protocol.hpp>
+#include <libp2p/multi/multiaddress.hpp>
+#include <libp2p/outcome/outcome.hpp>
+#include <libp2p/transport/unix/unix_config.hpp>
+#include <libp2p/transport/unix/unix_connection.hpp>
+
+namespace libp2p::transport::detail {
+
+  inline bool supportsUnix(const multi::Multiaddress &ma) {
+    return ma.hasProtocol(multi::Protocol::Code::UNIX);
+  }
+
+  inline outcome::result<boost::asio::local::stream_protocol::endpoint>
+  makeUnixEndpoint(const multi::Multiaddress &ma) {
+    auto v = ma.getProtocolsWithValues();
+    if (v.empty() || v.front().first.code != multi::Protocol::Code::UNIX
+        || v.front().second.empty()) {
+      return std::errc::address_family_not_supported;
+    }
+    return boost::asio::local::stream_protocol::endpoint{"/"
+                                                         + v.front().second};
+  }
+
+  inline outcome::result<multi::Multiaddress> makeUnixAddress(
+      const std::string &path) {
+    if (path.empty() || path.front() != '/') {
+      return multi::Multiaddress::create("/unix/" + path);
+    }
+    return multi::Multiaddress::create("/unix" + path);
+  }
+
+  /**
+   * @return true, if security of the connection may be skipped, as the peer
+   * process is trusted by the config
+   */
+  inline bool skipsSecurity(UnixConnection &conn, const UnixConfig &config) {
+    if (!config.skip_security_for_trusted) {
+      return false;
+    }
+    auto credentials = conn.peerCredentials();
+    if (!credentials) {
+      return false;
+    }
+    if (config.trust_same_user && credentials->uid == getuid()) {
+      return true;
+    }
+    return std::find(config.trusted_uids.begin(), config.trusted_uids.end(),
+                     credentials->uid)
+        != config.trusted_uids.end();
+  }
+
+}  // namespace libp2p::transport::detail
+
+#endif  // LIBP2P_UNIX_UTIL_HPP
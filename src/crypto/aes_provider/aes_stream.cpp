@@ -0,0 +1,160 @@
+/**
+ * Copyright Soramitsu Co., Ltd. All Rights Reserved.
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <libp2p/crypto/aes_provider/aes_stream.hpp>
+
+#include <climits>
+
+#include <openssl/evp.h>
+#include <libp2p/crypto/error.hpp>
+
+namespace libp2p::crypto::aes {
+
+  namespace {
+    /// the largest part of the data, which is given to OpenSSL at once
+    constexpr size_t kMaxChunk = INT_MAX & ~size_t{15};
+
+    int enc(Mode mode) {
+      return mode == Mode::ENCRYPT ? 1 : 0;
+    }
+
+  }  // namespace
+
+  void AesStream::CtxDeleter::operator()(evp_cipher_ctx_st *ctx) const {
+    EVP_CIPHER_CTX_free(ctx);
+  }
+
+  AesStream::AesStream(Ctx ctx, Mode mode)
+      : ctx_{std::move(ctx)}, mode_{mode} {}
+
+  AesStream::AesStream(AesStream &&other) noexcept = default;
+
+  AesStream &AesStream::operator=(AesStream &&other) noexcept = default;
+
+  AesStream::~AesStream() = default;
+
+  outcome::result<AesStream::Ctx> AesStream::makeCtx(const EVP_CIPHER *cipher,
+                                                     const uint8_t *key,
+                                                     const uint8_t *iv,
+                                                     Mode mode) {
+    Ctx ctx{EVP_CIPHER_CTX_new()};
+    if (!ctx) {
+      return OpenSslError::FAILED_INITIALIZE_CONTEXT;
+    }
+    if (1
+        != EVP_CipherInit_ex(ctx.get(), cipher, nullptr, key, iv,
+                             enc(mode))) {
+      return OpenSslError::FAILED_INITIALIZE_OPERATION;
+    }
+    return ctx;
+  }
+
+  Mode AesStream::mode() const {
+    return mode_;
+  }
+
+  outcome::result<size_t> AesStream::update(gsl::span<const uint8_t> in,
+                                            gsl::span<uint8_t> out) {
+    if (out.size() < in.size()) {
+      return std::errc::no_buffer_space;
+    }
+    size_t written = 0;
+    while (written < static_cast<size_t>(in.size())) {
+      auto chunk = std::min(in.size() - written, kMaxChunk);
+      int len = 0;
+      if (1
+          != EVP_CipherUpdate(ctx_.get(), out.data() + written, &len,
+                              in.data() + written, static_cast<int>(chunk))) {
+        return mode_ == Mode::ENCRYPT ? OpenSslError::FAILED_ENCRYPT_UPDATE
+                                      : OpenSslError::FAILED_DECRYPT_UPDATE;
+      }
+      written += len;
+    }
+    return written;
+  }
+
+  outcome::result<void> AesStream::update(gsl::span<uint8_t> data) {
+    OUTCOME_TRY(update(data, data));
+    return outcome::success();
+  }
+
+  outcome::result<AesCtr> AesCtr::create(const Aes128Secret &secret,
+                                         Mode mode) {
+    OUTCOME_TRY(ctx, makeCtx(EVP_aes_128_ctr(), secret.key.data(),
+                             secret.iv.data(), mode));
+    return AesCtr{std::move(ctx), mode};
+  }
+
+  outcome::result<AesCtr> AesCtr::create(const Aes256Secret &secret,
+                                         Mode mode) {
+    OUTCOME_TRY(ctx, makeCtx(EVP_aes_256_ctr(), secret.key.data(),
+                             secret.iv.data(), mode));
+    return AesCtr{std::move(ctx), mode};
+  }
+
+  outcome::result<AesGcm> AesGcm::create(gsl::span<const uint8_t> key,
+                                         Mode mode) {
+    const EVP_CIPHER *cipher = nullptr;
+    switch (key.size()) {
+      case 16:
+        cipher = EVP_aes_128_gcm();
+        break;
+      case 32:
+        cipher = EVP_aes_256_gcm();
+        break;
+      default:
+        return OpenSslError::WRONG_KEY_SIZE;
+    }
+    OUTCOME_TRY(ctx, makeCtx(cipher, key.data(), nullptr, mode));
+    return AesGcm{std::move(ctx), mode};
+  }
+
+  outcome::result<void> AesGcm::begin(gsl::span<const uint8_t> iv,
+                                      gsl::span<const uint8_t> ad) {
+    if (iv.size() != kIvSize) {
+      return OpenSslError::WRONG_IV_SIZE;
+    }
+    if (1
+        != EVP_CipherInit_ex(ctx_.get(), nullptr, nullptr, nullptr, iv.data(),
+                             enc(mode_))) {
+      return OpenSslError::FAILED_INITIALIZE_OPERATION;
+    }
+    int len = 0;
+    if (!ad.empty()
+        && 1
+            != EVP_CipherUpdate(ctx_.get(), nullptr, &len, ad.data(),
+                                static_cast<int>(ad.size()))) {
+      return mode_ == Mode::ENCRYPT ? OpenSslError::FAILED_ENCRYPT_UPDATE
+                                    : OpenSslError::FAILED_DECRYPT_UPDATE;
+    }
+    return outcome::success();
+  }
+
+  outcome::result<void> AesGcm::finish(gsl::span<uint8_t> tag) {
+    if (tag.size() != kTagSize) {
+      return OpenSslError::WRONG_TAG_SIZE;
+    }
+    // GCM produces no output on finalization
+    uint8_t unused[EVP_MAX_BLOCK_LENGTH];
+    int len = 0;
+    if (mode_ == Mode::ENCRYPT) {
+      if (1 != EVP_CipherFinal_ex(ctx_.get(), unused, &len)
+          || 1
+              != EVP_CIPHER_CTX_ctrl(ctx_.get(), EVP_CTRL_AEAD_GET_TAG,
+                                     kTagSize, tag.data())) {
+        return OpenSslError::FAILED_ENCRYPT_FINALIZE;
+      }
+      return outcome::success();
+    }
+    if (1
+            != EVP_CIPHER_CTX_ctrl(ctx_.get(), EVP_CTRL_AEAD_SET_TAG, kTagSize,
+                                   tag.data())
+        || 1 != EVP_CipherFinal_ex(ctx_.get(), unused, &len)) {
+      return OpenSslError::FAILED_DECRYPT_FINALIZE;
+    }
+    return outcome::success();
+  }
+
+}  // namespace libp2p::crypto::aes
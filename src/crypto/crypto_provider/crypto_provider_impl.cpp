@@ -5,9 +5,12 @@
 
 #include <libp2p/crypto/crypto_provider/crypto_provider_impl.hpp>
 
+#include <algorithm>
 #include <exception>
 #include <iostream>
 
+#include <openssl/ec.h>
+#include <openssl/ecdh.h>
 #include <openssl/err.h>
 #include <openssl/evp.h>
 #include <openssl/rand.h>
@@ -16,16 +19,21 @@
 #include <gsl/gsl_util>
 #include <gsl/pointers>
 #include <gsl/span>
+#include <libp2p/crypto/common_functions.hpp>
 #include <libp2p/crypto/ed25519_provider.hpp>
 #include <libp2p/crypto/error.hpp>
+#include <libp2p/crypto/hmac_provider/hmac_stream.hpp>
 #include <libp2p/crypto/random_generator.hpp>
+#include <libp2p/crypto/sha/sha256.hpp>
 
 namespace libp2p::crypto {
   CryptoProviderImpl::CryptoProviderImpl(
       std::shared_ptr<random::CSPRNG> random_provider,
-      std::shared_ptr<ed25519::Ed25519Provider> ed25519_provider)
+      std::shared_ptr<ed25519::Ed25519Provider> ed25519_provider,
+      std::shared_ptr<metrics::Registry> registry)
       : random_provider_{std::move(random_provider)},
-        ed25519_provider_{std::move(ed25519_provider)} {
+        ed25519_provider_{std::move(ed25519_provider)},
+        ephemeral_keys_{kEphemeralKeyPoolSize, std::move(registry)} {
     initialize();
   }
 
@@ -204,6 +212,44 @@ namespace libp2p::crypto {
 
       return {std::move(public_bytes), std::move(private_bytes)};
     }
+
+    /**
+     * Verify ECDSA signature of SHA-256 of the message. The key is either a
+     * point on the curve (compressed, as generated by this provider, or
+     * uncompressed), or a DER-encoded PKIX key, as the libp2p spec sends
+     * ECDSA keys
+     */
+    outcome::result<bool> verifyEcdsa256WithCurve(
+        gsl::span<const uint8_t> message, gsl::span<const uint8_t> signature,
+        const PublicKey &key, int curve_nid) {
+      constexpr auto FAILED{CryptoProviderError::SIGNATURE_VERIFICATION_FAILED};
+      constexpr uint8_t kDerSequenceTag = 0x30;
+
+      const uint8_t *data_pointer = key.data.data();
+      std::shared_ptr<EC_KEY> ec_key;
+      if (!key.data.empty() && key.data[0] == kDerSequenceTag) {
+        ec_key.reset(d2i_EC_PUBKEY(nullptr, &data_pointer, key.data.size()),
+                     EC_KEY_free);
+        if (nullptr == ec_key
+            || EC_GROUP_get_curve_name(EC_KEY_get0_group(ec_key.get()))
+                != curve_nid) {
+          return FAILED;
+        }
+      } else {
+        ec_key.reset(EC_KEY_new_by_curve_name(curve_nid), EC_KEY_free);
+        if (nullptr == ec_key) {
+          return FAILED;
+        }
+        EC_KEY *key_pointer = ec_key.get();
+        if (nullptr
+            == o2i_ECPublicKey(&key_pointer, &data_pointer, key.data.size())) {
+          return FAILED;
+        }
+      }
+
+      auto digest = sha256(message);
+      return VerifyEcSignature(digest, signature, ec_key);
+    }
   }  // namespace detail
 
   outcome::result<KeyPair> CryptoProviderImpl::generateKeys(
@@ -386,15 +432,86 @@ namespace libp2p::crypto {
   outcome::result<bool> CryptoProviderImpl::verify(
       gsl::span<uint8_t> message, gsl::span<uint8_t> signature,
       const PublicKey &public_key) const {
+    auto entry = VerificationCache::makeEntry(message, signature, public_key);
+    if (verification_cache_.contains(entry)) {
+      return true;
+    }
+    OUTCOME_TRY(valid, verifyUncached(message, signature, public_key));
+    if (valid) {
+      verification_cache_.insert(entry);
+    }
+    return valid;
+  }
+
+  std::vector<bool> CryptoProviderImpl::verifyBatch(
+      gsl::span<const SignedMessage> messages) const {
+    std::vector<bool> results(messages.size(), false);
+    std::vector<VerificationCache::Entry> entries;
+    entries.reserve(messages.size());
+
+    // Ed25519 signatures, which are not in the cache, are verified together;
+    // others are verified one by one
+    std::vector<ed25519::SignedMessage> ed_batch;
+    std::vector<size_t> ed_indices;
+    for (size_t i = 0; i < static_cast<size_t>(messages.size()); ++i) {
+      const auto &msg = messages[i];
+      const PublicKey &key = msg.public_key;
+      entries.push_back(
+          VerificationCache::makeEntry(msg.message, msg.signature, key));
+      if (verification_cache_.contains(entries.back())) {
+        results[i] = true;
+        continue;
+      }
+
+      if (key.type == Key::Type::Ed25519) {
+        ed25519::SignedMessage ed_msg{msg.message, {}, {}};
+        if (static_cast<size_t>(msg.signature.size())
+                != ed_msg.signature.size()
+            || key.data.size() != ed_msg.public_key.size()) {
+          continue;
+        }
+        std::copy(msg.signature.begin(), msg.signature.end(),
+                  ed_msg.signature.begin());
+        std::copy(key.data.begin(), key.data.end(), ed_msg.public_key.begin());
+        ed_batch.push_back(ed_msg);
+        ed_indices.push_back(i);
+        continue;
+      }
+
+      auto valid = verifyUncached(msg.message, msg.signature, key);
+      if (valid && valid.value()) {
+        results[i] = true;
+        verification_cache_.insert(entries[i]);
+      }
+    }
+
+    if (!ed_batch.empty()) {
+      if (auto ed_results = ed25519_provider_->verifyBatch(ed_batch)) {
+        for (size_t j = 0; j < ed_indices.size(); ++j) {
+          if (ed_results.value()[j]) {
+            results[ed_indices[j]] = true;
+            verification_cache_.insert(entries[ed_indices[j]]);
+          }
+        }
+      }
+    }
+    return results;
+  }
+
+  outcome::result<bool> CryptoProviderImpl::verifyUncached(
+      gsl::span<const uint8_t> message, gsl::span<const uint8_t> signature,
+      const PublicKey &public_key) const {
     switch (public_key.type) {
       case Key::Type::RSA:
         return CryptoProviderError::SIGNATURE_VERIFICATION_FAILED;
       case Key::Type::Ed25519:
         return verifyEd25519(message, signature, public_key);
       case Key::Type::Secp256k1:
-        return CryptoProviderError::SIGNATURE_VERIFICATION_FAILED;
+        return detail::verifyEcdsa256WithCurve(message, signature, public_key,
+                                               NID_secp256k1);
       case Key::Type::ECDSA:
-        return CryptoProviderError::SIGNATURE_VERIFICATION_FAILED;
+        return detail::verifyEcdsa256WithCurve(message, signature, public_key,
+                                               NID_X9_62_prime256v1);
       case Key::Type::UNSPECIFIED:
         return KeyGeneratorError::WRONG_KEY_TYPE;
       default:
@@ -403,12 +520,15 @@ namespace libp2p::crypto {
   }
 
   outcome::result<bool> CryptoProviderImpl::verifyEd25519(
-      gsl::span<uint8_t> message, gsl::span<uint8_t> signature,
+      gsl::span<const uint8_t> message, gsl::span<const uint8_t> signature,
       const PublicKey &public_key) const {
-    ed25519::PrivateKey ed_pub;
-    std::copy_n(public_key.data.begin(), ed_pub.size(), ed_pub.begin());
-
+    ed25519::PublicKey ed_pub;
     ed25519::Signature ed_sig;
+    if (public_key.data.size() != ed_pub.size()
+        || static_cast<size_t>(signature.size()) != ed_sig.size()) {
+      return false;
+    }
+    std::copy_n(public_key.data.begin(), ed_pub.size(), ed_pub.begin());
     std::copy_n(signature.begin(), ed_sig.size(), ed_sig.begin());
 
     OUTCOME_TRY(result, ed25519_provider_->verify(message, ed_sig, ed_pub));
@@ -417,14 +537,98 @@ namespace libp2p::crypto {
 
   outcome::result<EphemeralKeyPair>
   CryptoProviderImpl::generateEphemeralKeyPair(common::CurveType curve) const {
-    // TODO(yuraz): pre-140 implement
-    return KeyGeneratorError::KEY_GENERATION_FAILED;
+    OUTCOME_TRY(ec_key, ephemeral_keys_.take(curve));
+    return EphemeralKeyPair{
+        std::move(ec_key.public_key),
+        [key{std::move(ec_key.key)}](gsl::span<const uint8_t> remote_public)
+            -> outcome::result<Buffer> {
+          const EC_GROUP *group = EC_KEY_get0_group(key.get());
+          std::unique_ptr<EC_POINT, void (*)(EC_POINT *)> point{
+              EC_POINT_new(group), EC_POINT_free};
+          if (nullptr == point
+              || 1
+                  != EC_POINT_oct2point(group, point.get(),
+                                        remote_public.data(),
+                                        remote_public.size(), nullptr)) {
+            return KeyValidatorError::INVALID_PUBLIC_KEY;
+          }
+          // the secret is the x coordinate, padded to the field size
+          Buffer secret((EC_GROUP_get_degree(group) + 7) / 8, 0);
+          if (ECDH_compute_key(secret.data(), secret.size(), point.get(),
+                               key.get(), nullptr)
+              != static_cast<int>(secret.size())) {
+            return KeyGeneratorError::KEY_DERIVATION_FAILED;
+          }
+          return secret;
+        }};
+  }
+
+  outcome::result<X25519KeyPair>
+  CryptoProviderImpl::generateEphemeralX25519KeyPair() const {
+    return ephemeral_keys_.takeX25519();
+  }
+
+  EphemeralKeyPool::Stats CryptoProviderImpl::ephemeralKeyPoolStats() const {
+    return ephemeral_keys_.stats();
   }
 
   std::vector<StretchedKey> CryptoProviderImpl::stretchKey(
       common::CipherType cipher_type, common::HashType hash_type,
       const Buffer &secret) const {
-    // TODO(yuraz): pre-140 implement
-    return {};
+    // the algorithm of go-libp2p-core/crypto, which SECIO peers expect
+    constexpr size_t kIvSize = 16;
+    constexpr size_t kMacKeySize = 20;
+    constexpr std::string_view kSeed = "key expansion";
+    size_t cipher_key_size = 0;
+    switch (cipher_type) {
+      case common::CipherType::AES128:
+        cipher_key_size = 16;
+        break;
+      case common::CipherType::AES256:
+        cipher_key_size = 32;
+        break;
+      default:
+        return {};
+    }
+    auto seed = gsl::make_span(reinterpret_cast<const uint8_t *>(kSeed.data()),
+                               kSeed.size());
+
+    auto hmac_res = hmac::HmacStream::create(hash_type, secret);
+    if (!hmac_res) {
+      return {};
+    }
+    auto &hmac = hmac_res.value();
+    std::array<uint8_t, hmac::HmacStream::kMaxDigestSize> a{};
+    std::array<uint8_t, hmac::HmacStream::kMaxDigestSize> b{};
+    auto a_span = gsl::make_span(a).first(hmac.digestSize());
+    auto b_span = gsl::make_span(b).first(hmac.digestSize());
+
+    auto key_size = kIvSize + cipher_key_size + kMacKeySize;
+    Buffer result(2 * key_size, 0);
+    if (!hmac.update(seed) || !hmac.finish(a_span)) {
+      return {};
+    }
+    for (size_t done = 0; done < result.size();) {
+      if (!hmac.update(a_span) || !hmac.update(seed) || !hmac.finish(b_span)) {
+        return {};
+      }
+      auto size =
+          std::min(static_cast<size_t>(b_span.size()), result.size() - done);
+      std::copy_n(b_span.begin(), size, result.begin() + done);
+      done += size;
+      if (!hmac.update(a_span) || !hmac.finish(a_span)) {
+        return {};
+      }
+    }
+
+    std::vector<StretchedKey> keys;
+    for (auto it = result.begin(); it != result.end(); it += key_size) {
+      auto cipher_key = it + kIvSize;
+      auto mac_key = cipher_key + cipher_key_size;
+      keys.push_back(StretchedKey{{it, cipher_key},
+                                  {cipher_key, mac_key},
+                                  {mac_key, it + key_size}});
+    }
+    return keys;
   }
 }  // namespace libp2p::crypto
@@ -0,0 +1,202 @@
+/**
+ * Copyright Soramitsu Co., Ltd. All Rights Reserved.
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <libp2p/crypto/crypto_provider/ephemeral_key_pool.hpp>
+
+#include <openssl/ec.h>
+#include <openssl/evp.h>
+#include <openssl/obj_mac.h>
+#include <gsl/gsl_util>
+#include <libp2p/crypto/error.hpp>
+
+namespace libp2p::crypto {
+
+  namespace {
+    size_t curveIndex(common::CurveType curve) {
+      return static_cast<size_t>(curve);
+    }
+
+    common::CurveType curveAt(size_t index) {
+      return static_cast<common::CurveType>(index);
+    }
+
+    /// keep the generated key; a broken key type is disabled, so that the
+    /// thread does not spin on it, and the next take() enables it again
+    template <typename Key>
+    void store(std::deque<Key> &keys, bool &used, outcome::result<Key> key) {
+      if (key) {
+        keys.push_back(std::move(key.value()));
+      } else {
+        used = false;
+      }
+    }
+  }  // namespace
+
+  EphemeralKeyPool::EphemeralKeyPool(
+      size_t size, std::shared_ptr<metrics::Registry> registry)
+      : size_{size} {
+    if (registry != nullptr) {
+      hits_ = registry->counter("libp2p_ephemeral_key_pool_hits_total",
+                                "Ephemeral keys, taken from the pool");
+      misses_ = registry->counter(
+          "libp2p_ephemeral_key_pool_misses_total",
+          "Ephemeral keys, generated by the handshakes, as the pool was empty");
+    } else {
+      hits_ = std::make_shared<metrics::Counter>();
+      misses_ = std::make_shared<metrics::Counter>();
+    }
+  }
+
+  EphemeralKeyPool::~EphemeralKeyPool() {
+    {
+      std::lock_guard lock{mutex_};
+      stopped_ = true;
+    }
+    refill_cv_.notify_one();
+    if (thread_.joinable()) {
+      thread_.join();
+    }
+  }
+
+  template <typename Key, typename Generate>
+  outcome::result<Key> EphemeralKeyPool::takeFrom(std::deque<Key> &keys,
+                                                  bool &used,
+                                                  const Generate &generate) {
+    if (size_ == 0) {
+      return generate();
+    }
+    {
+      std::lock_guard lock{mutex_};
+      used = true;
+      if (!thread_.joinable()) {
+        thread_ = std::thread{[this] { refill(); }};
+      }
+      if (!keys.empty()) {
+        auto key = std::move(keys.front());
+        keys.pop_front();
+        hits_->inc();
+        refill_cv_.notify_one();
+        return key;
+      }
+    }
+    misses_->inc();
+    refill_cv_.notify_one();
+    return generate();
+  }
+
+  outcome::result<EphemeralKeyPool::EcKey> EphemeralKeyPool::take(
+      common::CurveType curve) {
+    auto index = curveIndex(curve);
+    if (index >= kCurves) {
+      return KeyGeneratorError::UNSUPPORTED_KEY_TYPE;
+    }
+    return takeFrom(keys_[index], used_[index],
+                    [curve] { return generate(curve); });
+  }
+
+  outcome::result<X25519KeyPair> EphemeralKeyPool::takeX25519() {
+    return takeFrom(x25519_keys_, x25519_used_,
+                    [] { return generateX25519(); });
+  }
+
+  EphemeralKeyPool::Stats EphemeralKeyPool::stats() const {
+    return {hits_->value(), misses_->value()};
+  }
+
+  void EphemeralKeyPool::refill() {
+    std::unique_lock lock{mutex_};
+    while (true) {
+      size_t index = 0;
+      refill_cv_.wait(lock, [&] {
+        if (stopped_) {
+          return true;
+        }
+        for (index = 0; index < kCurves; ++index) {
+          if (used_[index] && keys_[index].size() < size_) {
+            return true;
+          }
+        }
+        // index is kCurves here, which stands for X25519
+        return x25519_used_ && x25519_keys_.size() < size_;
+      });
+      if (stopped_) {
+        return;
+      }
+      lock.unlock();
+      if (index < kCurves) {
+        auto key = generate(curveAt(index));
+        lock.lock();
+        store(keys_[index], used_[index], std::move(key));
+      } else {
+        auto key = generateX25519();
+        lock.lock();
+        store(x25519_keys_, x25519_used_, std::move(key));
+      }
+    }
+  }
+
+  outcome::result<EphemeralKeyPool::EcKey> EphemeralKeyPool::generate(
+      common::CurveType curve) {
+    int curve_nid = 0;
+    switch (curve) {
+      case common::CurveType::P256:
+        curve_nid = NID_X9_62_prime256v1;
+        break;
+      case common::CurveType::P384:
+        curve_nid = NID_secp384r1;
+        break;
+      case common::CurveType::P521:
+        curve_nid = NID_secp521r1;
+        break;
+      default:
+        return KeyGeneratorError::UNSUPPORTED_KEY_TYPE;
+    }
+
+    std::shared_ptr<EC_KEY> key{EC_KEY_new_by_curve_name(curve_nid),
+                                EC_KEY_free};
+    if (nullptr == key || 1 != EC_KEY_generate_key(key.get())) {
+      return KeyGeneratorError::KEY_GENERATION_FAILED;
+    }
+
+    // peers exchange uncompressed points, as Go's elliptic.Marshal makes them
+    EC_KEY_set_conv_form(key.get(), POINT_CONVERSION_UNCOMPRESSED);
+    auto public_length = i2o_ECPublicKey(key.get(), nullptr);
+    if (public_length <= 0) {
+      return KeyGeneratorError::KEY_GENERATION_FAILED;
+    }
+    Buffer public_bytes(public_length, 0);
+    uint8_t *public_pointer = public_bytes.data();
+    if (i2o_ECPublicKey(key.get(), &public_pointer) != public_length) {
+      return KeyGeneratorError::KEY_GENERATION_FAILED;
+    }
+    return EcKey{std::move(key), std::move(public_bytes)};
+  }
+
+  outcome::result<X25519KeyPair> EphemeralKeyPool::generateX25519() {
+    EVP_PKEY_CTX *pctx = EVP_PKEY_CTX_new_id(EVP_PKEY_X25519, nullptr);
+    if (pctx == nullptr) {
+      return KeyGeneratorError::KEY_GENERATION_FAILED;
+    }
+    auto free_pctx = gsl::finally([pctx] { EVP_PKEY_CTX_free(pctx); });
+    EVP_PKEY *pkey = nullptr;
+    if (1 != EVP_PKEY_keygen_init(pctx) || 1 != EVP_PKEY_keygen(pctx, &pkey)) {
+      return KeyGeneratorError::KEY_GENERATION_FAILED;
+    }
+    auto free_pkey = gsl::finally([pkey] { EVP_PKEY_free(pkey); });
+    X25519KeyPair keys{};
+    size_t private_len = keys.private_key.size();
+    size_t public_len = keys.public_key.size();
+    if (1
+            != EVP_PKEY_get_raw_private_key(pkey, keys.private_key.data(),
+                                            &private_len)
+        || 1
+            != EVP_PKEY_get_raw_public_key(pkey, keys.public_key.data(),
+                                           &public_len)) {
+      return KeyGeneratorError::KEY_GENERATION_FAILED;
+    }
+    return keys;
+  }
+
+}  // namespace libp2p::crypto
@@ -0,0 +1,89 @@
+/**
+ * Copyright Soramitsu Co., Ltd. All Rights Reserved.
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <libp2p/crypto/crypto_provider/verification_cache.hpp>
+
+#include <cstring>
+#include <iterator>
+
+#include <libp2p/crypto/sha/sha256.hpp>
+
+namespace libp2p::crypto {
+  namespace {
+    /// hash a field with its length, so that fields cannot shift into each
+    /// other
+    void updateField(Sha256 &hasher, gsl::span<const uint8_t> field) {
+      uint64_t size = field.size();
+      hasher.update(gsl::make_span(reinterpret_cast<const uint8_t *>(&size),
+                                   sizeof(size)))
+          .update(field);
+    }
+  }  // namespace
+
+  VerificationCache::VerificationCache(size_t capacity)
+      : capacity_{capacity} {
+    entries_.reserve(capacity_);
+  }
+
+  VerificationCache::Entry VerificationCache::makeEntry(
+      gsl::span<const uint8_t> message, gsl::span<const uint8_t> signature,
+      const PublicKey &public_key) {
+    // digest() starts the next message, so the context is reused by each
+    // next entry of the thread
+    thread_local Sha256 hasher;
+    auto type = static_cast<uint8_t>(public_key.type);
+    hasher.update(gsl::make_span(&type, 1));
+    updateField(hasher, public_key.data);
+    updateField(hasher, signature);
+    updateField(hasher, message);
+    return hasher.digest();
+  }
+
+  bool VerificationCache::contains(const Entry &entry) {
+    std::lock_guard lock{mutex_};
+    auto it = entries_.find(entry);
+    if (it == entries_.end()) {
+      return false;
+    }
+    lru_.splice(lru_.begin(), lru_, it->second);
+    return true;
+  }
+
+  void VerificationCache::insert(const Entry &entry) {
+    if (capacity_ == 0) {
+      return;
+    }
+    std::lock_guard lock{mutex_};
+    if (auto it = entries_.find(entry); it != entries_.end()) {
+      lru_.splice(lru_.begin(), lru_, it->second);
+      return;
+    }
+    if (entries_.size() == capacity_) {
+      // reuse the node of the evicted entry
+      entries_.erase(lru_.back());
+      lru_.splice(lru_.begin(), lru_, std::prev(lru_.end()));
+      lru_.front() = entry;
+    } else {
+      lru_.push_front(entry);
+    }
+    entries_.emplace(entry, lru_.begin());
+  }
+
+  size_t VerificationCache::size() const {
+    std::lock_guard lock{mutex_};
+    return entries_.size();
+  }
+
+  size_t VerificationCache::capacity() const {
+    return capacity_;
+  }
+
+  size_t VerificationCache::EntryHash::operator()(const Entry &entry) const {
+    // entries are digests already, so their prefix is uniformly distributed
+    size_t hash = 0;
+    std::memcpy(&hash, entry.data(), sizeof(hash));
+    return hash;
+  }
+}  // namespace libp2p::crypto
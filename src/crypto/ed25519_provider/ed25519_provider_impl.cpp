@@ -5,6 +5,8 @@
 
 #include <libp2p/crypto/ed25519_provider/ed25519_provider_impl.hpp>
 
+#include <map>
+
 #include <openssl/evp.h>
 #include <libp2p/crypto/common_functions.hpp>
 #include <libp2p/crypto/error.hpp>
@@ -93,7 +95,7 @@ namespace libp2p::crypto::ed25519 {
   }
 
   outcome::result<bool> Ed25519ProviderImpl::verify(
-      gsl::span<uint8_t> message, const Signature &signature,
+      gsl::span<const uint8_t> message, const Signature &signature,
       const PublicKey &public_key) const {
     OUTCOME_TRY(evp_pkey,
                 NewEvpPkeyFromBytes(EVP_PKEY_ED25519, public_key,
@@ -118,4 +120,47 @@ namespace libp2p::crypto::ed25519 {
 
     return FAILED;
   }
+
+  outcome::result<std::vector<bool>> Ed25519ProviderImpl::verifyBatch(
+      gsl::span<const SignedMessage> messages) const {
+    constexpr auto FAILED{CryptoProviderError::SIGNATURE_VERIFICATION_FAILED};
+
+    std::shared_ptr<EVP_MD_CTX> mctx{EVP_MD_CTX_new(), EVP_MD_CTX_free};
+    if (nullptr == mctx) {
+      return FAILED;
+    }
+
+    // records of one signer usually come together, so keys are decoded once
+    // per distinct key rather than once per message
+    std::map<PublicKey, std::shared_ptr<EVP_PKEY>> keys;
+    std::vector<bool> results;
+    results.reserve(messages.size());
+    for (const auto &msg : messages) {
+      auto key_it = keys.find(msg.public_key);
+      if (key_it == keys.end()) {
+        auto evp_pkey_res = NewEvpPkeyFromBytes(
+            EVP_PKEY_ED25519, msg.public_key, EVP_PKEY_new_raw_public_key);
+        if (!evp_pkey_res) {
+          // malformed key of one record does not fail the others
+          results.push_back(false);
+          continue;
+        }
+        key_it = keys.emplace(msg.public_key, std::move(evp_pkey_res.value()))
+                     .first;
+      }
+
+      if (1 != EVP_MD_CTX_reset(mctx.get())
+          || 1
+              != EVP_DigestVerifyInit(mctx.get(), nullptr, nullptr, nullptr,
+                                      key_it->second.get())) {
+        return FAILED;
+      }
+      int valid =
+          EVP_DigestVerify(mctx.get(), msg.signature.data(),
+                           msg.signature.size(), msg.message.data(),
+                           msg.message.size());
+      results.push_back(1 == valid);
+    }
+    return results;
+  }
 }  // namespace libp2p::crypto::ed25519
@@ -39,6 +39,10 @@ OUTCOME_CPP_DEFINE_CATEGORY(libp2p::crypto, OpenSslError, e) {
       return "failed to finalize decryption";
     case OpenSslError::WRONG_IV_SIZE:
       return "wrong iv size";
+    case OpenSslError::WRONG_KEY_SIZE:
+      return "wrong key size";
+    case OpenSslError::WRONG_TAG_SIZE:
+      return "wrong authentication tag size";
   }
   return "unknown CryptoProviderError code";
 }
@@ -0,0 +1,82 @@
+/**
+ * Copyright Soramitsu Co., Ltd. All Rights Reserved.
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <libp2p/crypto/hmac_provider/hmac_stream.hpp>
+
+#include <openssl/hmac.h>
+#include <libp2p/crypto/error.hpp>
+
+namespace libp2p::crypto::hmac {
+
+  namespace {
+    const EVP_MD *evpMd(common::HashType type) {
+      switch (type) {
+        case common::HashType::SHA1:
+          return EVP_sha1();
+        case common::HashType::SHA256:
+          return EVP_sha256();
+        case common::HashType::SHA512:
+          return EVP_sha512();
+      }
+      return nullptr;
+    }
+  }  // namespace
+
+  void HmacStream::CtxDeleter::operator()(hmac_ctx_st *ctx) const {
+    HMAC_CTX_free(ctx);
+  }
+
+  HmacStream::HmacStream(Ctx ctx, size_t digest_size)
+      : ctx_{std::move(ctx)}, digest_size_{digest_size} {}
+
+  HmacStream::HmacStream(HmacStream &&other) noexcept = default;
+
+  HmacStream &HmacStream::operator=(HmacStream &&other) noexcept = default;
+
+  HmacStream::~HmacStream() = default;
+
+  outcome::result<HmacStream> HmacStream::create(
+      common::HashType hash_type, gsl::span<const uint8_t> key) {
+    const auto *md = evpMd(hash_type);
+    if (md == nullptr) {
+      return HmacProviderError::UNSUPPORTED_HASH_METHOD;
+    }
+    Ctx ctx{HMAC_CTX_new()};
+    if (!ctx) {
+      return HmacProviderError::FAILED_CREATE_CONTEXT;
+    }
+    if (1 != HMAC_Init_ex(ctx.get(), key.data(), key.size(), md, nullptr)) {
+      return HmacProviderError::FAILED_INITIALIZE_CONTEXT;
+    }
+    return HmacStream{std::move(ctx), static_cast<size_t>(EVP_MD_size(md))};
+  }
+
+  size_t HmacStream::digestSize() const {
+    return digest_size_;
+  }
+
+  outcome::result<void> HmacStream::update(gsl::span<const uint8_t> data) {
+    if (1 != HMAC_Update(ctx_.get(), data.data(), data.size())) {
+      return HmacProviderError::FAILED_UPDATE_DIGEST;
+    }
+    return outcome::success();
+  }
+
+  outcome::result<void> HmacStream::finish(gsl::span<uint8_t> digest) {
+    if (static_cast<size_t>(digest.size()) < digest_size_) {
+      return HmacProviderError::WRONG_DIGEST_SIZE;
+    }
+    unsigned int len = 0;
+    if (1 != HMAC_Final(ctx_.get(), digest.data(), &len)) {
+      return HmacProviderError::FAILED_FINALIZE_DIGEST;
+    }
+    // null key and md keep the key, so only the inner state is reset
+    if (1 != HMAC_Init_ex(ctx_.get(), nullptr, 0, nullptr, nullptr)) {
+      return HmacProviderError::FAILED_INITIALIZE_CONTEXT;
+    }
+    return outcome::success();
+  }
+
+}  // namespace libp2p::crypto::hmac
@@ -5,21 +5,45 @@
 
 #include <libp2p/crypto/sha/sha256.hpp>
 
-#include <openssl/sha.h>
+#include <boost/assert.hpp>
+#include <openssl/evp.h>
 
 namespace libp2p::crypto {
+  namespace {
+    /// hasher of one-shot calls, so that they do not allocate a context
+    Sha256 &threadHasher() {
+      thread_local Sha256 hasher;
+      return hasher;
+    }
+  }  // namespace
+
+  Sha256::Sha256() : ShaHasher{EVP_sha256()} {}
+
+  common::Hash256 Sha256::digest() {
+    common::Hash256 out;
+    finish(out.data());
+    return out;
+  }
+
   common::Hash256 sha256(std::string_view input) {
-    std::vector<uint8_t> bytes{input.begin(), input.end()};
-    return sha256(bytes);
+    auto &hasher = threadHasher();
+    hasher.update(input);
+    return hasher.digest();
   }
 
   common::Hash256 sha256(gsl::span<const uint8_t> input) {
-    common::Hash256 out;
-    SHA256_CTX ctx;
-    SHA256_Init(&ctx);
-    SHA256_Update(&ctx, input.data(), input.size());
-    SHA256_Final(out.data(), &ctx);
-    // TODO(igor-egorov) FIL-67 Try to add checks for SHA-X return values
-    return out;
+    auto &hasher = threadHasher();
+    hasher.update(input);
+    return hasher.digest();
+  }
+
+  void sha256Batch(gsl::span<const gsl::span<const uint8_t>> inputs,
+                   gsl::span<common::Hash256> out) {
+    BOOST_ASSERT(out.size() >= inputs.size());
+    auto &hasher = threadHasher();
+    for (std::ptrdiff_t i = 0; i < inputs.size(); ++i) {
+      hasher.update(inputs[i]);
+      out[i] = hasher.digest();
+    }
   }
 }  // namespace libp2p::crypto
@@ -5,21 +5,34 @@
 
 #include <libp2p/crypto/sha/sha512.hpp>
 
-#include <openssl/sha.h>
+#include <openssl/evp.h>
 
 namespace libp2p::crypto {
+  namespace {
+    /// hasher of one-shot calls, so that they do not allocate a context
+    Sha512 &threadHasher() {
+      thread_local Sha512 hasher;
+      return hasher;
+    }
+  }  // namespace
+
+  Sha512::Sha512() : ShaHasher{EVP_sha512()} {}
+
+  common::Hash512 Sha512::digest() {
+    common::Hash512 out;
+    finish(out.data());
+    return out;
+  }
+
   common::Hash512 sha512(std::string_view input) {
-    std::vector<uint8_t> bytes{input.begin(), input.end()};
-    return sha512(bytes);
+    auto &hasher = threadHasher();
+    hasher.update(input);
+    return hasher.digest();
   }
 
   common::Hash512 sha512(gsl::span<const uint8_t> input) {
-    common::Hash512 out;
-    SHA512_CTX ctx;
-    SHA512_Init(&ctx);
-    SHA512_Update(&ctx, input.data(), input.size());
-    SHA512_Final(out.data(), &ctx);
-    // TODO(igor-egorov) FIL-67 Try to add checks for SHA-X return values
-    return out;
+    auto &hasher = threadHasher();
+    hasher.update(input);
+    return hasher.digest();
   }
 }  // namespace libp2p::crypto
@@ -0,0 +1,44 @@
+/**
+ * Copyright Soramitsu Co., Ltd. All Rights Reserved.
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <libp2p/crypto/sha/sha_hasher.hpp>
+
+#include <openssl/evp.h>
+
+namespace libp2p::crypto {
+
+  void ShaHasher::CtxDeleter::operator()(evp_md_ctx_st *ctx) const {
+    EVP_MD_CTX_free(ctx);
+  }
+
+  ShaHasher::ShaHasher(const evp_md_st *md)
+      : ctx_{EVP_MD_CTX_new()}, md_{md} {
+    EVP_DigestInit_ex(ctx_.get(), md_, nullptr);
+  }
+
+  ShaHasher::ShaHasher(ShaHasher &&other) noexcept = default;
+
+  ShaHasher &ShaHasher::operator=(ShaHasher &&other) noexcept = default;
+
+  ShaHasher::~ShaHasher() = default;
+
+  ShaHasher &ShaHasher::update(gsl::span<const uint8_t> input) {
+    EVP_DigestUpdate(ctx_.get(), input.data(), input.size());
+    return *this;
+  }
+
+  ShaHasher &ShaHasher::update(std::string_view input) {
+    EVP_DigestUpdate(ctx_.get(), input.data(), input.size());
+    return *this;
+  }
+
+  void ShaHasher::finish(uint8_t *out) {
+    EVP_DigestFinal_ex(ctx_.get(), out, nullptr);
+    // the same digest keeps its state memory, so nothing is allocated again
+    EVP_DigestInit_ex(ctx_.get(), md_, nullptr);
+    // TODO(igor-egorov) FIL-67 Try to add checks for SHA-X return values
+  }
+
+}  // namespace libp2p::crypto
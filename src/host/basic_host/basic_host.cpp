@@ -11,18 +11,52 @@
 
 namespace libp2p::host {
 
+  namespace {
+    /// how often closed warm connections are replaced
+    constexpr std::chrono::seconds kWarmCheckInterval{5};
+
+    /// how often expired addresses, empty protocol sets and closed
+    /// connections are collected
+    constexpr std::chrono::seconds kMaintenanceInterval{10};
+
+    /// how long garbage collection may block the io context at once
+    constexpr std::chrono::microseconds kMaintenanceTimeSlice{500};
+
+    /// how many entries a single garbage collection step may visit
+    constexpr size_t kMaintenanceStepEntries = 64;
+
+    /// how long a pooled stream may stay idle
+    constexpr std::chrono::seconds kStreamIdleTimeout{30};
+
+    /// how many idle streams are pooled to a single peer
+    constexpr size_t kMaxIdleStreamsPerPeer = 4;
+  }  // namespace
+
   BasicHost::BasicHost(std::shared_ptr<peer::IdentityManager> idmgr,
                        std::unique_ptr<network::Network> network,
                        std::unique_ptr<peer::PeerRepository> repo,
-                       std::shared_ptr<event::Bus> bus)
+                       std::shared_ptr<event::Bus> bus,
+                       std::shared_ptr<boost::asio::io_context> context)
       : idmgr_(std::move(idmgr)),
         network_(std::move(network)),
         repo_(std::move(repo)),
-        bus_(std::move(bus)) {
+        bus_(std::move(bus)),
+        context_(std::move(context)),
+        stream_pool_(*network_, kStreamIdleTimeout, kMaxIdleStreamsPerPeer) {
     BOOST_ASSERT(idmgr_ != nullptr);
     BOOST_ASSERT(network_ != nullptr);
     BOOST_ASSERT(repo_ != nullptr);
     BOOST_ASSERT(bus_ != nullptr);
+
+    if (context_) {
+      maintenance_ = std::make_shared<MaintenanceScheduler>(
+          context_, kMaintenanceInterval, kMaintenanceTimeSlice,
+          kMaintenanceStepEntries);
+      maintenance_->add(repo_->getAddressRepository());
+      maintenance_->add(repo_->getProtocolRepository());
+      maintenance_->add(network_->getConnectionManager());
+      maintenance_->add(stream_pool_);
+    }
   }
 
   std::string_view BasicHost::getLibp2pVersion() const {
@@ -91,6 +125,17 @@ namespace libp2p::host {
     network_->getDialer().newStream(p, protocol, handler);
   }
 
+  void BasicHost::acquireStream(const peer::PeerInfo &p,
+                                const peer::Protocol &protocol,
+                                const Host::StreamResultHandler &handler) {
+    stream_pool_.acquire(p, protocol, handler);
+  }
+
+  void BasicHost::releaseStream(const peer::Protocol &protocol,
+                                std::shared_ptr<connection::Stream> stream) {
+    stream_pool_.release(protocol, std::move(stream));
+  }
+
   outcome::result<void> BasicHost::listen(const multi::Multiaddress &ma) {
     return network_->getListener().listen(ma);
   }
@@ -107,10 +152,16 @@ namespace libp2p::host {
 
   void BasicHost::start() {
     network_->getListener().start();
+    if (maintenance_) {
+      maintenance_->start();
+    }
   }
 
   void BasicHost::stop() {
     network_->getListener().stop();
+    if (maintenance_) {
+      maintenance_->stop();
+    }
   }
 
   network::Network &BasicHost::getNetwork() {
@@ -132,4 +183,15 @@ namespace libp2p::host {
   void BasicHost::connect(const peer::PeerInfo &p) {
     network_->getDialer().dial(p, [](auto && /* ignored */) {});
   }
+
+  void BasicHost::keepWarm(std::vector<peer::PeerInfo> peers,
+                           size_t connections) {
+    if (prewarmer_) {
+      prewarmer_->stop();
+    }
+    prewarmer_ = std::make_shared<ConnectionPrewarmer>(
+        *network_, context_, std::move(peers), connections,
+        kWarmCheckInterval);
+    prewarmer_->start();
+  }
 }  // namespace libp2p::host
@@ -0,0 +1,110 @@
+/**
+ * Copyright Soramitsu Co., Ltd. All Rights Reserved.
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <libp2p/host/basic_host/connection_prewarmer.hpp>
+
+#include <algorithm>
+
+namespace libp2p::host {
+
+  ConnectionPrewarmer::ConnectionPrewarmer(
+      network::Network &network,
+      std::shared_ptr<boost::asio::io_context> context,
+      std::vector<peer::PeerInfo> peers, size_t connections,
+      std::chrono::milliseconds check_interval)
+      : network_(network),
+        context_(std::move(context)),
+        peers_(std::move(peers)),
+        connections_(connections),
+        check_interval_(check_interval) {
+    if (context_) {
+      timer_ = std::make_unique<boost::asio::steady_timer>(*context_);
+    }
+  }
+
+  void ConnectionPrewarmer::start() {
+    started_ = true;
+    check();
+  }
+
+  void ConnectionPrewarmer::stop() {
+    started_ = false;
+    if (timer_) {
+      timer_->cancel();
+    }
+  }
+
+  size_t ConnectionPrewarmer::warmConnections() const {
+    size_t warm = 0;
+    for (const auto &peer : peers_) {
+      if (isConnected(peer.id)) {
+        ++warm;
+      }
+    }
+    return warm;
+  }
+
+  bool ConnectionPrewarmer::isConnected(const peer::PeerId &peer) const {
+    auto conn = network_.getConnectionManager().getBestConnectionForPeer(peer);
+    return conn != nullptr && !conn->isClosed();
+  }
+
+  void ConnectionPrewarmer::check() {
+    if (!started_) {
+      return;
+    }
+
+    // a dial may complete at once and reorder the set
+    auto peers = peers_;
+    for (const auto &peer : peers) {
+      if (warmConnections() + dialing_.size() >= connections_) {
+        break;
+      }
+      if (dialing_.count(peer.id) != 0 || isConnected(peer.id)) {
+        continue;
+      }
+      dialing_.insert(peer.id);
+      network_.getDialer().dial(
+          peer, [wptr{weak_from_this()}, id{peer.id}](auto &&rconn) {
+            auto self = wptr.lock();
+            if (!self) {
+              return;
+            }
+            self->dialing_.erase(id);
+            if (!rconn) {
+              self->demote(id);
+            }
+          });
+    }
+
+    scheduleCheck();
+  }
+
+  void ConnectionPrewarmer::demote(const peer::PeerId &peer) {
+    // the next peers of the set are tried first on the next check
+    auto it = std::find_if(peers_.begin(), peers_.end(),
+                           [&peer](const auto &p) { return p.id == peer; });
+    if (it != peers_.end()) {
+      std::rotate(it, std::next(it), peers_.end());
+    }
+  }
+
+  void ConnectionPrewarmer::scheduleCheck() {
+    if (!timer_) {
+      return;
+    }
+    timer_->expires_after(check_interval_);
+    timer_->async_wait(
+        [wptr{weak_from_this()}](const boost::system::error_code &ec) {
+          if (ec) {
+            return;
+          }
+          if (auto self = wptr.lock()) {
+            self->check();
+          }
+        });
+  }
+
+}  // namespace libp2p::host
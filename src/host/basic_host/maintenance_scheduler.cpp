@@ -0,0 +1,85 @@
+/**
+ * Copyright Soramitsu Co., Ltd. All Rights Reserved.
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <libp2p/host/basic_host/maintenance_scheduler.hpp>
+
+#include <algorithm>
+
+#include <boost/assert.hpp>
+
+namespace libp2p::host {
+
+  MaintenanceScheduler::MaintenanceScheduler(
+      std::shared_ptr<boost::asio::io_context> context,
+      std::chrono::milliseconds interval, std::chrono::microseconds time_slice,
+      size_t step_entries)
+      : context_(std::move(context)),
+        interval_(interval),
+        time_slice_(time_slice),
+        step_entries_(std::max<size_t>(step_entries, 1)),
+        timer_(*context_) {}
+
+  void MaintenanceScheduler::add(basic::GarbageCollectable &collectable) {
+    components_.push_back({&collectable, false});
+  }
+
+  void MaintenanceScheduler::start() {
+    started_ = true;
+    schedule(interval_);
+  }
+
+  void MaintenanceScheduler::stop() {
+    started_ = false;
+    timer_.cancel();
+  }
+
+  bool MaintenanceScheduler::runSlice() {
+    auto deadline = std::chrono::steady_clock::now() + time_slice_;
+    auto left = std::count_if(
+        components_.begin(), components_.end(),
+        [](const Component &c) { return !c.pass_completed; });
+    while (left != 0) {
+      // components take turns, so that a large one does not delay the rest
+      auto &component = components_[next_component_];
+      next_component_ = (next_component_ + 1) % components_.size();
+      if (component.pass_completed) {
+        continue;
+      }
+      if (component.collectable->collectGarbageStep(step_entries_)) {
+        component.pass_completed = true;
+        --left;
+      }
+      if (std::chrono::steady_clock::now() >= deadline) {
+        break;
+      }
+    }
+    return left == 0;
+  }
+
+  void MaintenanceScheduler::startPass() {
+    for (auto &component : components_) {
+      component.pass_completed = false;
+    }
+  }
+
+  void MaintenanceScheduler::schedule(
+      std::chrono::steady_clock::duration delay) {
+    timer_.expires_after(delay);
+    timer_.async_wait(
+        [wptr{weak_from_this()}](const boost::system::error_code &ec) {
+          auto self = wptr.lock();
+          if (ec || !self || !self->started_) {
+            return;
+          }
+          if (self->runSlice()) {
+            self->startPass();
+            return self->schedule(self->interval_);
+          }
+          // let the other handlers run before the next slice
+          self->schedule(std::chrono::steady_clock::duration::zero());
+        });
+  }
+
+}  // namespace libp2p::host
@@ -0,0 +1,94 @@
+/**
+ * Copyright Soramitsu Co., Ltd. All Rights Reserved.
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <libp2p/host/basic_host/stream_pool.hpp>
+
+#include <algorithm>
+
+namespace libp2p::host {
+
+  StreamPool::StreamPool(network::Network &network,
+                         std::chrono::milliseconds idle_timeout,
+                         size_t max_idle_per_peer)
+      : network_(network),
+        idle_timeout_(idle_timeout),
+        max_idle_per_peer_(max_idle_per_peer) {}
+
+  void StreamPool::acquire(const peer::PeerInfo &p,
+                           const peer::Protocol &protocol,
+                           StreamResultFunc cb) {
+    if (auto it = idle_.find(p.id); it != idle_.end()) {
+      auto &streams = it->second;
+      auto now = Clock::now();
+
+      // the most recently released stream is the least likely to have been
+      // closed by the other side
+      for (auto idle = streams.rbegin(); idle != streams.rend(); ++idle) {
+        if (idle->protocol != protocol || !isUsable(*idle, now)) {
+          continue;
+        }
+        auto stream = std::move(idle->stream);
+        streams.erase(std::next(idle).base());
+        if (streams.empty()) {
+          idle_.erase(it);
+        }
+        return cb(std::move(stream));
+      }
+    }
+    network_.getDialer().newStream(p, protocol, std::move(cb));
+  }
+
+  void StreamPool::release(const peer::Protocol &protocol,
+                           std::shared_ptr<connection::Stream> stream) {
+    if (max_idle_per_peer_ == 0 || stream->isClosedForRead()
+        || stream->isClosedForWrite()) {
+      return close(std::move(stream));
+    }
+
+    auto &streams = idle_[stream->remotePeerId()];
+    if (streams.size() >= max_idle_per_peer_) {
+      close(std::move(streams.front().stream));
+      streams.erase(streams.begin());
+    }
+    streams.push_back(
+        {protocol, std::move(stream), Clock::now() + idle_timeout_});
+  }
+
+  size_t StreamPool::idleStreams() const {
+    size_t count = 0;
+    for (const auto &[peer, streams] : idle_) {
+      count += streams.size();
+    }
+    return count;
+  }
+
+  void StreamPool::collectGarbage() {
+    auto now = Clock::now();
+    for (auto it = idle_.begin(); it != idle_.end();) {
+      auto &streams = it->second;
+      auto unusable = std::stable_partition(
+          streams.begin(), streams.end(),
+          [now](const auto &idle) { return isUsable(idle, now); });
+      std::for_each(unusable, streams.end(),
+                    [](auto &idle) { close(std::move(idle.stream)); });
+      streams.erase(unusable, streams.end());
+      it = streams.empty() ? idle_.erase(it) : std::next(it);
+    }
+  }
+
+  bool StreamPool::isUsable(const IdleStream &idle, Clock::time_point now) {
+    return idle.expires > now && !idle.stream->isClosedForRead()
+        && !idle.stream->isClosedForWrite();
+  }
+
+  void StreamPool::close(std::shared_ptr<connection::Stream> stream) {
+    if (stream->isClosedForWrite()) {
+      return;
+    }
+    auto s = stream.get();
+    s->close([stream{std::move(stream)}](auto &&) {});
+  }
+
+}  // namespace libp2p::host
@@ -0,0 +1,104 @@
+/**
+ * Copyright Soramitsu Co., Ltd. All Rights Reserved.
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <libp2p/metrics/histogram.hpp>
+
+#include <algorithm>
+#include <cmath>
+
+namespace libp2p::metrics {
+
+  namespace {
+    /// index of the highest set bit of a non-zero value
+    size_t log2Floor(uint64_t value) {
+      size_t result = 0;
+      for (size_t shift = 32; shift > 0; shift /= 2) {
+        if ((value >> shift) != 0) {
+          value >>= shift;
+          result += shift;
+        }
+      }
+      return result;
+    }
+  }  // namespace
+
+  void Histogram::record(uint64_t value) {
+    buckets_[bucketIndex(value)].fetch_add(1, std::memory_order_relaxed);
+    count_.fetch_add(1, std::memory_order_relaxed);
+    sum_.fetch_add(value, std::memory_order_relaxed);
+  }
+
+  void Histogram::recordSince(Clock::time_point start) {
+    auto elapsed = std::chrono::duration_cast<std::chrono::microseconds>(
+        Clock::now() - start);
+    record(elapsed.count());
+  }
+
+  uint64_t Histogram::count() const {
+    return count_.load(std::memory_order_relaxed);
+  }
+
+  uint64_t Histogram::sum() const {
+    return sum_.load(std::memory_order_relaxed);
+  }
+
+  uint64_t Histogram::quantile(double q) const {
+    // the buckets are read once, so that the total matches them, even if
+    // values are recorded meanwhile
+    auto buckets = this->buckets();
+    uint64_t total = 0;
+    for (const auto &bucket : buckets) {
+      total += bucket.count;
+    }
+    if (total == 0) {
+      return 0;
+    }
+
+    auto rank = std::max<uint64_t>(
+        1,
+        static_cast<uint64_t>(
+            std::ceil(std::clamp(q, 0.0, 1.0) * static_cast<double>(total))));
+    uint64_t seen = 0;
+    for (const auto &bucket : buckets) {
+      seen += bucket.count;
+      if (seen >= rank) {
+        return bucket.upper_bound;
+      }
+    }
+    return buckets.back().upper_bound;
+  }
+
+  std::vector<Histogram::Bucket> Histogram::buckets() const {
+    std::vector<Bucket> result;
+    for (size_t i = 0; i < kBuckets; ++i) {
+      if (auto count = buckets_[i].load(std::memory_order_relaxed);
+          count != 0) {
+        result.push_back({bucketUpperBound(i), count});
+      }
+    }
+    return result;
+  }
+
+  size_t Histogram::bucketIndex(uint64_t value) {
+    if (value < kSubBuckets) {
+      return value;
+    }
+    // the leading kSubBucketBits + 1 bits select the bucket in the power of
+    // two, the rest are dropped
+    auto shift = log2Floor(value) - kSubBucketBits;
+    return (shift + 1) * kSubBuckets + ((value >> shift) - kSubBuckets);
+  }
+
+  uint64_t Histogram::bucketUpperBound(size_t index) {
+    if (index < kSubBuckets) {
+      return index;
+    }
+    auto shift = index / kSubBuckets - 1;
+    uint64_t lower = static_cast<uint64_t>(kSubBuckets + index % kSubBuckets)
+        << shift;
+    return lower + ((uint64_t{1} << shift) - 1);
+  }
+
+}  // namespace libp2p::metrics
@@ -0,0 +1,228 @@
+/**
+ * Copyright Soramitsu Co., Ltd. All Rights Reserved.
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <libp2p/metrics/prometheus_exporter.hpp>
+
+#include <istream>
+#include <sstream>
+
+#include <boost/asio/read_until.hpp>
+#include <boost/asio/streambuf.hpp>
+#include <boost/asio/write.hpp>
+
+namespace libp2p::metrics {
+
+  namespace {
+    std::string escape(const std::string &value, bool quotes) {
+      std::string result;
+      result.reserve(value.size());
+      for (auto c : value) {
+        if (c == '\\') {
+          result += "\\\\";
+        } else if (c == '\n') {
+          result += "\\n";
+        } else if (c == '"' && quotes) {
+          result += "\\\"";
+        } else {
+          result += c;
+        }
+      }
+      return result;
+    }
+
+    /// labels in braces with an optional extra one, e.g. {a="1",le="7"}
+    std::string formatLabels(const Labels &labels,
+                             const std::string &extra = {}) {
+      if (labels.empty() && extra.empty()) {
+        return {};
+      }
+      std::string result = "{";
+      for (const auto &[name, value] : labels) {
+        if (result.size() > 1) {
+          result += ',';
+        }
+        result += name + "=\"" + escape(value, true) + '"';
+      }
+      if (!extra.empty()) {
+        if (result.size() > 1) {
+          result += ',';
+        }
+        result += extra;
+      }
+      return result + '}';
+    }
+
+    const char *typeName(MetricType type) {
+      switch (type) {
+        case MetricType::COUNTER:
+          return "counter";
+        case MetricType::GAUGE:
+          return "gauge";
+        case MetricType::HISTOGRAM:
+          return "histogram";
+      }
+      return "untyped";
+    }
+
+    void formatHistogram(std::ostringstream &out, const std::string &name,
+                         const Labels &labels, const Histogram &histogram) {
+      // the buckets are read once, so that the count matches them
+      uint64_t cumulative = 0;
+      for (const auto &bucket : histogram.buckets()) {
+        cumulative += bucket.count;
+        out << name << "_bucket"
+            << formatLabels(labels,
+                            "le=\"" + std::to_string(bucket.upper_bound) + '"')
+            << ' ' << cumulative << '\n';
+      }
+      out << name << "_bucket" << formatLabels(labels, "le=\"+Inf\"") << ' '
+          << cumulative << '\n';
+      out << name << "_sum" << formatLabels(labels) << ' ' << histogram.sum()
+          << '\n';
+      out << name << "_count" << formatLabels(labels) << ' ' << cumulative
+          << '\n';
+    }
+  }  // namespace
+
+  struct PrometheusExporter::Session {
+    explicit Session(boost::asio::ip::tcp::socket socket)
+        : socket{std::move(socket)}, request{kMaxRequestSize} {}
+
+    boost::asio::ip::tcp::socket socket;
+    boost::asio::streambuf request;
+    std::string response;
+  };
+
+  PrometheusExporter::PrometheusExporter(
+      boost::asio::io_context &context,
+      std::shared_ptr<const Registry> registry)
+      : acceptor_{context}, registry_{std::move(registry)} {
+    BOOST_ASSERT(registry_ != nullptr);
+  }
+
+  outcome::result<void> PrometheusExporter::listen(
+      const boost::asio::ip::tcp::endpoint &endpoint) {
+    if (acceptor_.is_open()) {
+      return std::errc::already_connected;
+    }
+
+    try {
+      acceptor_.open(endpoint.protocol());
+      acceptor_.set_option(
+          boost::asio::ip::tcp::acceptor::reuse_address(true));
+      acceptor_.bind(endpoint);
+      acceptor_.listen();
+    } catch (const boost::system::system_error &e) {
+      boost::system::error_code ignored;
+      acceptor_.close(ignored);
+      return e.code();
+    }
+
+    doAccept();
+    return outcome::success();
+  }
+
+  outcome::result<boost::asio::ip::tcp::endpoint>
+  PrometheusExporter::localEndpoint() const {
+    boost::system::error_code ec;
+    auto endpoint = acceptor_.local_endpoint(ec);
+    if (ec) {
+      return ec;
+    }
+    return endpoint;
+  }
+
+  void PrometheusExporter::close() {
+    boost::system::error_code ignored;
+    acceptor_.close(ignored);
+  }
+
+  std::string PrometheusExporter::format(
+      const std::vector<MetricFamily> &families) {
+    std::ostringstream out;
+    for (const auto &family : families) {
+      out << "# HELP " << family.name << ' ' << escape(family.help, false)
+          << '\n';
+      out << "# TYPE " << family.name << ' ' << typeName(family.type) << '\n';
+      for (const auto &[labels, metric] : family.metrics) {
+        if (auto counter = std::get_if<std::shared_ptr<Counter>>(&metric)) {
+          out << family.name << formatLabels(labels) << ' '
+              << (*counter)->value() << '\n';
+        } else if (auto gauge = std::get_if<std::shared_ptr<Gauge>>(&metric)) {
+          out << family.name << formatLabels(labels) << ' '
+              << (*gauge)->value() << '\n';
+        } else if (auto histogram =
+                       std::get_if<std::shared_ptr<Histogram>>(&metric)) {
+          formatHistogram(out, family.name, labels, **histogram);
+        }
+      }
+    }
+    return out.str();
+  }
+
+  void PrometheusExporter::doAccept() {
+    if (!acceptor_.is_open()) {
+      return;
+    }
+
+    acceptor_.async_accept(
+        [self{shared_from_this()}](const boost::system::error_code &ec,
+                                   boost::asio::ip::tcp::socket socket) {
+          if (ec == boost::asio::error::operation_aborted) {
+            return;
+          }
+          if (!ec) {
+            self->serve(std::make_shared<Session>(std::move(socket)));
+          }
+          self->doAccept();
+        });
+  }
+
+  void PrometheusExporter::serve(std::shared_ptr<Session> session) {
+    boost::asio::async_read_until(
+        session->socket, session->request, "\r\n\r\n",
+        [self{shared_from_this()}, session](
+            const boost::system::error_code &ec, size_t) {
+          if (ec) {
+            // the client has gone, or the request is too big
+            return;
+          }
+
+          std::istream request{&session->request};
+          std::string method;
+          std::string target;
+          request >> method >> target;
+          session->response = self->respond(method, target);
+
+          boost::asio::async_write(
+              session->socket, boost::asio::buffer(session->response),
+              [session](const boost::system::error_code &, size_t) {
+                boost::system::error_code ignored;
+                session->socket.shutdown(
+                    boost::asio::ip::tcp::socket::shutdown_both, ignored);
+                session->socket.close(ignored);
+              });
+        });
+  }
+
+  std::string PrometheusExporter::respond(const std::string &method,
+                                          const std::string &target) const {
+    std::string status = "200 OK";
+    std::string body;
+    if (method != "GET") {
+      status = "405 Method Not Allowed";
+    } else if (target.substr(0, target.find('?')) != "/metrics") {
+      status = "404 Not Found";
+    } else {
+      body = format(registry_->collect());
+    }
+
+    return "HTTP/1.1 " + status
+        + "\r\nContent-Type: text/plain; version=0.0.4; charset=utf-8"
+        + "\r\nContent-Length: " + std::to_string(body.size())
+        + "\r\nConnection: close\r\n\r\n" + body;
+  }
+
+}  // namespace libp2p::metrics
@@ -0,0 +1,60 @@
+/**
+ * Copyright Soramitsu Co., Ltd. All Rights Reserved.
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <libp2p/metrics/registry.hpp>
+
+namespace libp2p::metrics {
+
+  std::shared_ptr<Counter> Registry::counter(const std::string &name,
+                                             const std::string &help,
+                                             const Labels &labels) {
+    return get<Counter>(name, help, MetricType::COUNTER, labels);
+  }
+
+  std::shared_ptr<Gauge> Registry::gauge(const std::string &name,
+                                         const std::string &help,
+                                         const Labels &labels) {
+    return get<Gauge>(name, help, MetricType::GAUGE, labels);
+  }
+
+  std::shared_ptr<Histogram> Registry::histogram(const std::string &name,
+                                                 const std::string &help,
+                                                 const Labels &labels) {
+    return get<Histogram>(name, help, MetricType::HISTOGRAM, labels);
+  }
+
+  std::vector<MetricFamily> Registry::collect() const {
+    std::lock_guard lock{mutex_};
+    std::vector<MetricFamily> families;
+    families.reserve(families_.size());
+    for (const auto &[name, family] : families_) {
+      families.push_back(family);
+    }
+    return families;
+  }
+
+  template <typename T>
+  std::shared_ptr<T> Registry::get(const std::string &name,
+                                   const std::string &help, MetricType type,
+                                   const Labels &labels) {
+    std::lock_guard lock{mutex_};
+    auto &family =
+        families_.try_emplace(name, MetricFamily{name, help, type, {}})
+            .first->second;
+    if (family.type != type) {
+      // the name is taken, so the metric is kept only by its owner
+      return std::make_shared<T>();
+    }
+    auto &metric = family.metrics[labels];
+    if (auto existing = std::get_if<std::shared_ptr<T>>(&metric);
+        existing != nullptr && *existing != nullptr) {
+      return *existing;
+    }
+    auto created = std::make_shared<T>();
+    metric = created;
+    return created;
+  }
+
+}  // namespace libp2p::metrics
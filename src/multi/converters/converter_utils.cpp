@@ -8,6 +8,7 @@
 #include <boost/algorithm/string.hpp>
 #include <boost/asio/ip/address_v4.hpp>
 #include <boost/asio/ip/address_v6.hpp>
+#include <boost/range/iterator_range.hpp>
 #include <libp2p/common/hexutil.hpp>
 #include <libp2p/common/types.hpp>
 #include <libp2p/multi/converters/conversion_error.hpp>
@@ -15,6 +16,7 @@
 #include <libp2p/multi/converters/ip_v6_converter.hpp>
 #include <libp2p/multi/converters/ipfs_converter.hpp>
 #include <libp2p/multi/converters/dns_converter.hpp>
+#include <libp2p/multi/converters/memory_converter.hpp>
 #include <libp2p/multi/converters/tcp_converter.hpp>
 #include <libp2p/multi/converters/udp_converter.hpp>
 #include <libp2p/multi/multiaddress_protocol_list.hpp>
@@ -54,7 +56,8 @@ namespace libp2p::multi::converters {
     std::list<std::string> tokens;
     boost::algorithm::split(tokens, str, boost::algorithm::is_any_of("/"));
 
-    for (auto &word : tokens) {
+    for (auto it = tokens.begin(); it != tokens.end(); ++it) {
+      auto &word = *it;
       if (type == WordType::PROTOCOL) {
         protx = ProtocolList::get(word);
         if (protx != nullptr) {
@@ -63,6 +66,14 @@ namespace libp2p::multi::converters {
         } else {
           return ConversionError::NO_SUCH_PROTOCOL;
         }
+      } else if (protx->code == Protocol::Code::UNIX) {
+        // path protocol takes the rest of the address, slashes included
+        auto path = "/" + boost::algorithm::join(
+                        boost::make_iterator_range(it, tokens.end()), "/");
+        OUTCOME_TRY(val, addressToHex(*protx, path));
+        processed += val;
+        type = WordType::PROTOCOL;
+        break;
       } else {
         OUTCOME_TRY(val, addressToHex(*protx, word));
         processed += val;
@@ -89,6 +100,8 @@ namespace libp2p::multi::converters {
         return UdpConverter::addressToHex(addr);
       case Protocol::Code::P2P:
         return IpfsConverter::addressToHex(addr);
+      case Protocol::Code::MEMORY:
+        return MemoryConverter::addressToHex(addr);
 
       case Protocol::Code::DNS:
       case Protocol::Code::DNS4:
@@ -130,7 +143,25 @@ namespace libp2p::multi::converters {
         return ConversionError::NO_SUCH_PROTOCOL;
       }
 
-      if (protocol->name != "ipfs" and protocol->name != "p2p") {
+      if (protocol->code == Protocol::Code::UNIX) {
+        lastpos = lastpos
+            + UVarint::calculateSize(pid_bytes.subspan(lastpos / 2)) * 2;
+        UVarint path_size{pid_bytes.subspan(lastpos / 2)};
+        lastpos += path_size.size() * 2;
+        auto path_len = path_size.toUInt64();
+        if (lastpos / 2 + path_len > bytes.size()) {
+          return ConversionError::INVALID_ADDRESS;
+        }
+        auto path = pid_bytes.subspan(lastpos / 2, path_len);
+
+        results += "/";
+        results += protocol->name;
+        if (path.empty() || path[0] != '/') {
+          results += "/";
+        }
+        results.append(path.begin(), path.end());
+        lastpos += path_len * 2;
+      } else if (protocol->name != "ipfs" and protocol->name != "p2p") {
         lastpos = lastpos
             + UVarint::calculateSize(pid_bytes.subspan(lastpos / 2)) * 2;
         std::string address;
@@ -158,6 +189,8 @@ namespace libp2p::multi::converters {
             results += std::to_string(std::stoul(address, nullptr, 16));
           } else if (protocol->name == "udp") {
             results += std::to_string(std::stoul(address, nullptr, 16));
+          } else if (protocol->name == "memory") {
+            results += std::to_string(std::stoull(address, nullptr, 16));
           } else {
             return ConversionError::NOT_IMPLEMENTED;
           }
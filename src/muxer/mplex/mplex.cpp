@@ -10,7 +10,16 @@
 #include <libp2p/muxer/mplex/mplexed_connection.hpp>
 
 namespace libp2p::muxer {
-  Mplex::Mplex(MuxedConnectionConfig config) : config_{config} {}
+  Mplex::Mplex(MuxedConnectionConfig config,
+               std::shared_ptr<libp2p::event::Bus> bus,
+               std::shared_ptr<network::ResourceManager> rmgr,
+               std::shared_ptr<metrics::Registry> registry)
+      : config_{config},
+        bus_{std::move(bus)},
+        rmgr_{std::move(rmgr)},
+        metrics_{registry != nullptr
+                     ? std::make_shared<MuxerMetrics>(*registry, "mplex")
+                     : nullptr} {}
 
   peer::Protocol Mplex::getProtocolId() const noexcept {
     return "/mplex/6.7.0";
@@ -18,7 +27,7 @@ namespace libp2p::muxer {
 
   void Mplex::muxConnection(std::shared_ptr<connection::SecureConnection> conn,
                             CapConnCallbackFunc cb) const {
-    cb(std::make_shared<connection::MplexedConnection>(std::move(conn),
-                                                       config_));
+    cb(std::make_shared<connection::MplexedConnection>(
+        std::move(conn), config_, bus_, rmgr_, metrics_));
   }
 }  // namespace libp2p::muxer
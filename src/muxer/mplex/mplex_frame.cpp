@@ -24,6 +24,12 @@ namespace libp2p::connection {
     return result;
   }
 
+  size_t MplexFrame::size() const {
+    uint64_t id_and_flag = (stream_number << 3) | static_cast<uint8_t>(flag);
+    return multi::UVarint{id_and_flag}.size() + multi::UVarint{length}.size()
+        + data.size();
+  }
+
   common::ByteArray createFrameBytes(MplexFrame::Flag flag,
                                      MplexStream::StreamNumber stream_number,
                                      common::ByteArray data) {
@@ -7,6 +7,7 @@
 
 #include <algorithm>
 
+#include <boost/assert.hpp>
 #include <boost/container_hash/hash.hpp>
 #include <libp2p/muxer/mplex/mplexed_connection.hpp>
 
@@ -54,8 +55,13 @@ namespace libp2p::connection {
   }
 
   MplexStream::MplexStream(std::weak_ptr<MplexedConnection> connection,
-                           StreamId stream_id)
-      : connection_{std::move(connection)}, stream_id_{stream_id} {}
+                           StreamId stream_id,
+                           std::shared_ptr<const peer::PeerId> remote_peer)
+      : connection_{std::move(connection)},
+        stream_id_{stream_id},
+        remote_peer_{std::move(remote_peer)} {
+    BOOST_ASSERT(remote_peer_);
+  }
 
   void MplexStream::read(gsl::span<uint8_t> out, size_t bytes,
                          ReadCallbackFunc cb) {
@@ -207,9 +213,8 @@ namespace libp2p::connection {
     cb(outcome::success());
   }
 
-  outcome::result<peer::PeerId> MplexStream::remotePeerId() const {
-    TRY_GET_CONNECTION(conn)
-    return conn->remotePeer();
+  const peer::PeerId &MplexStream::remotePeerId() const {
+    return *remote_peer_;
   }
 
   outcome::result<bool> MplexStream::isInitiator() const {
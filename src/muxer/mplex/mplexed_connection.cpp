@@ -7,6 +7,7 @@
 
 #include <boost/assert.hpp>
 #include <libp2p/muxer/mplex/mplex_frame.hpp>
+#include <libp2p/network/connection_manager.hpp>
 
 OUTCOME_CPP_DEFINE_CATEGORY(libp2p::connection, MplexedConnection::Error, e) {
   using E = libp2p::connection::MplexedConnection::Error;
@@ -27,9 +28,28 @@ namespace libp2p::connection {
 
   MplexedConnection::MplexedConnection(
       std::shared_ptr<SecureConnection> connection,
-      muxer::MuxedConnectionConfig config)
-      : connection_{std::move(connection)}, config_{config} {
+      muxer::MuxedConnectionConfig config,
+      std::shared_ptr<libp2p::event::Bus> bus,
+      std::shared_ptr<network::ResourceManager> rmgr,
+      std::shared_ptr<muxer::MuxerMetrics> metrics)
+      : connection_{std::move(connection)},
+        config_{config},
+        bus_{std::move(bus)},
+        rmgr_{std::move(rmgr)},
+        metrics_{std::move(metrics)} {
     BOOST_ASSERT(connection_);
+    remote_peer_ =
+        std::make_shared<const peer::PeerId>(connection_->remotePeer());
+  }
+
+  MplexedConnection::~MplexedConnection() {
+    for (size_t i = 0; i < streams_.size(); ++i) {
+      releaseStream();
+    }
+    // the connection may be dropped without being closed
+    if (rmgr_ != nullptr && !closed_published_) {
+      rmgr_->releaseConnection(weak_from_this());
+    }
   }
 
   void MplexedConnection::start() {
@@ -55,36 +75,42 @@ namespace libp2p::connection {
     if (streams_.size() >= config_.maximum_streams) {
       return cb(Error::TOO_MANY_STREAMS);
     }
+    if (auto res = reserveStream(); !res) {
+      return cb(res.error());
+    }
 
     StreamId new_stream_id{last_issued_stream_number_++, true};
     auto new_stream_frame =
         createFrameBytes(MplexFrame::Flag::NEW_STREAM, new_stream_id.number);
+
+    // the stream is returned without waiting for the frame to be written, so
+    // that the first frames of the stream follow it back to back
+    auto new_stream = std::make_shared<MplexStream>(
+        weak_from_this(), new_stream_id, remote_peer_);
+    streams_[new_stream_id] = new_stream;
+
     write({std::move(new_stream_frame),
-           [self{shared_from_this()}, cb{std::move(cb)},
-            new_stream_id](auto &&create_res) {
+           [self{shared_from_this()}, new_stream_id](auto &&create_res) {
              if (!create_res) {
                self->log_->error("stream creation failed: {}",
                                  create_res.error().message());
-               return cb(create_res.error());
+               self->removeStream(new_stream_id);
              }
-
-             auto new_stream =
-                 std::make_shared<MplexStream>(self, new_stream_id);
-             self->streams_[new_stream_id] = new_stream;
-             cb(std::move(new_stream));
            }});
+
+    cb(std::move(new_stream));
   }
 
   void MplexedConnection::onStream(NewStreamHandlerFunc cb) {
     new_stream_handler_ = std::move(cb);
   }
 
-  outcome::result<peer::PeerId> MplexedConnection::localPeer() const {
+  const peer::PeerId &MplexedConnection::localPeer() const {
     return connection_->localPeer();
   }
 
-  outcome::result<peer::PeerId> MplexedConnection::remotePeer() const {
-    return connection_->remotePeer();
+  const peer::PeerId &MplexedConnection::remotePeer() const {
+    return *remote_peer_;
   }
 
   outcome::result<crypto::PublicKey> MplexedConnection::remotePublicKey()
@@ -92,6 +118,10 @@ namespace libp2p::connection {
     return connection_->remotePublicKey();
   }
 
+  size_t MplexedConnection::streamsCount() const {
+    return streams_.size();
+  }
+
   bool MplexedConnection::isInitiator() const noexcept {
     return connection_->isInitiator();
   }
@@ -107,8 +137,13 @@ namespace libp2p::connection {
   outcome::result<void> MplexedConnection::close() {
     is_active_ = false;
     resetAllStreams();
+    for (size_t i = 0; i < streams_.size(); ++i) {
+      releaseStream();
+    }
     streams_.clear();
-    return connection_->close();
+    auto res = connection_->close();
+    publishClosed();
+    return res;
   }
 
   bool MplexedConnection::isClosed() const {
@@ -165,6 +200,9 @@ namespace libp2p::connection {
   void MplexedConnection::onWriteCompleted(outcome::result<size_t> write_res) {
     if (!write_res) {
       log_->error("data write failed: {}", write_res.error().message());
+    } else if (metrics_ != nullptr) {
+      metrics_->frames_out->inc();
+      metrics_->bytes_out->inc(write_res.value());
     }
 
     write_queue_.front().cb(std::forward<decltype(write_res)>(write_res));
@@ -185,6 +223,10 @@ namespace libp2p::connection {
                   return self->closeSession();
                 }
 
+                if (self->metrics_ != nullptr) {
+                  self->metrics_->frames_in->inc();
+                  self->metrics_->bytes_in->inc(frame_res.value().size());
+                }
                 self->processFrame(std::move(frame_res.value()));
               });
   }
@@ -226,13 +268,14 @@ namespace libp2p::connection {
 
   void MplexedConnection::processNewStreamFrame(const MplexFrame &frame,
                                                 StreamId stream_id) {
-    if (streams_.size() >= config_.maximum_streams || !new_stream_handler_) {
+    if (streams_.size() >= config_.maximum_streams || !new_stream_handler_
+        || !reserveStream()) {
       return resetStream(stream_id);
     }
 
     log_->info("accepting a new stream with {}", stream_id.toString());
-    auto new_stream =
-        std::make_shared<MplexStream>(weak_from_this(), stream_id);
+    auto new_stream = std::make_shared<MplexStream>(weak_from_this(),
+                                                    stream_id, remote_peer_);
     streams_[stream_id] = new_stream;
     new_stream_handler_(std::move(new_stream));
   }
@@ -291,6 +334,7 @@ namespace libp2p::connection {
   void MplexedConnection::removeStream(StreamId stream_id) {
     if (auto stream_opt = findStream(stream_id); stream_opt) {
       streams_.erase(stream_id);
+      releaseStream();
       (*stream_opt)->is_writable_ = false;
       (*stream_opt)->is_readable_ = false;
     }
@@ -316,6 +360,41 @@ namespace libp2p::connection {
     }
   }
 
+  void MplexedConnection::publishClosed() {
+    if (closed_published_) {
+      return;
+    }
+    closed_published_ = true;
+    if (rmgr_ != nullptr) {
+      rmgr_->releaseConnection(weak_from_this());
+    }
+    if (bus_ == nullptr) {
+      return;
+    }
+    bus_->getChannel<network::event::OnConnectionClosedChannel>().publish(
+        weak_from_this());
+  }
+
+  outcome::result<void> MplexedConnection::reserveStream() {
+    if (rmgr_ != nullptr) {
+      OUTCOME_TRY(
+          rmgr_->reserveStream(*remote_peer_, MplexStream::kInitialWindowSize));
+    }
+    if (metrics_ != nullptr) {
+      metrics_->streams->inc();
+    }
+    return outcome::success();
+  }
+
+  void MplexedConnection::releaseStream() {
+    if (rmgr_ != nullptr) {
+      rmgr_->releaseStream(*remote_peer_, MplexStream::kInitialWindowSize);
+    }
+    if (metrics_ != nullptr) {
+      metrics_->streams->dec();
+    }
+  }
+
   void MplexedConnection::closeSession() {
     auto close_res = close();
     if (!close_res) {
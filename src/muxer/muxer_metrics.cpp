@@ -0,0 +1,31 @@
+/**
+ * Copyright Soramitsu Co., Ltd. All Rights Reserved.
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <libp2p/muxer/muxer_metrics.hpp>
+
+namespace libp2p::muxer {
+
+  namespace {
+    constexpr auto kBytes = "libp2p_muxer_bytes_total";
+    constexpr auto kBytesHelp = "Bytes, read and written by the muxers";
+    constexpr auto kFrames = "libp2p_muxer_frames_total";
+    constexpr auto kFramesHelp = "Frames, read and written by the muxers";
+  }  // namespace
+
+  MuxerMetrics::MuxerMetrics(metrics::Registry &registry,
+                             const std::string &muxer)
+      : bytes_in{registry.counter(kBytes, kBytesHelp,
+                                  {{"muxer", muxer}, {"direction", "in"}})},
+        bytes_out{registry.counter(kBytes, kBytesHelp,
+                                   {{"muxer", muxer}, {"direction", "out"}})},
+        frames_in{registry.counter(kFrames, kFramesHelp,
+                                   {{"muxer", muxer}, {"direction", "in"}})},
+        frames_out{registry.counter(kFrames, kFramesHelp,
+                                    {{"muxer", muxer}, {"direction", "out"}})},
+        streams{registry.gauge("libp2p_muxer_streams",
+                               "Open streams of the muxed connections",
+                               {{"muxer", muxer}})} {}
+
+}  // namespace libp2p::muxer
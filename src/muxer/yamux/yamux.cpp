@@ -8,7 +8,16 @@
 #include <libp2p/muxer/yamux/yamuxed_connection.hpp>
 
 namespace libp2p::muxer {
-  Yamux::Yamux(MuxedConnectionConfig config) : config_{config} {}
+  Yamux::Yamux(MuxedConnectionConfig config,
+               std::shared_ptr<libp2p::event::Bus> bus,
+               std::shared_ptr<network::ResourceManager> rmgr,
+               std::shared_ptr<metrics::Registry> registry)
+      : config_{config},
+        bus_{std::move(bus)},
+        rmgr_{std::move(rmgr)},
+        metrics_{registry != nullptr
+                     ? std::make_shared<MuxerMetrics>(*registry, "yamux")
+                     : nullptr} {}
 
   peer::Protocol Yamux::getProtocolId() const noexcept {
     return "/yamux/1.0.0";
@@ -16,7 +25,7 @@ namespace libp2p::muxer {
 
   void Yamux::muxConnection(std::shared_ptr<connection::SecureConnection> conn,
                             CapConnCallbackFunc cb) const {
-    cb(std::make_shared<connection::YamuxedConnection>(std::move(conn),
-                                                       config_));
+    cb(std::make_shared<connection::YamuxedConnection>(
+        std::move(conn), config_, bus_, rmgr_, metrics_));
   }
 }  // namespace libp2p::muxer
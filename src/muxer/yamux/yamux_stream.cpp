@@ -5,6 +5,8 @@
 
 #include <libp2p/muxer/yamux/yamux_stream.hpp>
 
+#include <boost/assert.hpp>
+
 OUTCOME_CPP_DEFINE_CATEGORY(libp2p::connection, YamuxStream::Error, e) {
   using E = libp2p::connection::YamuxStream::Error;
   switch (e) {
@@ -35,10 +37,14 @@ namespace libp2p::connection {
 
   YamuxStream::YamuxStream(std::weak_ptr<YamuxedConnection> yamuxed_connection,
                            YamuxedConnection::StreamId stream_id,
-                           uint32_t maximum_window_size)
+                           uint32_t maximum_window_size,
+                           std::shared_ptr<const peer::PeerId> remote_peer)
       : yamuxed_connection_{std::move(yamuxed_connection)},
         stream_id_{stream_id},
-        maximum_window_size_{maximum_window_size} {}
+        remote_peer_{std::move(remote_peer)},
+        maximum_window_size_{maximum_window_size} {
+    BOOST_ASSERT(remote_peer_);
+  }
 
   void YamuxStream::read(gsl::span<uint8_t> out, size_t bytes,
                          ReadCallbackFunc cb) {
@@ -247,11 +253,8 @@ namespace libp2p::connection {
         });
   }
 
-  outcome::result<peer::PeerId> YamuxStream::remotePeerId() const {
-    if (auto conn = yamuxed_connection_.lock()) {
-      return conn->remotePeer();
-    }
-    return Error::CONNECTION_IS_DEAD;
+  const peer::PeerId &YamuxStream::remotePeerId() const {
+    return *remote_peer_;
   }
 
   outcome::result<bool> YamuxStream::isInitiator() const {
@@ -8,6 +8,7 @@
 
 #include <libp2p/muxer/yamux/yamux_frame.hpp>
 #include <libp2p/muxer/yamux/yamux_stream.hpp>
+#include <libp2p/network/connection_manager.hpp>
 
 using Buffer = libp2p::common::ByteArray;
 
@@ -34,15 +35,34 @@ OUTCOME_CPP_DEFINE_CATEGORY(libp2p::connection, YamuxedConnection::Error, e) {
 namespace libp2p::connection {
   YamuxedConnection::YamuxedConnection(
       std::shared_ptr<SecureConnection> connection,
-      muxer::MuxedConnectionConfig config)
+      muxer::MuxedConnectionConfig config,
+      std::shared_ptr<libp2p::event::Bus> bus,
+      std::shared_ptr<network::ResourceManager> rmgr,
+      std::shared_ptr<muxer::MuxerMetrics> metrics)
       : header_buffer_(YamuxFrame::kHeaderLength, 0),
         data_buffer_(config.maximum_window_size, 0),
         connection_{std::move(connection)},
-        config_{config} {
+        remote_peer_{
+            std::make_shared<const peer::PeerId>(connection_->remotePeer())},
+        config_{config},
+        bus_{std::move(bus)},
+        rmgr_{std::move(rmgr)},
+        metrics_{std::move(metrics)} {
     // client uses odd numbers, server - even
     last_created_stream_id_ = connection_->isInitiator() ? 1 : 2;
   }
 
+  YamuxedConnection::~YamuxedConnection() {
+    // the streams and the connection are left here, if the session was
+    // terminated by the other side and never closed
+    for (size_t i = 0; i < streams_.size(); ++i) {
+      releaseStream();
+    }
+    if (rmgr_ != nullptr && !closed_published_) {
+      rmgr_->releaseConnection(weak_from_this());
+    }
+  }
+
   void YamuxedConnection::start() {
     BOOST_ASSERT_MSG(!started_,
                      "YamuxedConnection already started (double start)");
@@ -63,38 +83,41 @@ namespace libp2p::connection {
     if (streams_.size() >= config_.maximum_streams) {
       return cb(Error::TOO_MANY_STREAMS);
     }
+    if (auto res = reserveStream(); !res) {
+      return cb(res.error());
+    }
 
     auto stream_id = getNewStreamId();
 
-    new_stream_pending_ = true;
-
-    write(
-        {newStreamMsg(stream_id),
-         [self{shared_from_this()}, cb = std::move(cb), stream_id](auto &&res) {
-           if (!res) {
-             return cb(res.error());
-           }
-           auto created_stream =
-               std::make_shared<YamuxStream>(self->weak_from_this(), stream_id,
-                                             self->config_.maximum_window_size);
-           self->streams_.insert({stream_id, created_stream});
+    // the stream is returned without waiting for the SYN to be written: the
+    // frames of the stream are queued after it, so the protocol negotiation
+    // and the first request follow the SYN back to back
+    auto new_stream = std::make_shared<YamuxStream>(
+        weak_from_this(), stream_id, config_.maximum_window_size, remote_peer_);
+    streams_.insert({stream_id, new_stream});
 
-           self->new_stream_pending_ = false;
+    write({newStreamMsg(stream_id),
+           [self{shared_from_this()}, stream_id](auto &&res) {
+             if (!res) {
+               self->log_->error("cannot open new stream: {}",
+                                 res.error().message());
+               self->removeStream(stream_id);
+             }
+           }});
 
-           return cb(std::move(created_stream));
-         }});
+    return cb(std::move(new_stream));
   }
 
   void YamuxedConnection::onStream(NewStreamHandlerFunc cb) {
     new_stream_handler_ = std::move(cb);
   }
 
-  outcome::result<peer::PeerId> YamuxedConnection::localPeer() const {
+  const peer::PeerId &YamuxedConnection::localPeer() const {
     return connection_->localPeer();
   }
 
-  outcome::result<peer::PeerId> YamuxedConnection::remotePeer() const {
-    return connection_->remotePeer();
+  const peer::PeerId &YamuxedConnection::remotePeer() const {
+    return *remote_peer_;
   }
 
   outcome::result<crypto::PublicKey> YamuxedConnection::remotePublicKey()
@@ -102,6 +125,10 @@ namespace libp2p::connection {
     return connection_->remotePublicKey();
   }
 
+  size_t YamuxedConnection::streamsCount() const {
+    return streams_.size();
+  }
+
   bool YamuxedConnection::isInitiator() const noexcept {
     return connection_->isInitiator();
   }
@@ -117,10 +144,15 @@ namespace libp2p::connection {
   outcome::result<void> YamuxedConnection::close() {
     started_ = false;
     resetAllStreams();
+    for (size_t i = 0; i < streams_.size(); ++i) {
+      releaseStream();
+    }
     streams_.clear();
     window_updates_subs_.clear();
     data_subs_.clear();
-    return connection_->close();
+    auto res = connection_->close();
+    publishClosed();
+    return res;
   }
 
   bool YamuxedConnection::isClosed() const {
@@ -178,6 +210,10 @@ namespace libp2p::connection {
 
   void YamuxedConnection::writeCompleted(outcome::result<size_t> res) {
     const auto &data = write_queue_.front();
+    if (res && metrics_ != nullptr) {
+      metrics_->frames_out->inc();
+      metrics_->bytes_out->inc(res.value());
+    }
     if (res) {
       data.cb(res.value() - YamuxFrame::kHeaderLength);
     } else {
@@ -206,7 +242,7 @@ namespace libp2p::connection {
     if (!res) {
       if (res.error().value() == boost::asio::error::eof) {
         log_->info("the client has closed a session");
-        return;
+        return publishClosed();
       }
       log_->error(
           "cannot read header from the connection: {}; closing the session",
@@ -221,6 +257,10 @@ namespace libp2p::connection {
           "session");
       return closeSession();
     }
+    if (metrics_ != nullptr) {
+      metrics_->frames_in->inc();
+      metrics_->bytes_in->inc(YamuxFrame::kHeaderLength);
+    }
 
     switch (header_opt->type) {
       case FrameType::DATA:
@@ -242,6 +282,9 @@ namespace libp2p::connection {
     return connection_->read(
         data_buffer_, data_size,
         [self{shared_from_this()}, cb = std::move(cb)](auto &&res) {
+          if (res && self->metrics_ != nullptr) {
+            self->metrics_->bytes_in->inc(res.value());
+          }
           cb(std::forward<decltype(res)>(res));
         });
   }
@@ -266,7 +309,10 @@ namespace libp2p::connection {
         return closeSession();
       }
 
-      if (streams_.size() < config_.maximum_streams && new_stream_handler_) {
+      // the resource manager is asked last, so that nothing is reserved for
+      // a stream, rejected for another reason
+      if (streams_.size() < config_.maximum_streams && new_stream_handler_
+          && reserveStream()) {
         stream = registerNewStream(stream_id);
       } else {
         // if we cannot accept another stream, reset it on the other side
@@ -338,6 +384,7 @@ namespace libp2p::connection {
   void YamuxedConnection::processGoAwayFrame(const YamuxFrame &frame) {
     started_ = false;
     resetAllStreams();
+    publishClosed();
   }
 
   std::shared_ptr<YamuxStream> YamuxedConnection::findStream(
@@ -353,7 +400,7 @@ namespace libp2p::connection {
       StreamId stream_id) {
     // optimistic approach: assuming ACK will be successfully written
     auto new_stream = std::make_shared<YamuxStream>(
-        weak_from_this(), stream_id, config_.maximum_window_size);
+        weak_from_this(), stream_id, config_.maximum_window_size, remote_peer_);
     streams_.insert({stream_id, new_stream});
     new_stream_handler_(new_stream);
 
@@ -467,10 +514,11 @@ namespace libp2p::connection {
   void YamuxedConnection::removeStream(StreamId stream_id) {
     if (auto stream = findStream(stream_id)) {
       streams_.erase(stream_id);
+      releaseStream();
       stream->resetStream();
 
       // TODO(artem): temporarily cleanup itself!
-//      if (streams_.empty() && !new_stream_pending_) {
+//      if (streams_.empty()) {
 //        auto res = close();
 //        if (!res) {
 //          log_->error("cannot close connection: {} ", res.error().message());
@@ -489,6 +537,7 @@ namespace libp2p::connection {
     return write({goAwayMsg(YamuxFrame::GoAwayError::PROTOCOL_ERROR),
                   [self{shared_from_this()}](auto &&res) {
                     self->started_ = false;
+                    self->publishClosed();
                     if (!res) {
                       self->log_->error("cannot close a Yamux session: {} ",
                                         res.error().message());
@@ -498,6 +547,41 @@ namespace libp2p::connection {
                   }});
   }
 
+  void YamuxedConnection::publishClosed() {
+    if (closed_published_) {
+      return;
+    }
+    closed_published_ = true;
+    if (rmgr_ != nullptr) {
+      rmgr_->releaseConnection(weak_from_this());
+    }
+    if (bus_ == nullptr) {
+      return;
+    }
+    bus_->getChannel<network::event::OnConnectionClosedChannel>().publish(
+        weak_from_this());
+  }
+
+  outcome::result<void> YamuxedConnection::reserveStream() {
+    if (rmgr_ != nullptr) {
+      OUTCOME_TRY(
+          rmgr_->reserveStream(*remote_peer_, config_.maximum_window_size));
+    }
+    if (metrics_ != nullptr) {
+      metrics_->streams->inc();
+    }
+    return outcome::success();
+  }
+
+  void YamuxedConnection::releaseStream() {
+    if (rmgr_ != nullptr) {
+      rmgr_->releaseStream(*remote_peer_, config_.maximum_window_size);
+    }
+    if (metrics_ != nullptr) {
+      metrics_->streams->dec();
+    }
+  }
+
   void YamuxedConnection::streamOnWindowUpdate(StreamId stream_id,
                                                NotifyeeCallback cb) {
     window_updates_subs_[stream_id] = std::move(cb);
@@ -0,0 +1,43 @@
+/**
+ * Copyright Soramitsu Co., Ltd. All Rights Reserved.
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <libp2p/network/impl/blocklist_gater.hpp>
+
+namespace libp2p::network {
+
+  bool BlocklistGater::blockSubnet(const boost::asio::ip::address &address,
+                                   uint8_t prefix_length) {
+    return subnets_.insert(address, prefix_length);
+  }
+
+  bool BlocklistGater::unblockSubnet(const boost::asio::ip::address &address,
+                                     uint8_t prefix_length) {
+    return subnets_.erase(address, prefix_length);
+  }
+
+  void BlocklistGater::blockPeer(const peer::PeerId &peer) {
+    peers_.insert(peer);
+  }
+
+  void BlocklistGater::unblockPeer(const peer::PeerId &peer) {
+    peers_.erase(peer);
+  }
+
+  bool BlocklistGater::interceptAccept(
+      const boost::asio::ip::address &remote) const {
+    return !subnets_.contains(remote);
+  }
+
+  bool BlocklistGater::interceptSecured(const peer::PeerId &peer) const {
+    return peers_.count(peer) == 0;
+  }
+
+  bool BlocklistGater::interceptUpgraded(
+      const connection::CapableConnection &conn) const {
+    // the peer may be blocked, while the connection is being muxed
+    return interceptSecured(conn.remotePeer());
+  }
+
+}  // namespace libp2p::network
@@ -0,0 +1,119 @@
+/**
+ * Copyright Soramitsu Co., Ltd. All Rights Reserved.
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <libp2p/network/impl/cidr_trie.hpp>
+
+namespace libp2p::network {
+
+  namespace {
+    /// bits, which an IPv4 address is preceded by in the mapped one
+    constexpr size_t kV4MappedPrefix = 96;
+  }  // namespace
+
+  CidrTrie::CidrTrie() : nodes_(1) {}
+
+  bool CidrTrie::insert(const boost::asio::ip::address &address,
+                        uint8_t prefix_length) {
+    size_t key_prefix = 0;
+    if (!keyPrefix(address, prefix_length, key_prefix)) {
+      return false;
+    }
+    auto key = makeKey(address);
+
+    uint32_t node = 0;
+    for (size_t i = 0; i < key_prefix; ++i) {
+      auto bit = bitAt(key, i);
+      if (nodes_[node].children[bit] == kNoChild) {
+        nodes_[node].children[bit] = static_cast<uint32_t>(nodes_.size());
+        nodes_.emplace_back();
+      }
+      node = nodes_[node].children[bit];
+    }
+    if (!nodes_[node].terminal) {
+      nodes_[node].terminal = true;
+      ++subnets_;
+    }
+    return true;
+  }
+
+  bool CidrTrie::erase(const boost::asio::ip::address &address,
+                       uint8_t prefix_length) {
+    size_t key_prefix = 0;
+    if (!keyPrefix(address, prefix_length, key_prefix)) {
+      return false;
+    }
+    auto node = find(makeKey(address), key_prefix);
+    if (node == kNotFound || !nodes_[node].terminal) {
+      return false;
+    }
+    // the nodes stay allocated: removals are rare, and the trie is small
+    nodes_[node].terminal = false;
+    --subnets_;
+    return true;
+  }
+
+  bool CidrTrie::contains(const boost::asio::ip::address &address) const {
+    if (subnets_ == 0) {
+      return false;
+    }
+    auto key = makeKey(address);
+    uint32_t node = 0;
+    for (size_t i = 0; i < key.size() * 8; ++i) {
+      if (nodes_[node].terminal) {
+        return true;
+      }
+      node = nodes_[node].children[bitAt(key, i)];
+      if (node == kNoChild) {
+        return false;
+      }
+    }
+    return nodes_[node].terminal;
+  }
+
+  bool CidrTrie::empty() const {
+    return subnets_ == 0;
+  }
+
+  CidrTrie::Key CidrTrie::makeKey(const boost::asio::ip::address &address) {
+    if (address.is_v4()) {
+      return boost::asio::ip::make_address_v6(boost::asio::ip::v4_mapped,
+                                              address.to_v4())
+          .to_bytes();
+    }
+    return address.to_v6().to_bytes();
+  }
+
+  bool CidrTrie::keyPrefix(const boost::asio::ip::address &address,
+                           uint8_t prefix_length, size_t &key_prefix) {
+    if (address.is_v4()) {
+      if (prefix_length > 32) {
+        return false;
+      }
+      key_prefix = kV4MappedPrefix + prefix_length;
+      return true;
+    }
+    if (prefix_length > 128) {
+      return false;
+    }
+    key_prefix = prefix_length;
+    return true;
+  }
+
+  uint32_t CidrTrie::find(const Key &key, size_t key_prefix) const {
+    uint32_t node = 0;
+    for (size_t i = 0; i < key_prefix; ++i) {
+      node = nodes_[node].children[bitAt(key, i)];
+      if (node == kNoChild) {
+        return kNotFound;
+      }
+    }
+    return node;
+  }
+
+  uint8_t CidrTrie::bitAt(const Key &key, size_t index) {
+    return (key[index / 8] >> (7 - index % 8)) & 1u;
+  }
+
+}  // namespace libp2p::network
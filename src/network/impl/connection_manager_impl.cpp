@@ -6,6 +6,7 @@
 #include <libp2p/network/impl/connection_manager_impl.hpp>
 
 #include <algorithm>
+#include <tuple>
 
 namespace libp2p::network {
 
@@ -21,14 +22,51 @@ namespace libp2p::network {
 
   ConnectionManager::ConnectionSPtr
   ConnectionManagerImpl::getBestConnectionForPeer(const peer::PeerId &p) const {
-    // TODO(warchant): maybe make pluggable strategies
-    auto c = getConnectionsToPeer(p);
-    if (c.empty()) {
+    auto it = connections_.find(p);
+    if (it == connections_.end()) {
       return nullptr;
     }
 
-    // for now, return first connection
-    return c[0];
+    const ConnectionSPtr *best = nullptr;
+    for (const auto &conn : it->second) {
+      if (conn == nullptr || conn->isClosed()) {
+        continue;
+      }
+      if (best == nullptr || isBetter(*conn, **best)) {
+        best = &conn;
+      }
+    }
+    return best != nullptr ? *best : nullptr;
+  }
+
+  bool ConnectionManagerImpl::isBetter(const Connection &lhs,
+                                       const Connection &rhs) const {
+    auto rtt = [this](const Connection &conn) {
+      auto it = rtts_.find(&conn);
+      return it != rtts_.end() ? it->second
+                               : std::chrono::microseconds::max();
+    };
+    // the least loaded, then the fastest; inbound connections are muxed as
+    // well as outbound ones, so direction only breaks ties
+    return std::make_tuple(lhs.streamsCount(), rtt(lhs), !lhs.isInitiator())
+        < std::make_tuple(rhs.streamsCount(), rtt(rhs), !rhs.isInitiator());
+  }
+
+  void ConnectionManagerImpl::reportRtt(const ConnectionSPtr &c,
+                                        std::chrono::microseconds rtt) {
+    auto it = connections_.find(c->remotePeer());
+    if (it == connections_.end()
+        || std::find(it->second.begin(), it->second.end(), c)
+            == it->second.end()) {
+      return;
+    }
+
+    // smoothed as TCP does (RFC 6298), so that a single slow round trip does
+    // not make the connection the worst one
+    auto [srtt, inserted] = rtts_.emplace(c.get(), rtt);
+    if (!inserted) {
+      srtt->second = (srtt->second * 7 + rtt) / 8;
+    }
   }
 
   ConnectionManager::Connectedness ConnectionManagerImpl::connectedness(
@@ -74,10 +112,16 @@ namespace libp2p::network {
     auto it = connections_.find(p);
     if (it == connections_.end()) {
       connections_.insert({p, {c}});
+      connected_since_.emplace(p, Clock::now());
     } else {
       connections_[p].push_back(c);
     }
     bus_->getChannel<event::OnNewConnectionChannel>().publish(c);
+
+    if (config_.high_watermark != 0
+        && connectionsCount() > config_.high_watermark) {
+      scheduleTrim();
+    }
   }
 
   std::vector<ConnectionManager::ConnectionSPtr>
@@ -94,33 +138,172 @@ namespace libp2p::network {
 
   ConnectionManagerImpl::ConnectionManagerImpl(
       std::shared_ptr<libp2p::event::Bus> bus,
-      std::shared_ptr<TransportManager> tmgr)
-      : transport_manager_(std::move(tmgr)), bus_(std::move(bus)) {
+      std::shared_ptr<TransportManager> tmgr,
+      std::shared_ptr<boost::asio::io_context> context,
+      std::shared_ptr<PeerScorer> scorer, ConnectionManagerConfig config)
+      : transport_manager_(std::move(tmgr)),
+        bus_(std::move(bus)),
+        context_(std::move(context)),
+        scorer_(std::move(scorer)),
+        config_(config),
+        trim_timer_(*context_) {
     BOOST_ASSERT(transport_manager_ != nullptr);
+    BOOST_ASSERT(scorer_ != nullptr);
+    BOOST_ASSERT(config_.low_watermark <= config_.high_watermark);
+
+    // connections are forgotten as soon as they are terminated, so that
+    // garbage collection is only a fallback
+    closed_sub_ =
+        bus_->getChannel<event::OnConnectionClosedChannel>().subscribe(
+            [this](const std::weak_ptr<connection::CapableConnection> &conn) {
+              if (auto c = conn.lock()) {
+                onConnectionClosed(c);
+              }
+            });
+  }
+
+  size_t ConnectionManagerImpl::connectionsCount() const {
+    size_t count = 0;
+    for (const auto &entry : connections_) {
+      count += entry.second.size();
+    }
+    return count;
+  }
+
+  void ConnectionManagerImpl::scheduleTrim() {
+    if (trim_scheduled_) {
+      return;
+    }
+    trim_scheduled_ = true;
+
+    // the timer expires at once, if the silence period is over, but the
+    // trim is run by the context anyway, and not by the caller
+    trim_timer_.expires_at(
+        std::max(Clock::now(), last_trim_ + config_.silence_period));
+    trim_timer_.async_wait(
+        [wptr{weak_from_this()}](const boost::system::error_code &ec) {
+          auto self = wptr.lock();
+          if (!self || ec) {
+            return;
+          }
+          self->trim_scheduled_ = false;
+          self->trim();
+        });
+  }
+
+  void ConnectionManagerImpl::trim() {
+    last_trim_ = Clock::now();
+    collectGarbage();
+
+    auto count = connectionsCount();
+    if (count <= config_.low_watermark) {
+      return;
+    }
+
+    struct Candidate {
+      peer::PeerId peer;
+      int64_t score;
+    };
+    std::vector<Candidate> candidates;
+    for (const auto &[peer, conns] : connections_) {
+      if (last_trim_ - connected_since_.at(peer) < config_.grace_period
+          || scorer_->isProtected(peer)) {
+        continue;
+      }
+      candidates.push_back({peer, scorer_->score(peer, conns)});
+    }
+    std::stable_sort(candidates.begin(), candidates.end(),
+                     [](const Candidate &lhs, const Candidate &rhs) {
+                       return lhs.score < rhs.score;
+                     });
+
+    for (const auto &candidate : candidates) {
+      if (count <= config_.low_watermark) {
+        break;
+      }
+      count -= connections_.at(candidate.peer).size();
+      closeConnectionsToPeer(candidate.peer);
+    }
   }
 
   void ConnectionManagerImpl::collectGarbage() {
     for (auto it = connections_.begin(); it != connections_.end();) {
-      auto &vec = it->second;
-
-      // remove all nullptr and closed connections
-      vec.erase(std::remove_if(vec.begin(), vec.end(),
-                               [](auto &&conn) {
-                                 return conn == nullptr || conn->isClosed();
-                               }),
-                vec.end());
-
-      // if peer has no connections, remove peer
-      if (vec.empty()) {
-        it = connections_.erase(it);
-      } else {
-        ++it;
+      it = collectPeerGarbage(it);
+    }
+    gc_cursor_.reset();
+  }
+
+  bool ConnectionManagerImpl::collectGarbageStep(size_t max_entries) {
+    auto peer = connections_.begin();
+    if (gc_cursor_) {
+      // if the peer has gone, the pass is started over
+      if (auto it = connections_.find(*gc_cursor_); it != connections_.end()) {
+        peer = it;
       }
     }
+
+    size_t visited = 0;
+    while (peer != connections_.end() && visited < max_entries) {
+      visited += peer->second.size() + 1;
+      peer = collectPeerGarbage(peer);
+    }
+
+    if (peer == connections_.end()) {
+      gc_cursor_.reset();
+      return true;
+    }
+    gc_cursor_ = peer->first;
+    return false;
+  }
+
+  ConnectionManagerImpl::PeerConnections::iterator
+  ConnectionManagerImpl::collectPeerGarbage(PeerConnections::iterator peer) {
+    auto &vec = peer->second;
+
+    // remove all nullptr and closed connections
+    vec.erase(std::remove_if(vec.begin(), vec.end(),
+                             [this](auto &&conn) {
+                               if (conn == nullptr || conn->isClosed()) {
+                                 rtts_.erase(conn.get());
+                                 return true;
+                               }
+                               return false;
+                             }),
+              vec.end());
+
+    // if peer has no connections, remove peer
+    if (vec.empty()) {
+      connected_since_.erase(peer->first);
+      return connections_.erase(peer);
+    }
+    return ++peer;
+  }
+
+  void ConnectionManagerImpl::onConnectionClosed(const ConnectionSPtr &conn) {
+    auto peer = connections_.find(conn->remotePeer());
+    if (peer == connections_.end()) {
+      return;
+    }
+    auto &vec = peer->second;
+    auto it = std::find(vec.begin(), vec.end(), conn);
+    if (it == vec.end()) {
+      return;
+    }
+
+    rtts_.erase(conn.get());
+    vec.erase(it);
+    if (vec.empty()) {
+      connected_since_.erase(peer->first);
+      connections_.erase(peer);
+    }
   }
 
   void ConnectionManagerImpl::closeConnectionsToPeer(const peer::PeerId &p) {
     for (auto &&conn : getConnectionsToPeer(p)) {
+      if (conn == nullptr) {
+        continue;
+      }
+      rtts_.erase(conn.get());
       if (!conn->isClosed()) {
         // ignore errors
         (void)conn->close();
@@ -128,6 +311,7 @@ namespace libp2p::network {
     }
 
     connections_.erase(p);
+    connected_since_.erase(p);
   }
 
 }  // namespace libp2p::network
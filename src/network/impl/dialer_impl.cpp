@@ -11,13 +11,10 @@ namespace libp2p::network {
 
   void DialerImpl::dial(const peer::PeerInfo &p, DialResultFunc cb) {
     if (auto c = cmgr_->getBestConnectionForPeer(p.id); c != nullptr) {
-      // we have connection to this peer
+      // we have connection to this peer; it is muxed, so streams can be
+      // opened over it, whichever side has dialed it
       log_->debug("dialer: found reusable connection");
-
-      if (c->isInitiator()) {
-        // TODO(artem): dont reuse connections in opposite direction temporarily
-        return cb(std::move(c));
-      }
+      return cb(std::move(c));
     }
 
     // we don't have a connection to this peer.
@@ -27,22 +24,42 @@ namespace libp2p::network {
       return cb(std::errc::destination_address_required);
     }
 
+    // do not dial at all, if the connection is not going to be accepted
+    if (auto res = rmgr_->checkConnection(p.id); !res) {
+      return cb(res.error());
+    }
+
     // for all multiaddresses supplied in peerinfo
     for (auto &&ma : p.addresses) {
       // try to find best possible transport
       if (auto tr = this->tmgr_->findBest(ma); tr != nullptr) {
         // we can dial to this peer!
         // dial using best transport
+        if (dials_ != nullptr) {
+          dials_->inc();
+        }
         return tr->dial(
             p.id, ma,
-            [this, cb{std::move(cb)}, pid{p.id}](
+            [this, cb{std::move(cb)}, pid{p.id},
+             start{metrics::Histogram::Clock::now()}](
                 outcome::result<std::shared_ptr<connection::CapableConnection>>
                     rconn) {
               if (!rconn) {
+                if (this->dial_failures_ != nullptr) {
+                  this->dial_failures_->inc();
+                }
                 return cb(rconn.error());
               }
+              if (this->dial_duration_ != nullptr) {
+                this->dial_duration_->recordSince(start);
+              }
 
               auto &&conn = rconn.value();
+              // other connections may be established during the dial
+              if (auto res = this->rmgr_->reserveConnection(conn); !res) {
+                (void)conn->close();
+                return cb(res.error());
+              }
               this->cmgr_->addConnectionToPeer(pid, conn);
 
               // return connection to the user
@@ -74,7 +91,8 @@ namespace libp2p::network {
                 "dialer: opening outbound stream inside inbound connection");
           }
 
-          // 2. open new stream on that connection
+          // 2. open new stream on that connection; the muxer returns it
+          // before the frame, which opens it, is written
           conn->newStream(
               [this, cb{std::move(cb)},
                protocol](outcome::result<std::shared_ptr<connection::Stream>>
@@ -86,7 +104,24 @@ namespace libp2p::network {
 
                 log_->debug("dialer: inside newStream callback");
 
-                // 3. negotiate a protocol over that stream
+                // the protocol is accounted before anything is sent for it
+                if (auto res =
+                        this->rmgr_->reserveProtocolStream(protocol, stream);
+                    !res) {
+                  stream->reset();
+                  return cb(res.error());
+                }
+                this->countStream(protocol);
+
+                // 3. if allowed, select the protocol without waiting for the
+                // other side: its first bytes go with the proposal, and the
+                // stream is returned to the user at once
+                if (this->config_.optimistic_select) {
+                  return cb(this->multiselect_->selectOptimistically(
+                      protocol, std::move(stream)));
+                }
+
+                // 3. otherwise negotiate a protocol over that stream
                 std::vector<peer::Protocol> protocols{protocol};
                 this->multiselect_->selectOneOf(
                     protocols, stream, true /* initiator */,
@@ -106,13 +141,43 @@ namespace libp2p::network {
   DialerImpl::DialerImpl(
       std::shared_ptr<protocol_muxer::ProtocolMuxer> multiselect,
       std::shared_ptr<TransportManager> tmgr,
-      std::shared_ptr<ConnectionManager> cmgr)
+      std::shared_ptr<ConnectionManager> cmgr,
+      std::shared_ptr<ResourceManager> rmgr, DialerConfig config,
+      std::shared_ptr<metrics::Registry> registry)
       : multiselect_(std::move(multiselect)),
         tmgr_(std::move(tmgr)),
-        cmgr_(std::move(cmgr)) {
+        cmgr_(std::move(cmgr)),
+        rmgr_(std::move(rmgr)),
+        config_(config),
+        registry_(std::move(registry)) {
     BOOST_ASSERT(multiselect_ != nullptr);
     BOOST_ASSERT(tmgr_ != nullptr);
     BOOST_ASSERT(cmgr_ != nullptr);
+    BOOST_ASSERT(rmgr_ != nullptr);
+
+    if (registry_ != nullptr) {
+      dials_ = registry_->counter("libp2p_dials_total",
+                                  "Connections, dialed to the peers");
+      dial_failures_ = registry_->counter(
+          "libp2p_dial_failures_total",
+          "Dials, which failed to connect or to upgrade the connection");
+      dial_duration_ = registry_->histogram(
+          "libp2p_dial_duration_microseconds",
+          "Time to dial a peer and to upgrade the connection");
+    }
+  }
+
+  void DialerImpl::countStream(const peer::Protocol &protocol) {
+    if (registry_ == nullptr) {
+      return;
+    }
+    auto &counter = protocol_streams_[protocol];
+    if (counter == nullptr) {
+      counter = registry_->counter("libp2p_outbound_streams_total",
+                                   "Streams, opened to the peers",
+                                   {{"protocol", protocol}});
+    }
+    counter->inc();
   }
 
 }  // namespace libp2p::network
@@ -11,15 +11,20 @@ namespace libp2p::network {
       std::shared_ptr<protocol_muxer::ProtocolMuxer> multiselect,
       std::shared_ptr<network::Router> router,
       std::shared_ptr<TransportManager> tmgr,
-      std::shared_ptr<ConnectionManager> cmgr)
+      std::shared_ptr<ConnectionManager> cmgr,
+      std::shared_ptr<ResourceManager> rmgr,
+      std::shared_ptr<ConnectionGater> gater)
       : multiselect_(std::move(multiselect)),
         router_(std::move(router)),
         tmgr_(std::move(tmgr)),
-        cmgr_(std::move(cmgr)) {
+        cmgr_(std::move(cmgr)),
+        rmgr_(std::move(rmgr)),
+        gater_(std::move(gater)) {
     BOOST_ASSERT(multiselect_ != nullptr);
     BOOST_ASSERT(router_ != nullptr);
     BOOST_ASSERT(tmgr_ != nullptr);
     BOOST_ASSERT(cmgr_ != nullptr);
+    BOOST_ASSERT(rmgr_ != nullptr);
   }
 
   bool ListenerManagerImpl::isStarted() const {
@@ -173,13 +178,18 @@ namespace libp2p::network {
     }
     auto &&conn = rconn.value();
 
-    auto rid = conn->remotePeer();
-    if (!rid) {
-      // can not get remote peer id
-      // TODO(Warchant): log error
-      return;  // ignore
+    if (gater_ != nullptr && !gater_->interceptUpgraded(*conn)) {
+      (void)conn->close();
+      return;
     }
-    auto &&id = rid.value();
+
+    if (auto res = rmgr_->reserveConnection(conn); !res) {
+      // over the limits: close it before any stream is accepted
+      (void)conn->close();
+      return;
+    }
+
+    const auto &id = conn->remotePeer();
 
     // set onStream handler function
     conn->onStream(
@@ -191,10 +201,17 @@ namespace libp2p::network {
           }
           auto &&stream = rstream.value();
 
-          // negotiate protocols
-          this->multiselect_->selectOneOf(
-              this->router_->getSupportedProtocols(), stream,
-              false /* not initiator */,
+          // negotiate protocols; the router shares its snapshot of them and
+          // matches the proposed ones, so nothing is copied per stream
+          auto snapshot = this->router_->getProtocolsSnapshot();
+          protocol_muxer::ProtocolMuxer::Protocols protocols{
+              snapshot, &snapshot->protocols};
+          this->multiselect_->acceptOneOf(
+              std::move(protocols),
+              [this](const peer::Protocol &p) {
+                return this->router_->canHandle(p);
+              },
+              stream,
               [this, stream](outcome::result<peer::Protocol> rproto) {
                 if (!rproto) {
                   // can not negotiate protocols
@@ -0,0 +1,87 @@
+/**
+ * Copyright Soramitsu Co., Ltd. All Rights Reserved.
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <libp2p/network/impl/peer_scorer_impl.hpp>
+
+#include <libp2p/network/routing_events.hpp>
+
+namespace libp2p::network {
+
+  PeerScorerImpl::PeerScorerImpl(std::shared_ptr<libp2p::event::Bus> bus)
+      : bus_(std::move(bus)) {
+    BOOST_ASSERT(bus_ != nullptr);
+    peer_added_sub_ =
+        bus_->getChannel<event::RoutingPeerAddedChannel>().subscribe(
+            [this](const peer::PeerId &peer) {
+              routing_table_peers_.insert(peer);
+            });
+    peer_removed_sub_ =
+        bus_->getChannel<event::RoutingPeerRemovedChannel>().subscribe(
+            [this](const peer::PeerId &peer) {
+              routing_table_peers_.erase(peer);
+            });
+  }
+
+  void PeerScorerImpl::tagPeer(const peer::PeerId &peer,
+                               const std::string &tag, int64_t value) {
+    tags_[peer][tag] = value;
+  }
+
+  void PeerScorerImpl::untagPeer(const peer::PeerId &peer,
+                                 const std::string &tag) {
+    auto it = tags_.find(peer);
+    if (it == tags_.end()) {
+      return;
+    }
+    it->second.erase(tag);
+    if (it->second.empty()) {
+      tags_.erase(it);
+    }
+  }
+
+  void PeerScorerImpl::protect(const peer::PeerId &peer,
+                               const std::string &tag) {
+    protections_[peer].insert(tag);
+  }
+
+  bool PeerScorerImpl::unprotect(const peer::PeerId &peer,
+                                 const std::string &tag) {
+    auto it = protections_.find(peer);
+    if (it == protections_.end()) {
+      return false;
+    }
+    it->second.erase(tag);
+    if (it->second.empty()) {
+      protections_.erase(it);
+      return false;
+    }
+    return true;
+  }
+
+  bool PeerScorerImpl::isProtected(const peer::PeerId &peer) const {
+    return protections_.count(peer) != 0;
+  }
+
+  int64_t PeerScorerImpl::score(
+      const peer::PeerId &peer,
+      gsl::span<const ConnectionSPtr> connections) const {
+    int64_t score = 0;
+    if (auto it = tags_.find(peer); it != tags_.end()) {
+      for (const auto &tag : it->second) {
+        score += tag.second;
+      }
+    }
+    for (const auto &conn : connections) {
+      if (conn != nullptr) {
+        score += kStreamValue * static_cast<int64_t>(conn->streamsCount());
+      }
+    }
+    if (routing_table_peers_.count(peer) != 0) {
+      score += kRoutingTableValue;
+    }
+    return score;
+  }
+
+}  // namespace libp2p::network
@@ -0,0 +1,201 @@
+/**
+ * Copyright Soramitsu Co., Ltd. All Rights Reserved.
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <libp2p/network/impl/resource_manager_impl.hpp>
+
+#include <algorithm>
+
+#include <libp2p/network/connection_manager.hpp>
+
+OUTCOME_CPP_DEFINE_CATEGORY(libp2p::network, ResourceManagerImpl::Error, e) {
+  using E = libp2p::network::ResourceManagerImpl::Error;
+  switch (e) {
+    case E::CONNECTION_LIMIT_EXCEEDED:
+      return "limit of connections is exceeded";
+    case E::STREAM_LIMIT_EXCEEDED:
+      return "limit of streams is exceeded";
+    case E::MEMORY_LIMIT_EXCEEDED:
+      return "limit of buffered memory is exceeded";
+  }
+  return "unknown error";
+}
+
+namespace libp2p::network {
+
+  namespace {
+    /// @return true, if the amount does not fit the limit
+    bool exceeds(size_t used, size_t amount, size_t limit) {
+      return limit != 0 && used + amount > limit;
+    }
+
+    const ResourceUsage kNoUsage{};
+  }  // namespace
+
+  ResourceManagerImpl::ResourceManagerImpl(
+      std::shared_ptr<libp2p::event::Bus> bus, ResourceManagerConfig config)
+      : config_(std::move(config)) {
+    BOOST_ASSERT(bus != nullptr);
+    closed_sub_ =
+        bus->getChannel<event::OnConnectionClosedChannel>().subscribe(
+            [this](const std::weak_ptr<connection::CapableConnection> &conn) {
+              releaseConnection(conn);
+            });
+  }
+
+  outcome::result<void> ResourceManagerImpl::checkConnection(
+      const peer::PeerId &peer) const {
+    if (exceeds(global_.connections, 1, config_.global.connections)
+        || exceeds(peerUsage(peer).connections, 1, config_.peer.connections)) {
+      return Error::CONNECTION_LIMIT_EXCEEDED;
+    }
+    return outcome::success();
+  }
+
+  outcome::result<void> ResourceManagerImpl::reserveConnection(
+      const std::shared_ptr<connection::CapableConnection> &conn) {
+    BOOST_ASSERT(conn != nullptr);
+    std::weak_ptr<connection::CapableConnection> weak_conn = conn;
+    if (connections_.count(weak_conn) != 0) {
+      return outcome::success();
+    }
+    const auto &peer = conn->remotePeer();
+    if (connections_.size() >= connections_purge_at_
+        || !checkConnection(peer)) {
+      purgeConnections();
+    }
+    OUTCOME_TRY(checkConnection(peer));
+
+    connections_.emplace(std::move(weak_conn), peer);
+    ++global_.connections;
+    ++peers_[peer].connections;
+    return outcome::success();
+  }
+
+  void ResourceManagerImpl::releaseConnection(
+      const std::weak_ptr<connection::CapableConnection> &conn) {
+    if (auto it = connections_.find(conn); it != connections_.end()) {
+      releaseConnection(it);
+    }
+  }
+
+  ResourceManagerImpl::Connections::iterator
+  ResourceManagerImpl::releaseConnection(Connections::iterator it) {
+    --global_.connections;
+    if (auto peer_it = peers_.find(it->second); peer_it != peers_.end()) {
+      --peer_it->second.connections;
+      erasePeerIfUnused(peer_it);
+    }
+    return connections_.erase(it);
+  }
+
+  outcome::result<void> ResourceManagerImpl::reserveStream(
+      const peer::PeerId &peer, size_t memory) {
+    const auto &peer_usage = peerUsage(peer);
+    if (exceeds(global_.streams, 1, config_.global.streams)
+        || exceeds(peer_usage.streams, 1, config_.peer.streams)) {
+      return Error::STREAM_LIMIT_EXCEEDED;
+    }
+    if (exceeds(global_.memory, memory, config_.global.memory)
+        || exceeds(peer_usage.memory, memory, config_.peer.memory)) {
+      return Error::MEMORY_LIMIT_EXCEEDED;
+    }
+
+    auto &usage = peers_[peer];
+    ++usage.streams;
+    usage.memory += memory;
+    ++global_.streams;
+    global_.memory += memory;
+    return outcome::success();
+  }
+
+  void ResourceManagerImpl::releaseStream(const peer::PeerId &peer,
+                                          size_t memory) {
+    auto it = peers_.find(peer);
+    if (it == peers_.end() || it->second.streams == 0) {
+      return;
+    }
+    --it->second.streams;
+    it->second.memory -= std::min(it->second.memory, memory);
+    --global_.streams;
+    global_.memory -= std::min(global_.memory, memory);
+    erasePeerIfUnused(it);
+  }
+
+  outcome::result<void> ResourceManagerImpl::reserveProtocolStream(
+      const peer::Protocol &protocol,
+      const std::shared_ptr<connection::Stream> &stream) {
+    auto limit = protocolStreamsLimit(protocol);
+    auto &entry = protocols_[protocol];
+    if (entry.streams.size() >= entry.purge_at
+        || (limit != 0 && entry.streams.size() >= limit)) {
+      purge(entry);
+    }
+    if (limit != 0 && entry.streams.size() >= limit) {
+      return Error::STREAM_LIMIT_EXCEEDED;
+    }
+    entry.streams.push_back(stream);
+    return outcome::success();
+  }
+
+  ResourceUsage ResourceManagerImpl::globalUsage() const {
+    return global_;
+  }
+
+  ResourceUsage ResourceManagerImpl::peerUsage(const peer::PeerId &peer) const {
+    auto it = peers_.find(peer);
+    return it == peers_.end() ? kNoUsage : it->second;
+  }
+
+  ResourceUsage ResourceManagerImpl::protocolUsage(
+      const peer::Protocol &protocol) const {
+    ResourceUsage usage;
+    auto it = protocols_.find(protocol);
+    if (it == protocols_.end()) {
+      return usage;
+    }
+    for (const auto &weak_stream : it->second.streams) {
+      if (auto stream = weak_stream.lock(); stream && !stream->isClosed()) {
+        ++usage.streams;
+      }
+    }
+    return usage;
+  }
+
+  size_t ResourceManagerImpl::protocolStreamsLimit(
+      const peer::Protocol &protocol) const {
+    const auto &overrides = config_.protocol_streams_overrides;
+    if (auto it = overrides.find(protocol); it != overrides.end()) {
+      return it->second;
+    }
+    return config_.protocol_streams;
+  }
+
+  void ResourceManagerImpl::purge(ProtocolStreams &entry) {
+    auto &streams = entry.streams;
+    streams.erase(std::remove_if(streams.begin(), streams.end(),
+                                 [](const auto &weak_stream) {
+                                   auto stream = weak_stream.lock();
+                                   return !stream || stream->isClosed();
+                                 }),
+                  streams.end());
+    entry.purge_at = std::max(kMinPurgeSize, streams.size() * 2);
+  }
+
+  void ResourceManagerImpl::purgeConnections() {
+    for (auto it = connections_.begin(); it != connections_.end();) {
+      it = it->first.expired() ? releaseConnection(it) : std::next(it);
+    }
+    connections_purge_at_ = std::max(kMinPurgeSize, connections_.size() * 2);
+  }
+
+  void ResourceManagerImpl::erasePeerIfUnused(
+      std::unordered_map<peer::PeerId, ResourceUsage>::iterator it) {
+    const auto &usage = it->second;
+    if (usage.connections == 0 && usage.streams == 0 && usage.memory == 0) {
+      peers_.erase(it);
+    }
+  }
+
+}  // namespace libp2p::network
@@ -5,6 +5,8 @@
 
 #include <libp2p/network/impl/router_impl.hpp>
 
+#include <boost/assert.hpp>
+
 OUTCOME_CPP_DEFINE_CATEGORY(libp2p::network, RouterImpl::Error, e) {
   using E = libp2p::network::RouterImpl::Error;
   switch (e) {
@@ -15,6 +17,11 @@ OUTCOME_CPP_DEFINE_CATEGORY(libp2p::network, RouterImpl::Error, e) {
 }
 
 namespace libp2p::network {
+  RouterImpl::RouterImpl(std::shared_ptr<ResourceManager> rmgr)
+      : rmgr_(std::move(rmgr)) {
+    BOOST_ASSERT(rmgr_ != nullptr);
+  }
+
   void RouterImpl::setProtocolHandler(const peer::Protocol &protocol,
                                       const ProtoHandler &handler) {
     setProtocolHandler(protocol, handler, [protocol](const auto &p) {
@@ -27,45 +34,79 @@ namespace libp2p::network {
                                       const ProtoHandler &handler,
                                       const ProtoPredicate &predicate) {
     proto_handlers_[protocol] = PredicateAndHandler{predicate, handler};
+    onHandlersChanged();
   }
 
   std::vector<peer::Protocol> RouterImpl::getSupportedProtocols() const {
-    std::vector<peer::Protocol> protos;
-    if (proto_handlers_.empty()) {
-      return protos;
-    }
+    return snapshot_->protocols;
+  }
 
-    std::string key_buffer;  // a workaround, recommended by the library's devs
-    protos.reserve(proto_handlers_.size());
-    for (auto it = proto_handlers_.begin(); it != proto_handlers_.end(); ++it) {
-      it.key(key_buffer);
-      protos.push_back(std::move(key_buffer));
-    }
-    return protos;
+  std::shared_ptr<const Router::ProtocolsSnapshot>
+  RouterImpl::getProtocolsSnapshot() const {
+    return snapshot_;
+  }
+
+  bool RouterImpl::canHandle(const peer::Protocol &p) const {
+    return exact_protocols_.count(p) != 0 || findHandler(p) != nullptr;
   }
 
   void RouterImpl::removeProtocolHandlers(const peer::Protocol &protocol) {
     proto_handlers_.erase_prefix(protocol);
+    onHandlersChanged();
   }
 
   void RouterImpl::removeAll() {
     proto_handlers_.clear();
+    onHandlersChanged();
   }
 
   outcome::result<void> RouterImpl::handle(
       const peer::Protocol &p, std::shared_ptr<connection::Stream> stream) {
+    const auto *handler = findHandler(p);
+    if (handler == nullptr) {
+      return Error::NO_HANDLER_FOUND;
+    }
+    if (rmgr_ != nullptr) {
+      if (auto res = rmgr_->reserveProtocolStream(p, stream); !res) {
+        // the other side learns about it at once, and nothing is buffered
+        stream->reset();
+        return res.error();
+      }
+    }
+    (*handler)(std::move(stream));
+    return outcome::success();
+  }
+
+  void RouterImpl::onHandlersChanged() {
+    std::vector<peer::Protocol> protos;
+    std::string key_buffer;  // a workaround, recommended by the library's devs
+    protos.reserve(proto_handlers_.size());
+    for (auto it = proto_handlers_.begin(); it != proto_handlers_.end(); ++it) {
+      it.key(key_buffer);
+      protos.push_back(std::move(key_buffer));
+    }
+
+    // the previous snapshot stays valid for the ones, who hold it
+    snapshot_ = std::make_shared<const ProtocolsSnapshot>(
+        ProtocolsSnapshot{snapshot_->version + 1, std::move(protos)});
+    exact_protocols_.clear();
+    exact_protocols_.insert(snapshot_->protocols.begin(),
+                            snapshot_->protocols.end());
+  }
+
+  const Router::ProtoHandler *RouterImpl::findHandler(
+      const peer::Protocol &p) const {
     // firstly, try to find the longest prefix - even if it's not perfect match,
     // but a predicate one, it still will save the resources
     auto matched_proto = proto_handlers_.longest_prefix(p);
     if (matched_proto == proto_handlers_.end()) {
-      return Error::NO_HANDLER_FOUND;
+      return nullptr;
     }
 
     const auto &pred_hand = matched_proto.value();
     if (matched_proto.key() == p || pred_hand.predicate(p)) {
       // perfect or predicate match
-      pred_hand.handler(std::move(stream));
-      return outcome::success();
+      return &pred_hand.handler;
     }
 
     // fallback: find all matches for the first two letters of the given (the
@@ -73,23 +114,17 @@ namespace libp2p::network {
     // predicate; the longest match is to be called
     auto matched_protos = proto_handlers_.equal_prefix_range_ks(p.data(), 2);
 
-    std::reference_wrapper<const ProtoHandler> longest_match{
-        matched_protos.first.value().handler};
+    const ProtoHandler *longest_match = nullptr;
     size_t longest_match_size = 0;
     for (auto match = matched_protos.first; match != matched_protos.second;
          ++match) {
       if (match.value().predicate(p)
           && match.key().size() > longest_match_size) {
         longest_match_size = match.key().size();
-        longest_match = match.value().handler;
+        longest_match = &match.value().handler;
       }
     }
-
-    if (longest_match_size == 0) {
-      return Error::NO_HANDLER_FOUND;
-    }
-    longest_match(std::move(stream));
-    return outcome::success();
+    return longest_match;
   }
 
 }  // namespace libp2p::network
@@ -87,33 +87,60 @@ namespace libp2p::peer {
   void InmemAddressRepository::collectGarbage() {
     auto now = Clock::now();
     auto peer = db_.begin();
-    auto peer_end = db_.end();
-
-    // for each peer
-    while (peer != peer_end) {
-      auto &&maptr = peer->second;
-
-      // remove all expired addresses
-      auto ma = maptr->begin();
-      auto ma_end = maptr->end();
-      while (ma != ma_end) {
-        if (now >= ma->second) {
-          signal_removed_(peer->first, ma->first);
-          // erase returns element next to deleted
-          ma = maptr->erase(ma);
-        } else {
-          ++ma;
-        }
+    while (peer != db_.end()) {
+      peer = collectPeerGarbage(peer, now);
+    }
+    gc_cursor_.reset();
+  }
+
+  bool InmemAddressRepository::collectGarbageStep(size_t max_entries) {
+    auto now = Clock::now();
+    auto peer = db_.begin();
+    if (gc_cursor_) {
+      // if the peer has gone, the pass is started over
+      if (auto it = db_.find(*gc_cursor_); it != db_.end()) {
+        peer = it;
       }
+    }
 
-      // peer has no more addresses
-      if (peer->second->empty()) {
+    size_t visited = 0;
+    while (peer != db_.end() && visited < max_entries) {
+      visited += peer->second->size() + 1;
+      peer = collectPeerGarbage(peer, now);
+    }
+
+    if (peer == db_.end()) {
+      gc_cursor_.reset();
+      return true;
+    }
+    gc_cursor_ = peer->first;
+    return false;
+  }
+
+  InmemAddressRepository::db_t::iterator
+  InmemAddressRepository::collectPeerGarbage(db_t::iterator peer,
+                                             Clock::time_point now) {
+    auto &&maptr = peer->second;
+
+    // remove all expired addresses
+    auto ma = maptr->begin();
+    auto ma_end = maptr->end();
+    while (ma != ma_end) {
+      if (now >= ma->second) {
+        signal_removed_(peer->first, ma->first);
         // erase returns element next to deleted
-        peer = db_.erase(peer);
+        ma = maptr->erase(ma);
       } else {
-        ++peer;
+        ++ma;
       }
     }
+
+    // peer has no more addresses
+    if (maptr->empty()) {
+      // erase returns element next to deleted
+      return db_.erase(peer);
+    }
+    return ++peer;
   }
 
   std::unordered_set<PeerId> InmemAddressRepository::getPeers() const {
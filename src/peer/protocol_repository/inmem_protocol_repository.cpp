@@ -90,6 +90,33 @@ namespace libp2p::peer {
         ++peer;
       }
     }
+    gc_cursor_.reset();
+  }
+
+  bool InmemProtocolRepository::collectGarbageStep(size_t max_entries) {
+    auto peer = db_.begin();
+    if (gc_cursor_) {
+      // if the peer has gone, the pass is started over
+      if (auto it = db_.find(*gc_cursor_); it != db_.end()) {
+        peer = it;
+      }
+    }
+
+    for (size_t visited = 0; peer != db_.end() && visited < max_entries;
+         ++visited) {
+      if (peer->second->empty()) {
+        peer = db_.erase(peer);
+      } else {
+        ++peer;
+      }
+    }
+
+    if (peer == db_.end()) {
+      gc_cursor_.reset();
+      return true;
+    }
+    gc_cursor_ = peer->first;
+    return false;
   }
 
   std::unordered_set<PeerId> InmemProtocolRepository::getPeers() const {
@@ -60,17 +60,12 @@ namespace libp2p::protocol {
       return;
     }
 
-    auto remote_peer_res = conn.lock()->remotePeer();
-    if (!remote_peer_res) {
-      return;
-    }
-
     auto remote_peer_addr_res = conn.lock()->remoteMultiaddr();
     if (!remote_peer_addr_res) {
       return;
     }
 
-    peer::PeerInfo peer_info{std::move(remote_peer_res.value()),
+    peer::PeerInfo peer_info{conn.lock()->remotePeer(),
                              std::vector<multi::Multiaddress>{
                                  std::move(remote_peer_addr_res.value())}};
 
@@ -89,13 +89,7 @@ namespace libp2p::protocol {
       }
     });
 
-    auto peer_id_res = stream->remotePeerId();
-    if (!peer_id_res) {
-      return;
-      ;
-      return log_->error("cannot retrieve peer id from the stream");
-    }
-    auto &&peer_id = peer_id_res.value();
+    const auto &peer_id = stream->remotePeerId();
 
     auto &&delta_msg = id_msg.delta();
     auto &proto_repo = host_.getPeerRepository().getProtocolRepository();
@@ -152,7 +146,7 @@ namespace libp2p::protocol {
         *msg, [self{shared_from_this()}, s = std::move(stream)](auto &&res) {
           if (!res) {
             self->log_->error("cannot write Identify-Delta to peer {}, {}: {}",
-                              s->remotePeerId().value().toBase58(),
+                              s->remotePeerId().toBase58(),
                               s->remoteMultiaddr().value().getStringAddress(),
                               res.error().message());
           }
@@ -174,26 +174,15 @@ namespace libp2p::protocol {
 
   boost::optional<peer::PeerId> IdentifyMessageProcessor::consumePublicKey(
       const StreamSPtr &stream, std::string_view pubkey_str) {
-    auto stream_peer_id_res = stream->remotePeerId();
-
     // if we haven't received a key from the other peer, all we can do is to
     // return the already known peer id
     if (pubkey_str.empty()) {
-      if (!stream_peer_id_res) {
-        return boost::none;
-      }
-      return stream_peer_id_res.value();
+      return stream->remotePeerId();
     }
 
-    // peer id can be set in stream, derived from the received public key or
-    // both; handle all possible cases
-    boost::optional<peer::PeerId> stream_peer_id;
-    boost::optional<crypto::PublicKey> pubkey;
-
-    // retrieve a peer id from the stream
-    if (stream_peer_id_res) {
-      stream_peer_id = std::move(stream_peer_id_res.value());
-    }
+    // peer id is known from the stream; the one, derived from the received
+    // public key, must be equal to it
+    const auto &stream_peer_id = stream->remotePeerId();
 
     // unmarshal a received public key
     std::vector<uint8_t> pubkey_buf;
@@ -202,11 +191,10 @@ namespace libp2p::protocol {
         key_marshaller_->unmarshalPublicKey(crypto::ProtobufKey{pubkey_buf});
     if (!pubkey_res) {
       log_->info("cannot unmarshal public key for peer {}: {}",
-                 stream_peer_id ? stream_peer_id->toBase58() : "",
-                 pubkey_res.error().message());
+                 stream_peer_id.toBase58(), pubkey_res.error().message());
       return stream_peer_id;
     }
-    pubkey = std::move(pubkey_res.value());
+    auto &&pubkey = pubkey_res.value();
 
     // derive a peer id from the received public key; PeerId is made from
     // Protobuf-marshalled key, so we use it here
@@ -217,33 +205,22 @@ namespace libp2p::protocol {
                  msg_peer_id_res.error().message());
       return stream_peer_id;
     }
-    auto msg_peer_id = std::move(msg_peer_id_res.value());
+    auto &&msg_peer_id = msg_peer_id_res.value();
 
-    auto &key_repo = host_.getPeerRepository().getKeyRepository();
-    if (!stream_peer_id) {
-      // didn't know the ID before; memorize the key, from which it can be
-      // derived later
-      auto add_res = key_repo.addPublicKey(msg_peer_id, *pubkey);
-      if (!add_res) {
-        log_->error("cannot add key to the repo of peer {}: {}",
-                    msg_peer_id.toBase58(), add_res.error().message());
-      }
-      return msg_peer_id;
-    }
-
-    if (stream_peer_id && *stream_peer_id != msg_peer_id) {
+    if (stream_peer_id != msg_peer_id) {
       log_->error(
           "peer with id {} sent public key, which derives to id {}, but they "
           "must be equal",
-          stream_peer_id->toBase58(), msg_peer_id.toBase58());
+          stream_peer_id.toBase58(), msg_peer_id.toBase58());
       return boost::none;
     }
 
     // insert the derived key into key repository
-    auto add_res = key_repo.addPublicKey(*stream_peer_id, *pubkey);
+    auto &key_repo = host_.getPeerRepository().getKeyRepository();
+    auto add_res = key_repo.addPublicKey(stream_peer_id, pubkey);
     if (!add_res) {
       log_->error("cannot add key to the repo of peer {}: {}",
-                  stream_peer_id->toBase58(), add_res.error().message());
+                  stream_peer_id.toBase58(), add_res.error().message());
     }
     return stream_peer_id;
   }
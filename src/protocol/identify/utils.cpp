@@ -10,11 +10,8 @@
 namespace libp2p::protocol::detail {
   std::tuple<std::string, std::string> getPeerIdentity(
       const std::shared_ptr<libp2p::connection::Stream> &stream) {
-    std::string id = "unknown";
+    std::string id = stream->remotePeerId().toBase58();
     std::string addr = "unknown";
-    if (auto id_res = stream->remotePeerId()) {
-      id = id_res.value().toBase58();
-    }
     if (auto addr_res = stream->remoteMultiaddr()) {
       addr = addr_res.value().getStringAddress();
     }
@@ -27,7 +24,7 @@ namespace libp2p::protocol::detail {
     std::unordered_set<peer::PeerId> active_peers_ids;
 
     for (const auto &conn : conn_manager.getConnections()) {
-      active_peers_ids.insert(conn->remotePeer().value());
+      active_peers_ids.insert(conn->remotePeer());
     }
 
     auto &peer_repo = host.getPeerRepository();
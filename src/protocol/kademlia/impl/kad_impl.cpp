@@ -41,7 +41,8 @@ namespace libp2p::protocol::kademlia {
                    std::shared_ptr<Scheduler> scheduler,
                    std::shared_ptr<RoutingTable> table,
                    std::unique_ptr<ValueStoreBackend> storage,
-                   KademliaConfig config)
+                   KademliaConfig config,
+                   std::shared_ptr<metrics::Registry> registry)
       : config_(config),
         protocol_(config_.protocolId),
         host_(std::move(host)),
@@ -50,7 +51,33 @@ namespace libp2p::protocol::kademlia {
         local_store_(std::make_unique<LocalValueStore>(*this)),
         providers_store_(*scheduler_, scheduler::toTicks(config_.max_record_age)),
         log_("kad", "KadImpl", this)
-        {}
+        {
+    if (registry != nullptr) {
+      find_peer_queries_ =
+          std::make_shared<QueryMetrics>(*registry, "find_peer");
+      get_value_queries_ =
+          std::make_shared<QueryMetrics>(*registry, "get_value");
+    }
+  }
+
+  KadImpl::QueryMetrics::QueryMetrics(metrics::Registry &registry,
+                                      const std::string &query)
+      : duration{registry.histogram(
+          "libp2p_kad_query_duration_microseconds",
+          "Time to get an answer to a Kademlia query from the network",
+          {{"query", query}})},
+        failures{registry.counter("libp2p_kad_query_failures_total",
+                                  "Kademlia queries, which were not answered",
+                                  {{"query", query}})} {}
+
+  void KadImpl::QueryMetrics::record(
+      bool success, metrics::Histogram::Clock::time_point start) {
+    if (success) {
+      duration->recordSince(start);
+    } else {
+      failures->inc();
+    }
+  }
 
   KadImpl::~KadImpl() = default;
 
@@ -70,17 +97,13 @@ namespace libp2p::protocol::kademlia {
                     // adding outbound connections only
                     if (c->isInitiator()) {
                       log_.debug("new outbound connection");
-                      auto remote_peer_res = c->remotePeer();
-                      if (!remote_peer_res) {
-                        return;
-                      }
                       auto remote_peer_addr_res = c->remoteMultiaddr();
                       if (!remote_peer_addr_res) {
                         return;
                       }
                       addPeer(
                           peer::PeerInfo{
-                              std::move(remote_peer_res.value()),
+                              c->remotePeer(),
                               {std::move(remote_peer_addr_res.value())}},
                           false);
                     }
@@ -126,17 +149,19 @@ namespace libp2p::protocol::kademlia {
       return;
     }
 
-    auto peer_res = from->remotePeerId();
-    assert(peer_res);
-
-    if (msg.type != session->response_handler->expectedResponseType()) {
-      session->response_handler->onResult(
-          peer_res.value(), outcome::failure(Error::UNEXPECTED_MESSAGE_TYPE));
+    // the session is gone before the handler is called, as the handler may
+    // send new requests and get the same stream for one of them
+    auto peer = from->remotePeerId();
+    auto handler = session->response_handler;
+    if (msg.type != handler->expectedResponseType()) {
+      closeSession(from);
+      handler->onResult(peer,
+                        outcome::failure(Error::UNEXPECTED_MESSAGE_TYPE));
     } else {
-      session->response_handler->onResult(peer_res.value(), std::move(msg));
+      // the response is read completely, so the stream can be reused
+      releaseSession(from);
+      handler->onResult(peer, std::move(msg));
     }
-
-    closeSession(from);
   }
 
   void KadImpl::onCompleted(connection::Stream *from,
@@ -146,27 +171,34 @@ namespace libp2p::protocol::kademlia {
       return;
     }
 
-    if (session->response_handler->needResponse()) {
-      if (res.error() == Error::SUCCESS
-          && session->protocol_handler->state() == writing_to_peer) {
-        // request has been written, wait for response
-        if (session->protocol_handler->read()) {
-          session->protocol_handler->state(reading_from_peer);
-          return;
-        }
-        res = outcome::failure(Error::STREAM_RESET);
+    auto need_response = session->response_handler->needResponse();
+    if (need_response && res.error() == Error::SUCCESS
+        && session->protocol_handler->state() == writing_to_peer) {
+      // request has been written, wait for response
+      if (session->protocol_handler->read()) {
+        session->protocol_handler->state(reading_from_peer);
+        return;
       }
+      res = outcome::failure(Error::STREAM_RESET);
+    }
 
-      auto peer_res = from->remotePeerId();
-      assert(peer_res);
+    if (res.error() != Error::SUCCESS && session->pooled) {
+      // the other side may have closed the stream, while it was idle
+      return retrySession(from);
+    }
 
-      session->response_handler->onResult(peer_res.value(),
+    if (need_response) {
+      session->response_handler->onResult(from->remotePeerId(),
                                           outcome::failure(res.error()));
     }
 
     log_.debug("client session completed, total sessions: {}",
                 sessions_.size() - 1);
 
+    if (res.error() == Error::SUCCESS) {
+      // nothing is to be read in response, so the stream can be reused
+      return releaseSession(from);
+    }
     closeSession(from);
   }
 
@@ -178,6 +210,39 @@ namespace libp2p::protocol::kademlia {
     }
   }
 
+  void KadImpl::releaseSession(connection::Stream *s) {
+    auto it = sessions_.find(s);
+    if (it == sessions_.end()) {
+      return;
+    }
+    auto stream = it->second.protocol_handler->detach();
+    sessions_.erase(it);
+
+    if (released_streams_.size() >= released_streams_purge_at_) {
+      for (auto r = released_streams_.begin(); r != released_streams_.end();) {
+        r = r->expired() ? released_streams_.erase(r) : std::next(r);
+      }
+      released_streams_purge_at_ =
+          std::max(kMinPurgeSize, released_streams_.size() * 2);
+    }
+    released_streams_.insert(stream);
+    host_->releaseStream(protocol_, std::move(stream));
+  }
+
+  void KadImpl::retrySession(connection::Stream *s) {
+    auto it = sessions_.find(s);
+    if (it == sessions_.end()) {
+      return;
+    }
+    auto session = std::move(it->second);
+    session.protocol_handler->close();
+    sessions_.erase(it);
+
+    log_.debug("pooled stream to {} failed, sending the request again",
+               session.peer.id.toBase58());
+    connect(session.peer, session.response_handler, session.request, true);
+  }
+
   class FindPeerBatchHandler : public KadResponseHandler {
    public:
     FindPeerBatchHandler(peer::PeerId self, peer::PeerId key,
@@ -341,6 +406,15 @@ namespace libp2p::protocol::kademlia {
       return false;
     }
 
+    if (find_peer_queries_) {
+      f = [f = std::move(f), queries = find_peer_queries_,
+           start = metrics::Histogram::Clock::now()](
+              const peer::PeerId &key, FindPeerQueryResult result) {
+        queries->record(result.success, start);
+        f(key, std::move(result));
+      };
+    }
+
     auto handler = std::make_shared<FindPeerBatchHandler>(self.id, peer,
                                                           std::move(f), *this);
 
@@ -491,6 +565,14 @@ namespace libp2p::protocol::kademlia {
       return;
     }
 
+    if (get_value_queries_) {
+      f = [f = std::move(f), queries = get_value_queries_,
+           start = metrics::Histogram::Clock::now()](GetValueResult result) {
+        queries->record(result.has_value(), start);
+        f(std::move(result));
+      };
+    }
+
     auto handler = std::make_shared<GetValueBatchHandler>(
         key, std::move(f), *this);
 
@@ -565,28 +647,33 @@ namespace libp2p::protocol::kademlia {
 
   void KadImpl::connect(const peer::PeerInfo &pi,
                         const std::shared_ptr<KadResponseHandler> &handler,
-                        const KadProtocolSession::Buffer &request) {
+                        const KadProtocolSession::Buffer &request,
+                        bool fresh) {
     uint64_t id = ++connecting_sessions_counter_;
 
     log_.debug("connecting to {}, {}", pi.id.toBase58(), handler.use_count());
 
-    host_->newStream(pi, protocol_,
-                    [wptr = weak_from_this(), this, id, r = request,
-                     peerId = pi.id](auto &&stream_res) {
-                      auto self = wptr.lock();
-                      if (self) {
-                        onConnected(
-                            id, peerId,
-                            std::forward<decltype(stream_res)>(stream_res), r);
-                      }
-                    });
+    // a pooled stream is handed out at once, so the session is registered
+    // before the stream is asked for
     connecting_sessions_[id] = handler;
+    auto cb = [wptr = weak_from_this(), this, id, r = request,
+               pi](auto &&stream_res) {
+      auto self = wptr.lock();
+      if (self) {
+        onConnected(id, pi, std::forward<decltype(stream_res)>(stream_res), r);
+      }
+    };
+    if (fresh) {
+      return host_->newStream(pi, protocol_, cb);
+    }
+    host_->acquireStream(pi, protocol_, cb);
   }
 
   void KadImpl::onConnected(
-      uint64_t id, const peer::PeerId &peerId,
+      uint64_t id, const peer::PeerInfo &pi,
       outcome::result<std::shared_ptr<connection::Stream>> stream_res,
       KadProtocolSession::Buffer request) {
+    const auto &peerId = pi.id;
     auto it = connecting_sessions_.find(id);
     if (it == connecting_sessions_.end()) {
       log_.warn("cannot find connecting session {}",
@@ -611,18 +698,23 @@ namespace libp2p::protocol::kademlia {
     log_.debug("connected to {}, ({} - {})", addr,
                 stream_res.value().use_count(), connecting_sessions_.size());
 
+    auto pooled = released_streams_.erase(stream_res.value()) != 0;
     auto protocol_session = std::make_shared<KadProtocolSession>(
         weak_from_this(), std::move(stream_res.value()));
-    if (!protocol_session->write(std::move(request))) {
+    if (!protocol_session->write(request)) {
       log_.warn("write to {} failed",addr);
-      assert(stream->remotePeerId());
+      if (pooled) {
+        protocol_session->close();
+        return connect(pi, handler, request, true);
+      }
       handler->onResult(peerId, Error::STREAM_RESET);
       return;
     }
     protocol_session->state(writing_to_peer);
 
-    sessions_[stream] =
-        Session{std::move(protocol_session), std::move(handler)};
+    sessions_.emplace(stream,
+                      Session{std::move(protocol_session), std::move(handler),
+                              pi, std::move(request), pooled});
     log_.debug("total sessions: {}",
                 sessions_.size());
   }
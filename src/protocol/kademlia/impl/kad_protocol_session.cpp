@@ -131,6 +131,12 @@ namespace libp2p::protocol::kademlia {
     stream_->close([self{shared_from_this()}](outcome::result<void>) {});
   }
 
+  std::shared_ptr<connection::Stream> KadProtocolSession::detach() {
+    state_ = CLOSED_STATE;
+    cancelTimeout();
+    return stream_;
+  }
+
   void KadProtocolSession::setTimeout() {
     if (operations_timeout_ == 0) {
       return;
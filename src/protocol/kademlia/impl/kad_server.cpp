@@ -47,8 +47,11 @@ namespace libp2p::protocol::kademlia {
 
     connection::Stream *s = stream.get();
     assert(sessions_.find(s) == sessions_.end());
-    auto session = std::make_shared<KadProtocolSession>(weak_from_this(),
-                                                        std::move(stream));
+    // the session is re-armed with the timeout for each request, so an idle
+    // stream is closed, if the client forgets it
+    auto session = std::make_shared<KadProtocolSession>(
+        weak_from_this(), std::move(stream),
+        scheduler::toTicks(kad_.config().server_idle_timeout));
     if (!session->read()) {
       s->reset();
       return;
@@ -74,14 +77,30 @@ namespace libp2p::protocol::kademlia {
     log_.debug("request from '{}', type = {}",
                 from->remoteMultiaddr().value().getStringAddress(), msg.type);
 
-    bool close_session = (msg.type >= Message::kTableSize)
-        || (not(this->*(request_handlers_table[msg.type]))(msg))  // NOLINT
-        || (not session->write(msg));
-
-    if (close_session) {
+    if (msg.type >= Message::kTableSize) {
       closeSession(from);
-    } else {
+      return;
+    }
+
+    switch ((this->*(request_handlers_table[msg.type]))(msg)) {  // NOLINT
+      case Reply::RESPOND:
+        break;
+      case Reply::NONE:
+        // the client may send the next request over the same stream
+        if (not session->read()) {
+          closeSession(from);
+        }
+        return;
+      case Reply::REJECT:
+        log_.debug("malformed request, closing the stream");
+        closeSession(from);
+        return;
+    }
+
+    if (session->write(msg)) {
       session->state(writing_to_peer);
+    } else {
+      closeSession(from);
     }
   }
 
@@ -90,6 +109,16 @@ namespace libp2p::protocol::kademlia {
     auto session = findSession(from);
     if (!session)
       return;
+
+    // the clients keep their streams in a pool, so the stream is read for the
+    // next request after the response is written; it is closed, when the
+    // client closes it or stays idle for too long
+    if (res.error() == Error::SUCCESS && session->state() == writing_to_peer
+        && session->read()) {
+      session->state(reading_from_peer);
+      return;
+    }
+
     log_.debug("server session completed, total sessions: {}",
                 sessions_.size() - 1);
     closeSession(from);
@@ -103,11 +132,11 @@ namespace libp2p::protocol::kademlia {
     }
   }
 
-  bool KadServer::onPutValue(Message &msg) {
+  KadServer::Reply KadServer::onPutValue(Message &msg) {
     log_.info("{}",__FUNCTION__);
 
     if (!msg.record) {
-      return false;
+      return Reply::REJECT;
     }
     auto& r = msg.record.value();
 
@@ -118,20 +147,19 @@ namespace libp2p::protocol::kademlia {
       log_.info("onPutValue failed due to '{}'", res.error().message());
     }
 
-    return false; // no response
+    return Reply::NONE;
   }
 
-  bool KadServer::onGetValue(Message &msg) {
+  KadServer::Reply KadServer::onGetValue(Message &msg) {
     log_.info("{}",__FUNCTION__);
 
     if (msg.key.empty()) {
-      return false;
+      return Reply::REJECT;
     }
 
     auto r = ContentAddress::fromWire(msg.key);
     if (!r) {
-      // TODO(artem): log
-      return false;
+      return Reply::REJECT;
     }
     ContentAddress cid = std::move(r.value());
 
@@ -166,16 +194,16 @@ namespace libp2p::protocol::kademlia {
       msg.record = { std::move(cid), std::move(res.value()), std::to_string(ts) };
     }
 
-    return true;
+    return Reply::RESPOND;
   }
 
-  bool KadServer::onAddProvider(Message &msg) {
+  KadServer::Reply KadServer::onAddProvider(Message &msg) {
     log_.info("{}",__FUNCTION__);
 
     // TODO(artem): validate against sender id
 
     if (!msg.provider_peers) {
-      return false;
+      return Reply::REJECT;
     }
     ContentAddress cid(msg.key);
     auto providers = msg.provider_peers.value();
@@ -184,20 +212,19 @@ namespace libp2p::protocol::kademlia {
       kad_.addPeer(std::move(p.info), false);
     }
 
-    return false; // doesnt respond
+    return Reply::NONE;
   }
 
-  bool KadServer::onGetProviders(Message &msg) {
+  KadServer::Reply KadServer::onGetProviders(Message &msg) {
     log_.info("{}",__FUNCTION__);
 
     if (msg.key.empty()) {
-      return false;
+      return Reply::REJECT;
     }
 
     auto r = ContentAddress::fromWire(msg.key);
     if (!r) {
-      // TODO(artem): log
-      return false;
+      return Reply::REJECT;
     }
     ContentAddress cid = std::move(r.value());
 
@@ -231,10 +258,10 @@ namespace libp2p::protocol::kademlia {
       }
     }
 
-    return true;
+    return Reply::RESPOND;
   }
 
-  bool KadServer::onFindNode(Message &msg) {
+  KadServer::Reply KadServer::onFindNode(Message &msg) {
     log_.info("{}",__FUNCTION__);
 
     if (msg.closer_peers) {
@@ -271,10 +298,10 @@ namespace libp2p::protocol::kademlia {
       }
     }
 
-    return true;
+    return Reply::RESPOND;
   }
 
-  bool KadServer::onPing(Message &msg) {
+  KadServer::Reply KadServer::onPing(Message &msg) {
     log_.info("{}",__FUNCTION__);
 
     if (msg.closer_peers) {
@@ -286,7 +313,7 @@ namespace libp2p::protocol::kademlia {
     }
 
     msg.clear();
-    return true;
+    return Reply::RESPOND;
   }
 
 }  // namespace libp2p::protocol::kademlia
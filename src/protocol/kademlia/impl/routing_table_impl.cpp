@@ -5,6 +5,7 @@
 
 #include <libp2p/protocol/kademlia/impl/routing_table_impl.hpp>
 
+#include <algorithm>
 #include <numeric>
 
 OUTCOME_CPP_DEFINE_CATEGORY(libp2p::protocol::kademlia, RoutingTableImpl::Error,
@@ -64,15 +65,34 @@ namespace libp2p::protocol::kademlia {
       }
     }
 
-    // sort bucket in ascending order by XOR distance from local peer.
-    XorDistanceComparator cmp(id);
-    std::sort(bucket.begin(), bucket.end(), cmp);
-
-    if (count < bucket.size()) {
-      bucket.truncate(count);
+    // hash all peers at once, instead of two of them per comparison
+    const auto &peers = bucket.peers();
+    std::vector<gsl::span<const uint8_t>> peer_bytes;
+    peer_bytes.reserve(peers.size());
+    for (const auto &peer : peers) {
+      peer_bytes.emplace_back(peer.toVector());
+    }
+    std::vector<Hash256> distances(peers.size());
+    crypto::sha256Batch(peer_bytes, distances);
+    for (auto &distance : distances) {
+      distance = xor_distance(distance, id.getData());
     }
 
-    return bucket.toVector();
+    // sort bucket in ascending order by XOR distance from the target
+    std::vector<size_t> order(peers.size());
+    std::iota(order.begin(), order.end(), 0);
+    count = std::min(count, order.size());
+    std::partial_sort(order.begin(), order.begin() + count, order.end(),
+                      [&distances](size_t a, size_t b) {
+                        return distances[a] < distances[b];
+                      });
+
+    PeerIdVec nearest;
+    nearest.reserve(count);
+    for (size_t i = 0; i < count; ++i) {
+      nearest.push_back(peers[order[i]]);
+    }
+    return nearest;
   }
 
   outcome::result<void> RoutingTableImpl::update(const peer::PeerId &pid) {
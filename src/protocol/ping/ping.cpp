@@ -37,22 +37,45 @@ namespace libp2p::protocol {
       const std::shared_ptr<connection::CapableConnection> &conn,
       std::function<void(outcome::result<std::shared_ptr<PingClientSession>>)>
           cb) {
-    auto remote_peer = conn->remotePeer();
-    if (!remote_peer) {
-      return cb(remote_peer.error());
-    }
-    auto peer_info = host_.getPeerRepository().getPeerInfo(remote_peer.value());
+    auto peer_info =
+        host_.getPeerRepository().getPeerInfo(conn->remotePeer());
     return host_.newStream(
         peer_info, detail::kPingProto,
-        [self{shared_from_this()}, cb = std::move(cb)](auto &&stream_res) {
+        [self{shared_from_this()}, conn,
+         cb = std::move(cb)](auto &&stream_res) {
           if (!stream_res) {
             return cb(stream_res.error());
           }
+          auto &stream = stream_res.value();
+          auto rtt_handler = self->rttHandler(conn, *stream);
           auto session = std::make_shared<PingClientSession>(
-              self->io_context_, self->bus_, std::move(stream_res.value()),
-              self->rand_gen_, self->config_);
+              self->io_context_, self->bus_, std::move(stream),
+              self->rand_gen_, self->config_, std::move(rtt_handler));
           session->start();
           cb(std::move(session));
         });
   }
+
+  PingClientSession::RttHandler Ping::rttHandler(
+      const std::shared_ptr<connection::CapableConnection> &conn,
+      const connection::Stream &stream) {
+    // the host opens the stream over the best connection to the peer, which
+    // is not necessarily the one to be pinged
+    auto stream_local = stream.localMultiaddr();
+    auto stream_remote = stream.remoteMultiaddr();
+    auto conn_local = conn->localMultiaddr();
+    auto conn_remote = conn->remoteMultiaddr();
+    if (!stream_local || !stream_remote || !conn_local || !conn_remote
+        || !(stream_local.value() == conn_local.value())
+        || !(stream_remote.value() == conn_remote.value())) {
+      return {};
+    }
+    return [&host = host_,
+            weak_conn = std::weak_ptr<connection::CapableConnection>(conn)](
+               std::chrono::microseconds rtt) {
+      if (auto c = weak_conn.lock()) {
+        host.getNetwork().getConnectionManager().reportRtt(c, rtt);
+      }
+    };
+  }
 }  // namespace libp2p::protocol
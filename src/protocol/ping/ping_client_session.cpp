@@ -14,13 +14,14 @@ namespace libp2p::protocol {
       boost::asio::io_service &io_service, libp2p::event::Bus &bus,
       std::shared_ptr<connection::Stream> stream,
       std::shared_ptr<crypto::random::RandomGenerator> rand_gen,
-      PingConfig config)
+      PingConfig config, RttHandler rtt_handler)
       : io_service_{io_service},
         bus_{bus},
         channel_{bus_.getChannel<event::PeerIsDeadChannel>()},
         stream_{std::move(stream)},
         rand_gen_{std::move(rand_gen)},
         config_{config},
+        rtt_handler_{std::move(rtt_handler)},
         write_buffer_(config_.message_size, 0),
         read_buffer_(config_.message_size, 0),
         timer_{io_service_, boost::posix_time::milliseconds(config_.timeout)} {
@@ -46,6 +47,7 @@ namespace libp2p::protocol {
 
     auto rand_buf = rand_gen_->randomBytes(config_.message_size);
     std::move(rand_buf.begin(), rand_buf.end(), write_buffer_.begin());
+    write_started_ = std::chrono::steady_clock::now();
     stream_->write(write_buffer_, config_.message_size,
                    [self{shared_from_this()}](auto &&write_res) {
                      if (!write_res) {
@@ -63,9 +65,7 @@ namespace libp2p::protocol {
     if (ec || !last_op_completed_ || last_error_) {
       // timeout passed or error happened; in any case, we cannot ping it
       // anymore
-      if (auto peer_id_res = stream_->remotePeerId()) {
-        channel_.publish(peer_id_res.value());
-      }
+      channel_.publish(stream_->remotePeerId());
       return;
     }
     last_op_completed_ = false;
@@ -82,6 +82,7 @@ namespace libp2p::protocol {
                     if (!read_res) {
                       self->last_error_ = read_res.error();
                     }
+                    self->read_completed_ = std::chrono::steady_clock::now();
                     self->last_op_completed_ = true;
                   });
 
@@ -95,11 +96,14 @@ namespace libp2p::protocol {
         || write_buffer_ != read_buffer_) {
       // again, in case of any error we cannot continue to ping the peer and
       // thus declare it dead
-      if (auto peer_id_res = stream_->remotePeerId()) {
-        channel_.publish(peer_id_res.value());
-      }
+      channel_.publish(stream_->remotePeerId());
       return;
     }
+    if (rtt_handler_) {
+      // the timer only bounds the round trip; the echo may come much earlier
+      rtt_handler_(std::chrono::duration_cast<std::chrono::microseconds>(
+          read_completed_ - write_started_));
+    }
     last_op_completed_ = false;
     write();
   }
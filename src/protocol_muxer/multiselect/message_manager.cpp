@@ -5,11 +5,11 @@
 
 #include <libp2p/protocol_muxer/multiselect/message_manager.hpp>
 
+#include <algorithm>
 #include <sstream>
 #include <string_view>
 
 #include <boost/algorithm/string/predicate.hpp>
-#include <libp2p/common/hexutil.hpp>
 #include <libp2p/common/types.hpp>
 
 OUTCOME_CPP_DEFINE_CATEGORY(libp2p::protocol_muxer, MessageManager::ParseError,
@@ -39,19 +39,28 @@ namespace {
   /// string of na message
   constexpr std::string_view kNaString = "na\n";
 
-  /// ls message, ready to be sent
-  const ByteArray kLsMsg = []() -> ByteArray {
-    auto vec = UVarint{kLsString.size()}.toVector();
-    vec.insert(vec.end(), kLsString.begin(), kLsString.end());
+  /// message of the string with its varint length, ready to be sent
+  ByteArray encode(std::string_view str) {
+    auto vec = UVarint{str.size()}.toVector();
+    vec.insert(vec.end(), str.begin(), str.end());
     return vec;
-  }();
+  }
+
+  /// opening message, ready to be sent
+  const ByteArray kOpeningMsg =
+      encode(libp2p::protocol_muxer::MessageManager::kMultiselectHeader);
+
+  /// ls message, ready to be sent
+  const ByteArray kLsMsg = encode(kLsString);
 
   /// na message, ready to be sent
-  const ByteArray kNaMsg = []() -> ByteArray {
-    auto vec = UVarint{kNaString.size()}.toVector();
-    vec.insert(vec.end(), kNaString.begin(), kNaString.end());
-    return vec;
-  }();
+  const ByteArray kNaMsg = encode(kNaString);
+
+  /// @return true, if the bytes are the same as of the string
+  bool equals(gsl::span<const uint8_t> bytes, std::string_view str) {
+    return static_cast<size_t>(bytes.size()) == str.size()
+        && std::equal(str.begin(), str.end(), bytes.begin());
+  }
 
   /**
    * Retrieve a varint from the line
@@ -120,18 +129,11 @@ namespace libp2p::protocol_muxer {
   outcome::result<MultiselectMessage> MessageManager::parseConstantMsg(
       gsl::span<const uint8_t> bytes) {
     // first varint is already read
-    static constexpr std::string_view kLsMsgHex{"6C730A"};  // 'ls\n'
-    static constexpr std::string_view kNaMsgHex{"6E610A"};  // 'na\n'
-    static constexpr int64_t kConstMsgsLength{kLsMsgHex.size() / 2};
-
-    if (bytes.size() == kConstMsgsLength) {
-      auto msg_hex = common::hex_upper(bytes);
-      if (msg_hex == kLsMsgHex) {
-        return MultiselectMessage{MultiselectMessage::MessageType::LS};
-      }
-      if (msg_hex == kNaMsgHex) {
-        return MultiselectMessage{MultiselectMessage::MessageType::NA};
-      }
+    if (equals(bytes, kLsString)) {
+      return MultiselectMessage{MultiselectMessage::MessageType::LS};
+    }
+    if (equals(bytes, kNaString)) {
+      return MultiselectMessage{MultiselectMessage::MessageType::NA};
     }
     return ParseError::MSG_IS_ILL_FORMED;
   }
@@ -166,18 +168,15 @@ namespace libp2p::protocol_muxer {
         std::string{bytes.data(), bytes.data() + bytes.size()});  // NOLINT
   }
 
-  ByteArray MessageManager::openingMsg() {
-    ByteArray buffer = multi::UVarint{kMultiselectHeader.size()}.toVector();
-    buffer.insert(buffer.end(), kMultiselectHeader.begin(),
-                  kMultiselectHeader.end());
-    return buffer;
+  const ByteArray &MessageManager::openingMsg() {
+    return kOpeningMsg;
   }
 
-  ByteArray MessageManager::lsMsg() {
+  const ByteArray &MessageManager::lsMsg() {
     return kLsMsg;
   }
 
-  ByteArray MessageManager::naMsg() {
+  const ByteArray &MessageManager::naMsg() {
     return kNaMsg;
   }
 
@@ -189,6 +188,13 @@ namespace libp2p::protocol_muxer {
     return buffer;
   }
 
+  bool MessageManager::isProtocolMsg(gsl::span<const uint8_t> body,
+                                     std::string_view protocol) {
+    return static_cast<size_t>(body.size()) == protocol.size() + 1
+        && body[protocol.size()] == '\n'
+        && std::equal(protocol.begin(), protocol.end(), body.begin());
+  }
+
   ByteArray MessageManager::protocolsMsg(
       gsl::span<const peer::Protocol> protocols) {
     ByteArray msg{};
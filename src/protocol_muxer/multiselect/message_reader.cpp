@@ -23,19 +23,31 @@ namespace {
   const std::string_view kMultiselectHeader =
       MessageManager::kMultiselectHeader.substr(
           0, MessageManager::kMultiselectHeader.size() - 1);
+
+  /// each message has a varint and at least '\n', so these bytes can be read
+  /// at once without touching the next message
+  constexpr size_t kMinMessageSize = 2;
+
+  /// lists of protocols are the longest messages, and they are far shorter
+  constexpr uint64_t kMaxMessageSize = 64 * 1024;
+
+  /// varint of kMaxMessageSize is shorter
+  constexpr size_t kMaxVarintSize = 4;
 }  // namespace
 
 namespace libp2p::protocol_muxer {
   void MessageReader::readNextMessage(
       std::shared_ptr<ConnectionState> connection_state) {
-    readNextVarint(std::move(connection_state));
+    readNextVarint(std::move(connection_state), kMinMessageSize);
   }
 
   void MessageReader::readNextVarint(
-      std::shared_ptr<ConnectionState> connection_state) {
-    // we don't know exact length of varint, so read byte-by-byte
+      std::shared_ptr<ConnectionState> connection_state, size_t bytes) {
+    // we don't know exact length of varint, so read byte-by-byte, after the
+    // smallest possible message; reading more could take bytes of the protocol,
+    // which follows the negotiation
     auto state = connection_state;
-    state->read(1,
+    state->read(bytes,
                 [connection_state = std::move(connection_state)](
                     const outcome::result<void> &res) mutable {
                   if (not res) {
@@ -53,13 +65,26 @@ namespace libp2p::protocol_muxer {
     auto varint_opt = getVarint(*connection_state->read_buffer);
     if (!varint_opt) {
       // no varint; continue reading
-      readNextVarint(std::move(connection_state));
+      auto buffered = connection_state->read_buffer->size();
+      if (buffered >= kMaxVarintSize) {
+        auto multiselect = connection_state->multiselect;
+        return multiselect->negotiationRoundFailed(
+            connection_state,
+            MessageManager::ParseError::MSG_LENGTH_IS_INCORRECT);
+      }
+      readNextVarint(std::move(connection_state), buffered + 1);
       return;
     }
+    auto bytes_to_read = varint_opt->toUInt64();
+    if (bytes_to_read > kMaxMessageSize) {
+      auto multiselect = connection_state->multiselect;
+      return multiselect->negotiationRoundFailed(
+          connection_state,
+          MessageManager::ParseError::MSG_LENGTH_IS_INCORRECT);
+    }
+
     // we have length of the line to be read; do it
     connection_state->read_buffer->consume(varint_opt->size());
-
-    auto bytes_to_read = varint_opt->toUInt64();
     readNextBytes(std::move(connection_state), bytes_to_read,
                   [bytes_to_read](auto &&state) {
                     onReadLineCompleted(std::forward<decltype(state)>(state),
@@ -98,7 +123,25 @@ namespace libp2p::protocol_muxer {
                        read_bytes);
     connection_state->read_buffer->consume(msg_span.size());
 
-    // firstly, try to match the message against constant messages
+    // firstly, compare the message with the ones, known beforehand: the header
+    // and the protocols of this negotiation, so that they are recognized
+    // without parsing; a responder with a matcher may support more protocols,
+    // than are listed, so they are matched after parsing
+    if (MessageManager::isProtocolMsg(msg_span, kMultiselectHeader)) {
+      return multiselect->onReadCompleted(
+          connection_state, Message{Message::MessageType::OPENING});
+    }
+    if (!connection_state->matcher) {
+      for (const auto &protocol : *connection_state->protocols) {
+        if (MessageManager::isProtocolMsg(msg_span, protocol)) {
+          return multiselect->onReadCompleted(
+              connection_state,
+              Message{Message::MessageType::PROTOCOL, {protocol}});
+        }
+      }
+    }
+
+    // then try to match the message against constant messages
     auto const_msg_res = MessageManager::parseConstantMsg(msg_span);
     if (const_msg_res) {
       multiselect->onReadCompleted(connection_state,
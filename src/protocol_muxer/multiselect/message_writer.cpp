@@ -39,7 +39,8 @@ namespace libp2p::protocol_muxer {
   void MessageWriter::sendProtocolMsg(
       const Protocol &protocol,
       const std::shared_ptr<ConnectionState> &connection_state) {
-    *connection_state->write_buffer = MessageManager::protocolMsg(protocol);
+    *connection_state->write_buffer =
+        connection_state->multiselect->protocolMsg(protocol);
     const auto &state = connection_state;
     state->write(getWriteCallback(
         connection_state, ConnectionState::NegotiationStatus::PROTOCOL_SENT));
@@ -65,7 +66,8 @@ namespace libp2p::protocol_muxer {
   void MessageWriter::sendProtocolAck(
       std::shared_ptr<ConnectionState> connection_state,
       const peer::Protocol &protocol) {
-    *connection_state->write_buffer = MessageManager::protocolMsg(protocol);
+    *connection_state->write_buffer =
+        connection_state->multiselect->protocolMsg(protocol);
     auto state = connection_state;
     state->write([connection_state = std::move(connection_state), protocol](
                      const outcome::result<size_t> written_bytes_res) mutable {
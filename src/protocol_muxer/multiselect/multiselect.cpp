@@ -5,9 +5,22 @@
 
 #include <libp2p/protocol_muxer/multiselect/multiselect.hpp>
 
+#include <libp2p/protocol_muxer/multiselect/optimistic_stream.hpp>
+
 namespace libp2p::protocol_muxer {
   using peer::Protocol;
 
+  Multiselect::Multiselect(std::shared_ptr<metrics::Registry> registry) {
+    if (registry != nullptr) {
+      negotiation_duration_ = registry->histogram(
+          "libp2p_multiselect_negotiation_duration_microseconds",
+          "Time to negotiate a protocol with multistream-select");
+      negotiation_failures_ =
+          registry->counter("libp2p_multiselect_failures_total",
+                            "Failed multistream-select negotiations");
+    }
+  }
+
   void Multiselect::selectOneOf(
       gsl::span<const peer::Protocol> supported_protocols,
       std::shared_ptr<basic::ReadWriter> connection, bool is_initiator,
@@ -17,23 +30,61 @@ namespace libp2p::protocol_muxer {
       return;
     }
 
-    negotiate(connection, supported_protocols, is_initiator, handler);
+    negotiate(connection,
+              std::make_shared<const std::vector<Protocol>>(
+                  supported_protocols.begin(), supported_protocols.end()),
+              {}, is_initiator, handler);
+  }
+
+  void Multiselect::acceptOneOf(Protocols protocols, ProtocolMatcher matcher,
+                                std::shared_ptr<basic::ReadWriter> connection,
+                                ProtocolHandlerFunc handler) {
+    if (!protocols || protocols->empty()) {
+      handler(MultiselectError::PROTOCOLS_LIST_EMPTY);
+      return;
+    }
+
+    negotiate(connection, std::move(protocols), std::move(matcher), false,
+              handler);
+  }
+
+  std::shared_ptr<connection::Stream> Multiselect::selectOptimistically(
+      const peer::Protocol &protocol,
+      std::shared_ptr<connection::Stream> stream) {
+    return std::make_shared<OptimisticStream>(std::move(stream), protocol);
   }
 
   void Multiselect::negotiate(
       const std::shared_ptr<basic::ReadWriter> &connection,
-      gsl::span<const peer::Protocol> supported_protocols, bool is_initiator,
-      const ProtocolHandlerFunc &handler) {
+      Protocols supported_protocols, ProtocolMatcher matcher,
+      bool is_initiator, const ProtocolHandlerFunc &handler) {
     auto [write_buffer, read_buffer, index] = getBuffers();
 
+    auto on_negotiated = handler;
+    if (negotiation_duration_ != nullptr) {
+      on_negotiated = [handler, start = metrics::Histogram::Clock::now(),
+                       duration = negotiation_duration_,
+                       failures = negotiation_failures_](
+                          const outcome::result<Protocol> &res) {
+        if (res) {
+          duration->recordSince(start);
+        } else {
+          failures->inc();
+        }
+        handler(res);
+      };
+    }
+
     if (is_initiator) {
       MessageWriter::sendOpeningMsg(std::make_shared<ConnectionState>(
-          connection, supported_protocols, handler, write_buffer, read_buffer,
-          index, shared_from_this()));
+          connection, std::move(supported_protocols), std::move(matcher),
+          std::move(on_negotiated), write_buffer, read_buffer, index,
+          shared_from_this()));
     } else {
       MessageReader::readNextMessage(std::make_shared<ConnectionState>(
-          connection, supported_protocols, handler, write_buffer, read_buffer,
-          index, shared_from_this(),
+          connection, std::move(supported_protocols), std::move(matcher),
+          std::move(on_negotiated), write_buffer, read_buffer, index,
+          shared_from_this(),
           ConnectionState::NegotiationStatus::NOTHING_SENT));
     }
   }
@@ -93,7 +144,8 @@ namespace libp2p::protocol_muxer {
         // if opening is received as a response to ours, we send one of the
         // protocols we consider
         return MessageWriter::sendProtocolMsg(
-            connection_state->left_protocols->front(), connection_state);
+            (*connection_state->protocols)[connection_state->next_protocol],
+            connection_state);
       case Status::PROTOCOL_SENT:
       case Status::PROTOCOLS_SENT:
       case Status::LS_SENT:
@@ -163,13 +215,13 @@ namespace libp2p::protocol_muxer {
       const std::shared_ptr<ConnectionState> &connection_state) {
     // if we receive na message, send next protocol we consider; if none is
     // left, negotiation failed
-    auto protos = connection_state->left_protocols;
-    protos->erase(protos->begin());
-    if (protos->empty()) {
+    const auto &protos = *connection_state->protocols;
+    if (++connection_state->next_protocol >= protos.size()) {
       return negotiationRoundFailed(connection_state,
                                     MultiselectError::NEGOTIATION_FAILED);
     }
-    MessageWriter::sendProtocolMsg(protos->front(), connection_state);
+    MessageWriter::sendProtocolMsg(protos[connection_state->next_protocol],
+                                   connection_state);
   }
 
   void Multiselect::onProtocolAfterOpeningLsOrNa(
@@ -182,9 +234,12 @@ namespace libp2p::protocol_muxer {
       return negotiationRoundFailed(connection_state,
                                     MultiselectError::INTERNAL_ERROR);
     }
-    if (std::find(protocols_to_search->begin(), protocols_to_search->end(),
-                  protocol)
-        != protocols_to_search->end()) {
+    auto supported = connection_state->matcher
+        ? connection_state->matcher(protocol)
+        : std::find(protocols_to_search->begin(), protocols_to_search->end(),
+                    protocol)
+            != protocols_to_search->end();
+    if (supported) {
       return MessageWriter::sendProtocolAck(std::move(connection_state),
                                             protocol);
     }
@@ -253,4 +308,18 @@ namespace libp2p::protocol_muxer {
     // add them to the pool of free buffers
     free_buffers_.push(connection_state->buffers_index);
   }
+
+  const common::ByteArray &Multiselect::protocolMsg(
+      const peer::Protocol &protocol) {
+    auto it = protocol_msgs_.find(protocol);
+    if (it != protocol_msgs_.end()) {
+      return it->second;
+    }
+    if (protocol_msgs_.size() >= kMaxCachedProtocolMsgs) {
+      protocol_msgs_.clear();
+    }
+    return protocol_msgs_
+        .emplace(protocol, MessageManager::protocolMsg(protocol))
+        .first->second;
+  }
 }  // namespace libp2p::protocol_muxer
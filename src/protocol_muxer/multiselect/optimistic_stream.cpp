@@ -0,0 +1,256 @@
+/**
+ * Copyright Soramitsu Co., Ltd. All Rights Reserved.
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <libp2p/protocol_muxer/multiselect/optimistic_stream.hpp>
+
+#include <algorithm>
+#include <string_view>
+
+#include <boost/assert.hpp>
+#include <libp2p/multi/uvarint.hpp>
+#include <libp2p/protocol_muxer/multiselect/message_manager.hpp>
+#include <libp2p/protocol_muxer/multiselect/multiselect_error.hpp>
+
+namespace libp2p::protocol_muxer {
+
+  namespace {
+    /// varint of a protocol response is never longer than that
+    constexpr size_t kMaxVarintSize = 8;
+  }  // namespace
+
+  OptimisticStream::OptimisticStream(std::shared_ptr<connection::Stream> stream,
+                                     peer::Protocol protocol)
+      : stream_{std::move(stream)}, protocol_{std::move(protocol)} {
+    BOOST_ASSERT(stream_);
+  }
+
+  void OptimisticStream::read(gsl::span<uint8_t> out, size_t bytes,
+                              ReadCallbackFunc cb) {
+    if (status_ == Status::ACCEPTED) {
+      return stream_->read(out, bytes, std::move(cb));
+    }
+    negotiated([self{shared_from_this()}, out, bytes,
+                cb{std::move(cb)}](outcome::result<void> res) mutable {
+      if (!res) {
+        return cb(res.error());
+      }
+      self->stream_->read(out, bytes, std::move(cb));
+    });
+  }
+
+  void OptimisticStream::readSome(gsl::span<uint8_t> out, size_t bytes,
+                                  ReadCallbackFunc cb) {
+    if (status_ == Status::ACCEPTED) {
+      return stream_->readSome(out, bytes, std::move(cb));
+    }
+    negotiated([self{shared_from_this()}, out, bytes,
+                cb{std::move(cb)}](outcome::result<void> res) mutable {
+      if (!res) {
+        return cb(res.error());
+      }
+      self->stream_->readSome(out, bytes, std::move(cb));
+    });
+  }
+
+  void OptimisticStream::write(gsl::span<const uint8_t> in, size_t bytes,
+                               WriteCallbackFunc cb) {
+    if (status_ == Status::FAILED) {
+      return cb(MultiselectError::NEGOTIATION_FAILED);
+    }
+    if (proposal_sent_) {
+      return stream_->write(in, bytes, std::move(cb));
+    }
+
+    // the first bytes of the caller go in one write with the proposal
+    proposal_sent_ = true;
+    auto size = std::min(static_cast<size_t>(in.size()), bytes);
+    write_buffer_ = proposal();
+    auto prefix = write_buffer_.size();
+    write_buffer_.insert(write_buffer_.end(), in.begin(), in.begin() + size);
+    stream_->write(write_buffer_, write_buffer_.size(),
+                   [self{shared_from_this()}, prefix,
+                    cb{std::move(cb)}](outcome::result<size_t> res) {
+                     self->write_buffer_.clear();
+                     if (!res) {
+                       return cb(res.error());
+                     }
+                     cb(res.value() - prefix);
+                   });
+  }
+
+  void OptimisticStream::writeSome(gsl::span<const uint8_t> in, size_t bytes,
+                                   WriteCallbackFunc cb) {
+    if (status_ == Status::FAILED) {
+      return cb(MultiselectError::NEGOTIATION_FAILED);
+    }
+    if (proposal_sent_) {
+      return stream_->writeSome(in, bytes, std::move(cb));
+    }
+    // the proposal cannot be written partially
+    write(in, bytes, std::move(cb));
+  }
+
+  bool OptimisticStream::isClosedForRead() const {
+    return stream_->isClosedForRead();
+  }
+
+  bool OptimisticStream::isClosedForWrite() const {
+    return stream_->isClosedForWrite();
+  }
+
+  bool OptimisticStream::isClosed() const {
+    return stream_->isClosed();
+  }
+
+  void OptimisticStream::close(VoidResultHandlerFunc cb) {
+    stream_->close(std::move(cb));
+  }
+
+  void OptimisticStream::reset() {
+    stream_->reset();
+  }
+
+  void OptimisticStream::adjustWindowSize(uint32_t new_size,
+                                          VoidResultHandlerFunc cb) {
+    stream_->adjustWindowSize(new_size, std::move(cb));
+  }
+
+  outcome::result<bool> OptimisticStream::isInitiator() const {
+    return stream_->isInitiator();
+  }
+
+  const peer::PeerId &OptimisticStream::remotePeerId() const {
+    return stream_->remotePeerId();
+  }
+
+  outcome::result<multi::Multiaddress> OptimisticStream::localMultiaddr()
+      const {
+    return stream_->localMultiaddr();
+  }
+
+  outcome::result<multi::Multiaddress> OptimisticStream::remoteMultiaddr()
+      const {
+    return stream_->remoteMultiaddr();
+  }
+
+  common::ByteArray OptimisticStream::proposal() const {
+    auto bytes = MessageManager::openingMsg();
+    auto protocol = MessageManager::protocolMsg(protocol_);
+    bytes.insert(bytes.end(), protocol.begin(), protocol.end());
+    return bytes;
+  }
+
+  void OptimisticStream::negotiated(ThenFunc then) {
+    switch (status_) {
+      case Status::ACCEPTED:
+        return then(outcome::success());
+      case Status::FAILED:
+        return then(MultiselectError::NEGOTIATION_FAILED);
+      case Status::PENDING:
+        break;
+    }
+    if (proposal_sent_) {
+      return readEchoes(std::move(then));
+    }
+    sendProposal([self{shared_from_this()},
+                  then{std::move(then)}](outcome::result<void> res) mutable {
+      if (!res) {
+        return then(res.error());
+      }
+      self->readEchoes(std::move(then));
+    });
+  }
+
+  void OptimisticStream::sendProposal(ThenFunc then) {
+    proposal_sent_ = true;
+    write_buffer_ = proposal();
+    stream_->write(write_buffer_, write_buffer_.size(),
+                   [self{shared_from_this()},
+                    then{std::move(then)}](outcome::result<size_t> res) {
+                     self->write_buffer_.clear();
+                     if (!res) {
+                       return then(res.error());
+                     }
+                     then(outcome::success());
+                   });
+  }
+
+  void OptimisticStream::readEchoes(ThenFunc then) {
+    read_buffer_.resize(MessageManager::openingMsg().size());
+    stream_->read(read_buffer_, read_buffer_.size(),
+                  [self{shared_from_this()},
+                   then{std::move(then)}](outcome::result<size_t> res) mutable {
+                    if (!res) {
+                      return then(res.error());
+                    }
+                    if (self->read_buffer_ != MessageManager::openingMsg()) {
+                      self->status_ = Status::FAILED;
+                      return then(MultiselectError::PROTOCOL_VIOLATION);
+                    }
+                    self->read_buffer_.clear();
+                    self->readResponseLength(std::move(then));
+                  });
+  }
+
+  void OptimisticStream::readResponseLength(ThenFunc then) {
+    read_buffer_.push_back(0);
+    stream_->read(
+        gsl::make_span(read_buffer_).last(1), 1,
+        [self{shared_from_this()},
+         then{std::move(then)}](outcome::result<size_t> res) mutable {
+          if (!res) {
+            return then(res.error());
+          }
+          auto varint = multi::UVarint::create(self->read_buffer_);
+          if (!varint) {
+            if (self->read_buffer_.size() == kMaxVarintSize) {
+              self->status_ = Status::FAILED;
+              return then(MultiselectError::PROTOCOL_VIOLATION);
+            }
+            return self->readResponseLength(std::move(then));
+          }
+
+          // the response is either the echo of the protocol or "na"
+          auto size = varint->toUInt64();
+          if (size > std::max(self->protocol_.size() + 1,
+                              MessageManager::naMsg().size())) {
+            self->status_ = Status::FAILED;
+            return then(MultiselectError::PROTOCOL_VIOLATION);
+          }
+          self->read_buffer_.resize(size);
+          self->stream_->read(
+              self->read_buffer_, size,
+              [self, then{std::move(then)}](outcome::result<size_t> res) {
+                if (!res) {
+                  return then(res.error());
+                }
+                self->checkResponse(then);
+              });
+        });
+  }
+
+  void OptimisticStream::checkResponse(ThenFunc then) {
+    std::string_view response{
+        reinterpret_cast<const char *>(read_buffer_.data()),  // NOLINT
+        read_buffer_.size()};
+    auto accepted = response.size() == protocol_.size() + 1
+        && response.back() == '\n'
+        && response.substr(0, protocol_.size()) == protocol_;
+    auto constant = MessageManager::parseConstantMsg(read_buffer_);
+    read_buffer_ = {};
+    if (accepted) {
+      status_ = Status::ACCEPTED;
+      return then(outcome::success());
+    }
+    status_ = Status::FAILED;
+    if (constant
+        && constant.value().type
+            == MessageManager::MultiselectMessage::MessageType::NA) {
+      return then(MultiselectError::NEGOTIATION_FAILED);
+    }
+    then(MultiselectError::PROTOCOL_VIOLATION);
+  }
+
+}  // namespace libp2p::protocol_muxer
@@ -0,0 +1,158 @@
+/**
+ * Copyright Soramitsu Co., Ltd. All Rights Reserved.
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <libp2p/security/noise/cipher_state.hpp>
+
+#include <limits>
+
+#include <openssl/evp.h>
+#include <libp2p/security/noise/noise_error.hpp>
+
+namespace libp2p::security::noise {
+
+  namespace {
+    constexpr size_t kNonceSize = 12;
+
+    const EVP_CIPHER *evpCipher(CipherSuite suite) {
+      switch (suite) {
+        case CipherSuite::AES_GCM:
+          return EVP_aes_256_gcm();
+        case CipherSuite::CHACHA_POLY:
+          break;
+      }
+      return EVP_chacha20_poly1305();
+    }
+  }  // namespace
+
+  void CipherState::CtxDeleter::operator()(evp_cipher_ctx_st *ctx) const {
+    EVP_CIPHER_CTX_free(ctx);
+  }
+
+  CipherState::CipherState(CipherSuite suite) : suite_{suite} {}
+
+  CipherState::CipherState(CipherState &&other) noexcept = default;
+
+  CipherState &CipherState::operator=(CipherState &&other) noexcept = default;
+
+  CipherState::~CipherState() = default;
+
+  outcome::result<void> CipherState::initializeKey(const Key &key) {
+    if (!ctx_) {
+      ctx_.reset(EVP_CIPHER_CTX_new());
+      if (!ctx_) {
+        return NoiseError::CIPHER_INIT_FAILED;
+      }
+    }
+    if (1
+        != EVP_CipherInit_ex(ctx_.get(), evpCipher(suite_), nullptr,
+                             key.data(), nullptr, 1)) {
+      has_key_ = false;
+      return NoiseError::CIPHER_INIT_FAILED;
+    }
+    has_key_ = true;
+    nonce_ = 0;
+    return outcome::success();
+  }
+
+  bool CipherState::hasKey() const {
+    return has_key_;
+  }
+
+  uint64_t CipherState::nonce() const {
+    return nonce_;
+  }
+
+  outcome::result<void> CipherState::begin(gsl::span<const uint8_t> ad,
+                                           bool encrypt) {
+    // the last value is reserved by the spec
+    if (nonce_ == std::numeric_limits<uint64_t>::max()) {
+      return NoiseError::NONCE_EXHAUSTED;
+    }
+    // 32 bits of zeros and the counter: little-endian for ChaChaPoly and
+    // big-endian for AESGCM
+    std::array<uint8_t, kNonceSize> iv{};
+    for (size_t i = 0; i < sizeof(nonce_); ++i) {
+      auto byte = static_cast<uint8_t>(nonce_ >> (8 * i));
+      if (suite_ == CipherSuite::CHACHA_POLY) {
+        iv[4 + i] = byte;
+      } else {
+        iv[kNonceSize - 1 - i] = byte;
+      }
+    }
+    // the key schedule is kept, only the nonce and the direction are reset
+    if (1
+        != EVP_CipherInit_ex(ctx_.get(), nullptr, nullptr, nullptr, iv.data(),
+                             encrypt ? 1 : 0)) {
+      return NoiseError::CIPHER_INIT_FAILED;
+    }
+    int len = 0;
+    if (!ad.empty()
+        && 1
+            != EVP_CipherUpdate(ctx_.get(), nullptr, &len, ad.data(),
+                                static_cast<int>(ad.size()))) {
+      return NoiseError::CIPHER_INIT_FAILED;
+    }
+    return outcome::success();
+  }
+
+  outcome::result<size_t> CipherState::encrypt(gsl::span<const uint8_t> ad,
+                                               gsl::span<uint8_t> buffer,
+                                               size_t size) {
+    if (!has_key_) {
+      return size;
+    }
+    if (static_cast<size_t>(buffer.size()) < size + kTagSize) {
+      return NoiseError::MESSAGE_TOO_LARGE;
+    }
+    OUTCOME_TRY(begin(ad, true));
+    int len = 0;
+    if (size != 0
+        && 1
+            != EVP_CipherUpdate(ctx_.get(), buffer.data(), &len,
+                                buffer.data(), static_cast<int>(size))) {
+      return NoiseError::ENCRYPTION_FAILED;
+    }
+    int final_len = 0;
+    if (1 != EVP_CipherFinal_ex(ctx_.get(), buffer.data() + len, &final_len)
+        || 1
+            != EVP_CIPHER_CTX_ctrl(ctx_.get(), EVP_CTRL_AEAD_GET_TAG,
+                                   kTagSize, buffer.data() + size)) {
+      return NoiseError::ENCRYPTION_FAILED;
+    }
+    ++nonce_;
+    return size + kTagSize;
+  }
+
+  outcome::result<size_t> CipherState::decrypt(gsl::span<const uint8_t> ad,
+                                               gsl::span<uint8_t> buffer) {
+    if (!has_key_) {
+      return buffer.size();
+    }
+    if (static_cast<size_t>(buffer.size()) < kTagSize) {
+      return NoiseError::MESSAGE_TOO_SHORT;
+    }
+    auto size = buffer.size() - kTagSize;
+    OUTCOME_TRY(begin(ad, false));
+    int len = 0;
+    if (size != 0
+        && 1
+            != EVP_CipherUpdate(ctx_.get(), buffer.data(), &len,
+                                buffer.data(), static_cast<int>(size))) {
+      return NoiseError::DECRYPTION_FAILED;
+    }
+    int final_len = 0;
+    if (1
+            != EVP_CIPHER_CTX_ctrl(ctx_.get(), EVP_CTRL_AEAD_SET_TAG,
+                                   kTagSize, buffer.data() + size)
+        || 1
+            != EVP_CipherFinal_ex(ctx_.get(), buffer.data() + len,
+                                  &final_len)) {
+      return NoiseError::DECRYPTION_FAILED;
+    }
+    ++nonce_;
+    return size;
+  }
+
+}  // namespace libp2p::security::noise
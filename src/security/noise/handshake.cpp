@@ -0,0 +1,189 @@
+/**
+ * Copyright Soramitsu Co., Ltd. All Rights Reserved.
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <libp2p/security/noise/handshake.hpp>
+
+#include <generated/security/noise/protobuf/noise.pb.h>
+#include <libp2p/security/noise/noise_connection.hpp>
+#include <libp2p/security/noise/noise_error.hpp>
+
+namespace libp2p::security::noise {
+
+  namespace {
+    constexpr size_t kLengthSize = 2;
+
+    std::vector<uint8_t> signedMessage(const DhKey &static_key) {
+      std::vector<uint8_t> message{kPayloadSigningPrefix.begin(),
+                                   kPayloadSigningPrefix.end()};
+      message.insert(message.end(), static_key.begin(), static_key.end());
+      return message;
+    }
+  }  // namespace
+
+  outcome::result<LocalIdentity> makeLocalIdentity(
+      const crypto::CryptoProvider &crypto_provider,
+      const crypto::marshaller::KeyMarshaller &key_marshaller,
+      const crypto::KeyPair &key_pair, const peer::PeerId &peer_id) {
+    OUTCOME_TRY(static_keys, generateDhKeyPair());
+    OUTCOME_TRY(identity_key, key_marshaller.marshal(key_pair.publicKey));
+    auto message = signedMessage(static_keys.public_key);
+    OUTCOME_TRY(signature, crypto_provider.sign(message, key_pair.privateKey));
+
+    protobuf::NoiseHandshakePayload payload_msg;
+    payload_msg.set_identity_key(identity_key.key.data(),
+                                 identity_key.key.size());
+    payload_msg.set_identity_sig(signature.data(), signature.size());
+    std::vector<uint8_t> payload(payload_msg.ByteSizeLong());
+    if (!payload_msg.SerializeToArray(payload.data(), payload.size())) {
+      return NoiseError::INVALID_PAYLOAD;
+    }
+    return LocalIdentity{key_pair.publicKey, peer_id, static_keys,
+                         std::move(payload)};
+  }
+
+  Handshake::Handshake(
+      std::shared_ptr<crypto::CryptoProvider> crypto_provider,
+      std::shared_ptr<crypto::marshaller::KeyMarshaller> key_marshaller,
+      std::shared_ptr<const LocalIdentity> identity, DhKeyPair ephemeral_keys,
+      CipherSuite suite, std::shared_ptr<connection::RawConnection> conn,
+      bool initiator, boost::optional<peer::PeerId> remote_peer,
+      SecConnCallbackFunc cb)
+      : crypto_provider_{std::move(crypto_provider)},
+        key_marshaller_{std::move(key_marshaller)},
+        identity_{std::move(identity)},
+        conn_{std::move(conn)},
+        state_{suite, initiator, identity_->static_keys, {}, ephemeral_keys},
+        initiator_{initiator},
+        remote_peer_{std::move(remote_peer)},
+        cb_{std::move(cb)} {}
+
+  void Handshake::connect() {
+    auto self = shared_from_this();
+    if (initiator_) {
+      // -> e
+      // <- e, ee, s, es
+      // -> s, se
+      return sendMessage({}, [self] {
+        self->receiveMessage([self](auto payload) {
+          if (auto res = self->verifyPayload(payload); !res) {
+            return self->fail(res.error());
+          }
+          self->sendMessage(self->identity_->payload,
+                            [self] { self->complete(); });
+        });
+      });
+    }
+    receiveMessage([self](auto) {
+      self->sendMessage(self->identity_->payload, [self] {
+        self->receiveMessage([self](auto payload) {
+          if (auto res = self->verifyPayload(payload); !res) {
+            return self->fail(res.error());
+          }
+          self->complete();
+        });
+      });
+    });
+  }
+
+  void Handshake::sendMessage(gsl::span<const uint8_t> payload,
+                              ThenFunc then) {
+    auto message = state_.writeMessage(payload);
+    if (!message) {
+      return fail(message.error());
+    }
+    auto size = message.value().size();
+    buffer_.resize(kLengthSize);
+    buffer_[0] = static_cast<uint8_t>(size >> 8u);
+    buffer_[1] = static_cast<uint8_t>(size);
+    buffer_.insert(buffer_.end(), message.value().begin(),
+                   message.value().end());
+    conn_->write(buffer_, buffer_.size(),
+                 [self{shared_from_this()}, then{std::move(then)}](
+                     outcome::result<size_t> res) {
+                   if (!res) {
+                     return self->fail(res.error());
+                   }
+                   then();
+                 });
+  }
+
+  void Handshake::receiveMessage(PayloadFunc then) {
+    buffer_.resize(kLengthSize);
+    conn_->read(
+        buffer_, kLengthSize,
+        [self{shared_from_this()},
+         then{std::move(then)}](outcome::result<size_t> res) mutable {
+          if (!res) {
+            return self->fail(res.error());
+          }
+          auto size = (static_cast<size_t>(self->buffer_[0]) << 8u)
+              + self->buffer_[1];
+          self->buffer_.resize(size);
+          self->conn_->read(
+              self->buffer_, size,
+              [self, then{std::move(then)}](outcome::result<size_t> res) {
+                if (!res) {
+                  return self->fail(res.error());
+                }
+                auto payload = self->state_.readMessage(self->buffer_);
+                if (!payload) {
+                  return self->fail(payload.error());
+                }
+                then(std::move(payload.value()));
+              });
+        });
+  }
+
+  outcome::result<void> Handshake::verifyPayload(
+      gsl::span<const uint8_t> payload) {
+    protobuf::NoiseHandshakePayload payload_msg;
+    if (!payload_msg.ParseFromArray(payload.data(), payload.size())) {
+      return NoiseError::INVALID_PAYLOAD;
+    }
+    const auto &key = payload_msg.identity_key();
+    crypto::ProtobufKey identity_key{{key.begin(), key.end()}};
+    OUTCOME_TRY(public_key, key_marshaller_->unmarshalPublicKey(identity_key));
+    OUTCOME_TRY(peer_id, peer::PeerId::fromPublicKey(identity_key));
+    if (remote_peer_ && *remote_peer_ != peer_id) {
+      return NoiseError::PEER_ID_MISMATCH;
+    }
+
+    auto message = signedMessage(state_.remoteStaticKey());
+    const auto &sig = payload_msg.identity_sig();
+    std::vector<uint8_t> signature{sig.begin(), sig.end()};
+    OUTCOME_TRY(valid,
+                crypto_provider_->verify(message, signature, public_key));
+    if (!valid) {
+      return NoiseError::INVALID_SIGNATURE;
+    }
+    remote_peer_ = std::move(peer_id);
+    remote_pubkey_ = std::move(public_key);
+    return outcome::success();
+  }
+
+  void Handshake::complete() {
+    auto states = state_.split();
+    if (!states) {
+      return fail(states.error());
+    }
+    buffer_ = {};
+    cb_(std::make_shared<connection::NoiseConnection>(
+        conn_, std::move(states.value().first),
+        std::move(states.value().second), identity_->public_key,
+        std::move(*remote_pubkey_), identity_->peer_id,
+        std::move(*remote_peer_)));
+  }
+
+  void Handshake::fail(const std::error_code &error) {
+    log_->error("error happened while establishing a Noise session: {}",
+                error.message());
+    if (auto close_res = conn_->close(); !close_res) {
+      log_->error("connection close attempt ended with error: {}",
+                  close_res.error().message());
+    }
+    cb_(error);
+  }
+
+}  // namespace libp2p::security::noise
@@ -0,0 +1,320 @@
+/**
+ * Copyright Soramitsu Co., Ltd. All Rights Reserved.
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <libp2p/security/noise/handshake_state.hpp>
+
+#include <algorithm>
+
+#include <openssl/evp.h>
+#include <openssl/hmac.h>
+#include <gsl/gsl_util>
+#include <libp2p/security/noise/noise_error.hpp>
+
+namespace libp2p::security::noise {
+
+  namespace {
+    using Hash = SymmetricState::Hash;
+
+    std::string protocolName(CipherSuite suite) {
+      return suite == CipherSuite::AES_GCM ? "Noise_XX_25519_AESGCM_SHA256"
+                                           : "Noise_XX_25519_ChaChaPoly_SHA256";
+    }
+
+    Hash hmac(const Hash &key, gsl::span<const uint8_t> data1,
+              gsl::span<const uint8_t> data2 = {}) {
+      Hash out{};
+      HMAC_CTX *ctx = HMAC_CTX_new();
+      auto free_ctx = gsl::finally([ctx] { HMAC_CTX_free(ctx); });
+      unsigned len = 0;
+      HMAC_Init_ex(ctx, key.data(), key.size(), EVP_sha256(), nullptr);
+      HMAC_Update(ctx, data1.data(), data1.size());
+      HMAC_Update(ctx, data2.data(), data2.size());
+      HMAC_Final(ctx, out.data(), &len);
+      return out;
+    }
+
+    /// HKDF of the Noise spec, which yields two outputs
+    std::pair<Hash, Hash> hkdf(const Hash &chaining_key,
+                               gsl::span<const uint8_t> input_key_material) {
+      auto temp_key = hmac(chaining_key, input_key_material);
+      const uint8_t one = 1;
+      const uint8_t two = 2;
+      auto out1 = hmac(temp_key, gsl::make_span(&one, 1));
+      auto out2 = hmac(temp_key, out1, gsl::make_span(&two, 1));
+      return {out1, out2};
+    }
+
+    outcome::result<std::shared_ptr<EVP_PKEY>> x25519Key(const DhKey &key,
+                                                         bool is_private) {
+      auto *pkey = is_private
+          ? EVP_PKEY_new_raw_private_key(EVP_PKEY_X25519, nullptr, key.data(),
+                                         key.size())
+          : EVP_PKEY_new_raw_public_key(EVP_PKEY_X25519, nullptr, key.data(),
+                                        key.size());
+      if (pkey == nullptr) {
+        return NoiseError::DH_FAILED;
+      }
+      return std::shared_ptr<EVP_PKEY>{pkey, EVP_PKEY_free};
+    }
+  }  // namespace
+
+  outcome::result<DhKeyPair> generateDhKeyPair() {
+    EVP_PKEY_CTX *pctx = EVP_PKEY_CTX_new_id(EVP_PKEY_X25519, nullptr);
+    if (pctx == nullptr) {
+      return NoiseError::DH_FAILED;
+    }
+    auto free_pctx = gsl::finally([pctx] { EVP_PKEY_CTX_free(pctx); });
+    EVP_PKEY *pkey = nullptr;
+    if (1 != EVP_PKEY_keygen_init(pctx) || 1 != EVP_PKEY_keygen(pctx, &pkey)) {
+      return NoiseError::DH_FAILED;
+    }
+    auto free_pkey = gsl::finally([pkey] { EVP_PKEY_free(pkey); });
+    DhKeyPair keys{};
+    size_t private_len = kDhSize;
+    size_t public_len = kDhSize;
+    if (1
+            != EVP_PKEY_get_raw_private_key(pkey, keys.private_key.data(),
+                                            &private_len)
+        || 1
+            != EVP_PKEY_get_raw_public_key(pkey, keys.public_key.data(),
+                                           &public_len)) {
+      return NoiseError::DH_FAILED;
+    }
+    return keys;
+  }
+
+  outcome::result<DhKeyPair> dhKeyPairFromPrivate(const DhKey &private_key) {
+    OUTCOME_TRY(pkey, x25519Key(private_key, true));
+    DhKeyPair keys{private_key, {}};
+    size_t len = kDhSize;
+    if (1
+        != EVP_PKEY_get_raw_public_key(pkey.get(), keys.public_key.data(),
+                                       &len)) {
+      return NoiseError::DH_FAILED;
+    }
+    return keys;
+  }
+
+  outcome::result<DhKey> dh(const DhKey &private_key, const DhKey &public_key) {
+    OUTCOME_TRY(local, x25519Key(private_key, true));
+    OUTCOME_TRY(remote, x25519Key(public_key, false));
+    EVP_PKEY_CTX *ctx = EVP_PKEY_CTX_new(local.get(), nullptr);
+    if (ctx == nullptr) {
+      return NoiseError::DH_FAILED;
+    }
+    auto free_ctx = gsl::finally([ctx] { EVP_PKEY_CTX_free(ctx); });
+    DhKey secret{};
+    size_t len = secret.size();
+    if (1 != EVP_PKEY_derive_init(ctx)
+        || 1 != EVP_PKEY_derive_set_peer(ctx, remote.get())
+        || 1 != EVP_PKEY_derive(ctx, secret.data(), &len)) {
+      return NoiseError::DH_FAILED;
+    }
+    return secret;
+  }
+
+  SymmetricState::SymmetricState(CipherSuite suite,
+                                 std::string_view protocol_name)
+      : suite_{suite}, cipher_{suite} {
+    if (protocol_name.size() <= h_.size()) {
+      std::copy(protocol_name.begin(), protocol_name.end(), h_.begin());
+    } else {
+      hasher_.update(protocol_name);
+      h_ = hasher_.digest();
+    }
+    ck_ = h_;
+  }
+
+  void SymmetricState::mixHash(gsl::span<const uint8_t> data) {
+    hasher_.update(h_).update(data);
+    h_ = hasher_.digest();
+  }
+
+  outcome::result<void> SymmetricState::mixKey(
+      gsl::span<const uint8_t> input_key_material) {
+    auto [ck, key] = hkdf(ck_, input_key_material);
+    ck_ = ck;
+    return cipher_.initializeKey(key);
+  }
+
+  outcome::result<size_t> SymmetricState::encryptAndHash(
+      gsl::span<uint8_t> buffer, size_t size) {
+    OUTCOME_TRY(encrypted, cipher_.encrypt(h_, buffer, size));
+    mixHash(buffer.first(encrypted));
+    return encrypted;
+  }
+
+  outcome::result<size_t> SymmetricState::decryptAndHash(
+      gsl::span<uint8_t> buffer) {
+    // the hash is of the ciphertext, which is overwritten by decryption
+    auto h = h_;
+    mixHash(buffer);
+    return cipher_.decrypt(h, buffer);
+  }
+
+  bool SymmetricState::hasKey() const {
+    return cipher_.hasKey();
+  }
+
+  const Hash &SymmetricState::handshakeHash() const {
+    return h_;
+  }
+
+  outcome::result<std::pair<CipherState, CipherState>> SymmetricState::split()
+      const {
+    auto [key1, key2] = hkdf(ck_, {});
+    std::pair<CipherState, CipherState> states{suite_, suite_};
+    OUTCOME_TRY(states.first.initializeKey(key1));
+    OUTCOME_TRY(states.second.initializeKey(key2));
+    return states;
+  }
+
+  HandshakeState::HandshakeState(CipherSuite suite, bool initiator,
+                                 DhKeyPair static_keys,
+                                 gsl::span<const uint8_t> prologue,
+                                 std::optional<DhKeyPair> ephemeral_keys)
+      : initiator_{initiator},
+        symmetric_{suite, protocolName(suite)},
+        s_{static_keys},
+        e_{ephemeral_keys} {
+    symmetric_.mixHash(prologue);
+  }
+
+  outcome::result<DhKey> HandshakeState::dhToken(Token token) const {
+    switch (token) {
+      case Token::EE:
+        return dh(e_->private_key, re_);
+      case Token::ES:
+        return initiator_ ? dh(e_->private_key, rs_)
+                          : dh(s_.private_key, re_);
+      case Token::SE:
+        return initiator_ ? dh(s_.private_key, re_)
+                          : dh(e_->private_key, rs_);
+      default:
+        break;
+    }
+    return NoiseError::DH_FAILED;
+  }
+
+  const std::vector<HandshakeState::Token> &HandshakeState::tokens(
+      size_t message) {
+    static const std::vector<Token> kPattern[kMessages] = {
+        {Token::E},
+        {Token::E, Token::EE, Token::S, Token::ES},
+        {Token::S, Token::SE},
+    };
+    return kPattern[message];
+  }
+
+  outcome::result<std::vector<uint8_t>> HandshakeState::writeMessage(
+      gsl::span<const uint8_t> payload) {
+    if (isComplete()) {
+      return NoiseError::HANDSHAKE_COMPLETE;
+    }
+    auto tag = [this] {
+      return symmetric_.hasKey() ? CipherState::kTagSize : 0;
+    };
+    std::vector<uint8_t> message;
+    message.reserve(2 * (kDhSize + CipherState::kTagSize) + payload.size()
+                    + CipherState::kTagSize);
+    for (auto token : tokens(message_index_)) {
+      if (token == Token::E) {
+        if (!e_) {
+          OUTCOME_TRY(keys, generateDhKeyPair());
+          e_ = keys;
+        }
+        message.insert(message.end(), e_->public_key.begin(),
+                       e_->public_key.end());
+        symmetric_.mixHash(e_->public_key);
+      } else if (token == Token::S) {
+        auto offset = message.size();
+        message.insert(message.end(), s_.public_key.begin(),
+                       s_.public_key.end());
+        message.resize(offset + kDhSize + tag());
+        OUTCOME_TRY(symmetric_.encryptAndHash(
+            gsl::make_span(message).subspan(offset), kDhSize));
+      } else {
+        OUTCOME_TRY(secret, dhToken(token));
+        OUTCOME_TRY(symmetric_.mixKey(secret));
+      }
+    }
+    auto offset = message.size();
+    message.insert(message.end(), payload.begin(), payload.end());
+    message.resize(offset + payload.size() + tag());
+    if (message.size() > kMaxMessageSize) {
+      return NoiseError::MESSAGE_TOO_LARGE;
+    }
+    OUTCOME_TRY(symmetric_.encryptAndHash(
+        gsl::make_span(message).subspan(offset), payload.size()));
+    ++message_index_;
+    return message;
+  }
+
+  outcome::result<std::vector<uint8_t>> HandshakeState::readMessage(
+      gsl::span<const uint8_t> message) {
+    if (isComplete()) {
+      return NoiseError::HANDSHAKE_COMPLETE;
+    }
+    if (static_cast<size_t>(message.size()) > kMaxMessageSize) {
+      return NoiseError::MESSAGE_TOO_LARGE;
+    }
+    std::vector<uint8_t> buffer{message.begin(), message.end()};
+    auto rest = gsl::make_span(buffer);
+    for (auto token : tokens(message_index_)) {
+      if (token == Token::E) {
+        if (static_cast<size_t>(rest.size()) < kDhSize) {
+          return NoiseError::MESSAGE_TOO_SHORT;
+        }
+        std::copy_n(rest.begin(), kDhSize, re_.begin());
+        symmetric_.mixHash(re_);
+        rest = rest.subspan(kDhSize);
+      } else if (token == Token::S) {
+        auto size =
+            kDhSize + (symmetric_.hasKey() ? CipherState::kTagSize : 0);
+        if (static_cast<size_t>(rest.size()) < size) {
+          return NoiseError::MESSAGE_TOO_SHORT;
+        }
+        OUTCOME_TRY(symmetric_.decryptAndHash(rest.first(size)));
+        std::copy_n(rest.begin(), kDhSize, rs_.begin());
+        rest = rest.subspan(size);
+      } else {
+        OUTCOME_TRY(secret, dhToken(token));
+        OUTCOME_TRY(symmetric_.mixKey(secret));
+      }
+    }
+    OUTCOME_TRY(size, symmetric_.decryptAndHash(rest));
+    ++message_index_;
+    return std::vector<uint8_t>{rest.begin(), rest.begin() + size};
+  }
+
+  bool HandshakeState::isMyTurn() const {
+    return (message_index_ % 2 == 0) == initiator_;
+  }
+
+  bool HandshakeState::isComplete() const {
+    return message_index_ == kMessages;
+  }
+
+  const DhKey &HandshakeState::remoteStaticKey() const {
+    return rs_;
+  }
+
+  const SymmetricState::Hash &HandshakeState::handshakeHash() const {
+    return symmetric_.handshakeHash();
+  }
+
+  outcome::result<std::pair<CipherState, CipherState>> HandshakeState::split()
+      const {
+    if (!isComplete()) {
+      return NoiseError::HANDSHAKE_INCOMPLETE;
+    }
+    OUTCOME_TRY(states, symmetric_.split());
+    if (initiator_) {
+      return std::move(states);
+    }
+    return std::make_pair(std::move(states.second), std::move(states.first));
+  }
+
+}  // namespace libp2p::security::noise
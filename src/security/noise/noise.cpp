@@ -0,0 +1,80 @@
+/**
+ * Copyright Soramitsu Co., Ltd. All Rights Reserved.
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <libp2p/security/noise/noise.hpp>
+
+#include <libp2p/security/noise/handshake.hpp>
+
+namespace libp2p::security {
+
+  Noise::Noise(
+      std::shared_ptr<peer::IdentityManager> idmgr,
+      std::shared_ptr<crypto::CryptoProvider> crypto_provider,
+      std::shared_ptr<crypto::marshaller::KeyMarshaller> key_marshaller,
+      noise::NoiseConfig config)
+      : idmgr_{std::move(idmgr)},
+        crypto_provider_{std::move(crypto_provider)},
+        key_marshaller_{std::move(key_marshaller)},
+        config_{config} {
+    BOOST_ASSERT(idmgr_);
+    BOOST_ASSERT(crypto_provider_);
+    BOOST_ASSERT(key_marshaller_);
+  }
+
+  peer::Protocol Noise::getProtocolId() const {
+    return "/noise";
+  }
+
+  void Noise::secureInbound(std::shared_ptr<connection::RawConnection> inbound,
+                            SecConnCallbackFunc cb) {
+    log_->debug("securing inbound connection");
+    handshake(std::move(inbound), false, boost::none, std::move(cb));
+  }
+
+  void Noise::secureOutbound(
+      std::shared_ptr<connection::RawConnection> outbound,
+      const peer::PeerId &p, SecConnCallbackFunc cb) {
+    log_->debug("securing outbound connection");
+    handshake(std::move(outbound), true, p, std::move(cb));
+  }
+
+  outcome::result<std::shared_ptr<const noise::LocalIdentity>>
+  Noise::localIdentity() {
+    const auto &key_pair = idmgr_->getKeyPair();
+    if (!identity_ || identity_->public_key != key_pair.publicKey) {
+      OUTCOME_TRY(identity,
+                  noise::makeLocalIdentity(*crypto_provider_, *key_marshaller_,
+                                           key_pair, idmgr_->getId()));
+      identity_ =
+          std::make_shared<const noise::LocalIdentity>(std::move(identity));
+    }
+    return identity_;
+  }
+
+  void Noise::handshake(std::shared_ptr<connection::RawConnection> conn,
+                        bool initiator,
+                        boost::optional<peer::PeerId> remote_peer,
+                        SecConnCallbackFunc cb) {
+    auto identity = localIdentity();
+    if (!identity) {
+      log_->error("cannot sign the static key: {}",
+                  identity.error().message());
+      return cb(identity.error());
+    }
+    // the provider keeps a pool of ephemeral keys, generated in background
+    auto ephemeral_keys = crypto_provider_->generateEphemeralX25519KeyPair();
+    if (!ephemeral_keys) {
+      log_->error("cannot generate the ephemeral key: {}",
+                  ephemeral_keys.error().message());
+      return cb(ephemeral_keys.error());
+    }
+    std::make_shared<noise::Handshake>(
+        crypto_provider_, key_marshaller_, std::move(identity.value()),
+        ephemeral_keys.value(), config_.cipher, std::move(conn), initiator,
+        std::move(remote_peer), std::move(cb))
+        ->connect();
+  }
+
+}  // namespace libp2p::security
@@ -0,0 +1,178 @@
+/**
+ * Copyright Soramitsu Co., Ltd. All Rights Reserved.
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <libp2p/security/noise/noise_connection.hpp>
+
+#include <algorithm>
+
+#include <boost/assert.hpp>
+#include <libp2p/security/noise/noise_error.hpp>
+
+namespace libp2p::connection {
+
+  using security::noise::CipherState;
+  using security::noise::NoiseError;
+
+  NoiseConnection::NoiseConnection(
+      std::shared_ptr<RawConnection> raw_connection, CipherState encoder,
+      CipherState decoder, crypto::PublicKey local_pubkey,
+      crypto::PublicKey remote_pubkey, peer::PeerId local_peer,
+      peer::PeerId remote_peer)
+      : raw_connection_{std::move(raw_connection)},
+        encoder_{std::move(encoder)},
+        decoder_{std::move(decoder)},
+        local_pubkey_{std::move(local_pubkey)},
+        remote_pubkey_{std::move(remote_pubkey)},
+        local_peer_{std::move(local_peer)},
+        remote_peer_{std::move(remote_peer)},
+        read_buffer_(kMaxPlaintextSize + CipherState::kTagSize),
+        write_buffer_(kLengthSize + kMaxPlaintextSize
+                      + CipherState::kTagSize) {
+    BOOST_ASSERT(raw_connection_);
+  }
+
+  const peer::PeerId &NoiseConnection::localPeer() const {
+    return local_peer_;
+  }
+
+  const peer::PeerId &NoiseConnection::remotePeer() const {
+    return remote_peer_;
+  }
+
+  outcome::result<crypto::PublicKey> NoiseConnection::remotePublicKey()
+      const {
+    return remote_pubkey_;
+  }
+
+  bool NoiseConnection::isInitiator() const noexcept {
+    return raw_connection_->isInitiator();
+  }
+
+  outcome::result<multi::Multiaddress> NoiseConnection::localMultiaddr() {
+    return raw_connection_->localMultiaddr();
+  }
+
+  outcome::result<multi::Multiaddress> NoiseConnection::remoteMultiaddr() {
+    return raw_connection_->remoteMultiaddr();
+  }
+
+  void NoiseConnection::read(gsl::span<uint8_t> out, size_t bytes,
+                             ReadCallbackFunc cb) {
+    auto size = std::min(static_cast<size_t>(out.size()), bytes);
+    readFrames(out.first(size), 0, true, std::move(cb));
+  }
+
+  void NoiseConnection::readSome(gsl::span<uint8_t> out, size_t bytes,
+                                 ReadCallbackFunc cb) {
+    auto size = std::min(static_cast<size_t>(out.size()), bytes);
+    readFrames(out.first(size), 0, false, std::move(cb));
+  }
+
+  size_t NoiseConnection::popPlaintext(gsl::span<uint8_t> out) {
+    auto size = std::min(static_cast<size_t>(out.size()),
+                         read_end_ - read_offset_);
+    std::copy_n(read_buffer_.begin() + read_offset_, size, out.begin());
+    read_offset_ += size;
+    return size;
+  }
+
+  void NoiseConnection::readFrames(gsl::span<uint8_t> out, size_t done,
+                                   bool all, ReadCallbackFunc cb) {
+    done += popPlaintext(out.subspan(done));
+    if (done == static_cast<size_t>(out.size()) || (done != 0 && !all)) {
+      return cb(done);
+    }
+    readFrame([self{shared_from_this()}, out, done, all,
+               cb{std::move(cb)}](outcome::result<void> res) mutable {
+      if (!res) {
+        return cb(res.error());
+      }
+      self->readFrames(out, done, all, std::move(cb));
+    });
+  }
+
+  void NoiseConnection::readFrame(
+      std::function<void(outcome::result<void>)> cb) {
+    raw_connection_->read(
+        read_length_, kLengthSize,
+        [self{shared_from_this()},
+         cb{std::move(cb)}](outcome::result<size_t> res) mutable {
+          if (!res) {
+            return cb(res.error());
+          }
+          auto size = (static_cast<size_t>(self->read_length_[0]) << 8u)
+              + self->read_length_[1];
+          if (size < CipherState::kTagSize) {
+            return cb(NoiseError::MESSAGE_TOO_SHORT);
+          }
+          auto frame = gsl::make_span(self->read_buffer_).first(size);
+          self->raw_connection_->read(
+              frame, size,
+              [self, frame,
+               cb{std::move(cb)}](outcome::result<size_t> res) mutable {
+                if (!res) {
+                  return cb(res.error());
+                }
+                auto decrypted = self->decoder_.decrypt({}, frame);
+                if (!decrypted) {
+                  return cb(decrypted.error());
+                }
+                self->read_offset_ = 0;
+                self->read_end_ = decrypted.value();
+                cb(outcome::success());
+              });
+        });
+  }
+
+  void NoiseConnection::write(gsl::span<const uint8_t> in, size_t bytes,
+                              WriteCallbackFunc cb) {
+    auto size = std::min(static_cast<size_t>(in.size()), bytes);
+    writeFrames(in.first(size), 0, true, std::move(cb));
+  }
+
+  void NoiseConnection::writeSome(gsl::span<const uint8_t> in, size_t bytes,
+                                  WriteCallbackFunc cb) {
+    auto size = std::min(static_cast<size_t>(in.size()), bytes);
+    writeFrames(in.first(size), 0, false, std::move(cb));
+  }
+
+  void NoiseConnection::writeFrames(gsl::span<const uint8_t> in, size_t done,
+                                    bool all, WriteCallbackFunc cb) {
+    if (done == static_cast<size_t>(in.size())) {
+      return cb(done);
+    }
+    auto size = std::min(in.size() - done, kMaxPlaintextSize);
+    auto frame = gsl::make_span(write_buffer_).subspan(kLengthSize);
+    std::copy_n(in.begin() + done, size, frame.begin());
+    auto encrypted = encoder_.encrypt({}, frame, size);
+    if (!encrypted) {
+      return cb(encrypted.error());
+    }
+    write_buffer_[0] = static_cast<uint8_t>(encrypted.value() >> 8u);
+    write_buffer_[1] = static_cast<uint8_t>(encrypted.value());
+    auto total = kLengthSize + encrypted.value();
+    raw_connection_->write(
+        gsl::make_span(write_buffer_).first(total), total,
+        [self{shared_from_this()}, in, done{done + size}, all,
+         cb{std::move(cb)}](outcome::result<size_t> res) mutable {
+          if (!res) {
+            return cb(res.error());
+          }
+          if (!all) {
+            return cb(done);
+          }
+          self->writeFrames(in, done, all, std::move(cb));
+        });
+  }
+
+  bool NoiseConnection::isClosed() const {
+    return raw_connection_->isClosed();
+  }
+
+  outcome::result<void> NoiseConnection::close() {
+    return raw_connection_->close();
+  }
+
+}  // namespace libp2p::connection
@@ -0,0 +1,37 @@
+/**
+ * Copyright Soramitsu Co., Ltd. All Rights Reserved.
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <libp2p/security/noise/noise_error.hpp>
+
+OUTCOME_CPP_DEFINE_CATEGORY(libp2p::security::noise, NoiseError, e) {
+  using E = libp2p::security::noise::NoiseError;
+  switch (e) {
+    case E::CIPHER_INIT_FAILED:
+      return "Failed to initialize the Noise cipher";
+    case E::ENCRYPTION_FAILED:
+      return "Failed to encrypt the Noise message";
+    case E::DECRYPTION_FAILED:
+      return "Failed to decrypt the Noise message";
+    case E::NONCE_EXHAUSTED:
+      return "Nonce of the Noise cipher is exhausted";
+    case E::DH_FAILED:
+      return "X25519 key agreement failed";
+    case E::MESSAGE_TOO_LARGE:
+      return "Noise message exceeds 65535 bytes";
+    case E::MESSAGE_TOO_SHORT:
+      return "Noise message is too short";
+    case E::HANDSHAKE_COMPLETE:
+      return "Noise handshake is already complete";
+    case E::HANDSHAKE_INCOMPLETE:
+      return "Noise handshake is not complete yet";
+    case E::INVALID_PAYLOAD:
+      return "Noise handshake payload cannot be decoded";
+    case E::INVALID_SIGNATURE:
+      return "Noise static key is not signed by the identity key";
+    case E::PEER_ID_MISMATCH:
+      return "Remote peer id differs from the dialed one";
+  }
+  return "Unknown error";
+}
@@ -175,7 +175,7 @@ namespace libp2p::security {
 
     cb(std::make_shared<connection::PlaintextConnection>(
         conn, idmgr_->getKeyPair().publicKey, std::move(pkey),
-        key_marshaller_));
+        idmgr_->getId(), std::move(derived_pid)));
   }
 
   void Plaintext::closeConnection(
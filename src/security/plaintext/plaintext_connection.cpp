@@ -6,7 +6,6 @@
 #include <libp2p/security/plaintext/plaintext_connection.hpp>
 
 #include <boost/assert.hpp>
-#include "libp2p/crypto/protobuf/protobuf_key.hpp"
 
 namespace libp2p::connection {
 
@@ -14,29 +13,22 @@ namespace libp2p::connection {
       std::shared_ptr<RawConnection> raw_connection,
       crypto::PublicKey localPubkey,
       crypto::PublicKey remotePubkey,
-      std::shared_ptr<crypto::marshaller::KeyMarshaller> key_marshaller)
+      peer::PeerId localPeer,
+      peer::PeerId remotePeer)
       : raw_connection_{std::move(raw_connection)},
         local_(std::move(localPubkey)),
         remote_(std::move(remotePubkey)),
-        key_marshaller_{std::move(key_marshaller)} {
+        local_peer_{std::move(localPeer)},
+        remote_peer_{std::move(remotePeer)} {
     BOOST_ASSERT(raw_connection_);
-    BOOST_ASSERT(key_marshaller_);
   }
 
-  outcome::result<peer::PeerId> PlaintextConnection::localPeer() const {
-    auto proto_local_key_res = key_marshaller_->marshal(local_);
-    if (!proto_local_key_res) {
-      return proto_local_key_res.error();
-    }
-    return peer::PeerId::fromPublicKey(proto_local_key_res.value());
+  const peer::PeerId &PlaintextConnection::localPeer() const {
+    return local_peer_;
   }
 
-  outcome::result<peer::PeerId> PlaintextConnection::remotePeer() const {
-    auto proto_remote_key_res = key_marshaller_->marshal(remote_);
-    if (!proto_remote_key_res) {
-      return proto_remote_key_res.error();
-    }
-    return peer::PeerId::fromPublicKey(proto_remote_key_res.value());
+  const peer::PeerId &PlaintextConnection::remotePeer() const {
+    return remote_peer_;
   }
 
   outcome::result<crypto::PublicKey> PlaintextConnection::remotePublicKey()
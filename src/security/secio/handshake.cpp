@@ -0,0 +1,377 @@
+/**
+ * Copyright Soramitsu Co., Ltd. All Rights Reserved.
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <libp2p/security/secio/handshake.hpp>
+
+#include <algorithm>
+#include <cstring>
+
+#include <generated/security/secio/protobuf/secio.pb.h>
+#include <libp2p/crypto/sha/sha256.hpp>
+#include <libp2p/security/secio/secio_connection.hpp>
+#include <libp2p/security/secio/secio_error.hpp>
+
+namespace libp2p::security::secio {
+
+  namespace {
+    constexpr size_t kLengthSize = 4;
+
+    using crypto::common::CipherType;
+    using crypto::common::CurveType;
+    using crypto::common::HashType;
+
+    /// split comma-separated algorithms without allocation
+    template <typename F>
+    bool anyOf(std::string_view list, F &&f) {
+      while (!list.empty()) {
+        auto comma = list.find(',');
+        if (f(list.substr(0, comma))) {
+          return true;
+        }
+        if (comma == std::string_view::npos) {
+          break;
+        }
+        list.remove_prefix(comma + 1);
+      }
+      return false;
+    }
+
+    std::vector<uint8_t> concat(gsl::span<const uint8_t> a,
+                                gsl::span<const uint8_t> b,
+                                gsl::span<const uint8_t> c = {}) {
+      std::vector<uint8_t> result;
+      result.reserve(a.size() + b.size() + c.size());
+      result.insert(result.end(), a.begin(), a.end());
+      result.insert(result.end(), b.begin(), b.end());
+      result.insert(result.end(), c.begin(), c.end());
+      return result;
+    }
+
+    template <typename Message>
+    outcome::result<std::vector<uint8_t>> serialize(const Message &message) {
+      std::vector<uint8_t> bytes(message.ByteSizeLong());
+      if (!message.SerializeToArray(bytes.data(), bytes.size())) {
+        return SecioError::INVALID_MESSAGE;
+      }
+      return bytes;
+    }
+
+    outcome::result<CurveType> curveType(std::string_view name) {
+      if (name == "P-256") {
+        return CurveType::P256;
+      }
+      if (name == "P-384") {
+        return CurveType::P384;
+      }
+      if (name == "P-521") {
+        return CurveType::P521;
+      }
+      return SecioError::NO_COMMON_ALGORITHM;
+    }
+
+    outcome::result<CipherType> cipherType(std::string_view name) {
+      if (name == "AES-256") {
+        return CipherType::AES256;
+      }
+      if (name == "AES-128") {
+        return CipherType::AES128;
+      }
+      return SecioError::NO_COMMON_ALGORITHM;
+    }
+
+    outcome::result<HashType> hashType(std::string_view name) {
+      if (name == "SHA256") {
+        return HashType::SHA256;
+      }
+      if (name == "SHA512") {
+        return HashType::SHA512;
+      }
+      return SecioError::NO_COMMON_ALGORITHM;
+    }
+
+    template <typename T, typename F>
+    outcome::result<T> chooseAlgorithm(int order, std::string_view local,
+                                       const std::string &remote, F &&parse) {
+      auto best = selectBest(order, local, remote);
+      if (!best) {
+        return SecioError::NO_COMMON_ALGORITHM;
+      }
+      return parse(*best);
+    }
+
+    template <typename Secret>
+    Secret makeSecret(const crypto::StretchedKey &key) {
+      Secret secret{};
+      std::copy_n(key.cipher_key.begin(), secret.key.size(),
+                  secret.key.begin());
+      std::copy_n(key.iv.begin(), secret.iv.size(), secret.iv.begin());
+      return secret;
+    }
+
+    outcome::result<crypto::aes::AesCtr> makeCipher(
+        CipherType type, const crypto::StretchedKey &key,
+        crypto::aes::Mode mode) {
+      if (type == CipherType::AES128) {
+        return crypto::aes::AesCtr::create(
+            makeSecret<crypto::common::Aes128Secret>(key), mode);
+      }
+      return crypto::aes::AesCtr::create(
+          makeSecret<crypto::common::Aes256Secret>(key), mode);
+    }
+  }  // namespace
+
+  boost::optional<std::string_view> selectBest(int order,
+                                               std::string_view local,
+                                               std::string_view remote) {
+    if (order == 0) {
+      // same preferences
+      return local.substr(0, local.find(','));
+    }
+    auto first = order < 0 ? remote : local;
+    auto second = order < 0 ? local : remote;
+    boost::optional<std::string_view> best;
+    anyOf(first, [&](std::string_view a) {
+      if (anyOf(second, [a](std::string_view b) { return a == b; })) {
+        best = a;
+      }
+      return best.has_value();
+    });
+    return best;
+  }
+
+  Handshake::Handshake(
+      std::shared_ptr<crypto::CryptoProvider> crypto_provider,
+      std::shared_ptr<crypto::marshaller::KeyMarshaller> key_marshaller,
+      std::shared_ptr<crypto::random::CSPRNG> csprng,
+      crypto::KeyPair local_keys, peer::PeerId local_peer,
+      std::shared_ptr<connection::RawConnection> conn,
+      boost::optional<peer::PeerId> remote_peer, SecConnCallbackFunc cb)
+      : crypto_provider_{std::move(crypto_provider)},
+        key_marshaller_{std::move(key_marshaller)},
+        csprng_{std::move(csprng)},
+        local_keys_{std::move(local_keys)},
+        local_peer_{std::move(local_peer)},
+        conn_{std::move(conn)},
+        remote_peer_{std::move(remote_peer)},
+        cb_{std::move(cb)} {}
+
+  void Handshake::connect() {
+    if (auto res = makePropose(); !res) {
+      return fail(res.error());
+    }
+    auto self = shared_from_this();
+    sendMessage(local_propose_, [self] {
+      self->receiveMessage([self](auto propose) {
+        if (auto res = self->processPropose(propose); !res) {
+          return self->fail(res.error());
+        }
+        self->sendMessage(self->local_exchange_, [self] {
+          self->receiveMessage([self](auto exchange) {
+            auto conn = self->processExchange(exchange);
+            if (!conn) {
+              return self->fail(conn.error());
+            }
+            self->checkNonce(std::move(conn.value()));
+          });
+        });
+      });
+    });
+  }
+
+  outcome::result<void> Handshake::makePropose() {
+    OUTCOME_TRY(pubkey, key_marshaller_->marshal(local_keys_.publicKey));
+    local_pubkey_bytes_ = std::move(pubkey.key);
+    local_nonce_ = csprng_->randomBytes(kNonceSize);
+
+    protobuf::Propose propose;
+    propose.set_rand(local_nonce_.data(), local_nonce_.size());
+    propose.set_pubkey(local_pubkey_bytes_.data(), local_pubkey_bytes_.size());
+    propose.set_exchanges(kExchanges.data(), kExchanges.size());
+    propose.set_ciphers(kCiphers.data(), kCiphers.size());
+    propose.set_hashes(kHashes.data(), kHashes.size());
+    OUTCOME_TRY(bytes, serialize(propose));
+    local_propose_ = std::move(bytes);
+    return outcome::success();
+  }
+
+  outcome::result<void> Handshake::processPropose(
+      gsl::span<const uint8_t> message) {
+    remote_propose_.assign(message.begin(), message.end());
+    protobuf::Propose propose;
+    if (!propose.ParseFromArray(message.data(), message.size())) {
+      return SecioError::INVALID_MESSAGE;
+    }
+    remote_nonce_.assign(propose.rand().begin(), propose.rand().end());
+    crypto::ProtobufKey remote_key{
+        {propose.pubkey().begin(), propose.pubkey().end()}};
+    OUTCOME_TRY(public_key, key_marshaller_->unmarshalPublicKey(remote_key));
+    OUTCOME_TRY(peer_id, peer::PeerId::fromPublicKey(remote_key));
+    if (remote_peer_ && *remote_peer_ != peer_id) {
+      return SecioError::PEER_ID_MISMATCH;
+    }
+    remote_peer_ = std::move(peer_id);
+    remote_pubkey_ = std::move(public_key);
+
+    // peers agree on the order, so that they choose the same algorithms and
+    // directions of the stretched keys
+    auto remote_hash = crypto::sha256(concat(remote_key.key, local_nonce_));
+    auto local_hash =
+        crypto::sha256(concat(local_pubkey_bytes_, remote_nonce_));
+    order_ = std::memcmp(remote_hash.data(), local_hash.data(),
+                         remote_hash.size());
+    if (order_ == 0) {
+      return SecioError::SELF_DIAL;
+    }
+
+    OUTCOME_TRY(curve,
+                chooseAlgorithm<CurveType>(order_, kExchanges,
+                                           propose.exchanges(), curveType));
+    OUTCOME_TRY(cipher,
+                chooseAlgorithm<CipherType>(order_, kCiphers,
+                                            propose.ciphers(), cipherType));
+    OUTCOME_TRY(hash,
+                chooseAlgorithm<HashType>(order_, kHashes, propose.hashes(),
+                                          hashType));
+    cipher_ = cipher;
+    hash_ = hash;
+
+    OUTCOME_TRY(ephemeral, crypto_provider_->generateEphemeralKeyPair(curve));
+    auto corpus = concat(local_propose_, remote_propose_,
+                         ephemeral.ephemeral_public_key);
+    OUTCOME_TRY(signature,
+                crypto_provider_->sign(corpus, local_keys_.privateKey));
+
+    protobuf::Exchange exchange;
+    exchange.set_epubkey(ephemeral.ephemeral_public_key.data(),
+                         ephemeral.ephemeral_public_key.size());
+    exchange.set_signature(signature.data(), signature.size());
+    OUTCOME_TRY(bytes, serialize(exchange));
+    local_exchange_ = std::move(bytes);
+    ephemeral_ = std::move(ephemeral);
+    return outcome::success();
+  }
+
+  outcome::result<std::shared_ptr<connection::SecureConnection>>
+  Handshake::processExchange(gsl::span<const uint8_t> message) {
+    protobuf::Exchange exchange;
+    if (!exchange.ParseFromArray(message.data(), message.size())) {
+      return SecioError::INVALID_MESSAGE;
+    }
+    std::vector<uint8_t> epubkey{exchange.epubkey().begin(),
+                                 exchange.epubkey().end()};
+    std::vector<uint8_t> signature{exchange.signature().begin(),
+                                   exchange.signature().end()};
+    auto corpus = concat(remote_propose_, local_propose_, epubkey);
+    OUTCOME_TRY(valid,
+                crypto_provider_->verify(corpus, signature, *remote_pubkey_));
+    if (!valid) {
+      return SecioError::INVALID_SIGNATURE;
+    }
+
+    OUTCOME_TRY(secret, ephemeral_->shared_secret_generator(epubkey));
+    auto keys = crypto_provider_->stretchKey(cipher_, hash_, secret);
+    if (keys.size() != 2) {
+      return SecioError::KEY_STRETCHING_FAILED;
+    }
+    if (order_ < 0) {
+      std::swap(keys[0], keys[1]);
+    }
+    const auto &local = keys[0];
+    const auto &remote = keys[1];
+
+    OUTCOME_TRY(encryptor,
+                makeCipher(cipher_, local, crypto::aes::Mode::ENCRYPT));
+    OUTCOME_TRY(decryptor,
+                makeCipher(cipher_, remote, crypto::aes::Mode::DECRYPT));
+    OUTCOME_TRY(local_mac,
+                crypto::hmac::HmacStream::create(hash_, local.mac_key));
+    OUTCOME_TRY(remote_mac,
+                crypto::hmac::HmacStream::create(hash_, remote.mac_key));
+    ephemeral_ = boost::none;
+    return std::make_shared<connection::SecioConnection>(
+        conn_, std::move(encryptor), std::move(local_mac),
+        std::move(decryptor), std::move(remote_mac), local_keys_.publicKey,
+        std::move(*remote_pubkey_), local_peer_, std::move(*remote_peer_));
+  }
+
+  void Handshake::checkNonce(
+      std::shared_ptr<connection::SecureConnection> conn) {
+    conn->write(
+        remote_nonce_, remote_nonce_.size(),
+        [self{shared_from_this()}, conn](outcome::result<size_t> res) {
+          if (!res) {
+            return self->fail(res.error());
+          }
+          self->buffer_.resize(self->local_nonce_.size());
+          conn->read(self->buffer_, self->buffer_.size(),
+                     [self, conn](outcome::result<size_t> res) {
+                       if (!res) {
+                         return self->fail(res.error());
+                       }
+                       if (self->buffer_ != self->local_nonce_) {
+                         return self->fail(SecioError::NONCE_MISMATCH);
+                       }
+                       self->cb_(conn);
+                     });
+        });
+  }
+
+  void Handshake::sendMessage(gsl::span<const uint8_t> message,
+                              ThenFunc then) {
+    auto size = message.size();
+    buffer_.resize(kLengthSize);
+    for (size_t i = 0; i < kLengthSize; ++i) {
+      buffer_[i] = static_cast<uint8_t>(size >> (8u * (kLengthSize - 1 - i)));
+    }
+    buffer_.insert(buffer_.end(), message.begin(), message.end());
+    conn_->write(buffer_, buffer_.size(),
+                 [self{shared_from_this()}, then{std::move(then)}](
+                     outcome::result<size_t> res) {
+                   if (!res) {
+                     return self->fail(res.error());
+                   }
+                   then();
+                 });
+  }
+
+  void Handshake::receiveMessage(MessageFunc then) {
+    buffer_.resize(kLengthSize);
+    conn_->read(
+        buffer_, kLengthSize,
+        [self{shared_from_this()},
+         then{std::move(then)}](outcome::result<size_t> res) mutable {
+          if (!res) {
+            return self->fail(res.error());
+          }
+          size_t size = 0;
+          for (auto byte : self->buffer_) {
+            size = (size << 8u) + byte;
+          }
+          if (size > connection::SecioConnection::kMaxFrameSize) {
+            return self->fail(SecioError::MESSAGE_TOO_LARGE);
+          }
+          self->buffer_.resize(size);
+          self->conn_->read(
+              self->buffer_, size,
+              [self, then{std::move(then)}](outcome::result<size_t> res) {
+                if (!res) {
+                  return self->fail(res.error());
+                }
+                then(self->buffer_);
+              });
+        });
+  }
+
+  void Handshake::fail(const std::error_code &error) {
+    log_->error("error happened while establishing a SECIO session: {}",
+                error.message());
+    if (auto close_res = conn_->close(); !close_res) {
+      log_->error("connection close attempt ended with error: {}",
+                  close_res.error().message());
+    }
+    cb_(error);
+  }
+
+}  // namespace libp2p::security::secio
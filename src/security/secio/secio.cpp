@@ -0,0 +1,54 @@
+/**
+ * Copyright Soramitsu Co., Ltd. All Rights Reserved.
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <libp2p/security/secio/secio.hpp>
+
+#include <libp2p/security/secio/handshake.hpp>
+
+namespace libp2p::security {
+
+  Secio::Secio(
+      std::shared_ptr<peer::IdentityManager> idmgr,
+      std::shared_ptr<crypto::CryptoProvider> crypto_provider,
+      std::shared_ptr<crypto::marshaller::KeyMarshaller> key_marshaller,
+      std::shared_ptr<crypto::random::CSPRNG> csprng)
+      : idmgr_{std::move(idmgr)},
+        crypto_provider_{std::move(crypto_provider)},
+        key_marshaller_{std::move(key_marshaller)},
+        csprng_{std::move(csprng)} {
+    BOOST_ASSERT(idmgr_);
+    BOOST_ASSERT(crypto_provider_);
+    BOOST_ASSERT(key_marshaller_);
+    BOOST_ASSERT(csprng_);
+  }
+
+  peer::Protocol Secio::getProtocolId() const {
+    return "/secio/1.0.0";
+  }
+
+  void Secio::secureInbound(std::shared_ptr<connection::RawConnection> inbound,
+                            SecConnCallbackFunc cb) {
+    log_->debug("securing inbound connection");
+    handshake(std::move(inbound), boost::none, std::move(cb));
+  }
+
+  void Secio::secureOutbound(
+      std::shared_ptr<connection::RawConnection> outbound,
+      const peer::PeerId &p, SecConnCallbackFunc cb) {
+    log_->debug("securing outbound connection");
+    handshake(std::move(outbound), p, std::move(cb));
+  }
+
+  void Secio::handshake(std::shared_ptr<connection::RawConnection> conn,
+                        boost::optional<peer::PeerId> remote_peer,
+                        SecConnCallbackFunc cb) {
+    std::make_shared<secio::Handshake>(
+        crypto_provider_, key_marshaller_, csprng_, idmgr_->getKeyPair(),
+        idmgr_->getId(), std::move(conn), std::move(remote_peer),
+        std::move(cb))
+        ->connect();
+  }
+
+}  // namespace libp2p::security
@@ -0,0 +1,219 @@
+/**
+ * Copyright Soramitsu Co., Ltd. All Rights Reserved.
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <libp2p/security/secio/secio_connection.hpp>
+
+#include <algorithm>
+
+#include <boost/assert.hpp>
+#include <openssl/crypto.h>
+#include <libp2p/security/secio/secio_error.hpp>
+
+namespace libp2p::connection {
+
+  using crypto::aes::AesCtr;
+  using crypto::hmac::HmacStream;
+  using security::secio::SecioError;
+
+  SecioConnection::SecioConnection(
+      std::shared_ptr<RawConnection> raw_connection, AesCtr encryptor,
+      HmacStream local_mac, AesCtr decryptor, HmacStream remote_mac,
+      crypto::PublicKey local_pubkey, crypto::PublicKey remote_pubkey,
+      peer::PeerId local_peer, peer::PeerId remote_peer)
+      : raw_connection_{std::move(raw_connection)},
+        encryptor_{std::move(encryptor)},
+        local_mac_{std::move(local_mac)},
+        decryptor_{std::move(decryptor)},
+        remote_mac_{std::move(remote_mac)},
+        local_pubkey_{std::move(local_pubkey)},
+        remote_pubkey_{std::move(remote_pubkey)},
+        local_peer_{std::move(local_peer)},
+        remote_peer_{std::move(remote_peer)},
+        read_buffer_(kMaxPlaintextSize + HmacStream::kMaxDigestSize),
+        write_buffer_(kLengthSize + kMaxPlaintextSize
+                      + HmacStream::kMaxDigestSize) {
+    BOOST_ASSERT(raw_connection_);
+  }
+
+  const peer::PeerId &SecioConnection::localPeer() const {
+    return local_peer_;
+  }
+
+  const peer::PeerId &SecioConnection::remotePeer() const {
+    return remote_peer_;
+  }
+
+  outcome::result<crypto::PublicKey> SecioConnection::remotePublicKey()
+      const {
+    return remote_pubkey_;
+  }
+
+  bool SecioConnection::isInitiator() const noexcept {
+    return raw_connection_->isInitiator();
+  }
+
+  outcome::result<multi::Multiaddress> SecioConnection::localMultiaddr() {
+    return raw_connection_->localMultiaddr();
+  }
+
+  outcome::result<multi::Multiaddress> SecioConnection::remoteMultiaddr() {
+    return raw_connection_->remoteMultiaddr();
+  }
+
+  void SecioConnection::read(gsl::span<uint8_t> out, size_t bytes,
+                             ReadCallbackFunc cb) {
+    auto size = std::min(static_cast<size_t>(out.size()), bytes);
+    readFrames(out.first(size), 0, true, std::move(cb));
+  }
+
+  void SecioConnection::readSome(gsl::span<uint8_t> out, size_t bytes,
+                                 ReadCallbackFunc cb) {
+    auto size = std::min(static_cast<size_t>(out.size()), bytes);
+    readFrames(out.first(size), 0, false, std::move(cb));
+  }
+
+  size_t SecioConnection::popPlaintext(gsl::span<uint8_t> out) {
+    auto size = std::min(static_cast<size_t>(out.size()),
+                         read_end_ - read_offset_);
+    std::copy_n(read_buffer_.begin() + read_offset_, size, out.begin());
+    read_offset_ += size;
+    return size;
+  }
+
+  void SecioConnection::readFrames(gsl::span<uint8_t> out, size_t done,
+                                   bool all, ReadCallbackFunc cb) {
+    done += popPlaintext(out.subspan(done));
+    if (done == static_cast<size_t>(out.size()) || (done != 0 && !all)) {
+      return cb(done);
+    }
+    readFrame([self{shared_from_this()}, out, done, all,
+               cb{std::move(cb)}](outcome::result<void> res) mutable {
+      if (!res) {
+        return cb(res.error());
+      }
+      self->readFrames(out, done, all, std::move(cb));
+    });
+  }
+
+  void SecioConnection::readFrame(
+      std::function<void(outcome::result<void>)> cb) {
+    raw_connection_->read(
+        read_length_, kLengthSize,
+        [self{shared_from_this()},
+         cb{std::move(cb)}](outcome::result<size_t> res) mutable {
+          if (!res) {
+            return cb(res.error());
+          }
+          size_t size = 0;
+          for (auto byte : self->read_length_) {
+            size = (size << 8u) + byte;
+          }
+          if (size < self->remote_mac_.digestSize()) {
+            return cb(SecioError::MESSAGE_TOO_SHORT);
+          }
+          if (size > kMaxFrameSize) {
+            return cb(SecioError::MESSAGE_TOO_LARGE);
+          }
+          if (size > self->read_buffer_.size()) {
+            self->read_buffer_.resize(size);
+          }
+          auto frame = gsl::make_span(self->read_buffer_).first(size);
+          self->raw_connection_->read(
+              frame, size,
+              [self, frame,
+               cb{std::move(cb)}](outcome::result<size_t> res) mutable {
+                if (!res) {
+                  return cb(res.error());
+                }
+                auto decrypted = self->decryptFrame(frame);
+                if (!decrypted) {
+                  return cb(decrypted.error());
+                }
+                self->read_offset_ = 0;
+                self->read_end_ = decrypted.value();
+                cb(outcome::success());
+              });
+        });
+  }
+
+  outcome::result<size_t> SecioConnection::decryptFrame(
+      gsl::span<uint8_t> frame) {
+    auto mac_size = remote_mac_.digestSize();
+    auto ciphertext = frame.first(frame.size() - mac_size);
+    OUTCOME_TRY(remote_mac_.update(ciphertext));
+    auto mac = gsl::make_span(read_mac_).first(mac_size);
+    OUTCOME_TRY(remote_mac_.finish(mac));
+    // MAC is checked before decryption, in constant time
+    if (0 != CRYPTO_memcmp(mac.data(), frame.data() + ciphertext.size(),
+                           mac_size)) {
+      return SecioError::MAC_MISMATCH;
+    }
+    OUTCOME_TRY(decryptor_.update(ciphertext));
+    return ciphertext.size();
+  }
+
+  outcome::result<size_t> SecioConnection::encryptFrame(
+      gsl::span<const uint8_t> plaintext) {
+    auto mac_size = local_mac_.digestSize();
+    auto size = plaintext.size() + mac_size;
+    for (size_t i = 0; i < kLengthSize; ++i) {
+      write_buffer_[i] =
+          static_cast<uint8_t>(size >> (8u * (kLengthSize - 1 - i)));
+    }
+    auto ciphertext =
+        gsl::make_span(write_buffer_).subspan(kLengthSize, plaintext.size());
+    OUTCOME_TRY(encryptor_.update(plaintext, ciphertext));
+    OUTCOME_TRY(local_mac_.update(ciphertext));
+    OUTCOME_TRY(local_mac_.finish(gsl::make_span(write_buffer_)
+                                      .subspan(kLengthSize + plaintext.size(),
+                                               mac_size)));
+    return kLengthSize + size;
+  }
+
+  void SecioConnection::write(gsl::span<const uint8_t> in, size_t bytes,
+                              WriteCallbackFunc cb) {
+    auto size = std::min(static_cast<size_t>(in.size()), bytes);
+    writeFrames(in.first(size), 0, true, std::move(cb));
+  }
+
+  void SecioConnection::writeSome(gsl::span<const uint8_t> in, size_t bytes,
+                                  WriteCallbackFunc cb) {
+    auto size = std::min(static_cast<size_t>(in.size()), bytes);
+    writeFrames(in.first(size), 0, false, std::move(cb));
+  }
+
+  void SecioConnection::writeFrames(gsl::span<const uint8_t> in, size_t done,
+                                    bool all, WriteCallbackFunc cb) {
+    if (done == static_cast<size_t>(in.size())) {
+      return cb(done);
+    }
+    auto size = std::min(in.size() - done, kMaxPlaintextSize);
+    auto total = encryptFrame(in.subspan(done, size));
+    if (!total) {
+      return cb(total.error());
+    }
+    raw_connection_->write(
+        gsl::make_span(write_buffer_).first(total.value()), total.value(),
+        [self{shared_from_this()}, in, done{done + size}, all,
+         cb{std::move(cb)}](outcome::result<size_t> res) mutable {
+          if (!res) {
+            return cb(res.error());
+          }
+          if (!all) {
+            return cb(done);
+          }
+          self->writeFrames(in, done, all, std::move(cb));
+        });
+  }
+
+  bool SecioConnection::isClosed() const {
+    return raw_connection_->isClosed();
+  }
+
+  outcome::result<void> SecioConnection::close() {
+    return raw_connection_->close();
+  }
+
+}  // namespace libp2p::connection
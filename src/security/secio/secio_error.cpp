@@ -0,0 +1,33 @@
+/**
+ * Copyright Soramitsu Co., Ltd. All Rights Reserved.
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <libp2p/security/secio/secio_error.hpp>
+
+OUTCOME_CPP_DEFINE_CATEGORY(libp2p::security::secio, SecioError, e) {
+  using E = libp2p::security::secio::SecioError;
+  switch (e) {
+    case E::INVALID_MESSAGE:
+      return "SECIO handshake message cannot be decoded";
+    case E::MESSAGE_TOO_LARGE:
+      return "SECIO message exceeds the maximum frame size";
+    case E::MESSAGE_TOO_SHORT:
+      return "SECIO frame is shorter than its MAC";
+    case E::SELF_DIAL:
+      return "SECIO peer dialed itself";
+    case E::NO_COMMON_ALGORITHM:
+      return "SECIO peers have no algorithms in common";
+    case E::INVALID_SIGNATURE:
+      return "SECIO ephemeral key is not signed by the identity key";
+    case E::PEER_ID_MISMATCH:
+      return "Remote peer id differs from the dialed one";
+    case E::KEY_STRETCHING_FAILED:
+      return "Failed to stretch the SECIO shared secret";
+    case E::MAC_MISMATCH:
+      return "SECIO frame has invalid MAC";
+    case E::NONCE_MISMATCH:
+      return "Remote peer did not return the SECIO nonce";
+  }
+  return "Unknown error";
+}
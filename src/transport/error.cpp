@@ -0,0 +1,23 @@
+/**
+ * Copyright Soramitsu Co., Ltd. All Rights Reserved.
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <libp2p/transport/error.hpp>
+
+OUTCOME_CPP_DEFINE_CATEGORY(libp2p::transport, TransportError, e) {
+  using E = libp2p::transport::TransportError;
+  switch (e) {
+    case E::RESOLVE_TIMEOUT:
+      return "address resolution timed out";
+    case E::CONNECT_TIMEOUT:
+      return "connection establishment timed out";
+    case E::SECURITY_TIMEOUT:
+      return "security handshake timed out";
+    case E::MUXER_TIMEOUT:
+      return "muxer negotiation timed out";
+    case E::CONNECTION_GATED:
+      return "connection is rejected by the gater";
+  }
+  return "unknown error";
+}
@@ -0,0 +1,142 @@
+/**
+ * Copyright Soramitsu Co., Ltd. All Rights Reserved.
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <libp2p/transport/impl/admission_control.hpp>
+
+#include <algorithm>
+
+namespace libp2p::transport {
+
+  AdmissionControl::AdmissionControl(AdmissionConfig config)
+      : config_{config} {}
+
+  AdmissionControl::Decision AdmissionControl::admit(
+      const boost::asio::ip::address &remote, Clock::time_point now) {
+    if (config_.max_concurrent_upgrades != 0
+        && upgrades_in_progress_ >= config_.max_concurrent_upgrades) {
+      ++stats_.rejected;
+      return Decision::REJECT;
+    }
+    if (config_.max_inbound_connections != 0
+        && liveConnections() >= config_.max_inbound_connections) {
+      ++stats_.rejected;
+      return Decision::REJECT;
+    }
+
+    pruneWindows(now);
+    auto ip = makeKey(remote);
+    auto subnet = subnetOf(remote);
+    if (!fits(ip_windows_, ip, config_.ip_rate_limit, now)
+        || !fits(subnet_windows_, subnet, config_.subnet_rate_limit, now)) {
+      ++stats_.throttled;
+      return Decision::THROTTLE;
+    }
+    bump(ip_windows_, ip, now);
+    bump(subnet_windows_, subnet, now);
+
+    ++upgrades_in_progress_;
+    ++stats_.accepted;
+    return Decision::ACCEPT;
+  }
+
+  void AdmissionControl::track(
+      const std::shared_ptr<connection::RawConnection> &conn) {
+    if (config_.max_inbound_connections != 0) {
+      connections_.emplace_back(conn);
+    }
+  }
+
+  void AdmissionControl::onUpgradeFinished() {
+    if (upgrades_in_progress_ > 0) {
+      --upgrades_in_progress_;
+    }
+  }
+
+  size_t AdmissionControl::upgradesInProgress() const {
+    return upgrades_in_progress_;
+  }
+
+  const AdmissionControl::Stats &AdmissionControl::getStats() const {
+    return stats_;
+  }
+
+  AdmissionControl::Key AdmissionControl::makeKey(
+      const boost::asio::ip::address &address) {
+    if (address.is_v4()) {
+      return boost::asio::ip::make_address_v6(boost::asio::ip::v4_mapped,
+                                              address.to_v4())
+          .to_bytes();
+    }
+    return address.to_v6().to_bytes();
+  }
+
+  AdmissionControl::Key AdmissionControl::subnetOf(
+      const boost::asio::ip::address &address) const {
+    // IPv4 address occupies the last 32 bits of the mapped one
+    size_t prefix = address.is_v4() ? 96u + config_.ipv4_subnet_prefix
+                                    : config_.ipv6_subnet_prefix;
+    prefix = std::min<size_t>(prefix, 128);
+
+    auto key = makeKey(address);
+    for (size_t i = 0; i < key.size(); ++i) {
+      auto bits = std::min<size_t>(8, prefix - std::min(prefix, i * 8));
+      key[i] &= static_cast<uint8_t>(0xFF00u >> bits);
+    }
+    return key;
+  }
+
+  bool AdmissionControl::fits(Windows &windows, const Key &key, size_t limit,
+                              Clock::time_point now) {
+    if (limit == 0) {
+      return true;
+    }
+    auto it = windows.find(key);
+    if (it == windows.end() || now - it->second.start >= config_.rate_interval) {
+      return true;
+    }
+    return it->second.count < limit;
+  }
+
+  void AdmissionControl::bump(Windows &windows, const Key &key,
+                              Clock::time_point now) {
+    auto &window = windows[key];
+    if (window.count == 0 || now - window.start >= config_.rate_interval) {
+      window.start = now;
+      window.count = 0;
+    }
+    ++window.count;
+  }
+
+  void AdmissionControl::pruneWindows(Clock::time_point now) {
+    // windows of the sources, which went silent, are dropped once per interval
+    if (now - last_prune_ < config_.rate_interval) {
+      return;
+    }
+    last_prune_ = now;
+    for (auto *windows : {&ip_windows_, &subnet_windows_}) {
+      for (auto it = windows->begin(); it != windows->end();) {
+        if (now - it->second.start >= config_.rate_interval) {
+          it = windows->erase(it);
+        } else {
+          ++it;
+        }
+      }
+    }
+  }
+
+  size_t AdmissionControl::liveConnections() {
+    if (connections_.size() >= config_.max_inbound_connections) {
+      connections_.erase(
+          std::remove_if(connections_.begin(), connections_.end(),
+                         [](const auto &weak) {
+                           auto conn = weak.lock();
+                           return !conn || conn->isClosed();
+                         }),
+          connections_.end());
+    }
+    return connections_.size();
+  }
+
+}  // namespace libp2p::transport
@@ -5,8 +5,11 @@
 
 #include <libp2p/transport/impl/upgrader_impl.hpp>
 
+#include <algorithm>
 #include <numeric>
 
+#include <libp2p/transport/error.hpp>
+
 OUTCOME_CPP_DEFINE_CATEGORY(libp2p::transport, UpgraderImpl::Error, e) {
   using E = libp2p::transport::UpgraderImpl::Error;
   switch (e) {
@@ -37,12 +40,18 @@ namespace {
 namespace libp2p::transport {
   UpgraderImpl::UpgraderImpl(
       std::shared_ptr<protocol_muxer::ProtocolMuxer> protocol_muxer,
+      std::shared_ptr<peer::ProtocolRepository> protocol_repo,
       std::vector<SecAdaptorSPtr> security_adaptors,
-      std::vector<MuxAdaptorSPtr> muxer_adaptors)
+      std::vector<MuxAdaptorSPtr> muxer_adaptors,
+      std::shared_ptr<network::ConnectionGater> gater,
+      std::shared_ptr<metrics::Registry> registry)
       : protocol_muxer_{std::move(protocol_muxer)},
+        protocol_repo_{std::move(protocol_repo)},
         security_adaptors_{security_adaptors.begin(), security_adaptors.end()},
-        muxer_adaptors_{muxer_adaptors.begin(), muxer_adaptors.end()} {
+        muxer_adaptors_{muxer_adaptors.begin(), muxer_adaptors.end()},
+        gater_{std::move(gater)} {
     BOOST_ASSERT(protocol_muxer_ != nullptr);
+    BOOST_ASSERT(protocol_repo_ != nullptr);
     BOOST_ASSERT_MSG(!security_adaptors_.empty(),
                      "upgrader has no security adaptors");
     BOOST_ASSERT(std::all_of(security_adaptors_.begin(),
@@ -63,10 +72,28 @@ namespace libp2p::transport {
         muxer_adaptors.begin(), muxer_adaptors.end(),
         std::back_inserter(muxer_protocols_),
         [](const auto &adaptor) { return adaptor->getProtocolId(); });
+
+    if (registry != nullptr) {
+      inbound_handshakes_ =
+          std::make_shared<HandshakeMetrics>(*registry, "inbound");
+      outbound_handshakes_ =
+          std::make_shared<HandshakeMetrics>(*registry, "outbound");
+    }
   }
 
+  UpgraderImpl::HandshakeMetrics::HandshakeMetrics(
+      metrics::Registry &registry, const std::string &direction)
+      : duration{registry.histogram(
+          "libp2p_security_handshake_duration_microseconds",
+          "Time to negotiate a security protocol and to make its handshake",
+          {{"direction", direction}})},
+        failures{registry.counter("libp2p_security_handshake_failures_total",
+                                  "Failed or rejected security handshakes",
+                                  {{"direction", direction}})} {}
+
   void UpgraderImpl::upgradeToSecureInbound(RawSPtr conn,
                                             OnSecuredCallbackFunc cb) {
+    cb = measured(std::move(cb), inbound_handshakes_);
     protocol_muxer_->selectOneOf(
         security_protocols_, conn, conn->isInitiator(),
         [self{shared_from_this()}, cb = std::move(cb),
@@ -85,15 +112,39 @@ namespace libp2p::transport {
                            "connection is initiator, and SecureInbound is "
                            "called (should be SecureOutbound)");
 
-          return adaptor->secureInbound(std::move(conn), std::move(cb));
+          // the peer is known only after the handshake
+          return adaptor->secureInbound(
+              std::move(conn),
+              [self, cb = std::move(cb), protocol = proto_res.value()](
+                  outcome::result<SecSPtr> secured) {
+                if (!secured) {
+                  return cb(std::move(secured));
+                }
+                const auto &peer = secured.value()->remotePeer();
+                if (!self->allowed(peer)) {
+                  // no muxer is negotiated for it
+                  (void)secured.value()->close();
+                  return cb(TransportError::CONNECTION_GATED);
+                }
+                self->onNegotiated(peer, protocol);
+                cb(std::move(secured));
+              });
         });
   }
 
   void UpgraderImpl::upgradeToSecureOutbound(RawSPtr conn,
                                              const peer::PeerId &remoteId,
                                              OnSecuredCallbackFunc cb) {
+    cb = measured(std::move(cb), outbound_handshakes_);
+
+    // the peer is known in advance, so no handshake is made with it
+    if (!allowed(remoteId)) {
+      (void)conn->close();
+      return cb(TransportError::CONNECTION_GATED);
+    }
     protocol_muxer_->selectOneOf(
-        security_protocols_, conn, conn->isInitiator(),
+        preferNegotiated(remoteId, security_protocols_), conn,
+        conn->isInitiator(),
         [self{shared_from_this()}, cb = std::move(cb), conn,
          remoteId](outcome::result<peer::Protocol> proto_res) mutable {
           if (!proto_res) {
@@ -109,6 +160,7 @@ namespace libp2p::transport {
           BOOST_ASSERT_MSG(conn->isInitiator(),
                            "connection is NOT initiator, and SecureOutbound is "
                            "called (should be SecureInbound)");
+          self->onNegotiated(remoteId, proto_res.value());
 
           return adaptor->secureOutbound(std::move(conn), remoteId,
                                          std::move(cb));
@@ -116,8 +168,11 @@ namespace libp2p::transport {
   }
 
   void UpgraderImpl::upgradeToMuxed(SecSPtr conn, OnMuxedCallbackFunc cb) {
+    auto is_initiator = conn->isInitiator();
     return protocol_muxer_->selectOneOf(
-        muxer_protocols_, conn, conn->isInitiator(),
+        is_initiator ? preferNegotiated(conn->remotePeer(), muxer_protocols_)
+                     : muxer_protocols_,
+        conn, is_initiator,
         [self{shared_from_this()}, cb = std::move(cb),
          conn](outcome::result<peer::Protocol> proto_res) mutable {
           if (!proto_res) {
@@ -128,6 +183,7 @@ namespace libp2p::transport {
           if (!adaptor) {
             return cb(Error::NO_ADAPTOR_FOUND);
           }
+          self->onNegotiated(conn->remotePeer(), proto_res.value());
 
           return adaptor->muxConnection(
               std::move(conn),
@@ -142,4 +198,53 @@ namespace libp2p::transport {
               });
         });
   }
+
+  std::vector<peer::Protocol> UpgraderImpl::preferNegotiated(
+      const peer::PeerId &peer,
+      const std::vector<peer::Protocol> &protocols) const {
+    auto negotiated = protocol_repo_->supportsProtocols(
+        peer, {protocols.begin(), protocols.end()});
+    if (!negotiated || negotiated.value().empty()) {
+      return protocols;
+    }
+
+    // our order is kept among the known and among the other protocols
+    auto ordered = protocols;
+    std::stable_partition(
+        ordered.begin(), ordered.end(), [&negotiated](const auto &protocol) {
+          const auto &known = negotiated.value();
+          return std::find(known.begin(), known.end(), protocol) != known.end();
+        });
+    return ordered;
+  }
+
+  Upgrader::OnSecuredCallbackFunc UpgraderImpl::measured(
+      OnSecuredCallbackFunc cb,
+      const std::shared_ptr<HandshakeMetrics> &handshakes) {
+    if (handshakes == nullptr) {
+      return cb;
+    }
+    return [cb = std::move(cb), handshakes,
+            start = metrics::Histogram::Clock::now()](
+               outcome::result<SecSPtr> res) {
+      if (res) {
+        handshakes->duration->recordSince(start);
+      } else {
+        handshakes->failures->inc();
+      }
+      cb(std::move(res));
+    };
+  }
+
+  bool UpgraderImpl::allowed(const peer::PeerId &peer) const {
+    return gater_ == nullptr || gater_->interceptSecured(peer);
+  }
+
+  void UpgraderImpl::onNegotiated(const peer::PeerId &peer,
+                                  const peer::Protocol &protocol) {
+    // the repository only adds protocols, so it can not fail
+    auto res = protocol_repo_->addProtocols(peer, gsl::make_span(&protocol, 1));
+    (void)res;
+  }
+
 }  // namespace libp2p::transport
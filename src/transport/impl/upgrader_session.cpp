@@ -10,34 +10,92 @@ namespace libp2p::transport {
   UpgraderSession::UpgraderSession(
       std::shared_ptr<transport::Upgrader> upgrader,
       std::shared_ptr<connection::RawConnection> raw,
-      UpgraderSession::HandlerFunc handler)
+      UpgraderSession::HandlerFunc handler, boost::asio::io_context &context,
+      const TransportConfig &config)
       : upgrader_(std::move(upgrader)),
         raw_(std::move(raw)),
-        handler_(std::move(handler)) {}
+        handler_(std::move(handler)),
+        context_(context),
+        config_(config) {}
 
   void UpgraderSession::secureOutbound(const peer::PeerId &remoteId) {
     auto self{shared_from_this()};
+    startPhase(config_.security_timeout, TransportError::SECURITY_TIMEOUT);
     upgrader_->upgradeToSecureOutbound(raw_, remoteId, [self](auto &&r) {
       self->onSecured(std::forward<decltype(r)>(r));
     });
   }
 
   void UpgraderSession::secureInbound() {
+    startPhase(config_.security_timeout, TransportError::SECURITY_TIMEOUT);
     upgrader_->upgradeToSecureInbound(
         raw_, [self{shared_from_this()}](auto &&r) {
           self->onSecured(std::forward<decltype(r)>(r));
         });
   }
 
+  void UpgraderSession::secureOutbound(
+      const peer::PeerId &remoteId,
+      const std::shared_ptr<security::SecurityAdaptor> &adaptor) {
+    startPhase(config_.security_timeout, TransportError::SECURITY_TIMEOUT);
+    adaptor->secureOutbound(raw_, remoteId,
+                            [self{shared_from_this()}](auto &&r) {
+                              self->onSecured(std::forward<decltype(r)>(r));
+                            });
+  }
+
+  void UpgraderSession::secureInbound(
+      const std::shared_ptr<security::SecurityAdaptor> &adaptor) {
+    startPhase(config_.security_timeout, TransportError::SECURITY_TIMEOUT);
+    adaptor->secureInbound(raw_, [self{shared_from_this()}](auto &&r) {
+      self->onSecured(std::forward<decltype(r)>(r));
+    });
+  }
+
   void UpgraderSession::onSecured(
       outcome::result<std::shared_ptr<connection::SecureConnection>> rsecure) {
+    if (deadline_->stop()) {
+      // timeout was already reported, this is a late result
+      if (rsecure) {
+        (void)rsecure.value()->close();
+      }
+      return;
+    }
+
     if (!rsecure) {
       return handler_(rsecure.error());
     }
 
+    startPhase(config_.muxer_timeout, TransportError::MUXER_TIMEOUT);
     upgrader_->upgradeToMuxed(rsecure.value(),
                               [self{shared_from_this()}](auto &&r) {
-                                self->handler_(std::forward<decltype(r)>(r));
+                                self->onMuxed(std::forward<decltype(r)>(r));
                               });
   }
+
+  void UpgraderSession::onMuxed(
+      outcome::result<std::shared_ptr<connection::CapableConnection>> rmuxed) {
+    if (deadline_->stop()) {
+      if (rmuxed) {
+        (void)rmuxed.value()->close();
+      }
+      return;
+    }
+
+    handler_(std::move(rmuxed));
+  }
+
+  void UpgraderSession::startPhase(std::chrono::milliseconds timeout,
+                                   TransportError error) {
+    deadline_ = detail::Deadline::start(
+        context_, timeout, [self{shared_from_this()}, error] {
+          self->onPhaseTimeout(error);
+        });
+  }
+
+  void UpgraderSession::onPhaseTimeout(TransportError error) {
+    // closing the raw connection aborts all pending operations of the upgrade
+    (void)raw_->close();
+    handler_(error);
+  }
 }  // namespace libp2p::transport
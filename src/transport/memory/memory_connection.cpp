@@ -0,0 +1,254 @@
+/**
+ * Copyright Soramitsu Co., Ltd. All Rights Reserved.
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <libp2p/transport/memory/memory_connection.hpp>
+
+#include <algorithm>
+
+#include <boost/asio/error.hpp>
+#include <boost/asio/post.hpp>
+
+namespace libp2p::transport {
+
+  namespace {
+    using ResultCallbackFunc = std::function<void(outcome::result<size_t>)>;
+
+    /// completes the operation asynchronously, as socket operations do
+    void postResult(boost::asio::io_context &context, ResultCallbackFunc cb,
+                    outcome::result<size_t> result) {
+      boost::asio::post(context,
+                        [cb{std::move(cb)}, result{std::move(result)}] {
+                          cb(result);
+                        });
+    }
+
+    void postError(boost::asio::io_context &context, ResultCallbackFunc cb,
+                   boost::system::error_code ec) {
+      postResult(context, std::move(cb), ec);
+    }
+  }  // namespace
+
+  MemoryConnection::MemoryConnection(boost::asio::io_context &context,
+                                     MemoryLinkConfig config, bool initiator,
+                                     multi::Multiaddress local,
+                                     multi::Multiaddress remote)
+      : context_{context},
+        config_{config},
+        initiator_{initiator},
+        local_{std::move(local)},
+        remote_{std::move(remote)},
+        delivery_timer_{context},
+        // ends of the link must not lose the same chunks
+        loss_generator_{config.seed * 2 + (initiator ? 0 : 1)},
+        loss_{std::clamp(config.loss, 0.0, 1.0)} {}
+
+  std::pair<std::shared_ptr<MemoryConnection>,
+            std::shared_ptr<MemoryConnection>>
+  MemoryConnection::makePair(boost::asio::io_context &context,
+                             const MemoryLinkConfig &config,
+                             const multi::Multiaddress &initiator_address,
+                             const multi::Multiaddress &responder_address) {
+    auto initiator = std::make_shared<MemoryConnection>(
+        context, config, true, initiator_address, responder_address);
+    auto responder = std::make_shared<MemoryConnection>(
+        context, config, false, responder_address, initiator_address);
+    initiator->other_ = responder;
+    responder->other_ = initiator;
+    return {std::move(initiator), std::move(responder)};
+  }
+
+  void MemoryConnection::read(gsl::span<uint8_t> out, size_t bytes,
+                              ReadCallbackFunc cb) {
+    doRead(out, bytes, false, std::move(cb));
+  }
+
+  void MemoryConnection::readSome(gsl::span<uint8_t> out, size_t bytes,
+                                  ReadCallbackFunc cb) {
+    doRead(out, bytes, true, std::move(cb));
+  }
+
+  void MemoryConnection::write(gsl::span<const uint8_t> in, size_t bytes,
+                               WriteCallbackFunc cb) {
+    doWrite(in, bytes, std::move(cb));
+  }
+
+  void MemoryConnection::writeSome(gsl::span<const uint8_t> in, size_t bytes,
+                                   WriteCallbackFunc cb) {
+    // whole chunk always fits into the link
+    doWrite(in, bytes, std::move(cb));
+  }
+
+  outcome::result<multi::Multiaddress> MemoryConnection::remoteMultiaddr() {
+    return remote_;
+  }
+
+  outcome::result<multi::Multiaddress> MemoryConnection::localMultiaddr() {
+    return local_;
+  }
+
+  bool MemoryConnection::isInitiator() const noexcept {
+    return initiator_;
+  }
+
+  outcome::result<void> MemoryConnection::close() {
+    if (closed_) {
+      return outcome::success();
+    }
+    closed_ = true;
+
+    delivery_timer_.cancel();
+    received_.clear();
+    in_flight_.clear();
+    if (pending_read_) {
+      auto cb = std::move(pending_read_->cb);
+      pending_read_.reset();
+      postError(context_, std::move(cb), boost::asio::error::operation_aborted);
+    }
+
+    if (auto other = other_.lock()) {
+      other->onRemoteClosed();
+    }
+    return outcome::success();
+  }
+
+  bool MemoryConnection::isClosed() const {
+    return closed_;
+  }
+
+  void MemoryConnection::doRead(gsl::span<uint8_t> out, size_t bytes,
+                                bool some, ReadCallbackFunc cb) {
+    if (closed_) {
+      return postError(context_, std::move(cb),
+                       boost::asio::error::bad_descriptor);
+    }
+    if (pending_read_) {
+      return postError(context_, std::move(cb),
+                       boost::asio::error::in_progress);
+    }
+    if (bytes == 0) {
+      return postResult(context_, std::move(cb), 0);
+    }
+    if (static_cast<size_t>(out.size()) < bytes) {
+      return postError(context_, std::move(cb),
+                       boost::asio::error::no_buffer_space);
+    }
+
+    pending_read_ = PendingRead{out, bytes, some, std::move(cb)};
+    boost::asio::post(context_,
+                      [self{shared_from_this()}] { self->serveRead(); });
+  }
+
+  void MemoryConnection::doWrite(gsl::span<const uint8_t> in, size_t bytes,
+                                 WriteCallbackFunc cb) {
+    if (closed_) {
+      return postError(context_, std::move(cb),
+                       boost::asio::error::bad_descriptor);
+    }
+    auto other = other_.lock();
+    if (!other || other->closed_) {
+      return postError(context_, std::move(cb),
+                       boost::asio::error::broken_pipe);
+    }
+    bytes = std::min(bytes, static_cast<size_t>(in.size()));
+
+    auto now = Clock::now();
+    link_free_at_ = std::max(now, link_free_at_) + transmissionTime(bytes);
+    auto arrival = link_free_at_ + config_.latency;
+    if (config_.loss > 0 && loss_(loss_generator_)) {
+      arrival += config_.retransmit_delay;
+    }
+    other->enqueue(arrival, {in.begin(), in.begin() + bytes});
+
+    if (link_free_at_ <= now) {
+      return postResult(context_, std::move(cb), bytes);
+    }
+    // writer is blocked, until its data leaves the link
+    auto timer = std::make_shared<boost::asio::steady_timer>(context_);
+    timer->expires_at(link_free_at_);
+    timer->async_wait([timer, bytes, cb{std::move(cb)}](const auto &) {
+      cb(bytes);
+    });
+  }
+
+  void MemoryConnection::enqueue(Clock::time_point arrival,
+                                 std::vector<uint8_t> data) {
+    if (closed_) {
+      return;
+    }
+    // bytes may not overtake the ones, which were sent before
+    if (!in_flight_.empty()) {
+      arrival = std::max(arrival, in_flight_.back().arrival);
+    }
+    in_flight_.push_back(Chunk{arrival, std::move(data)});
+    if (in_flight_.size() == 1) {
+      delivery_timer_.expires_at(arrival);
+      delivery_timer_.async_wait(
+          [self{shared_from_this()}](const boost::system::error_code &ec) {
+            if (!ec) {
+              self->deliver();
+            }
+          });
+    }
+  }
+
+  void MemoryConnection::onRemoteClosed() {
+    remote_closed_ = true;
+    boost::asio::post(context_,
+                      [self{shared_from_this()}] { self->serveRead(); });
+  }
+
+  void MemoryConnection::deliver() {
+    auto now = Clock::now();
+    while (!in_flight_.empty() && in_flight_.front().arrival <= now) {
+      auto &data = in_flight_.front().data;
+      received_.insert(received_.end(), data.begin(), data.end());
+      in_flight_.pop_front();
+    }
+    serveRead();
+
+    if (!in_flight_.empty()) {
+      delivery_timer_.expires_at(in_flight_.front().arrival);
+      delivery_timer_.async_wait(
+          [self{shared_from_this()}](const boost::system::error_code &ec) {
+            if (!ec) {
+              self->deliver();
+            }
+          });
+    }
+  }
+
+  void MemoryConnection::serveRead() {
+    if (!pending_read_ || closed_) {
+      return;
+    }
+
+    auto &read = *pending_read_;
+    if (received_.size() >= read.bytes
+        || (read.some && !received_.empty())) {
+      auto n = std::min(read.bytes, received_.size());
+      std::copy_n(received_.begin(), n, read.out.begin());
+      received_.erase(received_.begin(), received_.begin() + n);
+      auto cb = std::move(read.cb);
+      pending_read_.reset();
+      return cb(n);
+    }
+
+    if (remote_closed_ && in_flight_.empty()) {
+      auto cb = std::move(read.cb);
+      pending_read_.reset();
+      return cb(boost::system::error_code{boost::asio::error::eof});
+    }
+  }
+
+  std::chrono::nanoseconds MemoryConnection::transmissionTime(
+      size_t bytes) const {
+    if (config_.bandwidth == 0) {
+      return std::chrono::nanoseconds::zero();
+    }
+    return std::chrono::nanoseconds(bytes * 1'000'000'000ull
+                                    / config_.bandwidth);
+  }
+
+}  // namespace libp2p::transport
@@ -0,0 +1,33 @@
+/**
+ * Copyright Soramitsu Co., Ltd. All Rights Reserved.
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <libp2p/transport/memory/memory_hub.hpp>
+
+namespace libp2p::transport {
+
+  outcome::result<void> MemoryHub::bind(uint64_t id, AcceptFunc accept) {
+    if (!listeners_.emplace(id, std::move(accept)).second) {
+      return std::errc::address_in_use;
+    }
+    return outcome::success();
+  }
+
+  void MemoryHub::unbind(uint64_t id) {
+    listeners_.erase(id);
+  }
+
+  MemoryHub::AcceptFunc MemoryHub::find(uint64_t id) const {
+    auto it = listeners_.find(id);
+    if (it == listeners_.end()) {
+      return nullptr;
+    }
+    return it->second;
+  }
+
+  uint64_t MemoryHub::nextEphemeralId() {
+    return next_ephemeral_id_++;
+  }
+
+}  // namespace libp2p::transport
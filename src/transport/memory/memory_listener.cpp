@@ -0,0 +1,83 @@
+/**
+ * Copyright Soramitsu Co., Ltd. All Rights Reserved.
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <libp2p/transport/memory/memory_listener.hpp>
+
+#include <libp2p/transport/impl/upgrader_session.hpp>
+#include <libp2p/transport/memory/memory_util.hpp>
+
+namespace libp2p::transport {
+
+  MemoryListener::MemoryListener(boost::asio::io_context &context,
+                                 std::shared_ptr<Upgrader> upgrader,
+                                 std::shared_ptr<MemoryHub> hub,
+                                 TransportListener::HandlerFunc handler,
+                                 TransportConfig config)
+      : context_(context),
+        upgrader_(std::move(upgrader)),
+        hub_(std::move(hub)),
+        handle_(std::move(handler)),
+        config_(config) {}
+
+  MemoryListener::~MemoryListener() {
+    if (id_) {
+      hub_->unbind(*id_);
+    }
+  }
+
+  outcome::result<void> MemoryListener::listen(
+      const multi::Multiaddress &address) {
+    if (!canListen(address)) {
+      return std::errc::address_family_not_supported;
+    }
+
+    if (id_) {
+      return std::errc::already_connected;
+    }
+
+    OUTCOME_TRY(id, detail::getMemoryId(address));
+    OUTCOME_TRY(hub_->bind(
+        id, [wptr{weak_from_this()}](std::shared_ptr<MemoryConnection> conn) {
+          if (auto self = wptr.lock()) {
+            self->onAccepted(std::move(conn));
+          }
+        }));
+    id_ = id;
+    address_ = address;
+    return outcome::success();
+  }
+
+  bool MemoryListener::canListen(const multi::Multiaddress &ma) const {
+    return detail::supportsMemory(ma);
+  }
+
+  outcome::result<multi::Multiaddress> MemoryListener::getListenMultiaddr()
+      const {
+    if (!address_) {
+      return std::errc::not_connected;
+    }
+    return *address_;
+  }
+
+  bool MemoryListener::isClosed() const {
+    return !id_;
+  }
+
+  outcome::result<void> MemoryListener::close() {
+    if (id_) {
+      hub_->unbind(*id_);
+      id_.reset();
+    }
+    return outcome::success();
+  }
+
+  void MemoryListener::onAccepted(std::shared_ptr<MemoryConnection> conn) {
+    auto session = std::make_shared<UpgraderSession>(
+        upgrader_, std::move(conn), handle_, context_, config_);
+
+    session->secureInbound();
+  }
+
+}  // namespace libp2p::transport
@@ -0,0 +1,77 @@
+/**
+ * Copyright Soramitsu Co., Ltd. All Rights Reserved.
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <libp2p/transport/memory/memory_transport.hpp>
+
+#include <boost/asio/steady_timer.hpp>
+#include <libp2p/transport/impl/upgrader_session.hpp>
+#include <libp2p/transport/memory/memory_util.hpp>
+
+namespace libp2p::transport {
+
+  MemoryTransport::MemoryTransport(
+      std::shared_ptr<boost::asio::io_context> context,
+      std::shared_ptr<Upgrader> upgrader, std::shared_ptr<MemoryHub> hub,
+      MemoryLinkConfig link_config, TransportConfig config)
+      : context_(std::move(context)),
+        upgrader_(std::move(upgrader)),
+        hub_(std::move(hub)),
+        link_config_(link_config),
+        config_(config) {}
+
+  void MemoryTransport::dial(const peer::PeerId &remoteId,
+                             multi::Multiaddress address,
+                             TransportAdaptor::HandlerFunc handler) {
+    if (!canDial(address)) {
+      return handler(std::errc::address_family_not_supported);
+    }
+
+    auto id = detail::getMemoryId(address);
+    if (!id) {
+      return handler(id.error());
+    }
+    auto accept = hub_->find(id.value());
+    if (!accept) {
+      return handler(std::errc::connection_refused);
+    }
+    auto local = detail::makeMemoryAddress(hub_->nextEphemeralId());
+    if (!local) {
+      return handler(local.error());
+    }
+
+    auto [initiator, responder] = MemoryConnection::makePair(
+        *context_, link_config_, local.value(), address);
+
+    // connection is established after a round trip, as TCP one is
+    auto timer = std::make_shared<boost::asio::steady_timer>(*context_);
+    timer->expires_after(link_config_.latency * 2);
+    timer->async_wait([self{shared_from_this()}, timer, remoteId,
+                       accept{std::move(accept)}, initiator{initiator},
+                       responder{responder},
+                       handler{std::move(handler)}](const auto &) {
+      accept(responder);
+
+      auto session = std::make_shared<UpgraderSession>(
+          self->upgrader_, initiator, handler, *self->context_, self->config_);
+
+      session->secureOutbound(remoteId);
+    });
+  }
+
+  std::shared_ptr<TransportListener> MemoryTransport::createListener(
+      TransportListener::HandlerFunc handler) {
+    return std::make_shared<MemoryListener>(*context_, upgrader_, hub_,
+                                            std::move(handler), config_);
+  }
+
+  bool MemoryTransport::canDial(const multi::Multiaddress &ma) const {
+    return detail::supportsMemory(ma);
+  }
+
+  peer::Protocol MemoryTransport::getProtocolId() const {
+    return "/memory/1.0.0";
+  }
+
+}  // namespace libp2p::transport
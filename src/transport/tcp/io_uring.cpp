@@ -0,0 +1,443 @@
+/**
+ * Copyright Soramitsu Co., Ltd. All Rights Reserved.
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <libp2p/transport/tcp/io_uring.hpp>
+
+#include <algorithm>
+#include <cstring>
+
+#include <linux/io_uring.h>
+#include <sys/eventfd.h>
+#include <sys/mman.h>
+#include <sys/socket.h>
+#include <sys/syscall.h>
+#include <sys/uio.h>
+#include <unistd.h>
+
+#include <boost/asio/post.hpp>
+
+namespace libp2p::transport {
+
+  namespace {
+    int setup(unsigned entries, io_uring_params *params) {
+      return static_cast<int>(syscall(__NR_io_uring_setup, entries, params));
+    }
+
+    int enter(int fd, unsigned to_submit) {
+      return static_cast<int>(
+          syscall(__NR_io_uring_enter, fd, to_submit, 0, 0, nullptr, 0));
+    }
+
+    int registerRing(int fd, unsigned opcode, const void *arg,
+                     unsigned nr_args) {
+      return static_cast<int>(
+          syscall(__NR_io_uring_register, fd, opcode, arg, nr_args));
+    }
+
+    template <typename T>
+    T *offset(void *base, uint32_t off) {
+      return reinterpret_cast<T *>(static_cast<uint8_t *>(base) + off);
+    }
+
+    unsigned loadAcquire(const unsigned *p) {
+      return __atomic_load_n(p, __ATOMIC_ACQUIRE);
+    }
+
+    void storeRelease(unsigned *p, unsigned v) {
+      __atomic_store_n(p, v, __ATOMIC_RELEASE);
+    }
+
+    boost::system::error_code lastError() {
+      return {errno, boost::system::system_category()};
+    }
+
+    /// user data of the cancellation requests, which are not operations
+    constexpr uint64_t kCancelData = UINT64_MAX;
+  }  // namespace
+
+  outcome::result<std::shared_ptr<IoUring>> IoUring::create(
+      boost::asio::io_context &context, const IoUringConfig &config) {
+    std::shared_ptr<IoUring> ring{new IoUring(context, config)};
+    OUTCOME_TRY(ring->init());
+    return ring;
+  }
+
+  IoUring::IoUring(boost::asio::io_context &context, IoUringConfig config)
+      : context_(context), config_(config), event_(context) {}
+
+  IoUring::~IoUring() {
+    if (ring_.sqes != nullptr) {
+      munmap(ring_.sqes, ring_.sqes_size);
+    }
+    if (ring_.cq_ptr != nullptr && ring_.cq_ptr != ring_.sq_ptr) {
+      munmap(ring_.cq_ptr, ring_.cq_size);
+    }
+    if (ring_.sq_ptr != nullptr) {
+      munmap(ring_.sq_ptr, ring_.sq_size);
+    }
+    if (ring_.fd >= 0) {
+      close(ring_.fd);
+    }
+    if (buffers_ != nullptr) {
+      munmap(buffers_, buffers_size_);
+    }
+  }
+
+  outcome::result<void> IoUring::init() {
+    io_uring_params params{};
+    ring_.fd = setup(config_.entries, &params);
+    if (ring_.fd < 0) {
+      return lastError();
+    }
+
+    ring_.sq_size = params.sq_off.array + params.sq_entries * sizeof(unsigned);
+    ring_.cq_size =
+        params.cq_off.cqes + params.cq_entries * sizeof(io_uring_cqe);
+    bool single_mmap = (params.features & IORING_FEAT_SINGLE_MMAP) != 0;
+    if (single_mmap) {
+      ring_.sq_size = ring_.cq_size = std::max(ring_.sq_size, ring_.cq_size);
+    }
+
+    auto map = [this](size_t size, off_t off) -> void * {
+      auto p = mmap(nullptr, size, PROT_READ | PROT_WRITE,
+                    MAP_SHARED | MAP_POPULATE, ring_.fd, off);
+      return p == MAP_FAILED ? nullptr : p;
+    };
+    ring_.sq_ptr = map(ring_.sq_size, IORING_OFF_SQ_RING);
+    if (ring_.sq_ptr == nullptr) {
+      return lastError();
+    }
+    ring_.cq_ptr =
+        single_mmap ? ring_.sq_ptr : map(ring_.cq_size, IORING_OFF_CQ_RING);
+    if (ring_.cq_ptr == nullptr) {
+      return lastError();
+    }
+    ring_.sqes_size = params.sq_entries * sizeof(io_uring_sqe);
+    ring_.sqes =
+        static_cast<io_uring_sqe *>(map(ring_.sqes_size, IORING_OFF_SQES));
+    if (ring_.sqes == nullptr) {
+      return lastError();
+    }
+
+    ring_.sq_head = offset<unsigned>(ring_.sq_ptr, params.sq_off.head);
+    ring_.sq_tail = offset<unsigned>(ring_.sq_ptr, params.sq_off.tail);
+    ring_.sq_mask = offset<unsigned>(ring_.sq_ptr, params.sq_off.ring_mask);
+    ring_.sq_entries =
+        offset<unsigned>(ring_.sq_ptr, params.sq_off.ring_entries);
+    ring_.sq_array = offset<unsigned>(ring_.sq_ptr, params.sq_off.array);
+    ring_.cq_head = offset<unsigned>(ring_.cq_ptr, params.cq_off.head);
+    ring_.cq_tail = offset<unsigned>(ring_.cq_ptr, params.cq_off.tail);
+    ring_.cq_mask = offset<unsigned>(ring_.cq_ptr, params.cq_off.ring_mask);
+    ring_.cqes = offset<io_uring_cqe>(ring_.cq_ptr, params.cq_off.cqes);
+
+    int event_fd = eventfd(0, EFD_NONBLOCK | EFD_CLOEXEC);
+    if (event_fd < 0) {
+      return lastError();
+    }
+    event_.assign(event_fd);
+    if (registerRing(ring_.fd, IORING_REGISTER_EVENTFD, &event_fd, 1) != 0) {
+      return lastError();
+    }
+
+    registerBuffers();
+
+    operations_.reserve(config_.entries);
+    return outcome::success();
+  }
+
+  void IoUring::registerBuffers() {
+    if (config_.registered_buffers == 0 || config_.buffer_size == 0) {
+      return;
+    }
+    auto size = config_.registered_buffers * config_.buffer_size;
+    auto p = mmap(nullptr, size, PROT_READ | PROT_WRITE,
+                  MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+    if (p == MAP_FAILED) {
+      return;
+    }
+    std::vector<iovec> iovecs(config_.registered_buffers);
+    for (uint32_t i = 0; i < config_.registered_buffers; ++i) {
+      iovecs[i].iov_base = static_cast<uint8_t *>(p) + i * config_.buffer_size;
+      iovecs[i].iov_len = config_.buffer_size;
+    }
+    if (registerRing(ring_.fd, IORING_REGISTER_BUFFERS, iovecs.data(),
+                     iovecs.size())
+        != 0) {
+      // memory lock limit may be too low for the buffers; reads go straight
+      // to the callers' memory then
+      munmap(p, size);
+      return;
+    }
+    buffers_ = static_cast<uint8_t *>(p);
+    buffers_size_ = size;
+    for (uint32_t i = 0; i < config_.registered_buffers; ++i) {
+      free_buffers_.push_back(static_cast<int>(i));
+    }
+  }
+
+  void IoUring::recv(int fd, gsl::span<uint8_t> out, bool all, Callback cb) {
+    auto index = allocOperation();
+    auto &op = operations_[index];
+    op.cb = std::move(cb);
+    op.fd = fd;
+    op.data = out.data();
+    op.size = out.size();
+    op.all = all;
+    op.is_send = false;
+    enqueue(index);
+  }
+
+  void IoUring::send(int fd, gsl::span<const uint8_t> in, bool all,
+                     Callback cb) {
+    auto index = allocOperation();
+    auto &op = operations_[index];
+    op.cb = std::move(cb);
+    op.fd = fd;
+    op.data = const_cast<uint8_t *>(in.data());  // NOLINT
+    op.size = in.size();
+    op.all = all;
+    op.is_send = true;
+    enqueue(index);
+  }
+
+  void IoUring::cancel(int fd) {
+    // queued entries refer to the descriptor, which is about to be closed
+    submit();
+
+    for (size_t index = 0; index < operations_.size(); ++index) {
+      auto &op = operations_[index];
+      if (!op.cb || op.fd != fd || op.canceled) {
+        continue;
+      }
+      op.canceled = true;
+      auto *sqe = getSqe();
+      if (sqe == nullptr) {
+        // the operation is not resubmitted anyway; shutdown of the socket
+        // completes it
+        continue;
+      }
+      std::memset(sqe, 0, sizeof(*sqe));
+      sqe->opcode = IORING_OP_ASYNC_CANCEL;
+      sqe->fd = -1;
+      sqe->addr = index;
+      sqe->user_data = kCancelData;
+      ++to_submit_;
+    }
+    submit();
+  }
+
+  size_t IoUring::submitCalls() const {
+    return submit_calls_;
+  }
+
+  size_t IoUring::freeBuffers() const {
+    return free_buffers_.size();
+  }
+
+  size_t IoUring::allocOperation() {
+    if (!free_operations_.empty()) {
+      auto index = free_operations_.back();
+      free_operations_.pop_back();
+      return index;
+    }
+    operations_.emplace_back();
+    return operations_.size() - 1;
+  }
+
+  void IoUring::enqueue(size_t index) {
+    auto &op = operations_[index];
+    auto *sqe = getSqe();
+    if (sqe == nullptr) {
+      return fail(index, boost::asio::error::no_buffer_space);
+    }
+    std::memset(sqe, 0, sizeof(*sqe));
+    sqe->fd = op.fd;
+    sqe->user_data = index;
+
+    auto left = op.size - op.done;
+    if (op.is_send) {
+      sqe->opcode = IORING_OP_SEND;
+      sqe->addr = reinterpret_cast<uint64_t>(op.data + op.done);
+      sqe->len = static_cast<uint32_t>(left);
+      sqe->msg_flags = MSG_NOSIGNAL;
+    } else if (op.buffer >= 0 || !free_buffers_.empty()) {
+      // the buffer stays with the operation until it is completed, also
+      // between the steps of a read of the whole buffer
+      if (op.buffer < 0) {
+        op.buffer = free_buffers_.back();
+        free_buffers_.pop_back();
+      }
+      sqe->opcode = IORING_OP_READ_FIXED;
+      sqe->addr =
+          reinterpret_cast<uint64_t>(buffers_ + op.buffer * config_.buffer_size);
+      sqe->len = static_cast<uint32_t>(std::min(left, config_.buffer_size));
+      sqe->buf_index = static_cast<uint16_t>(op.buffer);
+    } else {
+      sqe->opcode = IORING_OP_RECV;
+      sqe->addr = reinterpret_cast<uint64_t>(op.data + op.done);
+      sqe->len = static_cast<uint32_t>(left);
+    }
+
+    ++to_submit_;
+    scheduleSubmit();
+  }
+
+  io_uring_sqe *IoUring::getSqe() {
+    auto full = [this] {
+      return *ring_.sq_tail - loadAcquire(ring_.sq_head) == *ring_.sq_entries;
+    };
+    if (full()) {
+      // the kernel copies entries on submission, so that they are freed
+      submit();
+      if (full()) {
+        return nullptr;
+      }
+    }
+    auto tail = *ring_.sq_tail;
+    auto index = tail & *ring_.sq_mask;
+    ring_.sq_array[index] = index;
+    storeRelease(ring_.sq_tail, tail + 1);
+    return &ring_.sqes[index];
+  }
+
+  void IoUring::scheduleSubmit() {
+    if (submit_scheduled_) {
+      return;
+    }
+    submit_scheduled_ = true;
+    boost::asio::post(context_, [self{shared_from_this()}] {
+      self->submit_scheduled_ = false;
+      self->submit();
+    });
+    waitCompletions();
+  }
+
+  void IoUring::submit() {
+    if (to_submit_ == 0) {
+      return;
+    }
+    ++submit_calls_;
+    int submitted = 0;
+    do {
+      submitted = enter(ring_.fd, to_submit_);
+    } while (submitted < 0 && errno == EINTR);
+    if (submitted < 0) {
+      return failQueued(lastError());
+    }
+    to_submit_ -= std::min(to_submit_, static_cast<unsigned>(submitted));
+  }
+
+  void IoUring::failQueued(const ErrorCode &ec) {
+    // the kernel consumes nothing after the head, when it fails, so the
+    // entries are taken back before any of the callbacks can queue new ones
+    auto head = loadAcquire(ring_.sq_head);
+    auto tail = *ring_.sq_tail;
+    std::vector<size_t> failed;
+    for (auto i = head; i != tail; ++i) {
+      auto user_data = ring_.sqes[ring_.sq_array[i & *ring_.sq_mask]].user_data;
+      if (user_data != kCancelData) {
+        failed.push_back(static_cast<size_t>(user_data));
+      }
+    }
+    storeRelease(ring_.sq_tail, head);
+    to_submit_ = 0;
+
+    for (auto index : failed) {
+      fail(index, ec);
+    }
+  }
+
+  void IoUring::fail(size_t index, const ErrorCode &ec) {
+    // the entry of the operation has not reached the kernel, so its buffer
+    // is not written anymore
+    auto &op = operations_[index];
+    releaseBuffer(op);
+    auto cb = std::move(op.cb);
+    auto done = op.done;
+    op = Operation{};
+    free_operations_.push_back(index);
+    boost::asio::post(context_,
+                      [cb{std::move(cb)}, ec, done] { cb(ec, done); });
+  }
+
+  void IoUring::waitCompletions() {
+    if (operations_.size() == free_operations_.size()) {
+      return;
+    }
+    // one wait at a time: the handler re-arms it, while operations remain
+    if (waiting_) {
+      return;
+    }
+    waiting_ = true;
+    event_.async_wait(boost::asio::posix::stream_descriptor::wait_read,
+                      [self{shared_from_this()}](const ErrorCode &ec) {
+                        self->waiting_ = false;
+                        if (ec) {
+                          return;
+                        }
+                        uint64_t value = 0;
+                        ErrorCode ignored;
+                        self->event_.read_some(
+                            boost::asio::buffer(&value, sizeof(value)),
+                            ignored);
+                        self->drainCompletions();
+                        self->waitCompletions();
+                      });
+  }
+
+  void IoUring::drainCompletions() {
+    auto head = *ring_.cq_head;
+    while (head != loadAcquire(ring_.cq_tail)) {
+      const auto &cqe = ring_.cqes[head & *ring_.cq_mask];
+      auto user_data = cqe.user_data;
+      auto res = cqe.res;
+      storeRelease(ring_.cq_head, ++head);
+      if (user_data != kCancelData) {
+        complete(static_cast<size_t>(user_data), res);
+      }
+    }
+  }
+
+  void IoUring::complete(size_t index, int res) {
+    auto &op = operations_[index];
+    ErrorCode ec;
+    if (res < 0) {
+      ec = {-res, boost::system::system_category()};
+    } else if (res == 0 && op.size != 0) {
+      ec = boost::asio::error::eof;
+    } else {
+      if (op.buffer >= 0) {
+        // the caller's memory is alive until the callback is called, even if
+        // the read has been canceled
+        std::memcpy(op.data + op.done,
+                    buffers_ + op.buffer * config_.buffer_size, res);
+      }
+      op.done += res;
+      if (op.all && op.done < op.size) {
+        if (!op.canceled) {
+          return enqueue(index);
+        }
+        ec = boost::asio::error::operation_aborted;
+      }
+    }
+
+    // the kernel is done with the buffer only now, when the completion of
+    // its read has arrived
+    releaseBuffer(op);
+    auto cb = std::move(op.cb);
+    auto done = op.done;
+    op = Operation{};
+    free_operations_.push_back(index);
+    cb(ec, done);
+  }
+
+  void IoUring::releaseBuffer(Operation &op) {
+    if (op.buffer >= 0) {
+      free_buffers_.push_back(op.buffer);
+      op.buffer = -1;
+    }
+  }
+
+}  // namespace libp2p::transport
@@ -5,19 +5,55 @@
 
 #include <libp2p/transport/tcp/tcp_connection.hpp>
 
+#include <netinet/in.h>
+#include <netinet/tcp.h>
+
+#include <libp2p/transport/impl/deadline.hpp>
 #include <libp2p/transport/tcp/tcp_util.hpp>
 
+#ifdef LIBP2P_IO_URING
+#include <libp2p/transport/tcp/io_uring.hpp>
+#endif
+
 namespace libp2p::transport {
 
+#ifdef LIBP2P_IO_URING
+  namespace {
+    template <typename Callback>
+    auto ringCallback(Callback cb) {
+      return [cb{std::move(cb)}](const boost::system::error_code &ec,
+                                 size_t bytes) {
+        if (ec) {
+          return cb(ec);
+        }
+        cb(bytes);
+      };
+    }
+  }  // namespace
+#endif
+
   TcpConnection::TcpConnection(boost::asio::io_context &ctx,
-                               boost::asio::ip::tcp::socket &&socket)
-      : context_(ctx), socket_(std::move(socket)) {}
+                               boost::asio::ip::tcp::socket &&socket,
+                               std::shared_ptr<IoUring> ring)
+      : context_(ctx), socket_(std::move(socket)), ring_(std::move(ring)) {}
 
-  TcpConnection::TcpConnection(boost::asio::io_context &ctx)
-      : context_(ctx), socket_(context_) {}
+  TcpConnection::TcpConnection(boost::asio::io_context &ctx,
+                               std::shared_ptr<IoUring> ring)
+      : context_(ctx), socket_(context_), ring_(std::move(ring)) {}
 
   outcome::result<void> TcpConnection::close() {
     boost::system::error_code ec;
+    if (ring_) {
+      // operations in the ring hold the socket, so that closing it does not
+      // wake them up; shutdown does
+      boost::system::error_code ignored;
+      socket_.shutdown(Tcp::socket::shutdown_both, ignored);
+#ifdef LIBP2P_IO_URING
+      // the queued operations must reach the kernel, while the descriptor
+      // still refers to this socket
+      ring_->cancel(socket_.native_handle());
+#endif
+    }
     socket_.close(ec);
     if (ec) {
       return handle_errcode(ec);
@@ -55,29 +91,110 @@ namespace libp2p::transport {
   }
 
   void TcpConnection::resolve(const TcpConnection::Tcp::endpoint &endpoint,
-                              TcpConnection::ResolveCallbackFunc cb) {
+                              TcpConnection::ResolveCallbackFunc cb,
+                              std::chrono::milliseconds timeout) {
     auto resolver = std::make_shared<Tcp::resolver>(context_);
+    auto shared_cb = std::make_shared<ResolveCallbackFunc>(std::move(cb));
+    // cancel does not interrupt a lookup, which is already running on the
+    // resolver's thread, so the timeout is reported without waiting for it
+    auto deadline =
+        detail::Deadline::start(context_, timeout, [resolver, shared_cb] {
+          resolver->cancel();
+          (*shared_cb)(boost::asio::error::timed_out, ResolverResultsType{});
+        });
     resolver->async_resolve(
         endpoint,
-        [resolver, cb{std::move(cb)}](const ErrorCode &ec, auto &&iterator) {
-          cb(ec, std::forward<decltype(iterator)>(iterator));
+        [resolver, deadline, shared_cb](const ErrorCode &ec, auto &&iterator) {
+          if (deadline->stop()) {
+            // the timeout has already been reported
+            return;
+          }
+          (*shared_cb)(ec, std::forward<decltype(iterator)>(iterator));
         });
   }
 
   void TcpConnection::connect(
       const TcpConnection::ResolverResultsType &iterator,
-      TcpConnection::ConnectCallbackFunc cb) {
-    boost::asio::async_connect(socket_, iterator,
-                               [self{shared_from_this()}, cb{std::move(cb)}](
-                                   auto &&ec, auto &&endpoint) {
-                                 self->initiator_ = true;
-                                 cb(std::forward<decltype(ec)>(ec),
-                                    std::forward<decltype(endpoint)>(endpoint));
-                               });
+      TcpConnection::ConnectCallbackFunc cb,
+      std::chrono::milliseconds timeout, bool fast_open) {
+    auto deadline = detail::Deadline::start(
+        context_, timeout, [wptr{weak_from_this()}] {
+          if (auto self = wptr.lock()) {
+            boost::system::error_code ignored;
+            self->socket_.close(ignored);
+          }
+        });
+    if (fast_open) {
+      return connectFastOpen(iterator, iterator.begin(), std::move(deadline),
+                             std::move(cb));
+    }
+    boost::asio::async_connect(
+        socket_, iterator,
+        [self{shared_from_this()}, deadline, cb{std::move(cb)}](
+            auto &&ec, auto &&endpoint) {
+          self->initiator_ = true;
+          if (deadline->stop()) {
+            return cb(boost::asio::error::timed_out,
+                      std::forward<decltype(endpoint)>(endpoint));
+          }
+          cb(std::forward<decltype(ec)>(ec),
+             std::forward<decltype(endpoint)>(endpoint));
+        });
+  }
+
+  void TcpConnection::connectFastOpen(
+      ResolverResultsType results, ResolverResultsType::const_iterator it,
+      std::shared_ptr<detail::Deadline> deadline, ConnectCallbackFunc cb) {
+    if (it == results.end()) {
+      deadline->stop();
+      return cb(boost::asio::error::host_not_found, Tcp::endpoint{});
+    }
+
+    // async_connect over the whole range reopens the socket for each
+    // endpoint, so that the option would be lost
+    auto endpoint = it->endpoint();
+    boost::system::error_code ec;
+    socket_.close(ec);
+    socket_.open(endpoint.protocol(), ec);
+    if (ec) {
+      deadline->stop();
+      return cb(ec, endpoint);
+    }
+#ifdef TCP_FASTOPEN_CONNECT
+    int enable = 1;
+    // failure is not fatal: ordinary handshake is done then
+    setsockopt(socket_.native_handle(), IPPROTO_TCP, TCP_FASTOPEN_CONNECT,
+               &enable, sizeof(enable));
+#endif
+
+    socket_.async_connect(
+        endpoint,
+        [self{shared_from_this()}, results{std::move(results)}, it, endpoint,
+         deadline{std::move(deadline)},
+         cb{std::move(cb)}](const ErrorCode &ec) mutable {
+          self->initiator_ = true;
+          if (deadline->expired()) {
+            deadline->stop();
+            return cb(boost::asio::error::timed_out, endpoint);
+          }
+          if (ec && std::next(it) != results.end()) {
+            return self->connectFastOpen(std::move(results), std::next(it),
+                                         std::move(deadline), std::move(cb));
+          }
+          deadline->stop();
+          cb(ec, endpoint);
+        });
   }
 
   void TcpConnection::read(gsl::span<uint8_t> out, size_t bytes,
                            TcpConnection::ReadCallbackFunc cb) {
+#ifdef LIBP2P_IO_URING
+    if (ring_) {
+      return ring_->recv(socket_.native_handle(),
+                         gsl::make_span(out.data(), bytes), true,
+                         ringCallback(std::move(cb)));
+    }
+#endif
     boost::asio::async_read(socket_, detail::makeBuffer(out, bytes),
                             [cb = std::move(cb)](auto &&ec, auto &&read) {
                               if (ec) {
@@ -89,6 +206,13 @@ namespace libp2p::transport {
 
   void TcpConnection::readSome(gsl::span<uint8_t> out, size_t bytes,
                                TcpConnection::ReadCallbackFunc cb) {
+#ifdef LIBP2P_IO_URING
+    if (ring_) {
+      return ring_->recv(socket_.native_handle(),
+                         gsl::make_span(out.data(), bytes), false,
+                         ringCallback(std::move(cb)));
+    }
+#endif
     socket_.async_read_some(detail::makeBuffer(out, bytes),
                             [cb = std::move(cb)](auto &&ec, auto &&read) {
                               if (ec) {
@@ -100,6 +224,13 @@ namespace libp2p::transport {
 
   void TcpConnection::write(gsl::span<const uint8_t> in, size_t bytes,
                             TcpConnection::WriteCallbackFunc cb) {
+#ifdef LIBP2P_IO_URING
+    if (ring_) {
+      return ring_->send(socket_.native_handle(),
+                         gsl::make_span(in.data(), bytes), true,
+                         ringCallback(std::move(cb)));
+    }
+#endif
     boost::asio::async_write(socket_, detail::makeBuffer(in, bytes),
                              [cb = std::move(cb)](auto &&ec, auto &&written) {
                                if (ec) {
@@ -111,6 +242,13 @@ namespace libp2p::transport {
 
   void TcpConnection::writeSome(gsl::span<const uint8_t> in, size_t bytes,
                                 TcpConnection::WriteCallbackFunc cb) {
+#ifdef LIBP2P_IO_URING
+    if (ring_) {
+      return ring_->send(socket_.native_handle(),
+                         gsl::make_span(in.data(), bytes), false,
+                         ringCallback(std::move(cb)));
+    }
+#endif
     socket_.async_write_some(detail::makeBuffer(in, bytes),
                              [cb = std::move(cb)](auto &&ec, auto &&written) {
                                if (ec) {
@@ -5,17 +5,33 @@
 
 #include <libp2p/transport/tcp/tcp_listener.hpp>
 
+#include <netinet/in.h>
+#include <netinet/tcp.h>
+
 #include <libp2p/transport/impl/upgrader_session.hpp>
 
+#ifdef LIBP2P_IO_URING
+#include <libp2p/transport/tcp/io_uring.hpp>
+#endif
+
 namespace libp2p::transport {
 
   TcpListener::TcpListener(boost::asio::io_context &context,
                            std::shared_ptr<Upgrader> upgrader,
-                           TransportListener::HandlerFunc handler)
+                           TransportListener::HandlerFunc handler,
+                           TransportConfig config,
+                           std::shared_ptr<network::ConnectionGater> gater)
       : context_(context),
         acceptor_(context_),
         upgrader_(std::move(upgrader)),
-        handle_(std::move(handler)) {}
+        handle_(std::move(handler)),
+        config_(config),
+        admission_(std::make_shared<AdmissionControl>(config_.admission)),
+        gater_(std::move(gater)) {
+#ifdef LIBP2P_IO_URING
+    ring_ = detail::makeIoUring(context_, config_.io_uring);
+#endif
+  }
 
   outcome::result<void> TcpListener::listen(
       const multi::Multiaddress &address) {
@@ -36,6 +52,13 @@ namespace libp2p::transport {
       acceptor_.open(endpoint.protocol());
       acceptor_.set_option(ip::tcp::acceptor::reuse_address(true));
       acceptor_.bind(endpoint);
+      if (config_.tcp_fast_open) {
+        int queue = config_.tcp_fast_open_queue;
+        // failure is not fatal: SYN data is ignored then, and the peers
+        // retransmit it after the handshake
+        setsockopt(acceptor_.native_handle(), IPPROTO_TCP, TCP_FASTOPEN,
+                   &queue, sizeof(queue));
+      }
       acceptor_.listen();
 
       // start listening
@@ -68,6 +91,10 @@ namespace libp2p::transport {
     return outcome::success();
   }
 
+  const AdmissionControl::Stats &TcpListener::getAdmissionStats() const {
+    return admission_->getStats();
+  }
+
   void TcpListener::doAccept() {
     using namespace boost::asio;    // NOLINT
     using namespace boost::system;  // NOLINT
@@ -83,11 +110,38 @@ namespace libp2p::transport {
             return self->handle_(ec);
           }
 
-          auto conn =
-              std::make_shared<TcpConnection>(self->context_, std::move(sock));
+          boost::system::error_code endpoint_ec;
+          auto remote = sock.remote_endpoint(endpoint_ec);
+          if (endpoint_ec) {
+            // peer has already gone
+            return self->doAccept();
+          }
+
+          // blocked addresses do not take slots of the admission control
+          auto gated = self->gater_ != nullptr
+              && !self->gater_->interceptAccept(remote.address());
+          if (gated
+              || self->admission_->admit(remote.address())
+                  != AdmissionControl::Decision::ACCEPT) {
+            // reset instead of graceful shutdown, so that no TIME_WAIT state
+            // is kept for the rejected peer
+            boost::system::error_code ignored;
+            sock.set_option(socket_base::linger(true, 0), ignored);
+            sock.close(ignored);
+            return self->doAccept();
+          }
+
+          auto conn = std::make_shared<TcpConnection>(
+              self->context_, std::move(sock), self->ring_);
+          self->admission_->track(conn);
 
           auto session = std::make_shared<UpgraderSession>(
-              self->upgrader_, std::move(conn), self->handle_);
+              self->upgrader_, std::move(conn),
+              [admission{self->admission_}, handle{self->handle_}](auto &&r) {
+                admission->onUpgradeFinished();
+                handle(std::forward<decltype(r)>(r));
+              },
+              self->context_, self->config_);
 
           session->secureInbound();
 
@@ -7,6 +7,10 @@
 
 #include <libp2p/transport/impl/upgrader_session.hpp>
 
+#ifdef LIBP2P_IO_URING
+#include <libp2p/transport/tcp/io_uring.hpp>
+#endif
+
 namespace libp2p::transport {
 
   void TcpTransport::dial(const peer::PeerId &remoteId,
@@ -15,40 +19,53 @@ namespace libp2p::transport {
     if (!canDial(address)) {
       return handler(std::errc::address_family_not_supported);
     }
+    if (gater_ != nullptr && !gater_->interceptSecured(remoteId)) {
+      return handler(TransportError::CONNECTION_GATED);
+    }
 
-    auto conn = std::make_shared<TcpConnection>(*context_);
+    auto conn = std::make_shared<TcpConnection>(*context_, ring_);
     auto rendpoint = detail::makeEndpoint(address);
     if (!rendpoint) {
       return handler(rendpoint.error());
     }
 
-    conn->resolve(rendpoint.value(),
-                  [self{shared_from_this()}, conn, handler{std::move(handler)},
-                   remoteId](auto ec, auto r) mutable {
-                    if (ec) {
-                      return handler(ec);
-                    }
+    conn->resolve(
+        rendpoint.value(),
+        [self{shared_from_this()}, conn, handler{std::move(handler)},
+         remoteId](auto ec, auto r) mutable {
+          if (ec == boost::asio::error::timed_out) {
+            return handler(TransportError::RESOLVE_TIMEOUT);
+          }
+          if (ec) {
+            return handler(ec);
+          }
 
-                    conn->connect(
-                        r,
-                        [self, conn, handler{std::move(handler)}, remoteId](
-                            auto ec, auto &e) mutable {
-                          if (ec) {
-                            return handler(ec);
-                          }
+          conn->connect(
+              r,
+              [self, conn, handler{std::move(handler)}, remoteId](
+                  auto ec, auto &e) mutable {
+                if (ec == boost::asio::error::timed_out) {
+                  return handler(TransportError::CONNECT_TIMEOUT);
+                }
+                if (ec) {
+                  return handler(ec);
+                }
 
-                          auto session = std::make_shared<UpgraderSession>(
-                              self->upgrader_, std::move(conn), handler);
+                auto session = std::make_shared<UpgraderSession>(
+                    self->upgrader_, std::move(conn), handler,
+                    *self->context_, self->config_);
 
-                          session->secureOutbound(remoteId);
-                        });
-                  });
+                session->secureOutbound(remoteId);
+              },
+              self->config_.connect_timeout, self->config_.tcp_fast_open);
+        },
+        config_.resolve_timeout);
   }
 
   std::shared_ptr<TransportListener> TcpTransport::createListener(
       TransportListener::HandlerFunc handler) {
     return std::make_shared<TcpListener>(*context_, upgrader_,
-                                         std::move(handler));
+                                         std::move(handler), config_, gater_);
   }
 
   bool TcpTransport::canDial(const multi::Multiaddress &ma) const {
@@ -56,8 +73,17 @@ namespace libp2p::transport {
   }
 
   TcpTransport::TcpTransport(std::shared_ptr<boost::asio::io_context> context,
-                             std::shared_ptr<Upgrader> upgrader)
-      : context_(std::move(context)), upgrader_(std::move(upgrader)) {}
+                             std::shared_ptr<Upgrader> upgrader,
+                             TransportConfig config,
+                             std::shared_ptr<network::ConnectionGater> gater)
+      : context_(std::move(context)),
+        upgrader_(std::move(upgrader)),
+        config_(config),
+        gater_(std::move(gater)) {
+#ifdef LIBP2P_IO_URING
+    ring_ = detail::makeIoUring(*context_, config_.io_uring);
+#endif
+  }
 
   peer::Protocol TcpTransport::getProtocolId() const {
     return "/tcp/1.0.0";
@@ -0,0 +1,140 @@
+/**
+ * Copyright Soramitsu Co., Ltd. All Rights Reserved.
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <libp2p/transport/unix/unix_connection.hpp>
+
+#include <sys/socket.h>
+#include <sys/types.h>
+#include <unistd.h>
+
+#include <libp2p/transport/impl/deadline.hpp>
+#include <libp2p/transport/tcp/tcp_util.hpp>
+
+namespace libp2p::transport {
+
+  UnixConnection::UnixConnection(boost::asio::io_context &ctx,
+                                 multi::Multiaddress address)
+      : context_(ctx), socket_(context_), address_(std::move(address)) {}
+
+  UnixConnection::UnixConnection(boost::asio::io_context &ctx,
+                                 Protocol::socket &&socket,
+                                 multi::Multiaddress address)
+      : context_(ctx),
+        socket_(std::move(socket)),
+        address_(std::move(address)) {}
+
+  void UnixConnection::connect(const Protocol::endpoint &endpoint,
+                               ConnectCallbackFunc cb,
+                               std::chrono::milliseconds timeout) {
+    auto deadline = detail::Deadline::start(
+        context_, timeout, [wptr{weak_from_this()}] {
+          if (auto self = wptr.lock()) {
+            boost::system::error_code ignored;
+            self->socket_.close(ignored);
+          }
+        });
+    socket_.async_connect(endpoint,
+                          [self{shared_from_this()}, deadline,
+                           cb{std::move(cb)}](const ErrorCode &ec) {
+                            self->initiator_ = true;
+                            if (deadline->stop()) {
+                              return cb(boost::asio::error::timed_out);
+                            }
+                            cb(ec);
+                          });
+  }
+
+  std::optional<UnixConnection::Credentials>
+  UnixConnection::peerCredentials() {
+    auto fd = socket_.native_handle();
+#if defined(SO_PEERCRED)
+    ucred cred{};
+    socklen_t len = sizeof(cred);
+    if (getsockopt(fd, SOL_SOCKET, SO_PEERCRED, &cred, &len) != 0) {
+      return std::nullopt;
+    }
+    return Credentials{cred.pid, cred.uid, cred.gid};
+#elif defined(__APPLE__) || defined(__FreeBSD__)
+    uid_t uid = 0;
+    gid_t gid = 0;
+    if (getpeereid(fd, &uid, &gid) != 0) {
+      return std::nullopt;
+    }
+    return Credentials{-1, uid, gid};
+#else
+    return std::nullopt;
+#endif
+  }
+
+  outcome::result<void> UnixConnection::close() {
+    boost::system::error_code ec;
+    socket_.close(ec);
+    if (ec) {
+      return ec;
+    }
+    return outcome::success();
+  }
+
+  bool UnixConnection::isClosed() const {
+    return !socket_.is_open();
+  }
+
+  outcome::result<multi::Multiaddress> UnixConnection::remoteMultiaddr() {
+    return address_;
+  }
+
+  outcome::result<multi::Multiaddress> UnixConnection::localMultiaddr() {
+    return address_;
+  }
+
+  bool UnixConnection::isInitiator() const noexcept {
+    return initiator_;
+  }
+
+  void UnixConnection::read(gsl::span<uint8_t> out, size_t bytes,
+                            UnixConnection::ReadCallbackFunc cb) {
+    boost::asio::async_read(socket_, detail::makeBuffer(out, bytes),
+                            [cb = std::move(cb)](auto &&ec, auto &&read) {
+                              if (ec) {
+                                return cb(std::forward<decltype(ec)>(ec));
+                              }
+                              return cb(read);
+                            });
+  }
+
+  void UnixConnection::readSome(gsl::span<uint8_t> out, size_t bytes,
+                                UnixConnection::ReadCallbackFunc cb) {
+    socket_.async_read_some(detail::makeBuffer(out, bytes),
+                            [cb = std::move(cb)](auto &&ec, auto &&read) {
+                              if (ec) {
+                                return cb(std::forward<decltype(ec)>(ec));
+                              }
+                              return cb(read);
+                            });
+  }
+
+  void UnixConnection::write(gsl::span<const uint8_t> in, size_t bytes,
+                             UnixConnection::WriteCallbackFunc cb) {
+    boost::asio::async_write(socket_, detail::makeBuffer(in, bytes),
+                             [cb = std::move(cb)](auto &&ec, auto &&written) {
+                               if (ec) {
+                                 return cb(std::forward<decltype(ec)>(ec));
+                               }
+                               return cb(written);
+                             });
+  }
+
+  void UnixConnection::writeSome(gsl::span<const uint8_t> in, size_t bytes,
+                                 UnixConnection::WriteCallbackFunc cb) {
+    socket_.async_write_some(detail::makeBuffer(in, bytes),
+                             [cb = std::move(cb)](auto &&ec, auto &&written) {
+                               if (ec) {
+                                 return cb(std::forward<decltype(ec)>(ec));
+                               }
+                               return cb(written);
+                             });
+  }
+
+}  // namespace libp2p::transport
@@ -0,0 +1,126 @@
+/**
+ * Copyright Soramitsu Co., Ltd. All Rights Reserved.
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <libp2p/transport/unix/unix_listener.hpp>
+
+#include <unistd.h>
+
+#include <libp2p/transport/impl/upgrader_session.hpp>
+#include <libp2p/transport/unix/unix_util.hpp>
+
+namespace libp2p::transport {
+
+  UnixListener::UnixListener(
+      boost::asio::io_context &context, std::shared_ptr<Upgrader> upgrader,
+      std::shared_ptr<security::SecurityAdaptor> trusted_security,
+      TransportListener::HandlerFunc handler, UnixConfig unix_config,
+      TransportConfig config)
+      : context_(context),
+        acceptor_(context_),
+        upgrader_(std::move(upgrader)),
+        trusted_security_(std::move(trusted_security)),
+        handle_(std::move(handler)),
+        unix_config_(std::move(unix_config)),
+        config_(config) {}
+
+  UnixListener::~UnixListener() {
+    if (!path_.empty()) {
+      ::unlink(path_.c_str());
+    }
+  }
+
+  outcome::result<void> UnixListener::listen(
+      const multi::Multiaddress &address) {
+    if (!canListen(address)) {
+      return std::errc::address_family_not_supported;
+    }
+
+    if (acceptor_.is_open()) {
+      return std::errc::already_connected;
+    }
+
+    try {
+      OUTCOME_TRY(endpoint, detail::makeUnixEndpoint(address));
+
+      // setup acceptor, throws
+      acceptor_.open(endpoint.protocol());
+      acceptor_.bind(endpoint);
+      path_ = endpoint.path();
+      acceptor_.listen();
+      address_ = address;
+
+      // start listening
+      doAccept();
+
+      return outcome::success();
+    } catch (const boost::system::system_error &e) {
+      boost::system::error_code ignored;
+      acceptor_.close(ignored);
+      return e.code();
+    }
+  }
+
+  bool UnixListener::canListen(const multi::Multiaddress &ma) const {
+    return detail::supportsUnix(ma);
+  }
+
+  outcome::result<multi::Multiaddress> UnixListener::getListenMultiaddr()
+      const {
+    if (!address_) {
+      return std::errc::not_connected;
+    }
+    return *address_;
+  }
+
+  bool UnixListener::isClosed() const {
+    return !acceptor_.is_open();
+  }
+
+  outcome::result<void> UnixListener::close() {
+    boost::system::error_code ec;
+    acceptor_.close(ec);
+    // the socket file outlives the acceptor, so it is removed here to let the
+    // path be bound again
+    if (!path_.empty()) {
+      ::unlink(path_.c_str());
+      path_.clear();
+    }
+    if (ec) {
+      return outcome::failure(ec);
+    }
+    return outcome::success();
+  }
+
+  void UnixListener::doAccept() {
+    if (!acceptor_.is_open()) {
+      return;
+    }
+
+    acceptor_.async_accept([self{this->shared_from_this()}](
+                               const boost::system::error_code &ec,
+                               UnixConnection::Protocol::socket sock) {
+      if (ec) {
+        return self->handle_(ec);
+      }
+
+      auto conn = std::make_shared<UnixConnection>(
+          self->context_, std::move(sock), *self->address_);
+      auto trusted = detail::skipsSecurity(*conn, self->unix_config_);
+
+      auto session = std::make_shared<UpgraderSession>(
+          self->upgrader_, std::move(conn), self->handle_, self->context_,
+          self->config_);
+
+      if (trusted) {
+        session->secureInbound(self->trusted_security_);
+      } else {
+        session->secureInbound();
+      }
+
+      self->doAccept();
+    });
+  }
+
+}  // namespace libp2p::transport
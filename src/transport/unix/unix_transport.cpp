@@ -0,0 +1,78 @@
+/**
+ * Copyright Soramitsu Co., Ltd. All Rights Reserved.
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <libp2p/transport/unix/unix_transport.hpp>
+
+#include <libp2p/transport/error.hpp>
+#include <libp2p/transport/impl/upgrader_session.hpp>
+#include <libp2p/transport/unix/unix_util.hpp>
+
+namespace libp2p::transport {
+
+  UnixTransport::UnixTransport(
+      std::shared_ptr<boost::asio::io_context> context,
+      std::shared_ptr<Upgrader> upgrader,
+      std::shared_ptr<security::Plaintext> trusted_security,
+      UnixConfig unix_config, TransportConfig config)
+      : context_(std::move(context)),
+        upgrader_(std::move(upgrader)),
+        trusted_security_(std::move(trusted_security)),
+        unix_config_(std::move(unix_config)),
+        config_(config) {}
+
+  void UnixTransport::dial(const peer::PeerId &remoteId,
+                           multi::Multiaddress address,
+                           TransportAdaptor::HandlerFunc handler) {
+    if (!canDial(address)) {
+      return handler(std::errc::address_family_not_supported);
+    }
+
+    auto endpoint = detail::makeUnixEndpoint(address);
+    if (!endpoint) {
+      return handler(endpoint.error());
+    }
+
+    auto conn = std::make_shared<UnixConnection>(*context_, std::move(address));
+    conn->connect(
+        endpoint.value(),
+        [self{shared_from_this()}, conn, handler{std::move(handler)},
+         remoteId](auto &ec) mutable {
+          if (ec == boost::asio::error::timed_out) {
+            return handler(TransportError::CONNECT_TIMEOUT);
+          }
+          if (ec) {
+            return handler(ec);
+          }
+
+          auto trusted = detail::skipsSecurity(*conn, self->unix_config_);
+          auto session = std::make_shared<UpgraderSession>(
+              self->upgrader_, std::move(conn), handler, *self->context_,
+              self->config_);
+
+          if (trusted) {
+            session->secureOutbound(remoteId, self->trusted_security_);
+          } else {
+            session->secureOutbound(remoteId);
+          }
+        },
+        config_.connect_timeout);
+  }
+
+  std::shared_ptr<TransportListener> UnixTransport::createListener(
+      TransportListener::HandlerFunc handler) {
+    return std::make_shared<UnixListener>(*context_, upgrader_,
+                                          trusted_security_, std::move(handler),
+                                          unix_config_, config_);
+  }
+
+  bool UnixTransport::canDial(const multi::Multiaddress &ma) const {
+    return detail::supportsUnix(ma);
+  }
+
+  peer::Protocol UnixTransport::getProtocolId() const {
+    return "/unix/1.0.0";
+  }
+
+}  // namespace libp2p::transport
@@ -101,7 +101,12 @@ Peer::sptr<host::BasicHost> Peer::makeHost(const crypto::KeyPair &keyPair) {
 
   auto multiselect = std::make_shared<protocol_muxer::Multiselect>();
 
-  auto router = std::make_shared<network::RouterImpl>();
+  auto bus = std::make_shared<libp2p::event::Bus>();
+
+  auto rmgr = std::make_shared<network::ResourceManagerImpl>(
+      bus, network::ResourceManagerConfig{});
+
+  auto router = std::make_shared<network::RouterImpl>(rmgr);
 
   auto exchange_msg_marshaller =
       std::make_shared<security::plaintext::ExchangeMessageMarshallerImpl>(
@@ -112,10 +117,13 @@ Peer::sptr<host::BasicHost> Peer::makeHost(const crypto::KeyPair &keyPair) {
                                             idmgr, std::move(key_marshaller))};
 
   std::vector<std::shared_ptr<muxer::MuxerAdaptor>> muxer_adaptors = {
-      std::make_shared<muxer::Yamux>(muxed_config_)};
+      std::make_shared<muxer::Yamux>(muxed_config_, bus, rmgr)};
+
+  auto protocol_repo = std::make_shared<peer::InmemProtocolRepository>();
 
   auto upgrader = std::make_shared<transport::UpgraderImpl>(
-      multiselect, std::move(security_adaptors), std::move(muxer_adaptors));
+      multiselect, protocol_repo, std::move(security_adaptors),
+      std::move(muxer_adaptors));
 
   std::vector<std::shared_ptr<transport::TransportAdaptor>> transports = {
       std::make_shared<transport::TcpTransport>(context_, std::move(upgrader))};
@@ -123,14 +131,15 @@ Peer::sptr<host::BasicHost> Peer::makeHost(const crypto::KeyPair &keyPair) {
   auto tmgr =
       std::make_shared<network::TransportManagerImpl>(std::move(transports));
 
-  auto bus = std::make_shared<libp2p::event::Bus>();
-
-  auto cmgr = std::make_shared<network::ConnectionManagerImpl>(bus, tmgr);
+  auto cmgr = std::make_shared<network::ConnectionManagerImpl>(
+      bus, tmgr, context_, std::make_shared<network::PeerScorerImpl>(bus),
+      network::ConnectionManagerConfig{});
 
   auto listener = std::make_unique<network::ListenerManagerImpl>(
-      multiselect, std::move(router), tmgr, cmgr);
+      multiselect, std::move(router), tmgr, cmgr, rmgr);
 
-  auto dialer = std::make_unique<network::DialerImpl>(multiselect, tmgr, cmgr);
+  auto dialer =
+      std::make_unique<network::DialerImpl>(multiselect, tmgr, cmgr, rmgr);
 
   auto network = std::make_unique<network::NetworkImpl>(
       std::move(listener), std::move(dialer), cmgr);
@@ -139,8 +148,6 @@ Peer::sptr<host::BasicHost> Peer::makeHost(const crypto::KeyPair &keyPair) {
 
   auto key_repo = std::make_shared<peer::InmemKeyRepository>();
 
-  auto protocol_repo = std::make_shared<peer::InmemProtocolRepository>();
-
   auto peer_repo = std::make_unique<peer::PeerRepositoryImpl>(
       std::move(addr_repo), std::move(key_repo), std::move(protocol_repo));
 
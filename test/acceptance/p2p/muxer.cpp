@@ -354,6 +354,10 @@ INSTANTIATE_TEST_CASE_P(
     AllMuxers, MuxerAcceptanceTest,
     ::testing::Values(
         // list here all muxers
-        std::make_shared<Yamux>(muxer::MuxedConnectionConfig{1048576, 1000}),
-        std::make_shared<Mplex>(muxer::MuxedConnectionConfig{})),
+        std::make_shared<Yamux>(muxer::MuxedConnectionConfig{1048576, 1000},
+                                std::make_shared<libp2p::event::Bus>(),
+                                nullptr),
+        std::make_shared<Mplex>(muxer::MuxedConnectionConfig{},
+                                std::make_shared<libp2p::event::Bus>(),
+                                nullptr)),
     MuxerAcceptanceTest::PrintToStringParamName());
@@ -0,0 +1,80 @@
+/**
+ * Copyright Soramitsu Co., Ltd. All Rights Reserved.
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+/**
+ * Compares the one-shot AES-CTR of AesProviderImpl, which sets up a context
+ * and allocates the output per call, with the stateful AesCtr and AesGcm,
+ * which encrypt frames in place with a context kept between calls.
+ *
+ * Usage: aes_benchmark [megabytes]
+ */
+
+#include <chrono>
+#include <iomanip>
+#include <iostream>
+#include <vector>
+
+#include <libp2p/crypto/aes_provider/aes_provider_impl.hpp>
+#include <libp2p/crypto/aes_provider/aes_stream.hpp>
+
+using namespace libp2p::crypto;
+using aes::Mode;
+
+namespace {
+  using Clock = std::chrono::steady_clock;
+
+  /// @return megabytes per second of encrypting frames by the function
+  template <typename F>
+  double measure(size_t frame_size, size_t megabytes, F &&encrypt) {
+    std::vector<uint8_t> frame(frame_size, 1);
+    size_t frames = megabytes * 1024 * 1024 / frame_size;
+    auto start = Clock::now();
+    for (size_t i = 0; i < frames; ++i) {
+      if (!encrypt(frame)) {
+        std::cerr << "frame " << i << " failed\n";
+        return 0;
+      }
+    }
+    std::chrono::duration<double> seconds = Clock::now() - start;
+    return static_cast<double>(frames * frame_size) / (1024 * 1024)
+        / seconds.count();
+  }
+}  // namespace
+
+int main(int argc, char **argv) {
+  size_t megabytes = 256;
+  if (argc > 1) {
+    megabytes = std::stoul(argv[1]);
+  }
+
+  common::Aes256Secret secret{};
+  secret.key.fill(1);
+  secret.iv.fill(2);
+  aes::AesProviderImpl provider;
+  auto ctr = aes::AesCtr::create(secret, Mode::ENCRYPT).value();
+  auto gcm = aes::AesGcm::create(secret.key, Mode::ENCRYPT).value();
+  std::vector<uint8_t> iv(aes::AesGcm::kIvSize, 3);
+  std::vector<uint8_t> tag(aes::AesGcm::kTagSize);
+
+  std::cout << std::left << std::setw(12) << "frame, B" << std::setw(20)
+            << "one-shot CTR, MB/s" << std::setw(20) << "stream CTR, MB/s"
+            << "stream GCM, MB/s\n";
+  for (size_t frame_size : {64, 1024, 16384, 65536}) {
+    auto one_shot = measure(frame_size, megabytes, [&](const auto &frame) {
+      return provider.encryptAesCtr256(secret, frame).has_value();
+    });
+    auto stream = measure(frame_size, megabytes, [&](auto &frame) {
+      return ctr.update(frame).has_value();
+    });
+    auto aead = measure(frame_size, megabytes, [&](auto &frame) {
+      ++iv[0];
+      return gcm.begin(iv) && gcm.update(frame) && gcm.finish(tag);
+    });
+    std::cout << std::left << std::setw(12) << frame_size << std::fixed
+              << std::setprecision(1) << std::setw(20) << one_shot
+              << std::setw(20) << stream << aead << '\n';
+  }
+  return 0;
+}
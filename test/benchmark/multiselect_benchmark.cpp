@@ -0,0 +1,138 @@
+/**
+ * Copyright Soramitsu Co., Ltd. All Rights Reserved.
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+/**
+ * Measures the rate of multistream-select negotiations between two peers over
+ * an in-memory pipe, so that only the cost of encoding, reading and parsing of
+ * the messages is counted; the protocol of the initiator is the last one of
+ * the responder, which matches it by a hash lookup, as the listener does.
+ *
+ * Usage: multiselect_benchmark [negotiations]
+ */
+
+#include <algorithm>
+#include <chrono>
+#include <iomanip>
+#include <iostream>
+#include <unordered_set>
+#include <vector>
+
+#include <libp2p/protocol_muxer/multiselect.hpp>
+
+using namespace libp2p;
+
+namespace {
+  using Clock = std::chrono::steady_clock;
+
+  /// end of an in-memory pipe; callbacks are called synchronously
+  class Pipe : public basic::ReadWriter {
+   public:
+    static std::pair<std::shared_ptr<Pipe>, std::shared_ptr<Pipe>> make() {
+      auto a = std::make_shared<Pipe>();
+      auto b = std::make_shared<Pipe>();
+      a->other_ = b;
+      b->other_ = a;
+      return {a, b};
+    }
+
+    void read(gsl::span<uint8_t> out, size_t bytes,
+              ReadCallbackFunc cb) override {
+      out_ = out.first(bytes);
+      read_cb_ = std::move(cb);
+      deliver();
+    }
+
+    void readSome(gsl::span<uint8_t> out, size_t bytes,
+                  ReadCallbackFunc cb) override {
+      read(out, bytes, std::move(cb));
+    }
+
+    void write(gsl::span<const uint8_t> in, size_t bytes,
+               WriteCallbackFunc cb) override {
+      auto other = other_.lock();
+      other->incoming_.insert(other->incoming_.end(), in.begin(),
+                              in.begin() + bytes);
+      other->deliver();
+      cb(bytes);
+    }
+
+    void writeSome(gsl::span<const uint8_t> in, size_t bytes,
+                   WriteCallbackFunc cb) override {
+      write(in, bytes, std::move(cb));
+    }
+
+   private:
+    void deliver() {
+      auto size = static_cast<size_t>(out_.size());
+      if (!read_cb_ || incoming_.size() < size) {
+        return;
+      }
+      std::copy_n(incoming_.begin(), size, out_.begin());
+      incoming_.erase(incoming_.begin(), incoming_.begin() + size);
+      auto cb = std::move(read_cb_);
+      read_cb_ = nullptr;
+      cb(size);
+    }
+
+    std::weak_ptr<Pipe> other_;
+    std::vector<uint8_t> incoming_;
+    gsl::span<uint8_t> out_;
+    ReadCallbackFunc read_cb_;
+  };
+
+  /// @return negotiations per second
+  double measure(size_t protocols_count, size_t negotiations) {
+    std::vector<peer::Protocol> protocols;
+    for (size_t i = 0; i < protocols_count; ++i) {
+      protocols.push_back("/benchmark/protocol/" + std::to_string(i));
+    }
+    std::vector<peer::Protocol> wanted{protocols.back()};
+
+    // the responder matches the protocols as the listener of the network does
+    auto supported = std::make_shared<const std::vector<peer::Protocol>>(
+        protocols.begin(), protocols.end());
+    std::unordered_set<peer::Protocol> index{protocols.begin(),
+                                             protocols.end()};
+    auto matcher = [&index](const peer::Protocol &p) {
+      return index.count(p) != 0;
+    };
+
+    auto initiator = std::make_shared<protocol_muxer::Multiselect>();
+    auto responder = std::make_shared<protocol_muxer::Multiselect>();
+    size_t succeeded = 0;
+    auto on_selected = [&](const outcome::result<peer::Protocol> &res) {
+      succeeded += res ? 1 : 0;
+    };
+
+    auto start = Clock::now();
+    for (size_t i = 0; i < negotiations; ++i) {
+      auto [a, b] = Pipe::make();
+      responder->acceptOneOf(supported, matcher, b, on_selected);
+      initiator->selectOneOf(wanted, a, true, on_selected);
+    }
+    std::chrono::duration<double> seconds = Clock::now() - start;
+    if (succeeded != 2 * negotiations) {
+      std::cerr << "negotiations failed: " << 2 * negotiations - succeeded
+                << '\n';
+    }
+    return static_cast<double>(negotiations) / seconds.count();
+  }
+}  // namespace
+
+int main(int argc, char **argv) {
+  size_t negotiations = 100000;
+  if (argc > 1) {
+    negotiations = std::stoul(argv[1]);
+  }
+
+  std::cout << std::left << std::setw(12) << "protocols"
+            << "negotiations/s\n";
+  for (size_t protocols_count : {1, 8, 32}) {
+    std::cout << std::left << std::setw(12) << protocols_count << std::fixed
+              << std::setprecision(0) << measure(protocols_count, negotiations)
+              << '\n';
+  }
+  return 0;
+}
@@ -0,0 +1,121 @@
+/**
+ * Copyright Soramitsu Co., Ltd. All Rights Reserved.
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+/**
+ * Measures the cost of the Noise protocol: throughput of in-place AEAD of
+ * transport frames for both cipher suites, and the rate of XX handshakes
+ * (without the network and libp2p payload signatures).
+ *
+ * Usage: noise_benchmark [megabytes] [handshakes]
+ */
+
+#include <chrono>
+#include <iomanip>
+#include <iostream>
+#include <vector>
+
+#include <libp2p/security/noise/handshake_state.hpp>
+
+using namespace libp2p::security::noise;
+
+namespace {
+  using Clock = std::chrono::steady_clock;
+
+  double secondsSince(Clock::time_point start) {
+    return std::chrono::duration<double>(Clock::now() - start).count();
+  }
+
+  const char *name(CipherSuite suite) {
+    return suite == CipherSuite::CHACHA_POLY ? "ChaChaPoly" : "AESGCM";
+  }
+
+  /// @return megabytes per second of encryption and decryption of frames
+  double transport(CipherSuite suite, size_t frame_size, size_t megabytes) {
+    CipherState::Key key{};
+    key.fill(1);
+    CipherState encoder{suite};
+    CipherState decoder{suite};
+    if (!encoder.initializeKey(key) || !decoder.initializeKey(key)) {
+      std::cerr << "cannot initialize the key\n";
+      return 0;
+    }
+    std::vector<uint8_t> buffer(frame_size + CipherState::kTagSize, 1);
+    size_t frames = megabytes * 1024 * 1024 / frame_size;
+
+    auto start = Clock::now();
+    for (size_t i = 0; i < frames; ++i) {
+      if (!encoder.encrypt({}, buffer, frame_size)
+          || !decoder.decrypt({}, buffer)) {
+        std::cerr << "frame " << i << " failed\n";
+        return 0;
+      }
+    }
+    return static_cast<double>(frames * frame_size) / (1024 * 1024)
+        / secondsSince(start);
+  }
+
+  /// @return handshakes per second, both sides counted as one handshake
+  double handshakes(CipherSuite suite, size_t count) {
+    auto initiator_keys = generateDhKeyPair();
+    auto responder_keys = generateDhKeyPair();
+    if (!initiator_keys || !responder_keys) {
+      std::cerr << "cannot generate keys\n";
+      return 0;
+    }
+
+    auto start = Clock::now();
+    for (size_t i = 0; i < count; ++i) {
+      HandshakeState initiator{suite, true, initiator_keys.value()};
+      HandshakeState responder{suite, false, responder_keys.value()};
+      for (size_t m = 0; m < 3; ++m) {
+        auto &writer = m % 2 == 0 ? initiator : responder;
+        auto &reader = m % 2 == 0 ? responder : initiator;
+        auto message = writer.writeMessage({});
+        if (!message || !reader.readMessage(message.value())) {
+          std::cerr << "handshake " << i << " failed\n";
+          return 0;
+        }
+      }
+      if (!initiator.split() || !responder.split()) {
+        return 0;
+      }
+    }
+    return count / secondsSince(start);
+  }
+}  // namespace
+
+int main(int argc, char **argv) {
+  size_t megabytes = 256;
+  size_t handshake_count = 2000;
+  if (argc > 1) {
+    megabytes = std::stoul(argv[1]);
+  }
+  if (argc > 2) {
+    handshake_count = std::stoul(argv[2]);
+  }
+
+  const std::vector<CipherSuite> suites{CipherSuite::CHACHA_POLY,
+                                        CipherSuite::AES_GCM};
+  const std::vector<size_t> frame_sizes{64, 1024, 16384, 65519};
+
+  std::cout << std::left << std::setw(12) << "cipher" << std::setw(12)
+            << "frame, B" << "encrypt + decrypt, MB/s\n";
+  for (auto suite : suites) {
+    for (auto frame_size : frame_sizes) {
+      std::cout << std::left << std::setw(12) << name(suite) << std::setw(12)
+                << frame_size << std::fixed << std::setprecision(1)
+                << transport(suite, frame_size, megabytes) << '\n';
+    }
+  }
+
+  std::cout << '\n' << std::left << std::setw(12) << "cipher"
+            << "handshakes per second\n";
+  for (auto suite : suites) {
+    std::cout << std::left << std::setw(12) << name(suite) << std::fixed
+              << std::setprecision(0) << handshakes(suite, handshake_count)
+              << '\n';
+  }
+  return 0;
+}
@@ -0,0 +1,104 @@
+/**
+ * Copyright Soramitsu Co., Ltd. All Rights Reserved.
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+/**
+ * Compares the way secure connections and their streams used to answer
+ * remotePeer()/remotePeerId() - by marshalling the remote key and deriving a
+ * PeerId from it on every call, a stream also locking its connection first -
+ * with the id, which is derived once at handshake and then returned by
+ * reference or copied by the caller.
+ *
+ * Usage: peer_id_benchmark [calls]
+ */
+
+#include <chrono>
+#include <iomanip>
+#include <iostream>
+#include <memory>
+#include <vector>
+
+#include <libp2p/crypto/key_marshaller/key_marshaller_impl.hpp>
+#include <libp2p/peer/peer_id.hpp>
+
+using namespace libp2p;
+using crypto::Key;
+using crypto::PublicKey;
+
+namespace {
+  using Clock = std::chrono::steady_clock;
+
+  /// @return nanoseconds per call of the function
+  template <typename F>
+  double measure(size_t calls, F &&get_id) {
+    size_t checksum = 0;
+    auto start = Clock::now();
+    for (size_t i = 0; i < calls; ++i) {
+      checksum += get_id().toVector().size();
+    }
+    std::chrono::duration<double, std::nano> ns = Clock::now() - start;
+    if (checksum == 0) {
+      std::cerr << "empty peer ids\n";
+    }
+    return ns.count() / calls;
+  }
+}  // namespace
+
+int main(int argc, char **argv) {
+  size_t calls = 1'000'000;
+  if (argc > 1) {
+    calls = std::stoul(argv[1]);
+  }
+
+  // marshalling does not validate keys, so their contents do not matter;
+  // Ed25519 ids are identity multihashes, RSA ones are SHA-256 of the key
+  struct {
+    const char *name;
+    PublicKey key;
+  } keys[] = {
+      {"Ed25519",
+       PublicKey{{Key::Type::Ed25519, std::vector<uint8_t>(32, 1)}}},
+      {"RSA-2048", PublicKey{{Key::Type::RSA, std::vector<uint8_t>(294, 1)}}},
+  };
+  crypto::marshaller::KeyMarshallerImpl marshaller{nullptr};
+
+  std::cout << std::left << std::setw(12) << "key" << std::setw(14) << "call"
+            << std::setw(16) << "before, ns" << std::setw(16)
+            << "after ref, ns" << "after copy, ns\n";
+  auto print = [](const char *name, const char *call, double before,
+                  double by_ref, double by_copy) {
+    std::cout << std::left << std::setw(12) << name << std::setw(14) << call
+              << std::fixed << std::setprecision(1) << std::setw(16) << before
+              << std::setw(16) << by_ref << by_copy << '\n';
+  };
+  for (const auto &[name, key] : keys) {
+    auto derive = [&marshaller, &key = key] {
+      return peer::PeerId::fromPublicKey(marshaller.marshal(key).value())
+          .value();
+    };
+
+    // connection: derived per call before, a member after
+    const auto cached = derive();
+    print(name, "connection", measure(calls, derive),
+          measure(calls,
+                  [&cached]() -> const peer::PeerId & { return cached; }),
+          measure(calls, [&cached] { return cached; }));
+
+    // stream: locked its connection, which derived the id, before; shares
+    // the connection's id after
+    auto connection = std::make_shared<int>(0);
+    std::weak_ptr<int> weak_connection = connection;
+    auto shared = std::make_shared<const peer::PeerId>(cached);
+    print(name, "stream",
+          measure(calls,
+                  [&weak_connection, &derive] {
+                    auto conn = weak_connection.lock();
+                    return derive();
+                  }),
+          measure(calls,
+                  [&shared]() -> const peer::PeerId & { return *shared; }),
+          measure(calls, [&shared] { return *shared; }));
+  }
+  return 0;
+}
@@ -0,0 +1,82 @@
+/**
+ * Copyright Soramitsu Co., Ltd. All Rights Reserved.
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+/**
+ * Compares SHA-256 through the low-level SHA256_Init API with the EVP-based
+ * one-shot sha256() and sha256Batch(), for inputs of the sizes of peer ids,
+ * keys and records.
+ *
+ * Usage: sha_benchmark [megabytes]
+ */
+
+#include <chrono>
+#include <iomanip>
+#include <iostream>
+#include <vector>
+
+#include <openssl/sha.h>
+#include <libp2p/crypto/sha/sha256.hpp>
+
+using namespace libp2p;
+
+namespace {
+  using Clock = std::chrono::steady_clock;
+  using Inputs = gsl::span<const gsl::span<const uint8_t>>;
+  using Outputs = gsl::span<common::Hash256>;
+
+  /// @return megabytes per second of hashing inputs by the function
+  template <typename F>
+  double measure(size_t input_size, size_t megabytes, F &&hash) {
+    constexpr size_t kBatchSize = 32;
+    std::vector<std::vector<uint8_t>> inputs(kBatchSize,
+                                             std::vector<uint8_t>(input_size));
+    std::vector<gsl::span<const uint8_t>> spans{inputs.begin(), inputs.end()};
+    std::vector<common::Hash256> out(kBatchSize);
+    size_t batches = megabytes * 1024 * 1024 / (input_size * kBatchSize);
+    auto start = Clock::now();
+    for (size_t i = 0; i < batches; ++i) {
+      inputs[0][0] = static_cast<uint8_t>(i);
+      hash(Inputs{spans}, Outputs{out});
+    }
+    std::chrono::duration<double> seconds = Clock::now() - start;
+    return static_cast<double>(batches * kBatchSize * input_size)
+        / (1024 * 1024) / seconds.count();
+  }
+}  // namespace
+
+int main(int argc, char **argv) {
+  size_t megabytes = 256;
+  if (argc > 1) {
+    megabytes = std::stoul(argv[1]);
+  }
+
+  std::cout << std::left << std::setw(12) << "input, B" << std::setw(20)
+            << "SHA256_Init, MB/s" << std::setw(20) << "sha256, MB/s"
+            << "sha256Batch, MB/s\n";
+  for (size_t input_size : {32, 64, 256, 1024, 16384}) {
+    auto low_level = measure(input_size, megabytes, [](Inputs inputs,
+                                                       Outputs out) {
+      for (std::ptrdiff_t i = 0; i < inputs.size(); ++i) {
+        SHA256_CTX ctx;
+        SHA256_Init(&ctx);
+        SHA256_Update(&ctx, inputs[i].data(), inputs[i].size());
+        SHA256_Final(out[i].data(), &ctx);
+      }
+    });
+    auto one_shot = measure(input_size, megabytes, [](Inputs inputs,
+                                                      Outputs out) {
+      for (std::ptrdiff_t i = 0; i < inputs.size(); ++i) {
+        out[i] = crypto::sha256(inputs[i]);
+      }
+    });
+    auto batch = measure(input_size, megabytes, [](Inputs inputs, Outputs out) {
+      crypto::sha256Batch(inputs, out);
+    });
+    std::cout << std::left << std::setw(12) << input_size << std::fixed
+              << std::setprecision(1) << std::setw(20) << low_level
+              << std::setw(20) << one_shot << batch << '\n';
+  }
+  return 0;
+}
@@ -0,0 +1,360 @@
+/**
+ * Copyright Soramitsu Co., Ltd. All Rights Reserved.
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+/**
+ * Measures the time to the first response of a small RPC protocol over a
+ * Yamux connection with a simulated one-way latency; a stream is opened for
+ * each request, and its protocol is selected either sequentially, waiting for
+ * the other side to confirm it before the request is sent, or optimistically,
+ * so that the SYN frame, the multistream header, the protocol and the request
+ * are written back to back, as the dialer does.
+ *
+ * Usage: stream_open_benchmark [rpcs] [latency_us]
+ */
+
+#include <chrono>
+#include <deque>
+#include <iomanip>
+#include <iostream>
+#include <vector>
+
+#include <boost/asio/io_context.hpp>
+#include <boost/asio/post.hpp>
+#include <boost/asio/steady_timer.hpp>
+#include <libp2p/connection/secure_connection.hpp>
+#include <libp2p/muxer/yamux/yamuxed_connection.hpp>
+#include <libp2p/protocol_muxer/multiselect.hpp>
+
+using namespace libp2p;
+
+namespace {
+  using Clock = std::chrono::steady_clock;
+
+  const peer::Protocol kProtocol = "/benchmark/rpc/1.0.0";
+  constexpr size_t kRequestSize = 64;
+  constexpr size_t kResponseSize = 256;
+
+  peer::PeerId makePeerId(uint8_t seed) {
+    return peer::PeerId::fromPublicKey(
+               crypto::ProtobufKey{std::vector<uint8_t>(32, seed)})
+        .value();
+  }
+
+  /**
+   * End of an in-memory link, which delivers the written bytes to the other
+   * end after the latency, keeping their order; a write completes at once,
+   * as a write to a socket with free buffer space does
+   */
+  class Link : public connection::SecureConnection,
+               public std::enable_shared_from_this<Link> {
+   public:
+    Link(boost::asio::io_context &context, Clock::duration latency,
+         bool initiator, peer::PeerId local, peer::PeerId remote)
+        : context_{context},
+          latency_{latency},
+          initiator_{initiator},
+          local_{std::move(local)},
+          remote_{std::move(remote)},
+          timer_{context} {}
+
+    static std::pair<std::shared_ptr<Link>, std::shared_ptr<Link>> make(
+        boost::asio::io_context &context, Clock::duration latency) {
+      auto a = std::make_shared<Link>(context, latency, true, makePeerId(1),
+                                      makePeerId(2));
+      auto b = std::make_shared<Link>(context, latency, false, makePeerId(2),
+                                      makePeerId(1));
+      a->other_ = b;
+      b->other_ = a;
+      return {a, b};
+    }
+
+    void read(gsl::span<uint8_t> out, size_t bytes,
+              ReadCallbackFunc cb) override {
+      out_ = out.first(bytes);
+      some_ = false;
+      read_cb_ = std::move(cb);
+      deliver();
+    }
+
+    void readSome(gsl::span<uint8_t> out, size_t bytes,
+                  ReadCallbackFunc cb) override {
+      out_ = out.first(bytes);
+      some_ = true;
+      read_cb_ = std::move(cb);
+      deliver();
+    }
+
+    void write(gsl::span<const uint8_t> in, size_t bytes,
+               WriteCallbackFunc cb) override {
+      if (auto other = other_.lock()) {
+        other->receive(in.first(bytes));
+      }
+      boost::asio::post(context_, [cb = std::move(cb), bytes] { cb(bytes); });
+    }
+
+    void writeSome(gsl::span<const uint8_t> in, size_t bytes,
+                   WriteCallbackFunc cb) override {
+      write(in, bytes, std::move(cb));
+    }
+
+    bool isInitiator() const noexcept override {
+      return initiator_;
+    }
+
+    outcome::result<multi::Multiaddress> localMultiaddr() override {
+      return multi::Multiaddress::create("/ip4/127.0.0.1/tcp/40000");
+    }
+
+    outcome::result<multi::Multiaddress> remoteMultiaddr() override {
+      return multi::Multiaddress::create("/ip4/127.0.0.1/tcp/40001");
+    }
+
+    const peer::PeerId &localPeer() const override {
+      return local_;
+    }
+
+    const peer::PeerId &remotePeer() const override {
+      return remote_;
+    }
+
+    outcome::result<crypto::PublicKey> remotePublicKey() const override {
+      return std::make_error_code(std::errc::not_supported);
+    }
+
+    bool isClosed() const override {
+      return closed_;
+    }
+
+    outcome::result<void> close() override {
+      closed_ = true;
+      timer_.cancel();
+      return outcome::success();
+    }
+
+   private:
+    /// queue the bytes, written by the other end, until the latency passes
+    void receive(gsl::span<const uint8_t> bytes) {
+      in_flight_.push_back(
+          {Clock::now() + latency_, {bytes.begin(), bytes.end()}});
+      if (in_flight_.size() == 1) {
+        arm();
+      }
+    }
+
+    void arm() {
+      timer_.expires_at(in_flight_.front().arrival);
+      timer_.async_wait([self{shared_from_this()}](auto &&ec) {
+        if (ec) {
+          return;
+        }
+        while (!self->in_flight_.empty()
+               && self->in_flight_.front().arrival <= Clock::now()) {
+          auto &bytes = self->in_flight_.front().bytes;
+          self->incoming_.insert(self->incoming_.end(), bytes.begin(),
+                                 bytes.end());
+          self->in_flight_.pop_front();
+        }
+        if (!self->in_flight_.empty()) {
+          self->arm();
+        }
+        self->deliver();
+      });
+    }
+
+    void deliver() {
+      auto size = static_cast<size_t>(out_.size());
+      if (!read_cb_ || incoming_.empty()
+          || (!some_ && incoming_.size() < size)) {
+        return;
+      }
+      size = std::min(size, incoming_.size());
+      std::copy_n(incoming_.begin(), size, out_.begin());
+      incoming_.erase(incoming_.begin(), incoming_.begin() + size);
+      auto cb = std::move(read_cb_);
+      read_cb_ = nullptr;
+      boost::asio::post(context_, [cb = std::move(cb), size] { cb(size); });
+    }
+
+    struct InFlight {
+      Clock::time_point arrival;
+      std::vector<uint8_t> bytes;
+    };
+
+    boost::asio::io_context &context_;
+    Clock::duration latency_;
+    bool initiator_;
+    peer::PeerId local_;
+    peer::PeerId remote_;
+    boost::asio::steady_timer timer_;
+    std::weak_ptr<Link> other_;
+    std::deque<InFlight> in_flight_;
+    std::deque<uint8_t> incoming_;
+    gsl::span<uint8_t> out_;
+    bool some_ = false;
+    ReadCallbackFunc read_cb_;
+    bool closed_ = false;
+  };
+
+  /// serves the RPC protocol: reads a request and writes a response to it
+  void serve(std::shared_ptr<protocol_muxer::Multiselect> multiselect,
+             std::shared_ptr<connection::Stream> stream) {
+    static auto protocols =
+        std::make_shared<const std::vector<peer::Protocol>>(1, kProtocol);
+    multiselect->acceptOneOf(
+        protocols,
+        [](const peer::Protocol &p) { return p == kProtocol; }, stream,
+        [stream](const outcome::result<peer::Protocol> &res) {
+          if (!res) {
+            return stream->reset();
+          }
+          auto request = std::make_shared<std::vector<uint8_t>>(kRequestSize);
+          stream->read(
+              *request, request->size(), [stream, request](auto &&res) {
+                if (!res) {
+                  return stream->reset();
+                }
+                auto response =
+                    std::make_shared<std::vector<uint8_t>>(kResponseSize, 1);
+                stream->write(*response, response->size(),
+                              [response](auto &&) {});
+              });
+        });
+  }
+
+  class Client {
+   public:
+    using Done = std::function<void(std::vector<Clock::duration>)>;
+
+    Client(std::shared_ptr<connection::CapableConnection> conn,
+           std::shared_ptr<protocol_muxer::Multiselect> multiselect,
+           bool pipelined, size_t rpcs, Done done)
+        : conn_{std::move(conn)},
+          multiselect_{std::move(multiselect)},
+          pipelined_{pipelined},
+          rpcs_{rpcs},
+          done_{std::move(done)} {}
+
+    /// send the requests one after another, each over a new stream
+    void next() {
+      if (durations_.size() == rpcs_) {
+        return done_(std::move(durations_));
+      }
+      start_ = Clock::now();
+      conn_->newStream([this](auto &&rstream) {
+        if (!rstream) {
+          std::cerr << "cannot open a stream: " << rstream.error().message()
+                    << '\n';
+          return done_(std::move(durations_));
+        }
+        auto stream = std::move(rstream.value());
+        if (pipelined_) {
+          return request(
+              multiselect_->selectOptimistically(kProtocol, std::move(stream)));
+        }
+        multiselect_->selectOneOf(
+            gsl::make_span(&kProtocol, 1), stream, true,
+            [this, stream](const outcome::result<peer::Protocol> &res) {
+              if (!res) {
+                std::cerr << "negotiation failed: " << res.error().message()
+                          << '\n';
+                return done_(std::move(durations_));
+              }
+              request(stream);
+            });
+      });
+    }
+
+   private:
+    void request(std::shared_ptr<connection::Stream> stream) {
+      stream->write(request_, request_.size(), [](auto &&) {});
+      stream->read(response_, response_.size(),
+                   [this, stream](auto &&res) {
+                     if (!res) {
+                       std::cerr << "request failed: "
+                                 << res.error().message() << '\n';
+                       return done_(std::move(durations_));
+                     }
+                     durations_.push_back(Clock::now() - start_);
+                     stream->reset();
+                     next();
+                   });
+    }
+
+    std::shared_ptr<connection::CapableConnection> conn_;
+    std::shared_ptr<protocol_muxer::Multiselect> multiselect_;
+    bool pipelined_;
+    size_t rpcs_;
+    Done done_;
+    std::vector<uint8_t> request_ = std::vector<uint8_t>(kRequestSize, 2);
+    std::vector<uint8_t> response_ = std::vector<uint8_t>(kResponseSize);
+    Clock::time_point start_;
+    std::vector<Clock::duration> durations_;
+  };
+
+  /// @return times to the first response of the requests
+  std::vector<Clock::duration> measure(bool pipelined, size_t rpcs,
+                                       Clock::duration latency) {
+    boost::asio::io_context context;
+    auto link = Link::make(context, latency);
+    auto a = link.first;
+    auto b = link.second;
+    auto initiator = std::make_shared<connection::YamuxedConnection>(a);
+    auto responder = std::make_shared<connection::YamuxedConnection>(b);
+    auto multiselect = std::make_shared<protocol_muxer::Multiselect>();
+
+    responder->onStream([multiselect](auto &&stream) {
+      serve(multiselect, std::forward<decltype(stream)>(stream));
+    });
+    responder->start();
+    initiator->start();
+
+    std::vector<Clock::duration> durations;
+    Client client{initiator, multiselect, pipelined, rpcs,
+                  [&](auto &&measured) {
+                    durations = std::move(measured);
+                    (void)a->close();
+                    (void)b->close();
+                    context.stop();
+                  }};
+    client.next();
+    context.run();
+    return durations;
+  }
+
+  void report(const char *mode, const std::vector<Clock::duration> &durations,
+              Clock::duration latency) {
+    if (durations.empty()) {
+      std::cout << std::left << std::setw(12) << mode << "failed\n";
+      return;
+    }
+    Clock::duration total{};
+    for (auto &d : durations) {
+      total += d;
+    }
+    std::chrono::duration<double, std::milli> mean = total / durations.size();
+    std::chrono::duration<double, std::milli> round_trip = 2 * latency;
+    std::cout << std::left << std::setw(12) << mode << std::setw(12)
+              << std::fixed << std::setprecision(2) << mean.count()
+              << mean / round_trip << '\n';
+  }
+}  // namespace
+
+int main(int argc, char **argv) {
+  size_t rpcs = 50;
+  std::chrono::microseconds latency{5000};
+  if (argc > 1) {
+    rpcs = std::stoul(argv[1]);
+  }
+  if (argc > 2) {
+    latency = std::chrono::microseconds{std::stoul(argv[2])};
+  }
+
+  std::cout << std::left << std::setw(12) << "mode" << std::setw(12)
+            << "mean, ms"
+            << "round trips\n";
+  report("sequential", measure(false, rpcs, latency), latency);
+  report("pipelined", measure(true, rpcs, latency), latency);
+  return 0;
+}
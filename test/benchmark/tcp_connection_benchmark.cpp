@@ -0,0 +1,150 @@
+/**
+ * Copyright Soramitsu Co., Ltd. All Rights Reserved.
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+/**
+ * Compares CPU time, which backends of TcpConnection spend on small frames:
+ * each of N loopback connections does ping-pong of 64-byte frames, so that
+ * the total number of frames is the same for every N.
+ *
+ * Usage: tcp_connection_benchmark [total_frames] [connections...]
+ */
+
+#include <chrono>
+#include <ctime>
+#include <iomanip>
+#include <iostream>
+#include <vector>
+
+#include <libp2p/transport/tcp/tcp_connection.hpp>
+
+#ifdef LIBP2P_IO_URING
+#include <libp2p/transport/tcp/io_uring.hpp>
+#endif
+
+using libp2p::transport::IoUring;
+using libp2p::transport::TcpConnection;
+using Tcp = boost::asio::ip::tcp;
+
+namespace {
+  constexpr size_t kFrameSize = 64;
+
+  /// client sends a frame, server echoes it back, until rounds are over
+  struct PingPong : std::enable_shared_from_this<PingPong> {
+    std::shared_ptr<TcpConnection> client;
+    std::shared_ptr<TcpConnection> server;
+    std::vector<uint8_t> client_buf = std::vector<uint8_t>(kFrameSize, 1);
+    std::vector<uint8_t> server_buf = std::vector<uint8_t>(kFrameSize, 0);
+    size_t rounds = 0;
+
+    void ping() {
+      if (rounds == 0) {
+        return;
+      }
+      --rounds;
+      client->write(client_buf, kFrameSize, [](auto &&res) {
+        if (!res) {
+          std::cerr << "write: " << res.error().message() << '\n';
+        }
+      });
+      server->read(server_buf, kFrameSize,
+                   [self{shared_from_this()}](auto &&res) {
+                     if (res) {
+                       self->pong();
+                     }
+                   });
+    }
+
+    void pong() {
+      server->write(server_buf, kFrameSize, [](auto &&) {});
+      client->read(client_buf, kFrameSize,
+                   [self{shared_from_this()}](auto &&res) {
+                     if (res) {
+                       self->ping();
+                     }
+                   });
+    }
+  };
+
+  struct Result {
+    double wall_ms;
+    double cpu_ms;
+  };
+
+  Result run(size_t connections, size_t total_frames, bool use_ring) {
+    boost::asio::io_context context;
+    std::shared_ptr<IoUring> ring;
+#ifdef LIBP2P_IO_URING
+    if (use_ring) {
+      libp2p::transport::IoUringConfig config;
+      config.enabled = true;
+      ring = libp2p::transport::detail::makeIoUring(context, config);
+    }
+#endif
+
+    Tcp::acceptor acceptor{context,
+                           {boost::asio::ip::make_address("127.0.0.1"), 0}};
+    std::vector<std::shared_ptr<PingPong>> pairs;
+    for (size_t i = 0; i < connections; ++i) {
+      Tcp::socket socket{context};
+      socket.connect(acceptor.local_endpoint());
+      socket.set_option(Tcp::no_delay(true));
+      auto accepted = acceptor.accept();
+      accepted.set_option(Tcp::no_delay(true));
+
+      auto pair = std::make_shared<PingPong>();
+      pair->client =
+          std::make_shared<TcpConnection>(context, std::move(socket), ring);
+      pair->server =
+          std::make_shared<TcpConnection>(context, std::move(accepted), ring);
+      pair->rounds = total_frames / connections;
+      pairs.push_back(std::move(pair));
+    }
+
+    auto wall_start = std::chrono::steady_clock::now();
+    auto cpu_start = std::clock();
+    for (auto &pair : pairs) {
+      pair->ping();
+    }
+    context.run();
+    auto cpu_ms = 1000.0 * (std::clock() - cpu_start) / CLOCKS_PER_SEC;
+    std::chrono::duration<double, std::milli> wall =
+        std::chrono::steady_clock::now() - wall_start;
+    return {wall.count(), cpu_ms};
+  }
+}  // namespace
+
+int main(int argc, char **argv) {
+  size_t total_frames = 200'000;
+  std::vector<size_t> connections{1, 16, 64, 256};
+  if (argc > 1) {
+    total_frames = std::stoul(argv[1]);
+  }
+  if (argc > 2) {
+    connections.clear();
+    for (int i = 2; i < argc; ++i) {
+      connections.push_back(std::stoul(argv[i]));
+    }
+  }
+
+  std::vector<std::pair<std::string, bool>> backends{{"asio", false}};
+#ifdef LIBP2P_IO_URING
+  backends.emplace_back("io_uring", true);
+#endif
+
+  std::cout << std::left << std::setw(10) << "backend" << std::setw(14)
+            << "connections" << std::setw(12) << "wall, ms" << std::setw(12)
+            << "cpu, ms" << "cpu per round trip, us\n";
+  for (auto &[name, use_ring] : backends) {
+    for (auto n : connections) {
+      auto result = run(n, total_frames, use_ring);
+      std::cout << std::left << std::setw(10) << name << std::setw(14) << n
+                << std::setw(12) << std::fixed << std::setprecision(1)
+                << result.wall_ms << std::setw(12) << result.cpu_ms
+                << std::setprecision(2)
+                << 1000.0 * result.cpu_ms / total_frames << '\n';
+    }
+  }
+  return 0;
+}
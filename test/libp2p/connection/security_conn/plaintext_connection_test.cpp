@@ -9,7 +9,6 @@
 #include <libp2p/common/literals.hpp>
 #include <testutil/outcome.hpp>
 #include "mock/libp2p/connection/raw_connection_mock.hpp"
-#include "mock/libp2p/crypto/key_marshaller_mock.hpp"
 #include "testutil/gmock_actions.hpp"
 
 using namespace libp2p::connection;
@@ -31,12 +30,13 @@ class PlaintextConnectionTest : public testing::Test {
   std::shared_ptr<RawConnectionMock> connection_ =
       std::make_shared<RawConnectionMock>();
 
-  std::shared_ptr<marshaller::KeyMarshallerMock> key_marshaller_ =
-      std::make_shared<marshaller::KeyMarshallerMock>();
+  PeerId local_peer = PeerId::fromPublicKey(ProtobufKey{local.data}).value();
+  PeerId remote_peer =
+      PeerId::fromPublicKey(ProtobufKey{remote.data}).value();
 
   std::shared_ptr<SecureConnection> secure_connection_ =
       std::make_shared<PlaintextConnection>(connection_, local, remote,
-                                            key_marshaller_);
+                                            local_peer, remote_peer);
 
   std::vector<uint8_t> bytes_{0x11, 0x22};
 };
@@ -44,25 +44,22 @@ class PlaintextConnectionTest : public testing::Test {
 /**
  * @given plaintext secure connection
  * @when invoking localPeer method of the connection
- * @then method behaves as expected
+ * @then the id, given at creation, is returned by reference each time
  */
 TEST_F(PlaintextConnectionTest, LocalPeer) {
-  EXPECT_CALL(*key_marshaller_, marshal(local))
-      .WillOnce(Return(ProtobufKey{local.data}));
-  ASSERT_EQ(secure_connection_->localPeer().value(),
-            PeerId::fromPublicKey(ProtobufKey{local.data}).value());
+  ASSERT_EQ(secure_connection_->localPeer(), local_peer);
+  ASSERT_EQ(&secure_connection_->localPeer(), &secure_connection_->localPeer());
 }
 
 /**
  * @given plaintext secure connection
  * @when invoking remotePeer method of the connection
- * @then method behaves as expected
+ * @then the id, given at creation, is returned by reference each time
  */
 TEST_F(PlaintextConnectionTest, RemotePeer) {
-  EXPECT_CALL(*key_marshaller_, marshal(remote))
-      .WillOnce(Return(ProtobufKey{remote.data}));
-  ASSERT_EQ(secure_connection_->remotePeer().value(),
-            PeerId::fromPublicKey(ProtobufKey{remote.data}).value());
+  ASSERT_EQ(secure_connection_->remotePeer(), remote_peer);
+  ASSERT_EQ(&secure_connection_->remotePeer(),
+            &secure_connection_->remotePeer());
 }
 
 /**
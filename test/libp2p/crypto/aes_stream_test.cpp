@@ -0,0 +1,167 @@
+/**
+ * Copyright Soramitsu Co., Ltd. All Rights Reserved.
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <libp2p/crypto/aes_provider/aes_stream.hpp>
+
+#include <gtest/gtest.h>
+#include <libp2p/common/literals.hpp>
+#include <libp2p/common/types.hpp>
+#include <libp2p/crypto/aes_provider/aes_provider_impl.hpp>
+#include <libp2p/crypto/error.hpp>
+#include "testutil/outcome.hpp"
+
+using namespace libp2p::crypto;
+using namespace libp2p::common;
+using aes::AesCtr;
+using aes::AesGcm;
+using aes::Mode;
+
+class AesCtrStreamTest : public testing::Test {
+ protected:
+  void SetUp() override {
+    std::copy(key.begin(), key.end(), secret.key.begin());
+    std::copy(iv.begin(), iv.end(), secret.iv.begin());
+    for (size_t i = 0; i < plain_text.size(); ++i) {
+      plain_text[i] = static_cast<uint8_t>(i * 13);
+    }
+  }
+
+  ByteArray iv{"3dafba429d9eb430b422da802c9fac41"_unhex};
+  ByteArray key{
+      "78dae34bc0eba813c09cec5c871f3ccb39dcbbe04a2fe1837e169fee896aa208"_unhex};
+  common::Aes256Secret secret{};
+  ByteArray plain_text = ByteArray(1000);
+};
+
+/**
+ * @given plain text and AES-256-CTR stream
+ * @when the text is encrypted by parts of different sizes, which are not
+ * aligned to the block
+ * @then result is equal to the one of the one-shot encryption
+ */
+TEST_F(AesCtrStreamTest, PartsEqualOneShot) {
+  EXPECT_OUTCOME_TRUE(expected,
+                      aes::AesProviderImpl{}.encryptAesCtr256(secret,
+                                                               plain_text));
+  EXPECT_OUTCOME_TRUE(encoder, AesCtr::create(secret, Mode::ENCRYPT));
+  ByteArray cipher_text(plain_text.size());
+  auto in = gsl::make_span(plain_text);
+  auto out = gsl::make_span(cipher_text);
+  for (size_t offset = 0, part = 1; offset < plain_text.size();
+       offset += part, part += 7) {
+    part = std::min(part, plain_text.size() - offset);
+    EXPECT_OUTCOME_TRUE(written, encoder.update(in.subspan(offset, part),
+                                                out.subspan(offset)));
+    ASSERT_EQ(written, part);
+  }
+  ASSERT_EQ(cipher_text, expected);
+}
+
+/**
+ * @given encrypting and decrypting AES-256-CTR streams with the same secret
+ * @when messages are encrypted and decrypted in place one after another
+ * @then the messages are restored
+ */
+TEST_F(AesCtrStreamTest, InPlaceRoundTrip) {
+  EXPECT_OUTCOME_TRUE(encoder, AesCtr::create(secret, Mode::ENCRYPT));
+  EXPECT_OUTCOME_TRUE(decoder, AesCtr::create(secret, Mode::DECRYPT));
+  for (size_t i = 0; i < 3; ++i) {
+    auto buffer = plain_text;
+    EXPECT_OUTCOME_TRUE_1(encoder.update(buffer));
+    ASSERT_NE(buffer, plain_text);
+    EXPECT_OUTCOME_TRUE_1(decoder.update(buffer));
+    ASSERT_EQ(buffer, plain_text);
+  }
+}
+
+/**
+ * @given AES-256-CTR stream
+ * @when the output is smaller than the input
+ * @then error is returned
+ */
+TEST_F(AesCtrStreamTest, SmallOutput) {
+  EXPECT_OUTCOME_TRUE(encoder, AesCtr::create(secret, Mode::ENCRYPT));
+  ByteArray out(plain_text.size() - 1);
+  EXPECT_OUTCOME_FALSE_1(encoder.update(plain_text, out));
+}
+
+class AesGcmStreamTest : public testing::Test {
+ protected:
+  /// test case 4 of "The Galois/Counter Mode of Operation" by McGrew, Viega
+  ByteArray key{"feffe9928665731c6d6a8f9467308308"_unhex};
+  ByteArray iv{"cafebabefacedbaddecaf888"_unhex};
+  ByteArray ad{"feedfacedeadbeeffeedfacedeadbeefabaddad2"_unhex};
+  ByteArray plain_text{
+      "d9313225f88406e5a55909c5aff5269a86a7a9531534f7da2e4c303d8a318a72"
+      "1c3c0c95956809532fcf0e2449a6b525b16aedf5aa0de657ba637b39"_unhex};
+  ByteArray cipher_text{
+      "42831ec2217774244b7221b784d0d49ce3aa212f2c02a4e035c17e2329aca12e"
+      "21d514b25466931c7d8f6a5aac84aa051ba30b396a0aac973d58e091"_unhex};
+  ByteArray tag{"5bc94fbc3221a5db94fae95ae7121a47"_unhex};
+};
+
+/**
+ * @given AES-128-GCM key, iv, associated data and plain text
+ * @when two messages are encrypted with the same stream, one at once and
+ * another one by parts
+ * @then both ciphertexts and tags are equal to the known ones
+ */
+TEST_F(AesGcmStreamTest, KnownAnswer) {
+  EXPECT_OUTCOME_TRUE(encoder, AesGcm::create(key, Mode::ENCRYPT));
+  for (size_t parts : {1, 3}) {
+    auto buffer = plain_text;
+    ByteArray result_tag(AesGcm::kTagSize);
+    EXPECT_OUTCOME_TRUE_1(encoder.begin(iv, ad));
+    auto span = gsl::make_span(buffer);
+    auto part = buffer.size() / parts + 1;
+    for (size_t offset = 0; offset < buffer.size(); offset += part) {
+      EXPECT_OUTCOME_TRUE_1(encoder.update(span.subspan(
+          offset, std::min(part, buffer.size() - offset))));
+    }
+    EXPECT_OUTCOME_TRUE_1(encoder.finish(result_tag));
+    ASSERT_EQ(buffer, cipher_text);
+    ASSERT_EQ(result_tag, tag);
+  }
+}
+
+/**
+ * @given AES-128-GCM ciphertext and tag
+ * @when it is decrypted with the right tag, and then with a wrong one
+ * @then the first message is restored, and the second one is rejected
+ */
+TEST_F(AesGcmStreamTest, DecryptAndReject) {
+  EXPECT_OUTCOME_TRUE(decoder, AesGcm::create(key, Mode::DECRYPT));
+  auto buffer = cipher_text;
+  EXPECT_OUTCOME_TRUE_1(decoder.begin(iv, ad));
+  EXPECT_OUTCOME_TRUE_1(decoder.update(buffer));
+  EXPECT_OUTCOME_TRUE_1(decoder.finish(tag));
+  ASSERT_EQ(buffer, plain_text);
+
+  buffer = cipher_text;
+  auto wrong_tag = tag;
+  wrong_tag[0] ^= 1;
+  EXPECT_OUTCOME_TRUE_1(decoder.begin(iv, ad));
+  EXPECT_OUTCOME_TRUE_1(decoder.update(buffer));
+  EXPECT_OUTCOME_FALSE(error, decoder.finish(wrong_tag));
+  ASSERT_EQ(error, OpenSslError::FAILED_DECRYPT_FINALIZE);
+}
+
+/**
+ * @given key, iv and tag of wrong sizes
+ * @when they are passed to AES-GCM
+ * @then errors are returned
+ */
+TEST_F(AesGcmStreamTest, WrongSizes) {
+  EXPECT_OUTCOME_FALSE(key_error,
+                       AesGcm::create(ByteArray(20), Mode::ENCRYPT));
+  ASSERT_EQ(key_error, OpenSslError::WRONG_KEY_SIZE);
+  EXPECT_OUTCOME_TRUE(encoder, AesGcm::create(key, Mode::ENCRYPT));
+  EXPECT_OUTCOME_FALSE(iv_error, encoder.begin(ByteArray(16)));
+  ASSERT_EQ(iv_error, OpenSslError::WRONG_IV_SIZE);
+  EXPECT_OUTCOME_TRUE_1(encoder.begin(iv));
+  ByteArray short_tag(8);
+  EXPECT_OUTCOME_FALSE(tag_error, encoder.finish(short_tag));
+  ASSERT_EQ(tag_error, OpenSslError::WRONG_TAG_SIZE);
+}
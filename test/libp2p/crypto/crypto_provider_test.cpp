@@ -0,0 +1,281 @@
+/**
+ * Copyright Soramitsu Co., Ltd. All Rights Reserved.
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <libp2p/crypto/crypto_provider/crypto_provider_impl.hpp>
+
+#include <chrono>
+#include <thread>
+
+#include <gtest/gtest.h>
+#include <openssl/evp.h>
+#include <openssl/obj_mac.h>
+#include <libp2p/common/literals.hpp>
+#include <libp2p/crypto/common_functions.hpp>
+#include <libp2p/crypto/ecdsa_provider/ecdsa_provider_impl.hpp>
+#include <libp2p/crypto/ed25519_provider/ed25519_provider_impl.hpp>
+#include <libp2p/crypto/random_generator/boost_generator.hpp>
+#include <libp2p/crypto/sha/sha256.hpp>
+#include <libp2p/metrics/registry.hpp>
+#include <testutil/outcome.hpp>
+
+using libp2p::common::ByteArray;
+using libp2p::crypto::CryptoProvider;
+using libp2p::crypto::CryptoProviderImpl;
+using libp2p::crypto::Key;
+using libp2p::crypto::KeyPair;
+using libp2p::crypto::PublicKey;
+using libp2p::crypto::VerificationCache;
+using libp2p::crypto::ecdsa::EcdsaProviderImpl;
+using libp2p::crypto::ed25519::Ed25519ProviderImpl;
+using libp2p::crypto::random::BoostRandomGenerator;
+using libp2p::common::operator""_unhex;
+using libp2p::common::operator""_v;
+
+class CryptoProviderVerifyTest : public ::testing::Test {
+ protected:
+  /// sign the message with a key of secp256k1 or ECDSA type
+  ByteArray signEc(const KeyPair &keys, gsl::span<const uint8_t> message) {
+    auto nid = keys.privateKey.type == Key::Type::Secp256k1
+        ? NID_secp256k1
+        : NID_X9_62_prime256v1;
+    auto ec_key =
+        libp2p::crypto::EcKeyFromPrivateKeyBytes(nid, keys.privateKey.data)
+            .value();
+    return libp2p::crypto::GenerateEcSignature(
+               libp2p::crypto::sha256(message), ec_key)
+        .value();
+  }
+
+  std::shared_ptr<CryptoProvider> crypto_provider_ =
+      std::make_shared<CryptoProviderImpl>(
+          std::make_shared<BoostRandomGenerator>(),
+          std::make_shared<Ed25519ProviderImpl>());
+
+  ByteArray message_ = "signed peer record"_v;
+};
+
+/**
+ * @given secp256k1 and ECDSA key pairs, generated by the provider
+ * @when a signature, made with a private key, is verified
+ * @then it is valid for the message and invalid for another one
+ */
+TEST_F(CryptoProviderVerifyTest, EcSignatures) {
+  for (auto type : {Key::Type::Secp256k1, Key::Type::ECDSA}) {
+    EXPECT_OUTCOME_TRUE(keys, crypto_provider_->generateKeys(type));
+    auto signature = signEc(keys, message_);
+
+    EXPECT_OUTCOME_TRUE(valid,
+                        crypto_provider_->verify(message_, signature,
+                                                 keys.publicKey));
+    EXPECT_TRUE(valid);
+
+    auto other_message = "other record"_v;
+    EXPECT_OUTCOME_TRUE(other_valid,
+                        crypto_provider_->verify(other_message, signature,
+                                                 keys.publicKey));
+    EXPECT_FALSE(other_valid);
+  }
+}
+
+/**
+ * @given ECDSA key pair in DER-encoded PKIX format, as libp2p spec sends it
+ * @when a signature, made with its private key, is verified
+ * @then it is valid
+ */
+TEST_F(CryptoProviderVerifyTest, EcdsaDerKey) {
+  EcdsaProviderImpl ecdsa;
+  EXPECT_OUTCOME_TRUE(keys, ecdsa.GenerateKeyPair());
+  EXPECT_OUTCOME_TRUE(signature, ecdsa.Sign(message_, keys.private_key));
+  PublicKey public_key{
+      {Key::Type::ECDSA, {keys.public_key.begin(), keys.public_key.end()}}};
+
+  EXPECT_OUTCOME_TRUE(
+      valid, crypto_provider_->verify(message_, signature, public_key));
+  EXPECT_TRUE(valid);
+}
+
+/**
+ * @given signed messages of several key types, one of them tampered
+ * @when they are verified as a batch
+ * @then each result matches the one of separate verification
+ */
+TEST_F(CryptoProviderVerifyTest, Batch) {
+  EXPECT_OUTCOME_TRUE(ed_keys,
+                      crypto_provider_->generateKeys(Key::Type::Ed25519));
+  EXPECT_OUTCOME_TRUE(ec_keys,
+                      crypto_provider_->generateKeys(Key::Type::Secp256k1));
+  EXPECT_OUTCOME_TRUE(ed_signature,
+                      crypto_provider_->sign(message_, ed_keys.privateKey));
+  auto ec_signature = signEc(ec_keys, message_);
+  auto tampered = ed_signature;
+  tampered[0] ^= 1;
+  auto other_message = "other record"_v;
+
+  std::vector<CryptoProvider::SignedMessage> messages{
+      {message_, ed_signature, ed_keys.publicKey},
+      {message_, tampered, ed_keys.publicKey},
+      {other_message, ed_signature, ed_keys.publicKey},
+      {message_, ec_signature, ec_keys.publicKey},
+      {message_, ed_signature, ed_keys.publicKey},
+  };
+  auto results = crypto_provider_->verifyBatch(messages);
+  EXPECT_EQ(results, (std::vector<bool>{true, false, false, true, true}));
+
+  // valid signatures are now cached, and the results are the same
+  EXPECT_EQ(crypto_provider_->verifyBatch(messages), results);
+}
+
+/**
+ * @given verification cache of two entries
+ * @when the third entry is inserted
+ * @then the least recently used one is evicted
+ */
+TEST(VerificationCacheTest, EvictsLeastRecentlyUsed) {
+  PublicKey key{{Key::Type::Ed25519, ByteArray(32, 1)}};
+  auto message = "message"_v;
+  auto entry = [&](uint8_t i) {
+    ByteArray signature(64, i);
+    return VerificationCache::makeEntry(message, signature, key);
+  };
+
+  VerificationCache cache{2};
+  cache.insert(entry(1));
+  cache.insert(entry(2));
+  ASSERT_TRUE(cache.contains(entry(1)));
+
+  cache.insert(entry(3));
+  EXPECT_EQ(cache.size(), 2);
+  EXPECT_TRUE(cache.contains(entry(1)));
+  EXPECT_FALSE(cache.contains(entry(2)));
+  EXPECT_TRUE(cache.contains(entry(3)));
+}
+
+/**
+ * @given ephemeral key pairs of two peers on each curve
+ * @when each peer computes the shared secret from the key of the other one
+ * @then both secrets are equal
+ */
+TEST_F(CryptoProviderVerifyTest, EphemeralKeyAgreement) {
+  using libp2p::crypto::common::CurveType;
+  for (auto curve : {CurveType::P256, CurveType::P384, CurveType::P521}) {
+    EXPECT_OUTCOME_TRUE(alice,
+                        crypto_provider_->generateEphemeralKeyPair(curve));
+    EXPECT_OUTCOME_TRUE(bob,
+                        crypto_provider_->generateEphemeralKeyPair(curve));
+    EXPECT_OUTCOME_TRUE(
+        alice_secret, alice.shared_secret_generator(bob.ephemeral_public_key));
+    EXPECT_OUTCOME_TRUE(
+        bob_secret, bob.shared_secret_generator(alice.ephemeral_public_key));
+    EXPECT_EQ(alice_secret, bob_secret);
+    EXPECT_FALSE(alice.shared_secret_generator("04"_unhex));
+  }
+}
+
+/**
+ * @given shared secret
+ * @when it is stretched for AES-256 with HMAC-SHA256
+ * @then two different key sets of expected sizes are made deterministically
+ */
+TEST_F(CryptoProviderVerifyTest, StretchKey) {
+  using libp2p::crypto::common::CipherType;
+  using libp2p::crypto::common::HashType;
+  ByteArray secret(32, 7);
+  auto keys =
+      crypto_provider_->stretchKey(CipherType::AES256, HashType::SHA256,
+                                   secret);
+  ASSERT_EQ(keys.size(), 2);
+  for (const auto &key : keys) {
+    EXPECT_EQ(key.iv.size(), 16);
+    EXPECT_EQ(key.cipher_key.size(), 32);
+    EXPECT_EQ(key.mac_key.size(), 20);
+  }
+  EXPECT_NE(keys[0].cipher_key, keys[1].cipher_key);
+
+  auto again =
+      crypto_provider_->stretchKey(CipherType::AES256, HashType::SHA256,
+                                   secret);
+  EXPECT_EQ(again[1].mac_key, keys[1].mac_key);
+}
+
+/**
+ * @given ephemeral key pool of two keys
+ * @when keys of a curve are taken, before and after background generation
+ * @then the first key is a miss, and the pool serves the later ones
+ */
+TEST(EphemeralKeyPoolTest, RefillsInBackground) {
+  using libp2p::crypto::EphemeralKeyPool;
+  using libp2p::crypto::common::CurveType;
+  EphemeralKeyPool pool{2};
+  EXPECT_OUTCOME_TRUE(first, pool.take(CurveType::P256));
+  EXPECT_EQ(first.public_key.size(), 65);
+  EXPECT_EQ(pool.stats().misses, 1);
+
+  // wait for the background thread to fill the pool
+  for (size_t i = 0; i < 1000 && pool.stats().hits == 0; ++i) {
+    std::this_thread::sleep_for(std::chrono::milliseconds(5));
+    EXPECT_OUTCOME_TRUE(key, pool.take(CurveType::P256));
+    EXPECT_NE(key.public_key, first.public_key);
+  }
+  EXPECT_GT(pool.stats().hits, 0);
+}
+
+/**
+ * @given ephemeral key pool of two keys
+ * @when X25519 keys are taken, before and after background generation
+ * @then the first key is a miss, the pool serves the later ones @and each
+ * public key belongs to its private key
+ */
+TEST(EphemeralKeyPoolTest, RefillsX25519InBackground) {
+  using libp2p::crypto::EphemeralKeyPool;
+  using libp2p::crypto::X25519KeyPair;
+  auto check_public = [](const X25519KeyPair &keys) {
+    std::unique_ptr<EVP_PKEY, void (*)(EVP_PKEY *)> pkey{
+        EVP_PKEY_new_raw_private_key(EVP_PKEY_X25519, nullptr,
+                                     keys.private_key.data(),
+                                     keys.private_key.size()),
+        EVP_PKEY_free};
+    ASSERT_NE(pkey, nullptr);
+    std::array<uint8_t, 32> public_key{};
+    size_t len = public_key.size();
+    ASSERT_EQ(
+        EVP_PKEY_get_raw_public_key(pkey.get(), public_key.data(), &len), 1);
+    EXPECT_EQ(public_key, keys.public_key);
+  };
+
+  EphemeralKeyPool pool{2};
+  EXPECT_OUTCOME_TRUE(first, pool.takeX25519());
+  check_public(first);
+  EXPECT_EQ(pool.stats().misses, 1);
+
+  // wait for the background thread to fill the pool
+  for (size_t i = 0; i < 1000 && pool.stats().hits == 0; ++i) {
+    std::this_thread::sleep_for(std::chrono::milliseconds(5));
+    EXPECT_OUTCOME_TRUE(keys, pool.takeX25519());
+    EXPECT_NE(keys.private_key, first.private_key);
+    check_public(keys);
+  }
+  EXPECT_GT(pool.stats().hits, 0);
+}
+
+/**
+ * @given crypto provider with a metrics registry
+ * @when an ephemeral key is generated, before the pool is filled
+ * @then the miss is counted in the registry
+ */
+TEST(EphemeralKeyPoolTest, CountsInRegistry) {
+  using libp2p::crypto::common::CurveType;
+  auto registry = std::make_shared<libp2p::metrics::Registry>();
+  CryptoProviderImpl provider{std::make_shared<BoostRandomGenerator>(),
+                              std::make_shared<Ed25519ProviderImpl>(),
+                              registry};
+  EXPECT_OUTCOME_TRUE_1(provider.generateEphemeralKeyPair(CurveType::P256));
+
+  auto misses =
+      registry->counter("libp2p_ephemeral_key_pool_misses_total", "");
+  auto hits = registry->counter("libp2p_ephemeral_key_pool_hits_total", "");
+  EXPECT_EQ(misses->value(), 1);
+  EXPECT_EQ(hits->value(), 0);
+  EXPECT_EQ(provider.ephemeralKeyPoolStats().misses, misses->value());
+}
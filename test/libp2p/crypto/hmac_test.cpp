@@ -4,6 +4,7 @@
  */
 
 #include <libp2p/crypto/hmac_provider/hmac_provider_impl.hpp>
+#include <libp2p/crypto/hmac_provider/hmac_stream.hpp>
 
 #include <gtest/gtest.h>
 #include <libp2p/common/literals.hpp>
@@ -101,3 +102,22 @@ TEST_F(HmacTest, HashInvalidFails) {
   ASSERT_EQ(digest.error().value(),
             static_cast<int>(HmacProviderError::UNSUPPORTED_HASH_METHOD));
 }
+
+/**
+ * @given HMAC stream with 32 bytes key
+ * @when two messages are digested in parts, one after another
+ * @then each digest matches the one of the provider
+ */
+TEST_F(HmacTest, StreamSha256) {
+  auto stream =
+      hmac::HmacStream::create(common::HashType::SHA256, sha256_key).value();
+  ASSERT_EQ(stream.digestSize(), 32);
+  auto half = message.size() / 2;
+  for (auto i = 0; i < 2; ++i) {
+    ByteArray digest(stream.digestSize());
+    ASSERT_TRUE(stream.update(gsl::make_span(message).first(half)));
+    ASSERT_TRUE(stream.update(gsl::make_span(message).subspan(half)));
+    ASSERT_TRUE(stream.finish(digest));
+    ASSERT_EQ(digest, sha256_dgst);
+  }
+}
@@ -0,0 +1,80 @@
+/**
+ * Copyright Soramitsu Co., Ltd. All Rights Reserved.
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <libp2p/crypto/sha/sha256.hpp>
+#include <libp2p/crypto/sha/sha512.hpp>
+
+#include <gtest/gtest.h>
+#include <libp2p/common/literals.hpp>
+
+using libp2p::common::ByteArray;
+using libp2p::common::Hash256;
+using libp2p::crypto::Sha256;
+using libp2p::crypto::Sha512;
+using libp2p::crypto::sha256;
+using libp2p::crypto::sha256Batch;
+using libp2p::crypto::sha512;
+using libp2p::common::operator""_unhex;
+using libp2p::common::operator""_v;
+
+namespace {
+  template <typename Hash>
+  ByteArray bytes(const Hash &hash) {
+    return {hash.begin(), hash.end()};
+  }
+
+  const ByteArray kAbcSha256 =
+      "ba7816bf8f01cfea414140de5dae2223b00361a396177a9cb410ff61f20015ad"_unhex;
+  const ByteArray kAbcSha512 =
+      "ddaf35a193617abacc417349ae20413112e6fa4e89a97ea20a9eeee64b55d39a"
+      "2192992a274fc1a836ba3c23a3feebbd454d4423643ce80e2a9ac94fa54ca49f"_unhex;
+  const ByteArray kEmptySha256 =
+      "e3b0c44298fc1c149afbf4c8996fb92427ae41e4649b934ca495991b7852b855"_unhex;
+}  // namespace
+
+/**
+ * @given "abc" as a string and as bytes
+ * @when it is hashed in one shot
+ * @then the digests are the FIPS 180-2 ones
+ */
+TEST(ShaTest, OneShot) {
+  EXPECT_EQ(bytes(sha256(std::string_view{"abc"})), kAbcSha256);
+  EXPECT_EQ(bytes(sha256("abc"_v)), kAbcSha256);
+  EXPECT_EQ(bytes(sha512(std::string_view{"abc"})), kAbcSha512);
+  EXPECT_EQ(bytes(sha512("abc"_v)), kAbcSha512);
+}
+
+/**
+ * @given streaming hashers
+ * @when a message is added in parts, and then the next message is hashed
+ * @then both digests are the same as in one shot
+ */
+TEST(ShaTest, Streaming) {
+  Sha256 sha256_hasher;
+  sha256_hasher.update("a"_v).update(std::string_view{"bc"});
+  EXPECT_EQ(bytes(sha256_hasher.digest()), kAbcSha256);
+  EXPECT_EQ(bytes(sha256_hasher.digest()), kEmptySha256);
+
+  Sha512 sha512_hasher;
+  sha512_hasher.update(std::string_view{"ab"}).update("c"_v);
+  EXPECT_EQ(bytes(sha512_hasher.digest()), kAbcSha512);
+  sha512_hasher.update(std::string_view{"abc"});
+  EXPECT_EQ(bytes(sha512_hasher.digest()), kAbcSha512);
+}
+
+/**
+ * @given several inputs
+ * @when they are hashed as a batch
+ * @then each digest is the same as in one shot
+ */
+TEST(ShaTest, Batch) {
+  std::vector<ByteArray> inputs{"abc"_v, {}, ByteArray(1000, 7)};
+  std::vector<gsl::span<const uint8_t>> spans{inputs.begin(), inputs.end()};
+  std::vector<Hash256> out(inputs.size());
+  sha256Batch(spans, out);
+  EXPECT_EQ(bytes(out[0]), kAbcSha256);
+  EXPECT_EQ(bytes(out[1]), kEmptySha256);
+  EXPECT_EQ(out[2], sha256(inputs[2]));
+}
@@ -0,0 +1,120 @@
+/**
+ * Copyright Soramitsu Co., Ltd. All Rights Reserved.
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <libp2p/host/basic_host/connection_prewarmer.hpp>
+
+#include <gtest/gtest.h>
+#include "mock/libp2p/connection/capable_connection_mock.hpp"
+#include "mock/libp2p/network/connection_manager_mock.hpp"
+#include "mock/libp2p/network/dialer_mock.hpp"
+#include "mock/libp2p/network/network_mock.hpp"
+#include "testutil/libp2p/peer.hpp"
+
+using namespace libp2p;
+using namespace host;
+using namespace network;
+using std::chrono_literals::operator""ms;
+
+using ::testing::_;
+using ::testing::Field;
+using ::testing::NiceMock;
+using ::testing::Return;
+using ::testing::ReturnRef;
+
+class ConnectionPrewarmerTest : public ::testing::Test {
+ public:
+  void SetUp() override {
+    for (int i = 0; i < 3; ++i) {
+      peers.push_back({testutil::randomPeerId(), {}});
+    }
+    ON_CALL(network, getDialer()).WillByDefault(ReturnRef(dialer));
+    ON_CALL(network, getConnectionManager()).WillByDefault(ReturnRef(cmgr));
+    ON_CALL(*conn, isClosed()).WillByDefault(Return(false));
+  }
+
+  auto makePrewarmer(size_t connections) {
+    return std::make_shared<ConnectionPrewarmer>(network, context, peers,
+                                                 connections, 10ms);
+  }
+
+  /// make the peer look connected
+  void connected(const peer::PeerInfo &peer) {
+    ON_CALL(cmgr, getBestConnectionForPeer(peer.id))
+        .WillByDefault(Return(conn));
+  }
+
+  std::shared_ptr<boost::asio::io_context> context =
+      std::make_shared<boost::asio::io_context>();
+  NiceMock<NetworkMock> network;
+  NiceMock<DialerMock> dialer;
+  NiceMock<ConnectionManagerMock> cmgr;
+  std::shared_ptr<NiceMock<connection::CapableConnectionMock>> conn =
+      std::make_shared<NiceMock<connection::CapableConnectionMock>>();
+  std::vector<peer::PeerInfo> peers;
+};
+
+/**
+ * @given 3 peers, none of them is connected
+ * @when prewarmer, which keeps 2 connections, starts
+ * @then the first 2 peers are dialed
+ */
+TEST_F(ConnectionPrewarmerTest, DialsFirstPeers) {
+  EXPECT_CALL(dialer, dial(Field(&peer::PeerInfo::id, peers[0].id), _));
+  EXPECT_CALL(dialer, dial(Field(&peer::PeerInfo::id, peers[1].id), _));
+  EXPECT_CALL(dialer, dial(Field(&peer::PeerInfo::id, peers[2].id), _))
+      .Times(0);
+
+  makePrewarmer(2)->start();
+}
+
+/**
+ * @given 3 peers, the first one is connected
+ * @when prewarmer, which keeps 1 connection, starts @and the connection is
+ * closed later
+ * @then nothing is dialed at first @and the peer is redialed after the
+ * connection is closed
+ */
+TEST_F(ConnectionPrewarmerTest, ReplacesClosedConnection) {
+  connected(peers[0]);
+  auto prewarmer = makePrewarmer(1);
+
+  EXPECT_CALL(dialer, dial(_, _)).Times(0);
+  prewarmer->start();
+  context->run_for(25ms);
+  EXPECT_EQ(prewarmer->warmConnections(), 1);
+  ::testing::Mock::VerifyAndClearExpectations(&dialer);
+
+  ON_CALL(*conn, isClosed()).WillByDefault(Return(true));
+  EXPECT_CALL(dialer, dial(Field(&peer::PeerInfo::id, peers[0].id), _))
+      .WillOnce([this](auto &&, auto &&cb) {
+        ON_CALL(*conn, isClosed()).WillByDefault(Return(false));
+        cb(conn);
+      });
+  context->restart();
+  context->run_for(25ms);
+  EXPECT_EQ(prewarmer->warmConnections(), 1);
+}
+
+/**
+ * @given 3 peers, the first one of which is unreachable
+ * @when prewarmer, which keeps 1 connection, starts
+ * @then after the first peer fails, the second one is dialed
+ */
+TEST_F(ConnectionPrewarmerTest, SkipsFailedPeer) {
+  EXPECT_CALL(dialer, dial(Field(&peer::PeerInfo::id, peers[0].id), _))
+      .WillOnce([](auto &&, auto &&cb) {
+        cb(std::make_error_code(std::errc::connection_refused));
+      });
+  EXPECT_CALL(dialer, dial(Field(&peer::PeerInfo::id, peers[1].id), _))
+      .WillOnce([this](auto &&, auto &&cb) {
+        connected(peers[1]);
+        cb(conn);
+      });
+
+  auto prewarmer = makePrewarmer(1);
+  prewarmer->start();
+  context->run_for(25ms);
+  EXPECT_EQ(prewarmer->warmConnections(), 1);
+}
@@ -0,0 +1,90 @@
+/**
+ * Copyright Soramitsu Co., Ltd. All Rights Reserved.
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <libp2p/host/basic_host/maintenance_scheduler.hpp>
+
+#include <gtest/gtest.h>
+
+using libp2p::host::MaintenanceScheduler;
+using std::chrono_literals::operator""ms;
+using std::chrono_literals::operator""us;
+
+/// component, a pass over which takes the given number of steps
+struct StepCounter : public libp2p::basic::GarbageCollectable {
+  explicit StepCounter(size_t steps_per_pass)
+      : steps_per_pass{steps_per_pass} {}
+
+  void collectGarbage() override {
+    ++passes;
+  }
+
+  bool collectGarbageStep(size_t max_entries) override {
+    EXPECT_EQ(max_entries, 8);
+    if (++steps % steps_per_pass == 0) {
+      ++passes;
+      return true;
+    }
+    return false;
+  }
+
+  size_t steps_per_pass;
+  size_t steps = 0;
+  size_t passes = 0;
+};
+
+class MaintenanceSchedulerTest : public ::testing::Test {
+ public:
+  std::shared_ptr<boost::asio::io_context> context =
+      std::make_shared<boost::asio::io_context>();
+  StepCounter small{1};
+  StepCounter large{3};
+};
+
+/**
+ * @given scheduler with zero time slice, and components of 1 and 3 steps
+ * @when slices are run
+ * @then one step is made per slice, in turns, until both passes complete
+ */
+TEST_F(MaintenanceSchedulerTest, StepPerSlice) {
+  auto scheduler =
+      std::make_shared<MaintenanceScheduler>(context, 10ms, 0us, 8);
+  scheduler->add(small);
+  scheduler->add(large);
+
+  EXPECT_FALSE(scheduler->runSlice());
+  EXPECT_EQ(small.steps, 1);
+  EXPECT_EQ(large.steps, 0);
+
+  EXPECT_FALSE(scheduler->runSlice());
+  EXPECT_FALSE(scheduler->runSlice());
+  EXPECT_TRUE(scheduler->runSlice());
+  EXPECT_EQ(small.passes, 1);
+  EXPECT_EQ(large.passes, 1);
+  EXPECT_EQ(large.steps, 3);
+}
+
+/**
+ * @given started scheduler with an interval of 10 ms
+ * @when the io context runs for several intervals
+ * @then each component completes a pass per interval, and stops after stop()
+ */
+TEST_F(MaintenanceSchedulerTest, PassPerInterval) {
+  auto scheduler =
+      std::make_shared<MaintenanceScheduler>(context, 10ms, 1000us, 8);
+  scheduler->add(small);
+  scheduler->add(large);
+  scheduler->start();
+
+  context->run_for(55ms);
+  EXPECT_GE(small.passes, 3);
+  EXPECT_LE(small.passes, 5);
+  EXPECT_EQ(large.passes, small.passes);
+
+  scheduler->stop();
+  auto passes = small.passes;
+  context->restart();
+  context->run_for(30ms);
+  EXPECT_EQ(small.passes, passes);
+}
@@ -0,0 +1,136 @@
+/**
+ * Copyright Soramitsu Co., Ltd. All Rights Reserved.
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <libp2p/host/basic_host/stream_pool.hpp>
+
+#include <gtest/gtest.h>
+#include "mock/libp2p/connection/stream_mock.hpp"
+#include "mock/libp2p/network/dialer_mock.hpp"
+#include "mock/libp2p/network/network_mock.hpp"
+#include "testutil/libp2p/peer.hpp"
+
+using namespace libp2p;
+using namespace host;
+using namespace network;
+using connection::Stream;
+using connection::StreamMock;
+using std::chrono_literals::operator""ms;
+
+using ::testing::_;
+using ::testing::InvokeArgument;
+using ::testing::NiceMock;
+using ::testing::Return;
+using ::testing::ReturnRef;
+
+class StreamPoolTest : public ::testing::Test {
+ public:
+  void SetUp() override {
+    ON_CALL(network, getDialer()).WillByDefault(ReturnRef(dialer));
+  }
+
+  /// make a stream to the peer, which is open in both directions
+  std::shared_ptr<NiceMock<StreamMock>> makeStream() {
+    auto stream = std::make_shared<NiceMock<StreamMock>>();
+    ON_CALL(*stream, remotePeerId()).WillByDefault(ReturnRef(peer.id));
+    ON_CALL(*stream, isClosedForRead()).WillByDefault(Return(false));
+    ON_CALL(*stream, isClosedForWrite()).WillByDefault(Return(false));
+    return stream;
+  }
+
+  /// @return the stream, which the pool has handed out
+  std::shared_ptr<Stream> acquire(StreamPool &pool,
+                                  const peer::Protocol &protocol) {
+    std::shared_ptr<Stream> acquired;
+    pool.acquire(peer, protocol, [&acquired](auto &&res) {
+      ASSERT_TRUE(res);
+      acquired = res.value();
+    });
+    return acquired;
+  }
+
+  NiceMock<NetworkMock> network;
+  NiceMock<DialerMock> dialer;
+  peer::PeerInfo peer{testutil::randomPeerId(), {}};
+  const peer::Protocol protocol = "/kad/1.0.0";
+};
+
+/**
+ * @given pool without idle streams
+ * @when a stream is acquired, released @and acquired again
+ * @then a new stream is opened only once @and the same stream is handed out
+ * the second time
+ */
+TEST_F(StreamPoolTest, ReusesReleasedStream) {
+  StreamPool pool{network, 1000ms, 2};
+  std::shared_ptr<Stream> stream = makeStream();
+  EXPECT_CALL(dialer, newStream(_, protocol, _))
+      .WillOnce(InvokeArgument<2>(stream));
+
+  ASSERT_EQ(acquire(pool, protocol), stream);
+  pool.release(protocol, stream);
+  EXPECT_EQ(pool.idleStreams(), 1);
+
+  ASSERT_EQ(acquire(pool, protocol), stream);
+  EXPECT_EQ(pool.idleStreams(), 0);
+}
+
+/**
+ * @given pool with idle streams of two protocols, the latest of which has
+ * been closed by the other side
+ * @when streams of a third protocol @and of the closed one's protocol are
+ * acquired
+ * @then a new stream is opened for the former @and an open idle stream is
+ * handed out for the latter
+ */
+TEST_F(StreamPoolTest, OpensStreamIfNoneIsUsable) {
+  StreamPool pool{network, 1000ms, 3};
+  auto closed = makeStream();
+  pool.release("/other/1.0.0", makeStream());
+  pool.release(protocol, makeStream());
+  pool.release(protocol, closed);
+  ON_CALL(*closed, isClosedForRead()).WillByDefault(Return(true));
+
+  std::shared_ptr<Stream> fresh = makeStream();
+  EXPECT_CALL(dialer, newStream(_, "/third/1.0.0", _))
+      .WillOnce(InvokeArgument<2>(fresh));
+  EXPECT_EQ(acquire(pool, "/third/1.0.0"), fresh);
+
+  // the closed stream is the most recent one, but it is skipped
+  EXPECT_CALL(dialer, newStream(_, protocol, _)).Times(0);
+  auto reused = acquire(pool, protocol);
+  EXPECT_NE(reused, nullptr);
+  EXPECT_NE(reused, closed);
+}
+
+/**
+ * @given pool, which keeps 2 idle streams per peer
+ * @when 3 streams to the peer are released
+ * @then the least recently released one is closed
+ */
+TEST_F(StreamPoolTest, CapsIdleStreamsPerPeer) {
+  StreamPool pool{network, 1000ms, 2};
+  auto oldest = makeStream();
+  EXPECT_CALL(*oldest, close(_));
+
+  pool.release(protocol, oldest);
+  pool.release(protocol, makeStream());
+  pool.release(protocol, makeStream());
+  EXPECT_EQ(pool.idleStreams(), 2);
+}
+
+/**
+ * @given pool with an idle stream, which has expired
+ * @when garbage is collected
+ * @then the stream is closed @and forgotten
+ */
+TEST_F(StreamPoolTest, ClosesExpiredStreams) {
+  StreamPool pool{network, 0ms, 2};
+  auto stream = makeStream();
+  EXPECT_CALL(*stream, close(_));
+
+  pool.release(protocol, stream);
+  pool.collectGarbage();
+  EXPECT_EQ(pool.idleStreams(), 0);
+}
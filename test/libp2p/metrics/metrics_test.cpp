@@ -0,0 +1,82 @@
+/**
+ * Copyright Soramitsu Co., Ltd. All Rights Reserved.
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include "libp2p/metrics/registry.hpp"
+
+#include <gtest/gtest.h>
+
+using namespace libp2p::metrics;
+
+/**
+ * @given values from the whole range
+ * @when their buckets are found
+ * @then each value is within its bucket @and the bucket is not wider than
+ * the allowed relative error
+ */
+TEST(HistogramTest, Buckets) {
+  for (uint64_t value : {0ull, 1ull, 7ull, 8ull, 9ull, 15ull, 16ull, 17ull,
+                         1000ull, 123456789ull, ~0ull}) {
+    auto index = Histogram::bucketIndex(value);
+    ASSERT_LT(index, Histogram::kBuckets);
+    auto upper = Histogram::bucketUpperBound(index);
+    EXPECT_GE(upper, value);
+    auto lower = index == 0 ? 0 : Histogram::bucketUpperBound(index - 1) + 1;
+    EXPECT_LE(lower, value);
+    EXPECT_LE(upper - lower, value / Histogram::kSubBuckets);
+  }
+  EXPECT_EQ(Histogram::bucketIndex(~0ull), Histogram::kBuckets - 1);
+  EXPECT_EQ(Histogram::bucketUpperBound(Histogram::kBuckets - 1), ~0ull);
+}
+
+/**
+ * @given histogram with a hundred of values
+ * @when the quantiles are estimated
+ * @then they are within the error of the real ones
+ */
+TEST(HistogramTest, Quantiles) {
+  Histogram histogram;
+  EXPECT_EQ(histogram.quantile(0.5), 0);
+
+  for (uint64_t value = 1; value <= 100; ++value) {
+    histogram.record(value * 1000);
+  }
+  EXPECT_EQ(histogram.count(), 100);
+  EXPECT_EQ(histogram.sum(), 5050 * 1000);
+
+  for (auto [q, expected] : {std::pair{0.5, 50000}, std::pair{0.99, 99000}}) {
+    auto estimate = histogram.quantile(q);
+    EXPECT_GE(estimate, expected);
+    EXPECT_LE(estimate, expected + expected / Histogram::kSubBuckets);
+  }
+  EXPECT_GE(histogram.quantile(1), 100000);
+}
+
+/**
+ * @given registry
+ * @when metrics are requested by the same and by the different labels
+ * @then the same labels give the same metric @and a name of another type
+ * gives a metric, which is not collected
+ */
+TEST(RegistryTest, Families) {
+  Registry registry;
+  auto in = registry.counter("bytes", "help", {{"direction", "in"}});
+  auto out = registry.counter("bytes", "other help", {{"direction", "out"}});
+  EXPECT_EQ(registry.counter("bytes", "", {{"direction", "in"}}), in);
+  EXPECT_NE(in, out);
+  in->inc(5);
+
+  auto orphan = registry.gauge("bytes", "help");
+  orphan->set(1);
+  registry.histogram("latency", "help")->record(1);
+
+  auto families = registry.collect();
+  ASSERT_EQ(families.size(), 2);
+  EXPECT_EQ(families[0].name, "bytes");
+  EXPECT_EQ(families[0].help, "help");
+  EXPECT_EQ(families[0].type, MetricType::COUNTER);
+  EXPECT_EQ(families[0].metrics.size(), 2);
+  EXPECT_EQ(families[1].name, "latency");
+  EXPECT_EQ(families[1].type, MetricType::HISTOGRAM);
+}
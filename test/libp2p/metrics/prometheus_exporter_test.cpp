@@ -0,0 +1,92 @@
+/**
+ * Copyright Soramitsu Co., Ltd. All Rights Reserved.
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include "libp2p/metrics/prometheus_exporter.hpp"
+
+#include <boost/asio/read.hpp>
+#include <boost/asio/write.hpp>
+#include <gtest/gtest.h>
+#include "testutil/outcome.hpp"
+
+using namespace libp2p::metrics;
+using std::chrono_literals::operator""ms;
+
+struct PrometheusExporterTest : public ::testing::Test {
+  void SetUp() override {
+    registry->counter("libp2p_bytes_total", "Bytes\nsent",
+                      {{"muxer", "yamux"}, {"direction", "out"}})
+        ->inc(42);
+    registry->gauge("libp2p_streams", "Open streams")->set(-1);
+    auto histogram = registry->histogram("libp2p_latency", "Latency",
+                                         {{"path", "a\"b"}});
+    histogram->record(3);
+    histogram->record(3);
+    histogram->record(100);
+  }
+
+  std::shared_ptr<Registry> registry = std::make_shared<Registry>();
+};
+
+/**
+ * @given registry with metrics of each type
+ * @when it is formatted
+ * @then the text follows the Prometheus exposition format
+ */
+TEST_F(PrometheusExporterTest, Format) {
+  auto text = PrometheusExporter::format(registry->collect());
+  EXPECT_EQ(text,
+            "# HELP libp2p_bytes_total Bytes\\nsent\n"
+            "# TYPE libp2p_bytes_total counter\n"
+            "libp2p_bytes_total{direction=\"out\",muxer=\"yamux\"} 42\n"
+            "# HELP libp2p_latency Latency\n"
+            "# TYPE libp2p_latency histogram\n"
+            "libp2p_latency_bucket{path=\"a\\\"b\",le=\"3\"} 2\n"
+            "libp2p_latency_bucket{path=\"a\\\"b\",le=\"103\"} 3\n"
+            "libp2p_latency_bucket{path=\"a\\\"b\",le=\"+Inf\"} 3\n"
+            "libp2p_latency_sum{path=\"a\\\"b\"} 106\n"
+            "libp2p_latency_count{path=\"a\\\"b\"} 3\n"
+            "# HELP libp2p_streams Open streams\n"
+            "# TYPE libp2p_streams gauge\n"
+            "libp2p_streams -1\n");
+}
+
+/**
+ * @given exporter, listening to a local port
+ * @when the metrics and an unknown path are requested over HTTP
+ * @then the metrics are returned @and the unknown path is not found
+ */
+TEST_F(PrometheusExporterTest, Serve) {
+  using boost::asio::ip::tcp;
+  boost::asio::io_context context;
+  auto exporter = std::make_shared<PrometheusExporter>(context, registry);
+  EXPECT_OUTCOME_TRUE_1(exporter->listen(
+      {boost::asio::ip::make_address("127.0.0.1"), 0}));
+  EXPECT_OUTCOME_TRUE(endpoint, exporter->localEndpoint());
+
+  auto get = [&](const std::string &target) {
+    tcp::socket client{context};
+    client.connect(endpoint);
+    auto request = "GET " + target + " HTTP/1.1\r\nHost: localhost\r\n\r\n";
+    boost::asio::write(client, boost::asio::buffer(request));
+
+    std::string response;
+    boost::asio::async_read(client, boost::asio::dynamic_buffer(response),
+                            [](const auto &, size_t) {});
+    context.restart();
+    context.run_for(100ms);
+    return response;
+  };
+
+  auto metrics = get("/metrics");
+  EXPECT_EQ(metrics.rfind("HTTP/1.1 200 OK\r\n", 0), 0);
+  EXPECT_NE(
+      metrics.find("libp2p_bytes_total{direction=\"out\",muxer=\"yamux\"} 42"),
+      std::string::npos);
+
+  auto unknown = get("/unknown");
+  EXPECT_EQ(unknown.rfind("HTTP/1.1 404 Not Found\r\n", 0), 0);
+
+  exporter->close();
+}
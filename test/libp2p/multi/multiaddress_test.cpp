@@ -255,3 +255,19 @@ TEST_F(MultiaddressTest, DnsAndIpfs) {
   ASSERT_EQ(address.getStringAddress(), addr);
 
 }
+
+/**
+ * @given a multiaddr of a unix socket, whose path contains slashes
+ * @when converting it to bytes and back
+ * @then the same address with the whole path is got
+ */
+TEST_F(MultiaddressTest, UnixPath) {
+  auto addr = "/unix/tmp/libp2p/node.sock"s;
+  EXPECT_OUTCOME_TRUE(address, Multiaddress::create(addr));
+  ASSERT_EQ(address.getProtocolsWithValues().at(0).second,
+            "tmp/libp2p/node.sock");
+
+  EXPECT_OUTCOME_TRUE(from_bytes,
+                      Multiaddress::create(address.getBytesAddress()));
+  ASSERT_EQ(from_bytes.getStringAddress(), addr);
+}
@@ -86,6 +86,22 @@ TEST(AddressConverter, UdpAddressToBytes) {
   ASSERT_FALSE(addressToHex(*p, " 34343 "));
 }
 
+/**
+ * @given A string with a memory address (an in-process listener id)
+ * @when converting it to bytes representation
+ * @then if the address was valid then valid byte sequence representing the
+ * address is returned
+ */
+TEST(AddressConverter, MemoryAddressToBytes) {
+  auto p = ProtocolList::get(libp2p::multi::Protocol::Code::MEMORY);
+  ASSERT_EQ("00000000000004D2", addressToHex(*p, "1234").value());
+  ASSERT_EQ("FFFFFFFFFFFFFFFF",
+            addressToHex(*p, "18446744073709551615").value());
+  ASSERT_FALSE(addressToHex(*p, "18446744073709551616"));
+  ASSERT_FALSE(addressToHex(*p, "12ab"));
+  ASSERT_FALSE(addressToHex(*p, ""));
+}
+
 /**
  * @given A string with an ipfs address (base58 encoded)
  * @when converting it to bytes representation
@@ -0,0 +1,93 @@
+/**
+ * Copyright Soramitsu Co., Ltd. All Rights Reserved.
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include "libp2p/network/impl/blocklist_gater.hpp"
+
+#include <gtest/gtest.h>
+#include <libp2p/common/literals.hpp>
+#include "mock/libp2p/connection/capable_connection_mock.hpp"
+
+using namespace libp2p;
+using namespace network;
+using namespace common;
+
+using boost::asio::ip::make_address;
+using testing::ReturnRef;
+
+/**
+ * @given trie with nested IPv4 subnets
+ * @when addresses are looked up @and the subnets are removed one by one
+ * @then an address is contained, while any subnet around it is left
+ */
+TEST(CidrTrieTest, NestedV4) {
+  CidrTrie trie;
+  EXPECT_TRUE(trie.empty());
+  EXPECT_FALSE(trie.contains(make_address("10.1.2.3")));
+
+  ASSERT_TRUE(trie.insert(make_address("10.0.0.0"), 8));
+  ASSERT_TRUE(trie.insert(make_address("10.1.0.0"), 16));
+  EXPECT_TRUE(trie.contains(make_address("10.1.2.3")));
+  EXPECT_TRUE(trie.contains(make_address("10.255.0.1")));
+  EXPECT_FALSE(trie.contains(make_address("11.0.0.1")));
+
+  EXPECT_TRUE(trie.erase(make_address("10.0.0.0"), 8));
+  EXPECT_FALSE(trie.erase(make_address("10.0.0.0"), 8));
+  EXPECT_TRUE(trie.contains(make_address("10.1.2.3")));
+  EXPECT_FALSE(trie.contains(make_address("10.255.0.1")));
+
+  EXPECT_TRUE(trie.erase(make_address("10.1.255.255"), 16));
+  EXPECT_FALSE(trie.contains(make_address("10.1.2.3")));
+  EXPECT_TRUE(trie.empty());
+}
+
+/**
+ * @given trie with an IPv6 subnet and a single IPv4 address
+ * @when addresses of both families are looked up
+ * @then the families do not overlap @and an invalid prefix is rejected
+ */
+TEST(CidrTrieTest, V6AndInvalidPrefix) {
+  CidrTrie trie;
+  ASSERT_TRUE(trie.insert(make_address("2001:db8::"), 32));
+  ASSERT_TRUE(trie.insert(make_address("192.168.0.1"), 32));
+  EXPECT_TRUE(trie.contains(make_address("2001:db8:1::1")));
+  EXPECT_FALSE(trie.contains(make_address("2001:db9::1")));
+  EXPECT_TRUE(trie.contains(make_address("192.168.0.1")));
+  EXPECT_FALSE(trie.contains(make_address("192.168.0.2")));
+
+  EXPECT_FALSE(trie.insert(make_address("192.168.0.0"), 33));
+  EXPECT_FALSE(trie.insert(make_address("::"), 129));
+
+  ASSERT_TRUE(trie.insert(make_address("::"), 0));
+  EXPECT_TRUE(trie.contains(make_address("fe80::1")));
+}
+
+/**
+ * @given gater with a blocked subnet and a blocked peer
+ * @when connections are intercepted
+ * @then the ones from the subnet or of the peer are rejected until they are
+ * unblocked
+ */
+TEST(BlocklistGaterTest, SubnetsAndPeers) {
+  BlocklistGater gater;
+  auto blocked = "1"_peerid;
+  auto allowed = "2"_peerid;
+
+  ASSERT_TRUE(gater.blockSubnet(make_address("127.0.0.0"), 8));
+  EXPECT_FALSE(gater.interceptAccept(make_address("127.0.0.1")));
+  EXPECT_TRUE(gater.interceptAccept(make_address("128.0.0.1")));
+
+  gater.blockPeer(blocked);
+  EXPECT_FALSE(gater.interceptSecured(blocked));
+  EXPECT_TRUE(gater.interceptSecured(allowed));
+
+  connection::CapableConnectionMock conn;
+  EXPECT_CALL(conn, remotePeer()).WillRepeatedly(ReturnRef(blocked));
+  EXPECT_FALSE(gater.interceptUpgraded(conn));
+
+  ASSERT_TRUE(gater.unblockSubnet(make_address("127.0.0.0"), 8));
+  gater.unblockPeer(blocked);
+  EXPECT_TRUE(gater.interceptAccept(make_address("127.0.0.1")));
+  EXPECT_TRUE(gater.interceptUpgraded(conn));
+}
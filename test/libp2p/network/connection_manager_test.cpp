@@ -3,13 +3,17 @@
  * SPDX-License-Identifier: Apache-2.0
  */
 
+#include <array>
+
 #include <gtest/gtest.h>
 
 #include <libp2p/common/literals.hpp>
 #include "libp2p/network/connection_manager.hpp"
 #include "libp2p/network/impl/connection_manager_impl.hpp"
+#include "libp2p/network/impl/peer_scorer_impl.hpp"
 #include "libp2p/peer/errors.hpp"
 #include "libp2p/peer/peer_id.hpp"
+#include "libp2p/network/routing_events.hpp"
 #include "mock/libp2p/connection/capable_connection_mock.hpp"
 #include "mock/libp2p/network/transport_manager_mock.hpp"
 #include "mock/libp2p/transport/transport_mock.hpp"
@@ -25,6 +29,7 @@ using namespace common;
 using testing::_;
 using testing::NiceMock;
 using testing::Return;
+using std::chrono_literals::operator""h;
 using C = ConnectionManager::Connectedness;
 
 struct ConnectionManagerTest : public ::testing::Test {
@@ -35,7 +40,12 @@ struct ConnectionManagerTest : public ::testing::Test {
 
     tmgr = std::make_shared<TransportManagerMock>();
 
-    cmgr = std::make_shared<ConnectionManagerImpl>(bus, tmgr);
+    context = std::make_shared<boost::asio::io_context>();
+
+    scorer = std::make_shared<PeerScorerImpl>(bus);
+
+    cmgr = std::make_shared<ConnectionManagerImpl>(bus, tmgr, context, scorer,
+                                                   ConnectionManagerConfig{});
 
     conn = std::make_shared<CapableConnectionMock>();
 
@@ -48,6 +58,8 @@ struct ConnectionManagerTest : public ::testing::Test {
   std::shared_ptr<libp2p::event::Bus> bus;
   std::shared_ptr<TransportManagerMock> tmgr;
   std::shared_ptr<TransportMock> t;
+  std::shared_ptr<boost::asio::io_context> context;
+  std::shared_ptr<PeerScorerImpl> scorer;
 
   std::shared_ptr<ConnectionManager> cmgr;
 
@@ -58,6 +70,36 @@ struct ConnectionManagerTest : public ::testing::Test {
   std::shared_ptr<CapableConnectionMock> conn;
 };
 
+/// connection manager, which trims down to 2 connections after 3
+struct ConnectionManagerTrimTest : public ConnectionManagerTest {
+  void SetUp() override {
+    ConnectionManagerTest::SetUp();
+    for (size_t i = 0; i < peers.size(); ++i) {
+      peers[i] = testutil::randomPeerId();
+      conns[i] = std::make_shared<NiceMock<CapableConnectionMock>>();
+      ON_CALL(*conns[i], isClosed()).WillByDefault(Return(false));
+      ON_CALL(*conns[i], streamsCount()).WillByDefault(Return(i));
+    }
+  }
+
+  std::shared_ptr<ConnectionManager> makeTrimming(
+      std::chrono::milliseconds grace_period) {
+    return std::make_shared<ConnectionManagerImpl>(
+        bus, tmgr, context, scorer,
+        ConnectionManagerConfig{3, 2, grace_period, {}});
+  }
+
+  void connectAll(ConnectionManager &manager) {
+    for (size_t i = 0; i < peers.size(); ++i) {
+      manager.addConnectionToPeer(peers[i], conns[i]);
+    }
+  }
+
+  /// peers, connections to which have as many streams, as their indices
+  std::array<PeerId, 4> peers{p1, p1, p1, p1};
+  std::array<std::shared_ptr<NiceMock<CapableConnectionMock>>, 4> conns;
+};
+
 /**
  * @given 3 peers. p1 has 2 conns, p2 has 1, p3 has 0
  * @when get all connections
@@ -94,6 +136,31 @@ TEST_F(ConnectionManagerTest, GetBestConn) {
   ASSERT_NE(c, nullptr);
 }
 
+/**
+ * @given peer with a closed connection and two open ones, the first of which
+ * has more streams
+ * @when get best connection, before and after RTTs are reported
+ * @then the least loaded open connection is selected, and then, when loads
+ * are equal, the fastest one
+ */
+TEST_F(ConnectionManagerTest, BestConnRanking) {
+  auto closed = std::make_shared<NiceMock<CapableConnectionMock>>();
+  auto busy = std::make_shared<NiceMock<CapableConnectionMock>>();
+  auto idle = std::make_shared<NiceMock<CapableConnectionMock>>();
+  ON_CALL(*closed, isClosed()).WillByDefault(Return(true));
+  ON_CALL(*busy, streamsCount()).WillByDefault(Return(2));
+  for (auto &c : {closed, busy, idle}) {
+    ON_CALL(*c, remotePeer()).WillByDefault(testing::ReturnRef(p3));
+    cmgr->addConnectionToPeer(p3, c);
+  }
+  EXPECT_EQ(cmgr->getBestConnectionForPeer(p3), idle);
+
+  ON_CALL(*busy, streamsCount()).WillByDefault(Return(0));
+  cmgr->reportRtt(idle, std::chrono::milliseconds(100));
+  cmgr->reportRtt(busy, std::chrono::milliseconds(10));
+  EXPECT_EQ(cmgr->getBestConnectionForPeer(p3), busy);
+}
+
 /**
  * @given Peer with 2 valid connections
  * @when get its connections
@@ -186,3 +253,100 @@ TEST_F(ConnectionManagerTest, GarbageCollection) {
   ASSERT_EQ(cmgr->getConnectionsToPeer(p2).size(), 0);
   ASSERT_EQ(cmgr->getConnectionsToPeer(p3).size(), 0);
 }
+
+/**
+ * @given connection manager with watermarks 3 and 2, and 4 connected peers,
+ * the least active of which is protected
+ * @when the background trim is run
+ * @then connections of the two least active unprotected peers are closed
+ */
+TEST_F(ConnectionManagerTrimTest, TrimLowestScored) {
+  auto manager = makeTrimming({});
+  scorer->protect(peers[0], "test");
+  connectAll(*manager);
+
+  // trim is not done by the caller, which has added the connection
+  ASSERT_EQ(manager->getConnections().size(), 4);
+
+  EXPECT_CALL(*conns[0], close()).Times(0);
+  EXPECT_CALL(*conns[1], close()).WillOnce(Return(outcome::success()));
+  EXPECT_CALL(*conns[2], close()).WillOnce(Return(outcome::success()));
+  EXPECT_CALL(*conns[3], close()).Times(0);
+  context->run();
+
+  EXPECT_EQ(manager->getConnections().size(), 2);
+  EXPECT_EQ(manager->getConnectionsToPeer(peers[0]).size(), 1);
+  EXPECT_EQ(manager->getConnectionsToPeer(peers[3]).size(), 1);
+}
+
+/**
+ * @given connection manager with watermarks 3 and 2, and 4 peers, connected
+ * within the grace period
+ * @when the background trim is run
+ * @then no connection is closed
+ */
+TEST_F(ConnectionManagerTrimTest, GracePeriod) {
+  auto manager = makeTrimming(1h);
+  connectAll(*manager);
+
+  for (auto &c : conns) {
+    EXPECT_CALL(*c, close()).Times(0);
+  }
+  context->run();
+
+  EXPECT_EQ(manager->getConnections().size(), 4);
+}
+
+/**
+ * @given peer scorer
+ * @when the peer is tagged, gets a stream, and is added to and removed from
+ * the Kademlia routing table
+ * @then its score follows all of them
+ */
+TEST_F(ConnectionManagerTest, PeerScore) {
+  std::vector<ConnectionManager::ConnectionSPtr> conns{conn};
+  EXPECT_CALL(*conn, streamsCount()).WillRepeatedly(Return(1));
+  EXPECT_EQ(scorer->score(p1, conns), PeerScorerImpl::kStreamValue);
+
+  scorer->tagPeer(p1, "a", 10);
+  scorer->tagPeer(p1, "b", 20);
+  scorer->untagPeer(p1, "a");
+  EXPECT_EQ(scorer->score(p1, conns), 20 + PeerScorerImpl::kStreamValue);
+
+  bus->getChannel<network::event::RoutingPeerAddedChannel>().publish(p1);
+  EXPECT_EQ(scorer->score(p1, {}), 20 + PeerScorerImpl::kRoutingTableValue);
+  bus->getChannel<network::event::RoutingPeerRemovedChannel>().publish(p1);
+  EXPECT_EQ(scorer->score(p1, {}), 20);
+
+  scorer->protect(p1, "a");
+  scorer->protect(p1, "b");
+  EXPECT_TRUE(scorer->unprotect(p1, "a"));
+  EXPECT_TRUE(scorer->isProtected(p1));
+  EXPECT_FALSE(scorer->unprotect(p1, "b"));
+  EXPECT_FALSE(scorer->isProtected(p1));
+}
+
+/**
+ * @given peer with two connections
+ * @when one of them publishes its termination
+ * @then it is removed at once, and the peer is removed with the last one
+ */
+TEST_F(ConnectionManagerTest, RemoveClosedConnection) {
+  auto first = std::make_shared<NiceMock<CapableConnectionMock>>();
+  auto second = std::make_shared<NiceMock<CapableConnectionMock>>();
+  for (auto &c : {first, second}) {
+    ON_CALL(*c, remotePeer()).WillByDefault(testing::ReturnRef(p3));
+    cmgr->addConnectionToPeer(p3, c);
+  }
+
+  auto &channel =
+      bus->getChannel<network::event::OnConnectionClosedChannel>();
+  channel.publish(first);
+  auto conns = cmgr->getConnectionsToPeer(p3);
+  ASSERT_EQ(conns.size(), 1);
+  EXPECT_EQ(conns[0], second);
+
+  channel.publish(second);
+  EXPECT_TRUE(cmgr->getConnectionsToPeer(p3).empty());
+  EXPECT_EQ(cmgr->getConnections().size(), 3);
+}
@@ -7,6 +7,7 @@
 
 #include <gtest/gtest.h>
 #include <libp2p/common/literals.hpp>
+#include <libp2p/network/impl/resource_manager_impl.hpp>
 #include "mock/libp2p/connection/capable_connection_mock.hpp"
 #include "mock/libp2p/connection/stream_mock.hpp"
 #include "mock/libp2p/network/connection_manager_mock.hpp"
@@ -30,6 +31,7 @@ using ::testing::ContainerEq;
 using ::testing::Contains;
 using ::testing::Eq;
 using ::testing::Return;
+using ::testing::ReturnRef;
 
 struct DialerTest : public ::testing::Test {
   std::shared_ptr<StreamMock> stream = std::make_shared<StreamMock>();
@@ -48,8 +50,14 @@ struct DialerTest : public ::testing::Test {
   std::shared_ptr<ConnectionManagerMock> cmgr =
       std::make_shared<ConnectionManagerMock>();
 
+  std::shared_ptr<libp2p::event::Bus> bus =
+      std::make_shared<libp2p::event::Bus>();
+
+  std::shared_ptr<ResourceManager> rmgr =
+      std::make_shared<ResourceManagerImpl>(bus, ResourceManagerConfig{});
+
   std::shared_ptr<Dialer> dialer =
-      std::make_shared<DialerImpl>(proto_muxer, tmgr, cmgr);
+      std::make_shared<DialerImpl>(proto_muxer, tmgr, cmgr, rmgr);
 
   multi::Multiaddress ma1 = "/ip4/127.0.0.1/tcp/1"_multiaddr;
   peer::PeerId pid = "1"_peerid;
@@ -74,6 +82,7 @@ TEST_F(DialerTest, DialNewConnection) {
   // transport->dial returns valid connection
   EXPECT_CALL(*transport, dial(pinfo.id, ma1, _))
       .WillOnce(Arg2CallbackWithArg(outcome::success(connection)));
+  EXPECT_CALL(*connection, remotePeer()).WillRepeatedly(ReturnRef(pid));
 
   // connection is stored by connection manager
   EXPECT_CALL(*cmgr, addConnectionToPeer(pinfo.id, _)).Times(1);
@@ -85,6 +94,35 @@ TEST_F(DialerTest, DialNewConnection) {
     executed = true;
   });
 
+  ASSERT_TRUE(executed);
+  EXPECT_EQ(rmgr->peerUsage(pid).connections, 1);
+}
+
+/**
+ * @given resource manager, which allows no more connections to the peer
+ * @when dial
+ * @then nothing is dialed, and the error is returned
+ */
+TEST_F(DialerTest, DialOverConnectionLimit) {
+  ResourceManagerConfig config;
+  config.peer.connections = 1;
+  auto limited_rmgr = std::make_shared<ResourceManagerImpl>(bus, config);
+  DialerImpl limited_dialer{proto_muxer, tmgr, cmgr, limited_rmgr};
+
+  EXPECT_CALL(*connection, remotePeer()).WillRepeatedly(ReturnRef(pid));
+  EXPECT_OUTCOME_TRUE_1(limited_rmgr->reserveConnection(connection));
+
+  EXPECT_CALL(*cmgr, getBestConnectionForPeer(pinfo.id))
+      .WillOnce(Return(nullptr));
+  EXPECT_CALL(*tmgr, findBest(_)).Times(0);
+
+  bool executed = false;
+  limited_dialer.dial(pinfo, [&](auto &&rconn) {
+    EXPECT_OUTCOME_FALSE(e, rconn);
+    EXPECT_EQ(e, ResourceManagerImpl::Error::CONNECTION_LIMIT_EXCEEDED);
+    executed = true;
+  });
+
   ASSERT_TRUE(executed);
 }
 
@@ -229,8 +267,75 @@ TEST_F(DialerTest, NewStreamSuccess) {
   bool executed = false;
   dialer->newStream(pinfo, protocol, [&](auto &&rstream) {
     EXPECT_OUTCOME_TRUE(s, rstream);
-    (void)s;
+    EXPECT_EQ(s, stream);
+    executed = true;
+  });
+  ASSERT_TRUE(executed);
+}
+
+/**
+ * @given dialer, which selects protocols optimistically, @and existing
+ * connection to peer
+ * @when newStream is executed
+ * @then get new stream without waiting for the other side
+ */
+TEST_F(DialerTest, NewStreamOptimistic) {
+  DialerImpl optimistic_dialer{proto_muxer, tmgr, cmgr, rmgr,
+                               DialerConfig{.optimistic_select = true}};
+
+  // connection exist to peer
+  EXPECT_CALL(*cmgr, getBestConnectionForPeer(pid))
+      .WillOnce(Return(connection));
+
+  // newStream returns valid stream
+  EXPECT_CALL(*connection, newStream(_)).WillOnce(Arg0CallbackWithArg(stream));
+
+  // the protocol is selected without a round trip
+  EXPECT_CALL(*proto_muxer, selectOneOf(_, _, _, _)).Times(0);
+  EXPECT_CALL(*proto_muxer, selectOptimistically(protocol, _))
+      .WillOnce(Return(stream));
+
+  bool executed = false;
+  optimistic_dialer.newStream(pinfo, protocol, [&](auto &&rstream) {
+    EXPECT_OUTCOME_TRUE(s, rstream);
+    EXPECT_EQ(s, stream);
+    executed = true;
+  });
+  ASSERT_TRUE(executed);
+}
+
+/**
+ * @given resource manager, which allows one stream of the protocol
+ * @when two streams of the protocol are opened
+ * @then the second one is reset before the protocol is selected over it
+ */
+TEST_F(DialerTest, NewStreamOverProtocolLimit) {
+  ResourceManagerConfig config;
+  config.protocol_streams = 1;
+  auto limited_rmgr = std::make_shared<ResourceManagerImpl>(bus, config);
+  DialerImpl limited_dialer{proto_muxer, tmgr, cmgr, limited_rmgr};
+
+  auto second_stream = std::make_shared<StreamMock>();
+  EXPECT_CALL(*cmgr, getBestConnectionForPeer(pid))
+      .WillRepeatedly(Return(connection));
+  EXPECT_CALL(*connection, newStream(_))
+      .WillOnce(Arg0CallbackWithArg(stream))
+      .WillOnce(Arg0CallbackWithArg(second_stream));
+  EXPECT_CALL(*stream, isClosed()).WillRepeatedly(Return(false));
+  EXPECT_CALL(*proto_muxer, selectOneOf(Contains(Eq(protocol)), _, true, _))
+      .WillOnce(Arg3CallbackWithArg(protocol));
+  EXPECT_CALL(*second_stream, reset()).Times(1);
+
+  limited_dialer.newStream(pinfo, protocol, [](auto &&rstream) {
+    EXPECT_OUTCOME_TRUE_1(rstream);
+  });
+
+  bool executed = false;
+  limited_dialer.newStream(pinfo, protocol, [&](auto &&rstream) {
+    EXPECT_OUTCOME_FALSE(e, rstream);
+    EXPECT_EQ(e, ResourceManagerImpl::Error::STREAM_LIMIT_EXCEEDED);
     executed = true;
   });
   ASSERT_TRUE(executed);
+  EXPECT_EQ(limited_rmgr->protocolUsage(protocol).streams, 1);
 }
@@ -7,6 +7,7 @@
 
 #include <gtest/gtest.h>
 #include <libp2p/common/literals.hpp>
+#include <libp2p/network/impl/resource_manager_impl.hpp>
 #include "mock/libp2p/connection/stream_mock.hpp"
 #include "mock/libp2p/network/connection_manager_mock.hpp"
 #include "mock/libp2p/network/router_mock.hpp"
@@ -55,8 +56,12 @@ struct ListenerManagerTest : public ::testing::Test {
   std::shared_ptr<ConnectionManagerMock> cmgr =
       std::make_shared<ConnectionManagerMock>();
 
+  std::shared_ptr<ResourceManager> rmgr = std::make_shared<ResourceManagerImpl>(
+      std::make_shared<libp2p::event::Bus>(), ResourceManagerConfig{});
+
   std::shared_ptr<ListenerManager> listener =
-      std::make_shared<ListenerManagerImpl>(proto_muxer, router, tmgr, cmgr);
+      std::make_shared<ListenerManagerImpl>(proto_muxer, router, tmgr, cmgr,
+                                            rmgr);
 };
 
 /**
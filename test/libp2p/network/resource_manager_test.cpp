@@ -0,0 +1,155 @@
+/**
+ * Copyright Soramitsu Co., Ltd. All Rights Reserved.
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include "libp2p/network/impl/resource_manager_impl.hpp"
+
+#include <gtest/gtest.h>
+#include <libp2p/common/literals.hpp>
+#include "libp2p/network/connection_manager.hpp"
+#include "mock/libp2p/connection/capable_connection_mock.hpp"
+#include "mock/libp2p/connection/stream_mock.hpp"
+#include "testutil/outcome.hpp"
+
+using namespace libp2p;
+using namespace network;
+using namespace connection;
+using namespace common;
+
+using testing::Return;
+using testing::ReturnRef;
+using E = ResourceManagerImpl::Error;
+
+struct ResourceManagerTest : public ::testing::Test {
+  void SetUp() override {
+    config.global = {2, 3, 300};
+    config.peer = {1, 2, 250};
+    config.protocol_streams = 2;
+    config.protocol_streams_overrides = {{"/limited/1.0.0", 1}};
+    rmgr = std::make_shared<ResourceManagerImpl>(bus, config);
+  }
+
+  std::shared_ptr<libp2p::event::Bus> bus =
+      std::make_shared<libp2p::event::Bus>();
+  ResourceManagerConfig config;
+  std::shared_ptr<ResourceManagerImpl> rmgr;
+
+  peer::PeerId peer1 = "1"_peerid;
+  peer::PeerId peer2 = "2"_peerid;
+};
+
+/**
+ * @given resource manager with limits of streams and memory
+ * @when streams are reserved for two peers
+ * @then each reservation fits both the limits of its peer and the global
+ * ones @and the released resources may be reserved again
+ */
+TEST_F(ResourceManagerTest, Streams) {
+  EXPECT_OUTCOME_TRUE_1(rmgr->reserveStream(peer1, 100));
+  EXPECT_OUTCOME_TRUE_1(rmgr->reserveStream(peer1, 100));
+  EXPECT_EQ(rmgr->reserveStream(peer1, 10).error(), E::STREAM_LIMIT_EXCEEDED);
+
+  EXPECT_EQ(rmgr->reserveStream(peer2, 101).error(), E::MEMORY_LIMIT_EXCEEDED);
+  EXPECT_OUTCOME_TRUE_1(rmgr->reserveStream(peer2, 100));
+  EXPECT_EQ(rmgr->reserveStream(peer2, 0).error(), E::STREAM_LIMIT_EXCEEDED);
+
+  auto global = rmgr->globalUsage();
+  EXPECT_EQ(global.streams, 3);
+  EXPECT_EQ(global.memory, 300);
+  EXPECT_EQ(rmgr->peerUsage(peer1).streams, 2);
+  EXPECT_EQ(rmgr->peerUsage(peer2).memory, 100);
+
+  rmgr->releaseStream(peer1, 100);
+  rmgr->releaseStream(peer1, 100);
+  EXPECT_EQ(rmgr->peerUsage(peer1).streams, 0);
+  EXPECT_OUTCOME_TRUE_1(rmgr->reserveStream(peer2, 100));
+  EXPECT_EQ(rmgr->globalUsage().streams, 2);
+}
+
+/**
+ * @given resource manager with limits of connections
+ * @when a connection is reserved @and then publishes its termination
+ * @then the second one to the same peer is rejected before the termination
+ * and accepted after it
+ */
+TEST_F(ResourceManagerTest, Connections) {
+  auto conn1 = std::make_shared<CapableConnectionMock>();
+  auto conn2 = std::make_shared<CapableConnectionMock>();
+  EXPECT_CALL(*conn1, remotePeer()).WillRepeatedly(ReturnRef(peer1));
+  EXPECT_CALL(*conn2, remotePeer()).WillRepeatedly(ReturnRef(peer1));
+
+  EXPECT_OUTCOME_TRUE_1(rmgr->checkConnection(peer1));
+  EXPECT_OUTCOME_TRUE_1(rmgr->reserveConnection(conn1));
+  EXPECT_EQ(rmgr->checkConnection(peer1).error(),
+            E::CONNECTION_LIMIT_EXCEEDED);
+  EXPECT_EQ(rmgr->reserveConnection(conn2).error(),
+            E::CONNECTION_LIMIT_EXCEEDED);
+  EXPECT_OUTCOME_TRUE_1(rmgr->checkConnection(peer2));
+
+  bus->getChannel<network::event::OnConnectionClosedChannel>().publish(
+      std::weak_ptr<CapableConnection>(conn1));
+  EXPECT_EQ(rmgr->globalUsage().connections, 0);
+  EXPECT_OUTCOME_TRUE_1(rmgr->reserveConnection(conn2));
+  EXPECT_EQ(rmgr->peerUsage(peer1).connections, 1);
+}
+
+/**
+ * @given resource manager with limits of connections
+ * @when a reserved connection is destroyed without being released @and its
+ * release is delivered after that
+ * @then another connection to the peer is accepted in its place @and the
+ * late release does not touch the new one
+ */
+TEST_F(ResourceManagerTest, DestroyedConnections) {
+  auto conn1 = std::make_shared<CapableConnectionMock>();
+  EXPECT_CALL(*conn1, remotePeer()).WillRepeatedly(ReturnRef(peer1));
+  EXPECT_OUTCOME_TRUE_1(rmgr->reserveConnection(conn1));
+  std::weak_ptr<CapableConnection> weak_conn1 = conn1;
+  conn1.reset();
+
+  auto conn2 = std::make_shared<CapableConnectionMock>();
+  EXPECT_CALL(*conn2, remotePeer()).WillRepeatedly(ReturnRef(peer1));
+  EXPECT_OUTCOME_TRUE_1(rmgr->reserveConnection(conn2));
+  EXPECT_EQ(rmgr->peerUsage(peer1).connections, 1);
+
+  rmgr->releaseConnection(weak_conn1);
+  EXPECT_EQ(rmgr->globalUsage().connections, 1);
+  rmgr->releaseConnection(conn2);
+  EXPECT_EQ(rmgr->globalUsage().connections, 0);
+}
+
+/**
+ * @given resource manager with limits of protocol streams
+ * @when streams of the protocols are reserved
+ * @then the limit of each protocol is applied @and the closed or destroyed
+ * streams do not count
+ */
+TEST_F(ResourceManagerTest, ProtocolStreams) {
+  const peer::Protocol proto = "/default/1.0.0";
+  const peer::Protocol limited = "/limited/1.0.0";
+  auto stream1 = std::make_shared<StreamMock>();
+  auto stream2 = std::make_shared<StreamMock>();
+  auto stream3 = std::make_shared<StreamMock>();
+  for (const auto &stream : {stream1, stream2, stream3}) {
+    EXPECT_CALL(*stream, isClosed()).WillRepeatedly(Return(false));
+  }
+
+  EXPECT_OUTCOME_TRUE_1(rmgr->reserveProtocolStream(limited, stream1));
+  EXPECT_EQ(rmgr->reserveProtocolStream(limited, stream2).error(),
+            E::STREAM_LIMIT_EXCEEDED);
+
+  EXPECT_OUTCOME_TRUE_1(rmgr->reserveProtocolStream(proto, stream2));
+  EXPECT_OUTCOME_TRUE_1(rmgr->reserveProtocolStream(proto, stream3));
+  EXPECT_EQ(rmgr->protocolUsage(proto).streams, 2);
+
+  // a destroyed stream is dropped, when the limit is reached
+  stream2.reset();
+  auto stream4 = std::make_shared<StreamMock>();
+  EXPECT_OUTCOME_TRUE_1(rmgr->reserveProtocolStream(proto, stream4));
+
+  // a closed one as well
+  EXPECT_CALL(*stream1, isClosed()).WillRepeatedly(Return(true));
+  EXPECT_EQ(rmgr->protocolUsage(limited).streams, 0);
+  EXPECT_OUTCOME_TRUE_1(rmgr->reserveProtocolStream(limited, stream4));
+}
@@ -7,6 +7,7 @@
 
 #include <gtest/gtest.h>
 #include <gsl/span>
+#include <libp2p/network/impl/resource_manager_impl.hpp>
 #include "mock/libp2p/connection/stream_mock.hpp"
 
 using namespace libp2p::network;
@@ -185,3 +186,65 @@ TEST_F(RouterTest, RemoveAll) {
   this->removeAll();
   ASSERT_TRUE(this->getSupportedProtocols().empty());
 }
+
+/**
+ * @given router with some protocols set
+ * @when snapshots of the protocols are taken before and after a change
+ * @then the same snapshot is shared until the handlers change, and the old one
+ * stays valid after that
+ */
+TEST_F(RouterTest, ProtocolsSnapshot) {
+  setHandlerWithFail(kDefaultProtocol);
+  auto snapshot = this->getProtocolsSnapshot();
+  ASSERT_EQ(snapshot, this->getProtocolsSnapshot());
+  ASSERT_EQ(snapshot->protocols, std::vector<Protocol>{kDefaultProtocol});
+
+  setHandlerWithFail(kAnotherProtocol);
+  auto changed = this->getProtocolsSnapshot();
+  EXPECT_GT(changed->version, snapshot->version);
+  EXPECT_EQ(changed->protocols.size(), 2);
+  EXPECT_EQ(snapshot->protocols, std::vector<Protocol>{kDefaultProtocol});
+}
+
+/**
+ * @given router with a perfect-match and a predicate handlers
+ * @when it is checked, which protocols can be handled
+ * @then both exact and predicate matches are accepted, and others are not
+ */
+TEST_F(RouterTest, CanHandle) {
+  setHandlerWithFail(kAnotherProtocol);
+  this->setProtocolHandler(
+      kVersionProtocolPrefix, [](auto &&) { FAIL(); },
+      [this](const auto &proto) { return proto == kDefaultProtocol; });
+
+  EXPECT_TRUE(this->canHandle(kAnotherProtocol));
+  EXPECT_TRUE(this->canHandle(kVersionProtocolPrefix));
+  EXPECT_TRUE(this->canHandle(kDefaultProtocol));
+  EXPECT_FALSE(this->canHandle("/ping/1.5.3"));
+  EXPECT_FALSE(this->canHandle("/http/2.2.9"));
+}
+
+/**
+ * @given router with a resource manager, which allows one stream of the
+ * protocol
+ * @when two streams of the protocol are handled
+ * @then the second one is reset and not passed to the handler
+ */
+TEST(RouterResourcesTest, HandleOverProtocolLimit) {
+  ResourceManagerConfig config;
+  config.protocol_streams = 1;
+  RouterImpl router{std::make_shared<ResourceManagerImpl>(
+      std::make_shared<libp2p::event::Bus>(), config)};
+  const Protocol protocol = "/ping/1.5.2";
+  size_t handled = 0;
+  router.setProtocolHandler(protocol, [&handled](auto &&) { ++handled; });
+
+  auto stream1 = std::make_shared<StreamMock>();
+  auto stream2 = std::make_shared<StreamMock>();
+  EXPECT_CALL(*stream1, isClosed()).WillRepeatedly(::testing::Return(false));
+  EXPECT_CALL(*stream2, reset()).Times(1);
+
+  EXPECT_TRUE(router.handle(protocol, stream1));
+  EXPECT_FALSE(router.handle(protocol, stream2));
+  EXPECT_EQ(handled, 1);
+}
@@ -194,3 +194,21 @@ TEST_F(InmemAddressRepository_Test, GetPeers) {
   auto s = db->getPeers();
   EXPECT_EQ(s.size(), 2);
 }
+
+/**
+ * @given two peers with expired addresses
+ * @when garbage is collected in steps of a single entry
+ * @then each step evicts a single peer, and the second one completes the pass
+ */
+TEST_F(InmemAddressRepository_Test, CollectGarbageInSteps) {
+  EXPECT_OUTCOME_TRUE_1(
+      db->addAddresses(p1, std::vector<Multiaddress>{ma1, ma2}, 0ms));
+  EXPECT_OUTCOME_TRUE_1(
+      db->addAddresses(p2, std::vector<Multiaddress>{ma3}, 0ms));
+
+  EXPECT_FALSE(db->collectGarbageStep(1));
+  EXPECT_EQ(db->getPeers().size(), 1);
+
+  EXPECT_TRUE(db->collectGarbageStep(1));
+  EXPECT_TRUE(db->getPeers().empty());
+}
@@ -112,7 +112,7 @@ TEST_F(IdentifyDeltaTest, Send) {
   // getActivePeers
   EXPECT_CALL(conn_manager_, getConnections())
       .WillOnce(Return(std::vector<std::shared_ptr<CapableConnection>>{conn_}));
-  EXPECT_CALL(*conn_, remotePeer()).WillOnce(Return(kRemotePeerId));
+  EXPECT_CALL(*conn_, remotePeer()).WillOnce(ReturnRef(kRemotePeerId));
   EXPECT_CALL(host_, getPeerRepository()).WillOnce(ReturnRef(peer_repo_));
   EXPECT_CALL(peer_repo_, getPeerInfo(kRemotePeerId))
       .WillOnce(Return(kPeerInfo));
@@ -152,7 +152,7 @@ TEST_F(IdentifyDeltaTest, Receive) {
   // deltaReceived
   EXPECT_CALL(*stream_, remotePeerId())
       .Times(2)
-      .WillRepeatedly(Return(kRemotePeerId));
+      .WillRepeatedly(ReturnRef(kRemotePeerId));
   EXPECT_CALL(*stream_, remoteMultiaddr())
       .Times(1)
       .WillRepeatedly(Return(outcome::success(kPeerInfo.addresses[0])));
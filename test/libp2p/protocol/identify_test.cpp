@@ -173,7 +173,7 @@ TEST_F(IdentifyTest, Send) {
   EXPECT_CALL(host_, getLibp2pVersion()).WillOnce(Return(kLibp2pVersion));
   EXPECT_CALL(host_, getLibp2pClientVersion()).WillOnce(Return(kClientVersion));
 
-  EXPECT_CALL(*stream_, remotePeerId()).WillOnce(Return(kRemotePeerId));
+  EXPECT_CALL(*stream_, remotePeerId()).WillOnce(ReturnRef(kRemotePeerId));
 
   // handle Identify request and check it
   EXPECT_CALL(*stream_, write(_, _, _))
@@ -199,7 +199,7 @@ ACTION_P(ReturnStreamRes, s) {
  * peer to be identified @and accepts the received message
  */
 TEST_F(IdentifyTest, Receive) {
-  EXPECT_CALL(*connection_, remotePeer()).WillOnce(Return(kRemotePeerId));
+  EXPECT_CALL(*connection_, remotePeer()).WillOnce(ReturnRef(kRemotePeerId));
   EXPECT_CALL(*connection_, remoteMultiaddr())
       .WillOnce(Return(remote_multiaddr_));
 
@@ -216,7 +216,7 @@ TEST_F(IdentifyTest, Receive) {
 
   EXPECT_CALL(*stream_, remotePeerId())
       .Times(2)
-      .WillRepeatedly(Return(kRemotePeerId));
+      .WillRepeatedly(ReturnRef(kRemotePeerId));
   EXPECT_CALL(*stream_, remoteMultiaddr())
       .Times(2)
       .WillRepeatedly(Return(outcome::success(remote_multiaddr_)));
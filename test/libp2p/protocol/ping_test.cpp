@@ -15,6 +15,8 @@
 #include "mock/libp2p/connection/stream_mock.hpp"
 #include "mock/libp2p/crypto/random_generator_mock.hpp"
 #include "mock/libp2p/host/host_mock.hpp"
+#include "mock/libp2p/network/connection_manager_mock.hpp"
+#include "mock/libp2p/network/network_mock.hpp"
 #include "mock/libp2p/peer/peer_repository_mock.hpp"
 #include <libp2p/common/literals.hpp>
 
@@ -56,6 +58,17 @@ class PingTest : public testing::Test {
   PeerRepositoryMock peer_repo_;
 
   std::vector<uint8_t> buffer_ = std::vector<uint8_t>(kPingMsgSize, 0xE3);
+
+  multi::Multiaddress local_ = "/ip4/127.0.0.1/tcp/40000"_multiaddr;
+  multi::Multiaddress remote_ = "/ip4/127.0.0.1/tcp/40001"_multiaddr;
+
+  /// make the stream look carried by the pinged connection
+  void expectStreamOverConnection() {
+    EXPECT_CALL(*stream_, localMultiaddr()).WillOnce(Return(local_));
+    EXPECT_CALL(*stream_, remoteMultiaddr()).WillOnce(Return(remote_));
+    EXPECT_CALL(*conn_, localMultiaddr()).WillOnce(Return(local_));
+    EXPECT_CALL(*conn_, remoteMultiaddr()).WillOnce(Return(remote_));
+  }
 };
 
 ACTION_P(ReadPut, buf) {
@@ -90,9 +103,17 @@ TEST_F(PingTest, PingServer) {
  * @given Ping protocol handler
  * @when a stream over the Ping protocol is initiated from our side
  * @then a Ping message is sent over that stream @and we expect to get it back
+ * @and the round trip time is reported for the connection
  */
 TEST_F(PingTest, PingClient) {
-  EXPECT_CALL(*conn_, remotePeer()).WillOnce(Return(peer_id_));
+  network::NetworkMock network;
+  network::ConnectionManagerMock cmgr;
+  expectStreamOverConnection();
+  EXPECT_CALL(host_, getNetwork()).WillOnce(ReturnRef(network));
+  EXPECT_CALL(network, getConnectionManager()).WillOnce(ReturnRef(cmgr));
+  EXPECT_CALL(cmgr, reportRtt(std::shared_ptr<CapableConnection>(conn_), _));
+
+  EXPECT_CALL(*conn_, remotePeer()).WillOnce(ReturnRef(peer_id_));
   EXPECT_CALL(host_, getPeerRepository()).WillOnce(ReturnRef(peer_repo_));
   EXPECT_CALL(peer_repo_, getPeerInfo(peer_id_)).WillOnce(Return(peer_info_));
   EXPECT_CALL(host_, newStream(peer_info_, kPingProto, _))
@@ -114,7 +135,7 @@ TEST_F(PingTest, PingClient) {
       .WillRepeatedly(Return(false));
   EXPECT_CALL(*stream_, isClosedForRead()).WillOnce(Return(false));
 
-  EXPECT_CALL(*stream_, remotePeerId()).WillOnce(Return(peer_id_));
+  EXPECT_CALL(*stream_, remotePeerId()).WillOnce(ReturnRef(peer_id_));
 
   ping_->startPinging(conn_,
                       [](auto &&session_res) { ASSERT_TRUE(session_res); });
@@ -129,7 +150,8 @@ TEST_F(PingTest, PingClient) {
  * @then PingIsDead event is emitted over the bus
  */
 TEST_F(PingTest, PingClientTimeoutExpired) {
-  EXPECT_CALL(*conn_, remotePeer()).WillOnce(Return(peer_id_));
+  expectStreamOverConnection();
+  EXPECT_CALL(*conn_, remotePeer()).WillOnce(ReturnRef(peer_id_));
   EXPECT_CALL(host_, getPeerRepository()).WillOnce(ReturnRef(peer_repo_));
   EXPECT_CALL(peer_repo_, getPeerInfo(peer_id_)).WillOnce(Return(peer_info_));
   EXPECT_CALL(host_, newStream(peer_info_, kPingProto, _))
@@ -141,7 +163,7 @@ TEST_F(PingTest, PingClientTimeoutExpired) {
 
   EXPECT_CALL(*stream_, isClosedForWrite()).WillOnce(Return(false));
 
-  EXPECT_CALL(*stream_, remotePeerId()).WillOnce(Return(peer_id_));
+  EXPECT_CALL(*stream_, remotePeerId()).WillOnce(ReturnRef(peer_id_));
 
   boost::optional<peer::PeerId> dead_peer_id;
   auto h = bus_.getChannel<protocol::event::PeerIsDeadChannel>().subscribe(
@@ -104,6 +104,20 @@ TEST_F(MessageManagerTest, ComposeProtocolMessage) {
   ASSERT_EQ(protocol_msg, kProtocolMsg);
 }
 
+/**
+ * @given body of a protocol message
+ * @when it is compared with protocols
+ * @then only the same protocol matches
+ */
+TEST_F(MessageManagerTest, MatchProtocolMessage) {
+  auto body = gsl::make_span(kProtocolMsg).subspan(1);
+  EXPECT_TRUE(MessageManager::isProtocolMsg(body, kDefaultProtocols[0]));
+  EXPECT_FALSE(MessageManager::isProtocolMsg(body, kDefaultProtocols[1]));
+  EXPECT_FALSE(MessageManager::isProtocolMsg(body, "/plaintext/1.0"));
+  EXPECT_FALSE(MessageManager::isProtocolMsg(body.first(body.size() - 1),
+                                             kDefaultProtocols[0]));
+}
+
 /**
  * @given message manager @and protocols
  * @when getting a protocols message from it
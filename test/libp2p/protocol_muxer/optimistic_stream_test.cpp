@@ -0,0 +1,159 @@
+/**
+ * Copyright Soramitsu Co., Ltd. All Rights Reserved.
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <libp2p/protocol_muxer/multiselect/optimistic_stream.hpp>
+
+#include <algorithm>
+
+#include <gtest/gtest.h>
+#include <libp2p/common/literals.hpp>
+#include <libp2p/protocol_muxer/multiselect/message_manager.hpp>
+#include <libp2p/protocol_muxer/multiselect/multiselect_error.hpp>
+#include "mock/libp2p/connection/stream_mock.hpp"
+#include "testutil/outcome.hpp"
+
+using namespace libp2p;
+using namespace connection;
+using namespace protocol_muxer;
+using common::ByteArray;
+using common::operator""_v;
+
+using ::testing::_;
+using ::testing::Invoke;
+
+class OptimisticStreamTest : public ::testing::Test {
+ public:
+  void SetUp() override {
+    // writes of the stream are collected, and reads are served from the bytes
+    // of the other side
+    ON_CALL(*stream_, write(_, _, _))
+        .WillByDefault(Invoke([this](gsl::span<const uint8_t> in,
+                                     size_t bytes,
+                                     const Stream::WriteCallbackFunc &cb) {
+          writes_.emplace_back(in.begin(), in.begin() + bytes);
+          cb(bytes);
+        }));
+    ON_CALL(*stream_, read(_, _, _))
+        .WillByDefault(Invoke([this](gsl::span<uint8_t> out,
+                                     size_t bytes,
+                                     const Stream::ReadCallbackFunc &cb) {
+          if (incoming_.size() < bytes) {
+            return cb(std::errc::io_error);
+          }
+          std::copy_n(incoming_.begin(), bytes, out.begin());
+          incoming_.erase(incoming_.begin(), incoming_.begin() + bytes);
+          cb(bytes);
+        }));
+  }
+
+  /// bytes, which the other side sends, if it replies with {@param response}
+  void respond(const ByteArray &response) {
+    incoming_ = MessageManager::openingMsg();
+    incoming_.insert(incoming_.end(), response.begin(), response.end());
+    incoming_.insert(incoming_.end(), payload_.begin(), payload_.end());
+  }
+
+  ByteArray proposal() const {
+    auto bytes = MessageManager::openingMsg();
+    auto protocol = MessageManager::protocolMsg(protocol_);
+    bytes.insert(bytes.end(), protocol.begin(), protocol.end());
+    return bytes;
+  }
+
+  std::shared_ptr<testing::NiceMock<StreamMock>> stream_ =
+      std::make_shared<testing::NiceMock<StreamMock>>();
+  peer::Protocol protocol_ = "/echo/1.0.0";
+  std::shared_ptr<OptimisticStream> optimistic_ =
+      std::make_shared<OptimisticStream>(stream_, protocol_);
+
+  ByteArray payload_ = "hello"_v;
+  std::vector<ByteArray> writes_;
+  ByteArray incoming_;
+};
+
+/**
+ * @given optimistic stream, whose protocol is supported by the other side
+ * @when data is written and then read
+ * @then the proposal and the data go in one write, and the data of the other
+ * side is read after its echoes
+ */
+TEST_F(OptimisticStreamTest, WriteThenRead) {
+  respond(MessageManager::protocolMsg(protocol_));
+
+  bool written = false;
+  optimistic_->write(payload_, payload_.size(), [&](auto &&res) {
+    EXPECT_OUTCOME_TRUE(size, res);
+    EXPECT_EQ(size, payload_.size());
+    written = true;
+  });
+  ASSERT_TRUE(written);
+  ASSERT_EQ(writes_.size(), 1);
+  auto expected = proposal();
+  expected.insert(expected.end(), payload_.begin(), payload_.end());
+  EXPECT_EQ(writes_[0], expected);
+
+  ByteArray out(payload_.size());
+  bool read = false;
+  optimistic_->read(out, out.size(), [&](auto &&res) {
+    EXPECT_OUTCOME_TRUE(size, res);
+    EXPECT_EQ(size, payload_.size());
+    read = true;
+  });
+  ASSERT_TRUE(read);
+  EXPECT_EQ(out, payload_);
+  EXPECT_TRUE(incoming_.empty());
+}
+
+/**
+ * @given optimistic stream
+ * @when it is read before anything is written
+ * @then the proposal is sent alone, and the data is read after the echoes
+ */
+TEST_F(OptimisticStreamTest, ReadFirst) {
+  respond(MessageManager::protocolMsg(protocol_));
+
+  ByteArray out(payload_.size());
+  bool read = false;
+  optimistic_->read(out, out.size(), [&](auto &&res) {
+    EXPECT_OUTCOME_TRUE(size, res);
+    EXPECT_EQ(size, payload_.size());
+    read = true;
+  });
+  ASSERT_TRUE(read);
+  EXPECT_EQ(out, payload_);
+  ASSERT_EQ(writes_.size(), 1);
+  EXPECT_EQ(writes_[0], proposal());
+}
+
+/**
+ * @given optimistic stream, whose protocol is not supported by the other side
+ * @when data is written and then read
+ * @then the read fails with NEGOTIATION_FAILED, as do the following writes
+ */
+TEST_F(OptimisticStreamTest, NotSupported) {
+  respond(MessageManager::naMsg());
+
+  optimistic_->write(payload_, payload_.size(), [](auto &&res) {
+    EXPECT_OUTCOME_TRUE_1(res);
+  });
+
+  ByteArray out(payload_.size());
+  bool read = false;
+  optimistic_->read(out, out.size(), [&](auto &&res) {
+    EXPECT_OUTCOME_FALSE(e, res);
+    EXPECT_EQ(e, MultiselectError::NEGOTIATION_FAILED);
+    read = true;
+  });
+  ASSERT_TRUE(read);
+
+  bool written = false;
+  optimistic_->write(payload_, payload_.size(), [&](auto &&res) {
+    EXPECT_OUTCOME_FALSE(e, res);
+    EXPECT_EQ(e, MultiselectError::NEGOTIATION_FAILED);
+    written = true;
+  });
+  ASSERT_TRUE(written);
+  EXPECT_EQ(writes_.size(), 1);
+}
@@ -0,0 +1,201 @@
+/**
+ * Copyright Soramitsu Co., Ltd. All Rights Reserved.
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <libp2p/security/noise/noise.hpp>
+
+#include <gtest/gtest.h>
+#include <libp2p/common/literals.hpp>
+#include <libp2p/crypto/crypto_provider/crypto_provider_impl.hpp>
+#include <libp2p/crypto/ed25519_provider/ed25519_provider_impl.hpp>
+#include <libp2p/crypto/key_marshaller/key_marshaller_impl.hpp>
+#include <libp2p/crypto/key_validator/key_validator_impl.hpp>
+#include <libp2p/crypto/random_generator/boost_generator.hpp>
+#include <libp2p/peer/impl/identity_manager_impl.hpp>
+#include <libp2p/security/noise/noise_error.hpp>
+#include <libp2p/transport/memory/memory_connection.hpp>
+#include "testutil/outcome.hpp"
+
+using namespace libp2p;
+using namespace security;
+using namespace crypto;
+using connection::SecureConnection;
+using transport::MemoryConnection;
+using libp2p::common::operator""_multiaddr;
+
+class NoiseAdaptorTest : public ::testing::Test {
+ public:
+  using SecureResult = outcome::result<std::shared_ptr<SecureConnection>>;
+
+  std::shared_ptr<CryptoProvider> crypto_provider =
+      std::make_shared<CryptoProviderImpl>(
+          std::make_shared<random::BoostRandomGenerator>(),
+          std::make_shared<ed25519::Ed25519ProviderImpl>());
+  std::shared_ptr<marshaller::KeyMarshaller> key_marshaller =
+      std::make_shared<marshaller::KeyMarshallerImpl>(
+          std::make_shared<validator::KeyValidatorImpl>(crypto_provider));
+
+  std::shared_ptr<peer::IdentityManager> makeIdentity() {
+    return std::make_shared<peer::IdentityManagerImpl>(
+        crypto_provider->generateKeys(Key::Type::Ed25519).value(),
+        key_marshaller);
+  }
+
+  std::shared_ptr<Noise> makeNoise(
+      const std::shared_ptr<peer::IdentityManager> &idmgr,
+      noise::NoiseConfig config = {}) {
+    return std::make_shared<Noise>(idmgr, crypto_provider, key_marshaller,
+                                   config);
+  }
+
+  /// make the handshake over in-memory connections
+  std::pair<SecureResult, SecureResult> secure(
+      const std::shared_ptr<Noise> &dialer,
+      const std::shared_ptr<Noise> &listener,
+      const peer::PeerId &expected_peer) {
+    auto [outbound, inbound] = MemoryConnection::makePair(
+        context, {}, "/memory/1"_multiaddr, "/memory/2"_multiaddr);
+    std::optional<SecureResult> dialer_result;
+    std::optional<SecureResult> listener_result;
+    dialer->secureOutbound(outbound, expected_peer,
+                           [&](auto &&res) { dialer_result = res; });
+    listener->secureInbound(inbound,
+                            [&](auto &&res) { listener_result = res; });
+    context.run();
+    context.restart();
+    EXPECT_TRUE(dialer_result);
+    EXPECT_TRUE(listener_result);
+    return {*dialer_result, *listener_result};
+  }
+
+  boost::asio::io_context context;
+  std::shared_ptr<peer::IdentityManager> dialer_id = makeIdentity();
+  std::shared_ptr<peer::IdentityManager> listener_id = makeIdentity();
+};
+
+/**
+ * @given noise adaptor
+ * @when getting id of the underlying security protocol
+ * @then id of the libp2p spec is returned
+ */
+TEST_F(NoiseAdaptorTest, GetId) {
+  ASSERT_EQ(makeNoise(dialer_id)->getProtocolId(), "/noise");
+}
+
+/**
+ * @given two peers with noise adaptors
+ * @when they secure a connection and send data, which spans many frames
+ * @then each side knows the other one, and the data is received intact
+ */
+TEST_F(NoiseAdaptorTest, SecureAndExchange) {
+  auto [dialer_res, listener_res] = secure(
+      makeNoise(dialer_id), makeNoise(listener_id), listener_id->getId());
+  EXPECT_OUTCOME_TRUE(dialer_conn, dialer_res);
+  EXPECT_OUTCOME_TRUE(listener_conn, listener_res);
+  EXPECT_EQ(dialer_conn->remotePeer(), listener_id->getId());
+  EXPECT_EQ(dialer_conn->localPeer(), dialer_id->getId());
+  EXPECT_EQ(listener_conn->remotePeer(), dialer_id->getId());
+  EXPECT_EQ(listener_conn->remotePublicKey().value(),
+            dialer_id->getKeyPair().publicKey);
+  EXPECT_TRUE(dialer_conn->isInitiator());
+
+  std::vector<uint8_t> out(200000);
+  for (size_t i = 0; i < out.size(); ++i) {
+    out[i] = static_cast<uint8_t>(i * 7);
+  }
+  std::vector<uint8_t> in(out.size());
+  bool written = false;
+  bool read = false;
+  dialer_conn->write(out, out.size(), [&](auto &&res) {
+    EXPECT_OUTCOME_TRUE(size, res);
+    EXPECT_EQ(size, out.size());
+    written = true;
+  });
+  listener_conn->read(in, in.size(), [&](auto &&res) {
+    EXPECT_OUTCOME_TRUE(size, res);
+    EXPECT_EQ(size, in.size());
+    read = true;
+  });
+  context.run();
+  context.restart();
+  ASSERT_TRUE(written);
+  ASSERT_TRUE(read);
+  EXPECT_EQ(in, out);
+
+  // readSome returns the rest of a frame, which was read partially before
+  std::vector<uint8_t> reply{1, 2, 3, 4, 5};
+  std::vector<uint8_t> head(2);
+  std::vector<uint8_t> tail(10);
+  listener_conn->write(reply, reply.size(), [](auto &&) {});
+  dialer_conn->read(head, head.size(), [&](auto &&res) {
+    EXPECT_OUTCOME_TRUE_1(res);
+    dialer_conn->readSome(tail, tail.size(), [&](auto &&res) {
+      EXPECT_OUTCOME_TRUE(size, res);
+      EXPECT_EQ(size, 3);
+    });
+  });
+  context.run();
+  EXPECT_EQ(head, (std::vector<uint8_t>{1, 2}));
+  EXPECT_EQ(std::vector<uint8_t>(tail.begin(), tail.begin() + 3),
+            (std::vector<uint8_t>{3, 4, 5}));
+}
+
+/**
+ * @given two peers with noise adaptors, which use AES-GCM
+ * @when they secure a connection
+ * @then it is established
+ */
+TEST_F(NoiseAdaptorTest, AesGcm) {
+  noise::NoiseConfig config{noise::CipherSuite::AES_GCM};
+  auto [dialer_res, listener_res] =
+      secure(makeNoise(dialer_id, config), makeNoise(listener_id, config),
+             listener_id->getId());
+  EXPECT_OUTCOME_TRUE_1(dialer_res);
+  EXPECT_OUTCOME_TRUE_1(listener_res);
+}
+
+/**
+ * @given two peers with noise adaptors
+ * @when the dialer expects another peer on the other end
+ * @then the handshake fails
+ */
+TEST_F(NoiseAdaptorTest, UnexpectedPeer) {
+  auto [dialer_res, listener_res] = secure(
+      makeNoise(dialer_id), makeNoise(listener_id), makeIdentity()->getId());
+  EXPECT_OUTCOME_FALSE(error, dialer_res);
+  EXPECT_EQ(error, noise::NoiseError::PEER_ID_MISMATCH);
+  EXPECT_OUTCOME_FALSE_1(listener_res);
+}
+
+/**
+ * @given peers with different noise ciphers
+ * @when they secure a connection
+ * @then the handshake fails on both sides
+ */
+TEST_F(NoiseAdaptorTest, CipherMismatch) {
+  auto [dialer_res, listener_res] =
+      secure(makeNoise(dialer_id),
+             makeNoise(listener_id, {noise::CipherSuite::AES_GCM}),
+             listener_id->getId());
+  EXPECT_OUTCOME_FALSE_1(dialer_res);
+  EXPECT_OUTCOME_FALSE_1(listener_res);
+}
+
+/**
+ * @given two peers with noise adaptors
+ * @when they secure a connection
+ * @then each side takes its ephemeral key from the pool of the crypto
+ * provider
+ */
+TEST_F(NoiseAdaptorTest, EphemeralKeysFromPool) {
+  auto &provider = dynamic_cast<CryptoProviderImpl &>(*crypto_provider);
+  auto before = provider.ephemeralKeyPoolStats();
+  auto [dialer_res, listener_res] = secure(
+      makeNoise(dialer_id), makeNoise(listener_id), listener_id->getId());
+  EXPECT_OUTCOME_TRUE_1(dialer_res);
+  EXPECT_OUTCOME_TRUE_1(listener_res);
+
+  auto after = provider.ephemeralKeyPoolStats();
+  EXPECT_EQ(after.hits + after.misses, before.hits + before.misses + 2);
+}
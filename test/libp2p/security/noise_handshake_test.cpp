@@ -0,0 +1,253 @@
+/**
+ * Copyright Soramitsu Co., Ltd. All Rights Reserved.
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <libp2p/security/noise/handshake_state.hpp>
+
+#include <gtest/gtest.h>
+#include <libp2p/common/hexutil.hpp>
+#include <libp2p/security/noise/noise_error.hpp>
+#include "testutil/outcome.hpp"
+
+using namespace libp2p::security::noise;
+using libp2p::common::hex_lower;
+using libp2p::common::unhex;
+
+namespace {
+  std::vector<uint8_t> bytes(std::string_view hex) {
+    return unhex(hex).value();
+  }
+
+  DhKeyPair keys(std::string_view private_hex) {
+    DhKey key{};
+    auto b = bytes(private_hex);
+    std::copy(b.begin(), b.end(), key.begin());
+    return dhKeyPairFromPrivate(key).value();
+  }
+
+  /**
+   * Handshake of Noise_XX_25519_*_SHA256 with fixed keys, as in the
+   * cacophony vectors: messages and two transport messages after the split
+   */
+  struct Vector {
+    CipherSuite suite;
+    std::string handshake_hash;
+    std::vector<std::string> messages;
+  };
+
+  const std::string kInitiatorStatic =
+      "e61ef9919cde45dd5f82166404bd08e38bceb5dfdfded0a34c8df7ed542214d1";
+  const std::string kInitiatorEphemeral =
+      "893e28b9dc6ca8d611ab664754b8ceb7bac5117349a4439a6b0569da977c464a";
+  const std::string kResponderStatic =
+      "4a3acbfdb163dec651dfa3194dece676d437029c62a408b4c5ea9114246e4893";
+  const std::string kResponderEphemeral =
+      "bbdb4cdbd309f1a1f2e1456967fe288cadd6f712d65dc7b7793d5e63da6b375b";
+  const std::string kPrologue = "4a6f686e2047616c74";
+  const std::vector<std::string> kPayloads{
+      "4c756477696720766f6e204d69736573",
+      "4d757272617920526f746862617264",
+      "462e20412e20486179656b",
+      "4361726c204d656e676572",
+      "4a65616e2d426170746973746520536179",
+  };
+
+  const std::vector<Vector> kVectors{
+      {CipherSuite::CHACHA_POLY,
+       "c8e5f64e846193be2a834104c2a009868d6c9f3bd3c186299888b488b2f1f58e",
+       {"ca35def5ae56cec33dc2036731ab14896bc4c75dbb07a61f879f8e3afa4c7944"
+        "4c756477696720766f6e204d69736573",
+        "95ebc60d2b1fa672c1f46a8aa265ef51bfe38e7ccb39ec5be34069f144808843"
+        "81cbad1f276e038c48378ffce2b65285e08d6b68aaa3629a5a8639392490e5b9"
+        "bd5269c2f1e4f488ed8831161f19b7815528f8982ffe09be9b5c412f8a0db50f"
+        "8814c7194e83f23dbd8d162c9326ad",
+        "c7195ffacac1307ff99046f219750fc47693e23c3cb08b89c2af808b444850a8"
+        "0ae475b9df0f169ae80a89be0865b57f58c9fea0d4ec82a286427402f113e4b6"
+        "ae769a1d95941d49b25030",
+        "3744e25d623542b0576724d2c54efc70916e296af7ecd4fd05336c",
+        "9f722dd57ef7e065a07d2e406c12ad9e274c3bd41bef1f237b430aa839fc1431"
+        "a4"}},
+      {CipherSuite::AES_GCM,
+       "1b7aefb1125762aa21a252890d00af54519638b76437444538f9a52f21e2e0dc",
+       {"ca35def5ae56cec33dc2036731ab14896bc4c75dbb07a61f879f8e3afa4c7944"
+        "4c756477696720766f6e204d69736573",
+        "95ebc60d2b1fa672c1f46a8aa265ef51bfe38e7ccb39ec5be34069f144808843"
+        "757117acceb05bd7a45733bc22015c97a9d0cbaf41b80446d5988ff5127235d7"
+        "6b79eade70f473d6a4ef521fdcbeda5340d01e028ba793fc059f2724a83af05f"
+        "12dda0448a7621a926b379a92477fd",
+        "c90f1cf77eba4e50edb038991565e36c9758943a989229b6051244dc4fbecb69"
+        "46744b401af2ee1a5881b65fbb87fd07cb6a328ececc9ce6ce84c399dc332d4f"
+        "d521fa4bb7f467ce909395",
+        "2c0f120541d0e4c13dc38dff2d783c6dbe77dea872b87bf628802e",
+        "b53bb47d67c53a9a75dbddf7eb2ba6b2848ce3a9bad1dcabf54bdbb6b7e831a6"
+        "b7"}},
+  };
+}  // namespace
+
+class NoiseVectorTest : public ::testing::TestWithParam<Vector> {};
+
+/**
+ * @given initiator and responder with the fixed keys of a test vector
+ * @when they make the XX handshake and exchange transport messages
+ * @then every message and the handshake hash are equal to the vector ones,
+ * and each side reads the payloads of the other one
+ */
+TEST_P(NoiseVectorTest, Handshake) {
+  const auto &vector = GetParam();
+  auto prologue = bytes(kPrologue);
+  HandshakeState initiator{vector.suite, true, keys(kInitiatorStatic),
+                           prologue, keys(kInitiatorEphemeral)};
+  HandshakeState responder{vector.suite, false, keys(kResponderStatic),
+                           prologue, keys(kResponderEphemeral)};
+
+  for (size_t i = 0; i < 3; ++i) {
+    auto &writer = i % 2 == 0 ? initiator : responder;
+    auto &reader = i % 2 == 0 ? responder : initiator;
+    ASSERT_TRUE(writer.isMyTurn());
+    ASSERT_FALSE(reader.isMyTurn());
+    EXPECT_OUTCOME_TRUE(message, writer.writeMessage(bytes(kPayloads[i])));
+    EXPECT_EQ(hex_lower(message), vector.messages[i]);
+    EXPECT_OUTCOME_TRUE(payload, reader.readMessage(message));
+    EXPECT_EQ(hex_lower(payload), kPayloads[i]);
+  }
+  ASSERT_TRUE(initiator.isComplete());
+  ASSERT_TRUE(responder.isComplete());
+  EXPECT_EQ(hex_lower(initiator.handshakeHash()), vector.handshake_hash);
+  EXPECT_EQ(hex_lower(responder.handshakeHash()), vector.handshake_hash);
+  EXPECT_EQ(initiator.remoteStaticKey(),
+            keys(kResponderStatic).public_key);
+  EXPECT_EQ(responder.remoteStaticKey(),
+            keys(kInitiatorStatic).public_key);
+
+  EXPECT_OUTCOME_TRUE(initiator_states, initiator.split());
+  EXPECT_OUTCOME_TRUE(responder_states, responder.split());
+  auto [initiator_send, initiator_recv] = std::move(initiator_states);
+  auto [responder_send, responder_recv] = std::move(responder_states);
+  auto exchange = [](CipherState &sender, CipherState &receiver,
+                     const std::string &payload, const std::string &message) {
+    auto buffer = bytes(payload);
+    auto size = buffer.size();
+    buffer.resize(size + CipherState::kTagSize);
+    EXPECT_OUTCOME_TRUE(encrypted, sender.encrypt({}, buffer, size));
+    EXPECT_EQ(hex_lower(gsl::make_span(buffer).first(encrypted)), message);
+    EXPECT_OUTCOME_TRUE(decrypted, receiver.decrypt({}, buffer));
+    EXPECT_EQ(hex_lower(gsl::make_span(buffer).first(decrypted)), payload);
+  };
+  exchange(initiator_send, responder_recv, kPayloads[3], vector.messages[3]);
+  exchange(responder_send, initiator_recv, kPayloads[4], vector.messages[4]);
+}
+
+INSTANTIATE_TEST_CASE_P(Suites, NoiseVectorTest,
+                        ::testing::ValuesIn(kVectors));
+
+/**
+ * @given X25519 keys from RFC 7748
+ * @when the shared secret is computed on both sides
+ * @then public keys and the secret are equal to the RFC ones
+ */
+TEST(NoiseDhTest, Rfc7748) {
+  auto alice =
+      keys("77076d0a7318a57d3c16c17251b26645df4c2f87ebc0992ab177fba51db92c2a");
+  auto bob =
+      keys("5dab087e624a8a4b79e17f8b83800ee66f3bb1292618b6fd1c2f8b27ff88e0eb");
+  EXPECT_EQ(hex_lower(alice.public_key),
+            "8520f0098930a754748b7ddcb43ef75a0dbf3a0d26381af4eba4a98eaa9b4e6a");
+  EXPECT_EQ(hex_lower(bob.public_key),
+            "de9edb7d7b7dc1b4d35b61c2ece435373f8343c85b78674dadfc7e146f882b4f");
+  EXPECT_OUTCOME_TRUE(secret1, dh(alice.private_key, bob.public_key));
+  EXPECT_OUTCOME_TRUE(secret2, dh(bob.private_key, alice.public_key));
+  EXPECT_EQ(hex_lower(secret1),
+            "4a5d9d5ba4ce2de1728e3bf480350f25e07e21c947d19e3376f09b3c1e161742");
+  EXPECT_EQ(secret1, secret2);
+}
+
+class CipherStateTest : public ::testing::TestWithParam<CipherSuite> {
+ public:
+  void SetUp() override {
+    CipherState::Key key{};
+    key.fill(7);
+    ASSERT_TRUE(encoder.initializeKey(key));
+    ASSERT_TRUE(decoder.initializeKey(key));
+  }
+
+  CipherState encoder{GetParam()};
+  CipherState decoder{GetParam()};
+  std::vector<uint8_t> ad{1, 2, 3};
+};
+
+/**
+ * @given two cipher states with the same key
+ * @when messages are encrypted in place by one and decrypted by the other
+ * @then the plaintexts are restored and both nonces advance
+ */
+TEST_P(CipherStateTest, InPlaceRoundTrip) {
+  for (size_t size : {0, 1, 100, 65519}) {
+    std::vector<uint8_t> plaintext(size, 42);
+    auto buffer = plaintext;
+    buffer.resize(size + CipherState::kTagSize);
+    EXPECT_OUTCOME_TRUE(encrypted, encoder.encrypt(ad, buffer, size));
+    ASSERT_EQ(encrypted, size + CipherState::kTagSize);
+    EXPECT_OUTCOME_TRUE(decrypted, decoder.decrypt(ad, buffer));
+    ASSERT_EQ(decrypted, size);
+    buffer.resize(decrypted);
+    EXPECT_EQ(buffer, plaintext);
+  }
+  EXPECT_EQ(encoder.nonce(), 4);
+  EXPECT_EQ(decoder.nonce(), 4);
+}
+
+/**
+ * @given an encrypted message
+ * @when its ciphertext or associated data differ at decryption
+ * @then decryption fails
+ */
+TEST_P(CipherStateTest, Tampered) {
+  std::vector<uint8_t> buffer(10 + CipherState::kTagSize, 1);
+  EXPECT_OUTCOME_TRUE_1(encoder.encrypt(ad, buffer, 10));
+  auto tampered = buffer;
+  tampered[3] ^= 1;
+  EXPECT_OUTCOME_FALSE(error, decoder.decrypt(ad, tampered));
+  EXPECT_EQ(error, NoiseError::DECRYPTION_FAILED);
+
+  // the nonce did not advance, so that the original message is accepted;
+  // copies are decrypted, as a failed decryption leaves garbage in place
+  auto other_ad = buffer;
+  EXPECT_OUTCOME_FALSE_1(decoder.decrypt({}, other_ad));
+  EXPECT_OUTCOME_TRUE_1(decoder.decrypt(ad, buffer));
+}
+
+INSTANTIATE_TEST_CASE_P(Suites, CipherStateTest,
+                        ::testing::Values(CipherSuite::CHACHA_POLY,
+                                          CipherSuite::AES_GCM));
+
+/**
+ * @given cipher state without a key
+ * @when a message is encrypted
+ * @then it is left as is, as the spec requires
+ */
+TEST(CipherStateNoKeyTest, PassThrough) {
+  CipherState state{CipherSuite::CHACHA_POLY};
+  std::vector<uint8_t> buffer{1, 2, 3};
+  EXPECT_OUTCOME_TRUE(size, state.encrypt({}, buffer, buffer.size()));
+  EXPECT_EQ(size, 3);
+  EXPECT_EQ(buffer, (std::vector<uint8_t>{1, 2, 3}));
+}
+
+/**
+ * @given responder of a handshake
+ * @when the second message is tampered on its way
+ * @then the initiator rejects it
+ */
+TEST(NoiseHandshakeTest, TamperedMessage) {
+  auto suite = CipherSuite::CHACHA_POLY;
+  HandshakeState initiator{suite, true, generateDhKeyPair().value()};
+  HandshakeState responder{suite, false, generateDhKeyPair().value()};
+  EXPECT_OUTCOME_TRUE(message1, initiator.writeMessage({}));
+  EXPECT_OUTCOME_TRUE_1(responder.readMessage(message1));
+  EXPECT_OUTCOME_TRUE(message2, responder.writeMessage({}));
+  message2.back() ^= 1;
+  EXPECT_OUTCOME_FALSE(error, initiator.readMessage(message2));
+  EXPECT_EQ(error, NoiseError::DECRYPTION_FAILED);
+  EXPECT_OUTCOME_FALSE_1(initiator.split());
+}
@@ -103,9 +103,7 @@ TEST_F(PlaintextAdaptorTest, SecureInbound) {
         EXPECT_OUTCOME_TRUE(sec_remote_pubkey, sec->remotePublicKey());
         EXPECT_EQ(sec_remote_pubkey, remote_pubkey);
 
-        EXPECT_CALL(*key_marshaller, marshal(sec_remote_pubkey))
-            .WillOnce(Return(ProtobufKey{remote_pubkey.data}));
-        EXPECT_OUTCOME_TRUE(remote_id, sec->remotePeer());
+        const auto &remote_id = sec->remotePeer();
         EXPECT_OUTCOME_TRUE(
             calculated, PeerId::fromPublicKey(ProtobufKey{remote_pubkey.data}))
         EXPECT_EQ(remote_id, calculated);
@@ -139,9 +137,7 @@ TEST_F(PlaintextAdaptorTest, SecureOutbound) {
         EXPECT_OUTCOME_TRUE(sec_remote_pubkey, sec->remotePublicKey());
         EXPECT_EQ(sec_remote_pubkey, remote_pubkey);
 
-        EXPECT_CALL(*key_marshaller, marshal(sec_remote_pubkey))
-            .WillOnce(Return(ProtobufKey{remote_pubkey.data}));
-        EXPECT_OUTCOME_TRUE(remote_id, sec->remotePeer());
+        const auto &remote_id = sec->remotePeer();
         EXPECT_OUTCOME_TRUE(
             calculated, PeerId::fromPublicKey(ProtobufKey{remote_pubkey.data}))
         EXPECT_EQ(remote_id, calculated);
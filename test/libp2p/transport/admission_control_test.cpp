@@ -0,0 +1,116 @@
+/**
+ * Copyright Soramitsu Co., Ltd. All Rights Reserved.
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <libp2p/transport/impl/admission_control.hpp>
+
+#include <gtest/gtest.h>
+#include "mock/libp2p/connection/raw_connection_mock.hpp"
+
+using namespace libp2p;
+using namespace transport;
+using boost::asio::ip::make_address;
+using std::chrono_literals::operator""ms;
+using Decision = AdmissionControl::Decision;
+using ::testing::NiceMock;
+using ::testing::Return;
+
+class AdmissionControlTest : public ::testing::Test {
+ public:
+  AdmissionConfig config;
+  AdmissionControl::Clock::time_point now{};
+
+  AdmissionControlTest() {
+    config.max_concurrent_upgrades = 0;
+    config.rate_interval = 1000ms;
+  }
+};
+
+/**
+ * @given admission control with a cap of 2 concurrent upgrades
+ * @when 3 connections arrive, then one upgrade finishes
+ * @then third connection is rejected, while the next one is accepted
+ */
+TEST_F(AdmissionControlTest, ConcurrentUpgradesCap) {
+  config.max_concurrent_upgrades = 2;
+  AdmissionControl admission{config};
+
+  EXPECT_EQ(admission.admit(make_address("10.0.0.1"), now), Decision::ACCEPT);
+  EXPECT_EQ(admission.admit(make_address("10.0.0.2"), now), Decision::ACCEPT);
+  EXPECT_EQ(admission.admit(make_address("10.0.0.3"), now), Decision::REJECT);
+  EXPECT_EQ(admission.upgradesInProgress(), 2);
+
+  admission.onUpgradeFinished();
+  EXPECT_EQ(admission.admit(make_address("10.0.0.3"), now), Decision::ACCEPT);
+
+  EXPECT_EQ(admission.getStats().accepted, 3);
+  EXPECT_EQ(admission.getStats().rejected, 1);
+  EXPECT_EQ(admission.getStats().throttled, 0);
+}
+
+/**
+ * @given admission control with per-IP rate limit of 2 per interval
+ * @when the same address connects 3 times in an interval
+ * @then third connection is throttled, other addresses are not affected,
+ * and the address is admitted again in the next interval
+ */
+TEST_F(AdmissionControlTest, PerIpRateLimit) {
+  config.ip_rate_limit = 2;
+  AdmissionControl admission{config};
+  auto ip = make_address("10.0.0.1");
+
+  EXPECT_EQ(admission.admit(ip, now), Decision::ACCEPT);
+  EXPECT_EQ(admission.admit(ip, now + 10ms), Decision::ACCEPT);
+  EXPECT_EQ(admission.admit(ip, now + 20ms), Decision::THROTTLE);
+  EXPECT_EQ(admission.admit(make_address("10.0.0.2"), now + 20ms),
+            Decision::ACCEPT);
+  EXPECT_EQ(admission.admit(ip, now + 1000ms), Decision::ACCEPT);
+
+  EXPECT_EQ(admission.getStats().throttled, 1);
+}
+
+/**
+ * @given admission control with per-subnet rate limit of 2 per interval
+ * @when addresses of the same /24 (IPv4) or /48 (IPv6) subnet connect
+ * @then the third one is throttled, while other subnets are admitted
+ */
+TEST_F(AdmissionControlTest, PerSubnetRateLimit) {
+  config.subnet_rate_limit = 2;
+  AdmissionControl admission{config};
+
+  EXPECT_EQ(admission.admit(make_address("10.0.0.1"), now), Decision::ACCEPT);
+  EXPECT_EQ(admission.admit(make_address("10.0.0.2"), now), Decision::ACCEPT);
+  EXPECT_EQ(admission.admit(make_address("10.0.0.3"), now), Decision::THROTTLE);
+  EXPECT_EQ(admission.admit(make_address("10.0.1.1"), now), Decision::ACCEPT);
+
+  EXPECT_EQ(admission.admit(make_address("2001:db8:1::1"), now),
+            Decision::ACCEPT);
+  EXPECT_EQ(admission.admit(make_address("2001:db8:1:ffff::1"), now),
+            Decision::ACCEPT);
+  EXPECT_EQ(admission.admit(make_address("2001:db8:1::2"), now),
+            Decision::THROTTLE);
+  EXPECT_EQ(admission.admit(make_address("2001:db8:2::1"), now),
+            Decision::ACCEPT);
+}
+
+/**
+ * @given admission control with a cap of 1 inbound connection
+ * @when a tracked connection is alive, and then is closed
+ * @then new connections are rejected until it is closed
+ */
+TEST_F(AdmissionControlTest, InboundConnectionsCap) {
+  config.max_inbound_connections = 1;
+  AdmissionControl admission{config};
+  auto conn = std::make_shared<NiceMock<connection::RawConnectionMock>>();
+
+  ASSERT_EQ(admission.admit(make_address("10.0.0.1"), now), Decision::ACCEPT);
+  admission.track(conn);
+  admission.onUpgradeFinished();
+
+  EXPECT_CALL(*conn, isClosed()).WillOnce(Return(false));
+  EXPECT_EQ(admission.admit(make_address("10.0.0.2"), now), Decision::REJECT);
+
+  EXPECT_CALL(*conn, isClosed()).WillOnce(Return(true));
+  EXPECT_EQ(admission.admit(make_address("10.0.0.2"), now), Decision::ACCEPT);
+}
@@ -0,0 +1,258 @@
+/**
+ * Copyright Soramitsu Co., Ltd. All Rights Reserved.
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <libp2p/transport/memory/memory_transport.hpp>
+
+#include <gtest/gtest.h>
+#include <libp2p/common/literals.hpp>
+#include <libp2p/transport/memory/memory_util.hpp>
+#include "mock/libp2p/connection/capable_connection_mock.hpp"
+#include "mock/libp2p/transport/upgrader_mock.hpp"
+#include "testutil/gmock_actions.hpp"
+#include "testutil/libp2p/peer.hpp"
+#include "testutil/outcome.hpp"
+
+using namespace libp2p;
+using namespace transport;
+using namespace connection;
+using namespace common;
+using std::chrono_literals::operator""ms;
+
+using ::testing::_;
+using ::testing::NiceMock;
+
+namespace {
+  auto makeUpgrader() {
+    auto upgrader = std::make_shared<NiceMock<UpgraderMock>>();
+    ON_CALL(*upgrader, upgradeToSecureOutbound(_, _, _))
+        .WillByDefault(UpgradeToSecureOutbound([](auto &&raw) {
+          std::shared_ptr<SecureConnection> sec =
+              std::make_shared<CapableConnBasedOnRawConnMock>(raw);
+          return sec;
+        }));
+    ON_CALL(*upgrader, upgradeToSecureInbound(_, _))
+        .WillByDefault(UpgradeToSecureInbound([](auto &&raw) {
+          std::shared_ptr<SecureConnection> sec =
+              std::make_shared<CapableConnBasedOnRawConnMock>(raw);
+          return sec;
+        }));
+    ON_CALL(*upgrader, upgradeToMuxed(_, _))
+        .WillByDefault(UpgradeToMuxed([](auto &&sec) {
+          std::shared_ptr<CapableConnection> cap =
+              std::make_shared<CapableConnBasedOnRawConnMock>(sec);
+          return cap;
+        }));
+    return upgrader;
+  }
+}  // namespace
+
+class MemoryConnectionTest : public ::testing::Test {
+ public:
+  using Clock = MemoryConnection::Clock;
+
+  boost::asio::io_context context;
+  MemoryLinkConfig config;
+
+  auto makePair() {
+    return MemoryConnection::makePair(context, config, "/memory/1"_multiaddr,
+                                      "/memory/2"_multiaddr);
+  }
+};
+
+/**
+ * @given pair of memory connections with 20ms latency
+ * @when one end writes data
+ * @then the other end reads the same data not earlier than in 20ms
+ */
+TEST_F(MemoryConnectionTest, DeliversWithLatency) {
+  config.latency = 20ms;
+  auto [a, b] = makePair();
+
+  ByteArray out{1, 2, 3, 4};
+  ByteArray in(out.size(), 0);
+  auto start = Clock::now();
+  Clock::time_point received;
+
+  a->write(out, out.size(), [](auto &&res) { ASSERT_TRUE(res); });
+  b->read(in, in.size(), [&](auto &&res) {
+    ASSERT_TRUE(res);
+    received = Clock::now();
+  });
+  context.run_for(200ms);
+
+  EXPECT_EQ(in, out);
+  EXPECT_GE(received - start, 20ms);
+  EXPECT_TRUE(a->isInitiator());
+  EXPECT_FALSE(b->isInitiator());
+}
+
+/**
+ * @given pair of memory connections with 100 KB/s bandwidth
+ * @when 5 KB are written
+ * @then write completes in about 50ms, as the link is busy until then
+ */
+TEST_F(MemoryConnectionTest, LimitsBandwidth) {
+  config.bandwidth = 100'000;
+  auto [a, b] = makePair();
+
+  ByteArray out(5'000, 42);
+  ByteArray in(out.size(), 0);
+  auto start = Clock::now();
+  Clock::time_point written;
+
+  a->write(out, out.size(), [&](auto &&res) {
+    ASSERT_TRUE(res);
+    written = Clock::now();
+  });
+  b->read(in, in.size(), [](auto &&res) { ASSERT_TRUE(res); });
+  context.run_for(200ms);
+
+  EXPECT_EQ(in, out);
+  EXPECT_GE(written - start, 50ms);
+}
+
+/**
+ * @given pair of memory connections, which lose half of the chunks
+ * @when many chunks are written
+ * @then all of them are read in the order of writing
+ */
+TEST_F(MemoryConnectionTest, LossKeepsOrder) {
+  config.loss = 0.5;
+  config.retransmit_delay = 5ms;
+  auto [a, b] = makePair();
+
+  constexpr size_t kChunks = 50;
+  ByteArray out(kChunks);
+  for (size_t i = 0; i < kChunks; ++i) {
+    out[i] = i;
+    a->write(gsl::make_span(&out[i], 1), 1,
+             [](auto &&res) { ASSERT_TRUE(res); });
+  }
+  ByteArray in(kChunks, 0);
+  b->read(in, in.size(), [](auto &&res) { ASSERT_TRUE(res); });
+  context.run_for(500ms);
+
+  EXPECT_EQ(in, out);
+}
+
+/**
+ * @given pair of memory connections
+ * @when one end is closed after writing
+ * @then the other end reads the written data, and then gets EOF
+ */
+TEST_F(MemoryConnectionTest, CloseGivesEof) {
+  auto [a, b] = makePair();
+
+  ByteArray out{1, 2};
+  ByteArray in(10, 0);
+  a->write(out, out.size(), [](auto &&res) { ASSERT_TRUE(res); });
+  EXPECT_OUTCOME_TRUE_1(a->close());
+  EXPECT_TRUE(a->isClosed());
+
+  bool eof = false;
+  b->readSome(in, in.size(), [&](auto &&res) {
+    ASSERT_TRUE(res);
+    ASSERT_EQ(res.value(), out.size());
+    b->readSome(in, in.size(), [&](auto &&res) {
+      ASSERT_FALSE(res);
+      eof = res.error().value() == boost::asio::error::eof;
+    });
+  });
+  context.run_for(50ms);
+
+  EXPECT_TRUE(eof);
+}
+
+class MemoryTransportTest : public ::testing::Test {
+ public:
+  std::shared_ptr<boost::asio::io_context> context =
+      std::make_shared<boost::asio::io_context>();
+  std::shared_ptr<MemoryHub> hub = std::make_shared<MemoryHub>();
+  std::shared_ptr<MemoryTransport> transport =
+      std::make_shared<MemoryTransport>(context, makeUpgrader(), hub);
+  multi::Multiaddress ma = "/memory/1234"_multiaddr;
+};
+
+/**
+ * @given memory transport with a listener
+ * @when it dials the listener and writes data
+ * @then both sides get upgraded connections, and listener receives the data
+ */
+TEST_F(MemoryTransportTest, DialAndListen) {
+  ByteArray out{1, 2, 3};
+  ByteArray in(out.size(), 0);
+  std::shared_ptr<CapableConnection> inbound;
+  std::shared_ptr<CapableConnection> outbound;
+
+  auto listener = transport->createListener([&](auto &&rconn) {
+    EXPECT_OUTCOME_TRUE(conn, rconn);
+    inbound = conn;
+    inbound->read(in, in.size(), [](auto &&res) { ASSERT_TRUE(res); });
+  });
+  EXPECT_OUTCOME_TRUE_1(listener->listen(ma));
+  EXPECT_OUTCOME_TRUE(listen_ma, listener->getListenMultiaddr());
+  EXPECT_EQ(listen_ma, ma);
+  EXPECT_TRUE(transport->canDial(ma));
+  EXPECT_FALSE(transport->canDial("/ip4/127.0.0.1/tcp/1234"_multiaddr));
+
+  transport->dial(testutil::randomPeerId(), ma, [&](auto &&rconn) {
+    EXPECT_OUTCOME_TRUE(conn, rconn);
+    outbound = conn;
+    outbound->write(out, out.size(), [](auto &&res) { ASSERT_TRUE(res); });
+  });
+  context->run_for(50ms);
+
+  ASSERT_TRUE(inbound);
+  ASSERT_TRUE(outbound);
+  EXPECT_EQ(in, out);
+  EXPECT_OUTCOME_TRUE(remote, inbound->remoteMultiaddr());
+  EXPECT_OUTCOME_TRUE(local, outbound->localMultiaddr());
+  EXPECT_EQ(remote, local);
+}
+
+/**
+ * @given memory transport
+ * @when it dials an address, nobody listens at
+ * @then connection is refused
+ */
+TEST_F(MemoryTransportTest, DialRefused) {
+  bool refused = false;
+  transport->dial(testutil::randomPeerId(), ma, [&](auto &&rconn) {
+    ASSERT_FALSE(rconn);
+    refused = rconn.error() == std::errc::connection_refused;
+  });
+  EXPECT_TRUE(refused);
+}
+
+/**
+ * @given two memory listeners
+ * @when they listen on the same address
+ * @then the second one fails, until the first one is closed
+ */
+TEST_F(MemoryTransportTest, AddressInUse) {
+  auto listener1 = transport->createListener([](auto &&) {});
+  auto listener2 = transport->createListener([](auto &&) {});
+
+  EXPECT_OUTCOME_TRUE_1(listener1->listen(ma));
+  EXPECT_OUTCOME_FALSE(e, listener2->listen(ma));
+  EXPECT_EQ(e, std::errc::address_in_use);
+
+  EXPECT_OUTCOME_TRUE_1(listener1->close());
+  EXPECT_TRUE(listener1->isClosed());
+  EXPECT_OUTCOME_TRUE_1(listener2->listen(ma));
+}
+
+/**
+ * @given memory multiaddress
+ * @when it is converted to bytes and back
+ * @then the same listener id is got
+ */
+TEST(MemoryAddress, RoundTrip) {
+  EXPECT_OUTCOME_TRUE(ma, detail::makeMemoryAddress(1ull << 63u));
+  EXPECT_OUTCOME_TRUE(from_bytes, multi::Multiaddress::create(ma.getBytesAddress()));
+  EXPECT_EQ(from_bytes.getStringAddress(), ma.getStringAddress());
+  EXPECT_OUTCOME_TRUE(id, detail::getMemoryId(from_bytes));
+  EXPECT_EQ(id, 1ull << 63u);
+}
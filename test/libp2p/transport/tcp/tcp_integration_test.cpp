@@ -324,3 +324,48 @@ TEST(TCP, OneTransportServerHandlesManyClients) {
 
   ASSERT_EQ(counter, 1);
 }
+
+/**
+ * @given tcp listener and transport, both with TCP Fast Open
+ * @when dialing the listener twice and writing data
+ * @then both dials succeed @and the listener receives the data, whether the
+ * kernel sends it in SYN or after the handshake
+ */
+TEST(TCP, FastOpen) {
+  auto context = std::make_shared<boost::asio::io_context>(1);
+  TransportConfig config;
+  config.tcp_fast_open = true;
+  auto transport =
+      std::make_shared<TcpTransport>(context, makeUpgrader(), config);
+  auto ma = "/ip4/127.0.0.1/tcp/40004"_multiaddr;
+
+  ByteArray out{1, 2, 3, 4};
+  size_t received = 0;
+  auto listener = transport->createListener([&](auto &&rconn) {
+    auto conn = expectConnectionValid(rconn);
+    auto buf = std::make_shared<ByteArray>(out.size(), 0);
+    conn->read(*buf, buf->size(), [&, conn, buf](auto &&res) {
+      ASSERT_TRUE(res) << res.error().message();
+      EXPECT_EQ(*buf, out);
+      ++received;
+    });
+  });
+  ASSERT_TRUE(listener->listen(ma));
+
+  auto dial = [&] {
+    transport->dial(testutil::randomPeerId(), ma, [&](auto &&rconn) {
+      auto conn = expectConnectionValid(rconn);
+      EXPECT_TRUE(conn->isInitiator());
+      conn->write(out, out.size(), [conn](auto &&res) {
+        ASSERT_TRUE(res) << res.error().message();
+      });
+    });
+  };
+  // the first connection gets a cookie, the second one may use it
+  dial();
+  context->run_for(50ms);
+  dial();
+  context->run_for(50ms);
+
+  EXPECT_EQ(received, 2);
+}
@@ -0,0 +1,256 @@
+/**
+ * Copyright Soramitsu Co., Ltd. All Rights Reserved.
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <libp2p/transport/tcp/io_uring.hpp>
+
+#include <gtest/gtest.h>
+#include <libp2p/transport/tcp/tcp_connection.hpp>
+
+using namespace libp2p::transport;
+using libp2p::common::ByteArray;
+using std::chrono_literals::operator""ms;
+
+class TcpIoUringTest : public ::testing::Test {
+ public:
+  using Tcp = boost::asio::ip::tcp;
+
+  void SetUp() override {
+    config.enabled = true;
+    config.buffer_size = 1024;
+    config.registered_buffers = 4;
+    auto r = IoUring::create(context, config);
+    ASSERT_TRUE(r) << r.error().message();
+    ring = r.value();
+
+    // connected pair of sockets, both driven by the ring
+    Tcp::acceptor acceptor{context,
+                           {boost::asio::ip::make_address("127.0.0.1"), 0}};
+    Tcp::socket client_socket{context};
+    client_socket.connect(acceptor.local_endpoint());
+    auto server_socket = acceptor.accept();
+    client = std::make_shared<TcpConnection>(context, std::move(client_socket),
+                                             ring);
+    server = std::make_shared<TcpConnection>(context, std::move(server_socket),
+                                             ring);
+  }
+
+  boost::asio::io_context context;
+  IoUringConfig config;
+  std::shared_ptr<IoUring> ring;
+  std::shared_ptr<TcpConnection> client;
+  std::shared_ptr<TcpConnection> server;
+};
+
+/**
+ * @given pair of connections over io_uring with 1 KB registered buffers
+ * @when 100 KB are written with a single write
+ * @then the other end reads them all with a single read
+ */
+TEST_F(TcpIoUringTest, ReadWriteAll) {
+  ByteArray out(100 * 1024);
+  for (size_t i = 0; i < out.size(); ++i) {
+    out[i] = static_cast<uint8_t>(i * 7);
+  }
+  ByteArray in(out.size(), 0);
+
+  size_t written = 0;
+  size_t read = 0;
+  client->write(out, out.size(), [&](auto &&res) {
+    ASSERT_TRUE(res) << res.error().message();
+    written = res.value();
+  });
+  server->read(in, in.size(), [&](auto &&res) {
+    ASSERT_TRUE(res) << res.error().message();
+    read = res.value();
+  });
+  context.run_for(200ms);
+
+  EXPECT_EQ(written, out.size());
+  EXPECT_EQ(read, in.size());
+  EXPECT_EQ(in, out);
+}
+
+/**
+ * @given pair of connections over io_uring
+ * @when 4 bytes are written, and 100 bytes are requested by readSome
+ * @then readSome completes with the 4 bytes
+ */
+TEST_F(TcpIoUringTest, ReadSome) {
+  ByteArray out{1, 2, 3, 4};
+  ByteArray in(100, 0);
+
+  size_t read = 0;
+  client->write(out, out.size(), [](auto &&res) { ASSERT_TRUE(res); });
+  server->readSome(in, in.size(), [&](auto &&res) {
+    ASSERT_TRUE(res) << res.error().message();
+    read = res.value();
+  });
+  context.run_for(100ms);
+
+  ASSERT_EQ(read, out.size());
+  EXPECT_TRUE(std::equal(out.begin(), out.end(), in.begin()));
+}
+
+/**
+ * @given pair of connections over io_uring
+ * @when several writes are made in the same handler
+ * @then they are submitted to the kernel by a single call
+ */
+TEST_F(TcpIoUringTest, BatchesSubmissions) {
+  ByteArray out{1, 2, 3, 4};
+  ByteArray in(out.size() * 3, 0);
+
+  auto calls_before = ring->submitCalls();
+  for (int i = 0; i < 3; ++i) {
+    client->write(out, out.size(), [](auto &&res) { ASSERT_TRUE(res); });
+  }
+  context.poll();
+  EXPECT_EQ(ring->submitCalls(), calls_before + 1);
+  context.restart();
+
+  bool read = false;
+  server->read(in, in.size(), [&](auto &&res) {
+    ASSERT_TRUE(res);
+    read = true;
+  });
+  context.run_for(100ms);
+  EXPECT_TRUE(read);
+}
+
+/**
+ * @given pair of connections over io_uring
+ * @when one end is closed
+ * @then pending read of the other end gets EOF @and pending read of the
+ * closed end is aborted
+ */
+TEST_F(TcpIoUringTest, CloseWakesPendingReads) {
+  ByteArray server_in(10, 0);
+  ByteArray client_in(10, 0);
+
+  bool eof = false;
+  bool aborted = false;
+  server->read(server_in, server_in.size(), [&](auto &&res) {
+    ASSERT_FALSE(res);
+    eof = res.error().value() == boost::asio::error::eof;
+  });
+  client->read(client_in, client_in.size(), [&](auto &&res) {
+    ASSERT_FALSE(res);
+    aborted = true;
+  });
+  context.run_for(20ms);
+  ASSERT_FALSE(eof);
+
+  ASSERT_TRUE(client->close());
+  context.run_for(100ms);
+
+  EXPECT_TRUE(eof);
+  EXPECT_TRUE(aborted);
+}
+
+/**
+ * @given pair of connections over io_uring
+ * @when a read is requested @and the connection is closed in the same
+ * handler, before the read is submitted @and a new pair of connections,
+ * which may get the same descriptor, is made
+ * @then the read is aborted @and data of the new pair is not taken by it
+ */
+TEST_F(TcpIoUringTest, CloseSubmitsQueuedOperations) {
+  ByteArray stale_in(4, 0);
+  bool aborted = false;
+  client->read(stale_in, stale_in.size(), [&](auto &&res) {
+    ASSERT_FALSE(res);
+    aborted = true;
+  });
+  ASSERT_TRUE(client->close());
+
+  Tcp::acceptor acceptor{context,
+                         {boost::asio::ip::make_address("127.0.0.1"), 0}};
+  Tcp::socket socket{context};
+  socket.connect(acceptor.local_endpoint());
+  auto reader =
+      std::make_shared<TcpConnection>(context, std::move(socket), ring);
+  auto writer =
+      std::make_shared<TcpConnection>(context, acceptor.accept(), ring);
+
+  ByteArray out{1, 2, 3, 4};
+  ByteArray in(out.size(), 0);
+  bool read = false;
+  writer->write(out, out.size(), [](auto &&res) { ASSERT_TRUE(res); });
+  reader->read(in, in.size(), [&](auto &&res) {
+    ASSERT_TRUE(res) << res.error().message();
+    read = true;
+  });
+  context.run_for(100ms);
+
+  EXPECT_TRUE(aborted);
+  EXPECT_TRUE(read);
+  EXPECT_EQ(in, out);
+}
+
+/**
+ * @given io_uring with 4 registered buffers
+ * @when 6 sockets are read at once
+ * @then 4 reads take the registered buffers @and the other 2 go straight to
+ * the caller's memory @and all of them get their data
+ */
+TEST_F(TcpIoUringTest, ReadsBeyondRegisteredBuffers) {
+  ASSERT_EQ(ring->freeBuffers(), 4);
+
+  constexpr size_t kPairs = 6;
+  Tcp::acceptor acceptor{context,
+                         {boost::asio::ip::make_address("127.0.0.1"), 0}};
+  std::vector<Tcp::socket> readers;
+  std::vector<Tcp::socket> writers;
+  std::vector<ByteArray> ins(kPairs, ByteArray(4, 0));
+  size_t read = 0;
+  for (size_t i = 0; i < kPairs; ++i) {
+    writers.emplace_back(context);
+    writers.back().connect(acceptor.local_endpoint());
+    readers.push_back(acceptor.accept());
+    ring->recv(readers.back().native_handle(), ins[i], true,
+               [&](const auto &ec, size_t n) {
+                 ASSERT_FALSE(ec) << ec.message();
+                 EXPECT_EQ(n, 4);
+                 ++read;
+               });
+  }
+  EXPECT_EQ(ring->freeBuffers(), 0);
+
+  for (size_t i = 0; i < kPairs; ++i) {
+    ByteArray out(4, static_cast<uint8_t>(i + 1));
+    boost::asio::write(writers[i], boost::asio::buffer(out));
+  }
+  context.run_for(100ms);
+
+  EXPECT_EQ(read, kPairs);
+  for (size_t i = 0; i < kPairs; ++i) {
+    EXPECT_EQ(ins[i], ByteArray(4, static_cast<uint8_t>(i + 1)));
+  }
+  EXPECT_EQ(ring->freeBuffers(), 4);
+}
+
+/**
+ * @given pending read over io_uring, which owns a registered buffer
+ * @when the connection is closed
+ * @then the buffer stays with the read until the kernel completes it @and
+ * is free after the read is aborted
+ */
+TEST_F(TcpIoUringTest, CanceledReadKeepsBufferUntilCompletion) {
+  ByteArray in(10, 0);
+  bool aborted = false;
+  client->read(in, in.size(), [&](auto &&res) {
+    ASSERT_FALSE(res);
+    aborted = true;
+  });
+  context.run_for(20ms);
+  ASSERT_EQ(ring->freeBuffers(), 3);
+
+  ASSERT_TRUE(client->close());
+  EXPECT_EQ(ring->freeBuffers(), 3);
+  context.run_for(100ms);
+
+  EXPECT_TRUE(aborted);
+  EXPECT_EQ(ring->freeBuffers(), 4);
+}
@@ -6,6 +6,7 @@
 #include <gtest/gtest.h>
 
 #include <libp2p/common/literals.hpp>
+#include "libp2p/network/impl/blocklist_gater.hpp"
 #include "libp2p/transport/tcp/tcp_listener.hpp"
 #include "testutil/gmock_actions.hpp"
 #include "testutil/outcome.hpp"
@@ -92,3 +93,77 @@ TEST_F(TcpListenerTest, DoubleClose) {
   ASSERT_TRUE(listener->isClosed());
   context->run_for(50ms);
 }
+
+/**
+ * @given listener, which may upgrade only one connection at a time
+ * @when two clients connect, while the first upgrade is still in progress
+ * @then the second client is disconnected without an upgrade, and it is
+ * counted as rejected
+ */
+TEST_F(TcpListenerTest, RejectsConnectionsOverUpgradesCap) {
+  TransportConfig config;
+  config.security_timeout = std::chrono::milliseconds::zero();
+  config.admission.max_concurrent_upgrades = 1;
+  listener = std::make_shared<TcpListener>(
+      *context, upgrader,
+      [this](auto &&r) { cb.Call(std::forward<decltype(r)>(r)); }, config);
+
+  // upgrade of the first connection never completes
+  EXPECT_CALL(*upgrader, upgradeToSecureInbound(_, _)).Times(1);
+  EXPECT_OUTCOME_TRUE_1(listener->listen(ma));
+
+  using boost::asio::ip::tcp;
+  tcp::endpoint endpoint{boost::asio::ip::make_address("127.0.0.1"), 40005};
+  tcp::socket first{*context};
+  tcp::socket second{*context};
+  first.connect(endpoint);
+  context->run_for(50ms);
+  second.connect(endpoint);
+
+  bool second_dropped = false;
+  std::array<uint8_t, 1> buf{};
+  second.async_read_some(boost::asio::buffer(buf),
+                         [&](const auto &ec, size_t) {
+                           second_dropped = static_cast<bool>(ec);
+                         });
+  context->run_for(100ms);
+
+  EXPECT_TRUE(second_dropped);
+  EXPECT_EQ(listener->getAdmissionStats().accepted, 1);
+  EXPECT_EQ(listener->getAdmissionStats().rejected, 1);
+}
+
+/**
+ * @given listener with a gater, which blocks the loopback subnet
+ * @when a client connects from it
+ * @then the client is disconnected before an upgrade, and it takes no slot of
+ * the admission control
+ */
+TEST_F(TcpListenerTest, RejectsGatedAddresses) {
+  auto gater = std::make_shared<network::BlocklistGater>();
+  ASSERT_TRUE(gater->blockSubnet(boost::asio::ip::make_address("127.0.0.0"),
+                                 8));
+  listener = std::make_shared<TcpListener>(
+      *context, upgrader,
+      [this](auto &&r) { cb.Call(std::forward<decltype(r)>(r)); },
+      TransportConfig{}, gater);
+
+  EXPECT_CALL(*upgrader, upgradeToSecureInbound(_, _)).Times(0);
+  EXPECT_OUTCOME_TRUE_1(listener->listen(ma));
+
+  using boost::asio::ip::tcp;
+  tcp::socket client{*context};
+  client.connect(
+      tcp::endpoint{boost::asio::ip::make_address("127.0.0.1"), 40005});
+
+  bool dropped = false;
+  std::array<uint8_t, 1> buf{};
+  client.async_read_some(boost::asio::buffer(buf),
+                         [&](const auto &ec, size_t) {
+                           dropped = static_cast<bool>(ec);
+                         });
+  context->run_for(100ms);
+
+  EXPECT_TRUE(dropped);
+  EXPECT_EQ(listener->getAdmissionStats().accepted, 0);
+}
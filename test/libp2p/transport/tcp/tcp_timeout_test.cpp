@@ -0,0 +1,378 @@
+/**
+ * Copyright Soramitsu Co., Ltd. All Rights Reserved.
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <arpa/inet.h>
+#include <dlfcn.h>
+#include <netdb.h>
+
+#include <atomic>
+#include <condition_variable>
+#include <mutex>
+#include <optional>
+
+#include <gmock/gmock.h>
+#include <gtest/gtest.h>
+#include <libp2p/common/literals.hpp>
+#include <libp2p/transport/error.hpp>
+#include <libp2p/transport/tcp.hpp>
+#include "mock/libp2p/connection/capable_connection_mock.hpp"
+#include "mock/libp2p/transport/upgrader_mock.hpp"
+#include "testutil/libp2p/peer.hpp"
+
+using namespace libp2p::transport;
+using namespace libp2p::connection;
+using namespace libp2p::common;
+using std::chrono_literals::operator""ms;
+
+using ::testing::_;
+using ::testing::Invoke;
+using ::testing::NiceMock;
+
+namespace {
+  using CapConnResult =
+      libp2p::outcome::result<std::shared_ptr<CapableConnection>>;
+  using Clock = std::chrono::steady_clock;
+
+  /**
+   * Reverse lookups of this address, which the transport does before
+   * connecting, hang until they are released, as they do with an
+   * unresponsive DNS server
+   */
+  const char *const kStalledAddress = "127.0.0.3";
+
+  std::mutex stall_mutex;
+  std::condition_variable stall_released;
+  bool stall_active = false;
+  std::atomic_int stalled_lookups = 0;
+
+  bool isStalledAddress(const sockaddr *sa) {
+    if (sa->sa_family != AF_INET) {
+      return false;
+    }
+    auto addr = reinterpret_cast<const sockaddr_in *>(sa)->sin_addr;
+    return addr.s_addr == inet_addr(kStalledAddress);
+  }
+
+  /// let the stalled lookups complete
+  void releaseStalledLookups() {
+    std::lock_guard lock{stall_mutex};
+    stall_active = false;
+    stall_released.notify_all();
+  }
+
+  /**
+   * Emulates handshake with a peer, which does not send anything: waits for
+   * a byte, which never arrives
+   */
+  template <typename Callback>
+  void waitForPeer(const std::shared_ptr<RawConnection> &conn, Callback cb) {
+    auto buf = std::make_shared<ByteArray>(1, 0);
+    conn->read(*buf, buf->size(), [buf, cb{std::move(cb)}](auto &&res) {
+      if (!res) {
+        cb(res.error());
+      }
+    });
+  }
+}  // namespace
+
+/**
+ * Wraps the one of libc, which Asio calls from its resolver thread, so that
+ * lookups of the stalled address are held there; the lookups are answered
+ * numerically, so that the tests do not depend on the host's DNS
+ */
+int getnameinfo(const sockaddr *sa, socklen_t salen, char *host,
+                socklen_t hostlen, char *serv, socklen_t servlen, int flags) {
+  using GetNameInfo = int (*)(const sockaddr *, socklen_t, char *, socklen_t,
+                              char *, socklen_t, int);
+  static auto real =
+      reinterpret_cast<GetNameInfo>(dlsym(RTLD_NEXT, "getnameinfo"));
+
+  if (isStalledAddress(sa)) {
+    std::unique_lock lock{stall_mutex};
+    ++stalled_lookups;
+    stall_released.wait(lock, [] { return !stall_active; });
+  }
+  return real(sa, salen, host, hostlen, serv, servlen, flags | NI_NUMERICHOST);
+}
+
+class TcpTimeoutTest : public ::testing::Test {
+ protected:
+  void SetUp() override {
+    config.security_timeout = 50ms;
+    config.muxer_timeout = 50ms;
+
+    ON_CALL(*upgrader, upgradeToSecureOutbound(_, _, _))
+        .WillByDefault(Invoke([this](auto &&raw, auto &&, auto &&cb) {
+          raw_ = raw;
+          waitForPeer(raw, cb);
+        }));
+    ON_CALL(*upgrader, upgradeToSecureInbound(_, _))
+        .WillByDefault(Invoke([this](auto &&raw, auto &&cb) {
+          raw_ = raw;
+          waitForPeer(raw, cb);
+        }));
+    ON_CALL(*upgrader, upgradeToMuxed(_, _))
+        .WillByDefault(
+            Invoke([](auto &&sec, auto &&cb) { waitForPeer(sec, cb); }));
+  }
+
+  void TearDown() override {
+    // the resolver thread is joined, when the context is destroyed
+    releaseStalledLookups();
+  }
+
+  /// make the reverse lookups of kStalledAddress hang
+  void stallLookups() {
+    std::lock_guard lock{stall_mutex};
+    stall_active = true;
+    stalled_lookups = 0;
+  }
+
+  /// start a peer, whose accept queue is full, so that new connection
+  /// attempts to it are dropped without an answer
+  void startOverloadedPeer() {
+    acceptor.open(endpoint.protocol());
+    acceptor.set_option(boost::asio::ip::tcp::acceptor::reuse_address(true));
+    acceptor.bind(endpoint);
+    acceptor.listen(0);
+    queued_client.connect(endpoint);
+  }
+
+  /// make secure upgrade succeed, so that the muxer phase is reached
+  void secureImmediately() {
+    ON_CALL(*upgrader, upgradeToSecureOutbound(_, _, _))
+        .WillByDefault(Invoke([this](auto &&raw, auto &&, auto &&cb) {
+          raw_ = raw;
+          cb(std::make_shared<CapableConnBasedOnRawConnMock>(raw));
+        }));
+  }
+
+  /// start a peer, which accepts TCP connections and then stays silent
+  void startStallingPeer() {
+    acceptor.open(endpoint.protocol());
+    acceptor.set_option(boost::asio::ip::tcp::acceptor::reuse_address(true));
+    acceptor.bind(endpoint);
+    acceptor.listen();
+    acceptor.async_accept(
+        [this](const boost::system::error_code &ec,
+               boost::asio::ip::tcp::socket sock) {
+          ASSERT_FALSE(ec) << ec.message();
+          peer_socket = std::make_unique<boost::asio::ip::tcp::socket>(
+              std::move(sock));
+        });
+  }
+
+  std::shared_ptr<boost::asio::io_context> context =
+      std::make_shared<boost::asio::io_context>(1);
+  std::shared_ptr<NiceMock<UpgraderMock>> upgrader =
+      std::make_shared<NiceMock<UpgraderMock>>();
+  TransportConfig config;
+
+  libp2p::multi::Multiaddress ma = "/ip4/127.0.0.1/tcp/40007"_multiaddr;
+  boost::asio::ip::tcp::endpoint endpoint{
+      boost::asio::ip::make_address("127.0.0.1"), 40007};
+  boost::asio::ip::tcp::acceptor acceptor{*context};
+  std::unique_ptr<boost::asio::ip::tcp::socket> peer_socket;
+  boost::asio::ip::tcp::socket queued_client{*context};
+
+  std::shared_ptr<RawConnection> raw_;
+};
+
+/**
+ * @given address, whose reverse lookup hangs
+ * @when dialing it
+ * @then resolve phase times out within its bound @and nothing is upgraded
+ */
+TEST_F(TcpTimeoutTest, StalledResolveTimesOut) {
+  config.resolve_timeout = 50ms;
+  stallLookups();
+  auto transport = std::make_shared<TcpTransport>(context, upgrader, config);
+  EXPECT_CALL(*upgrader, upgradeToSecureOutbound(_, _, _)).Times(0);
+
+  int calls = 0;
+  Clock::duration elapsed{};
+  auto started = Clock::now();
+  transport->dial(testutil::randomPeerId(),
+                  "/ip4/127.0.0.3/tcp/40007"_multiaddr,
+                  [&](CapConnResult rconn) {
+                    ++calls;
+                    elapsed = Clock::now() - started;
+                    ASSERT_FALSE(rconn);
+                    ASSERT_EQ(rconn.error(), TransportError::RESOLVE_TIMEOUT);
+                  });
+
+  context->run_for(200ms);
+
+  ASSERT_EQ(stalled_lookups, 1);
+  ASSERT_EQ(calls, 1);
+  ASSERT_LT(elapsed, 150ms);
+
+  // the lookup completes late @and its result is dropped
+  releaseStalledLookups();
+  context->run_for(50ms);
+  ASSERT_EQ(calls, 1);
+}
+
+/**
+ * @given peer, which drops connection attempts without an answer
+ * @when dialing it
+ * @then connect phase times out within its bound
+ */
+TEST_F(TcpTimeoutTest, ConnectToOverloadedPeerTimesOut) {
+  config.connect_timeout = 50ms;
+  startOverloadedPeer();
+  auto transport = std::make_shared<TcpTransport>(context, upgrader, config);
+  EXPECT_CALL(*upgrader, upgradeToSecureOutbound(_, _, _)).Times(0);
+
+  int calls = 0;
+  Clock::duration elapsed{};
+  auto started = Clock::now();
+  transport->dial(testutil::randomPeerId(), ma, [&](CapConnResult rconn) {
+    ++calls;
+    elapsed = Clock::now() - started;
+    ASSERT_FALSE(rconn);
+    ASSERT_EQ(rconn.error(), TransportError::CONNECT_TIMEOUT);
+  });
+
+  context->run_for(200ms);
+
+  ASSERT_EQ(calls, 1);
+  ASSERT_LT(elapsed, 150ms);
+}
+
+/**
+ * @given non-routable address
+ * @when dialing it
+ * @then connect phase times out within its bound
+ * @note hosts without a route to the address fail the connect at once, then
+ * there is nothing to time out
+ */
+TEST_F(TcpTimeoutTest, ConnectToNonRoutableAddressTimesOut) {
+  config.connect_timeout = 50ms;
+  auto transport = std::make_shared<TcpTransport>(context, upgrader, config);
+
+  std::optional<CapConnResult> result;
+  Clock::duration elapsed{};
+  auto started = Clock::now();
+  transport->dial(testutil::randomPeerId(),
+                  "/ip4/10.255.255.1/tcp/40007"_multiaddr,
+                  [&](CapConnResult rconn) {
+                    elapsed = Clock::now() - started;
+                    result = std::move(rconn);
+                  });
+
+  context->run_for(200ms);
+
+  ASSERT_TRUE(result);
+  ASSERT_FALSE(*result);
+  if (result->error() == std::errc::network_unreachable
+      || result->error() == std::errc::host_unreachable) {
+    GTEST_SKIP() << "no route to the non-routable address";
+  }
+  ASSERT_EQ(result->error(), TransportError::CONNECT_TIMEOUT);
+  ASSERT_LT(elapsed, 150ms);
+}
+
+/**
+ * @given peer, which accepts TCP connection and stays silent
+ * @when dialing it
+ * @then security phase times out @and raw connection is closed
+ */
+TEST_F(TcpTimeoutTest, SecurityHandshakeTimesOut) {
+  startStallingPeer();
+  auto transport = std::make_shared<TcpTransport>(context, upgrader, config);
+
+  int calls = 0;
+  transport->dial(testutil::randomPeerId(), ma, [&calls](CapConnResult rconn) {
+    ++calls;
+    ASSERT_FALSE(rconn);
+    ASSERT_EQ(rconn.error(), TransportError::SECURITY_TIMEOUT);
+  });
+
+  context->run_for(200ms);
+
+  ASSERT_EQ(calls, 1);
+  ASSERT_TRUE(raw_);
+  ASSERT_TRUE(raw_->isClosed());
+}
+
+/**
+ * @given peer, which accepts TCP connection and stays silent after security
+ * @when dialing it
+ * @then muxer phase times out @and raw connection is closed
+ */
+TEST_F(TcpTimeoutTest, MuxerNegotiationTimesOut) {
+  secureImmediately();
+  startStallingPeer();
+  auto transport = std::make_shared<TcpTransport>(context, upgrader, config);
+
+  int calls = 0;
+  transport->dial(testutil::randomPeerId(), ma, [&calls](CapConnResult rconn) {
+    ++calls;
+    ASSERT_FALSE(rconn);
+    ASSERT_EQ(rconn.error(), TransportError::MUXER_TIMEOUT);
+  });
+
+  context->run_for(200ms);
+
+  ASSERT_EQ(calls, 1);
+  ASSERT_TRUE(raw_);
+  ASSERT_TRUE(raw_->isClosed());
+}
+
+/**
+ * @given listener
+ * @when a client connects and stays silent
+ * @then inbound security phase times out @and the client gets EOF
+ */
+TEST_F(TcpTimeoutTest, InboundStallingClientIsDropped) {
+  auto transport = std::make_shared<TcpTransport>(context, upgrader, config);
+
+  int calls = 0;
+  auto listener = transport->createListener([&calls](CapConnResult rconn) {
+    ++calls;
+    ASSERT_FALSE(rconn);
+    ASSERT_EQ(rconn.error(), TransportError::SECURITY_TIMEOUT);
+  });
+  ASSERT_TRUE(listener->listen(ma));
+
+  bool eof = false;
+  boost::asio::ip::tcp::socket client{*context};
+  ByteArray buf(1, 0);
+  client.async_connect(endpoint, [&](const boost::system::error_code &ec) {
+    ASSERT_FALSE(ec) << ec.message();
+    boost::asio::async_read(
+        client, boost::asio::buffer(buf),
+        [&eof](const boost::system::error_code &ec, size_t) {
+          eof = ec == boost::asio::error::eof;
+        });
+  });
+
+  context->run_for(200ms);
+
+  ASSERT_EQ(calls, 1);
+  ASSERT_TRUE(eof);
+}
+
+/**
+ * @given zero timeouts
+ * @when dialing a silent peer
+ * @then nothing times out
+ */
+TEST_F(TcpTimeoutTest, ZeroTimeoutDisablesDeadline) {
+  config.security_timeout = 0ms;
+  startStallingPeer();
+  auto transport = std::make_shared<TcpTransport>(context, upgrader, config);
+
+  int calls = 0;
+  transport->dial(testutil::randomPeerId(), ma,
+                  [&calls](CapConnResult) { ++calls; });
+
+  context->run_for(100ms);
+
+  ASSERT_EQ(calls, 0);
+  ASSERT_TRUE(raw_);
+  ASSERT_FALSE(raw_->isClosed());
+}
@@ -0,0 +1,190 @@
+/**
+ * Copyright Soramitsu Co., Ltd. All Rights Reserved.
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <libp2p/transport/unix/unix_transport.hpp>
+
+#include <unistd.h>
+
+#include <gtest/gtest.h>
+#include <libp2p/common/literals.hpp>
+#include <libp2p/transport/unix/unix_util.hpp>
+#include "mock/libp2p/connection/capable_connection_mock.hpp"
+#include "mock/libp2p/security/security_adaptor_mock.hpp"
+#include "mock/libp2p/transport/upgrader_mock.hpp"
+#include "testutil/gmock_actions.hpp"
+#include "testutil/libp2p/peer.hpp"
+#include "testutil/outcome.hpp"
+
+using namespace libp2p;
+using namespace transport;
+using namespace connection;
+using namespace common;
+using std::chrono_literals::operator""ms;
+
+using ::testing::_;
+using ::testing::NiceMock;
+
+namespace {
+  auto makeUpgrader() {
+    auto upgrader = std::make_shared<NiceMock<UpgraderMock>>();
+    ON_CALL(*upgrader, upgradeToSecureOutbound(_, _, _))
+        .WillByDefault(UpgradeToSecureOutbound([](auto &&raw) {
+          std::shared_ptr<SecureConnection> sec =
+              std::make_shared<CapableConnBasedOnRawConnMock>(raw);
+          return sec;
+        }));
+    ON_CALL(*upgrader, upgradeToSecureInbound(_, _))
+        .WillByDefault(UpgradeToSecureInbound([](auto &&raw) {
+          std::shared_ptr<SecureConnection> sec =
+              std::make_shared<CapableConnBasedOnRawConnMock>(raw);
+          return sec;
+        }));
+    ON_CALL(*upgrader, upgradeToMuxed(_, _))
+        .WillByDefault(UpgradeToMuxed([](auto &&sec) {
+          std::shared_ptr<CapableConnection> cap =
+              std::make_shared<CapableConnBasedOnRawConnMock>(sec);
+          return cap;
+        }));
+    return upgrader;
+  }
+}  // namespace
+
+class UnixTransportTest : public ::testing::Test {
+ public:
+  void SetUp() override {
+    path = "/tmp/libp2p_unix_test_" + std::to_string(getpid()) + ".sock";
+    ::unlink(path.c_str());
+    ma = detail::makeUnixAddress(path).value();
+  }
+
+  void TearDown() override {
+    ::unlink(path.c_str());
+  }
+
+  std::shared_ptr<boost::asio::io_context> context =
+      std::make_shared<boost::asio::io_context>();
+  std::shared_ptr<NiceMock<UpgraderMock>> upgrader = makeUpgrader();
+  std::shared_ptr<UnixTransport> transport =
+      std::make_shared<UnixTransport>(context, upgrader, nullptr);
+  std::string path;
+  multi::Multiaddress ma = "/unix/tmp"_multiaddr;
+};
+
+/**
+ * @given unix transport with a listener
+ * @when it dials the listener and writes data
+ * @then both sides get upgraded connections, and listener receives the data
+ */
+TEST_F(UnixTransportTest, DialAndListen) {
+  ByteArray out{1, 2, 3};
+  ByteArray in(out.size(), 0);
+  std::shared_ptr<CapableConnection> inbound;
+  std::shared_ptr<CapableConnection> outbound;
+
+  auto listener = transport->createListener([&](auto &&rconn) {
+    EXPECT_OUTCOME_TRUE(conn, rconn);
+    inbound = conn;
+    inbound->read(in, in.size(), [](auto &&res) { ASSERT_TRUE(res); });
+  });
+  EXPECT_OUTCOME_TRUE_1(listener->listen(ma));
+  EXPECT_OUTCOME_TRUE(listen_ma, listener->getListenMultiaddr());
+  EXPECT_EQ(listen_ma, ma);
+  EXPECT_TRUE(transport->canDial(ma));
+  EXPECT_FALSE(transport->canDial("/ip4/127.0.0.1/tcp/1234"_multiaddr));
+
+  transport->dial(testutil::randomPeerId(), ma, [&](auto &&rconn) {
+    EXPECT_OUTCOME_TRUE(conn, rconn);
+    outbound = conn;
+    outbound->write(out, out.size(), [](auto &&res) { ASSERT_TRUE(res); });
+  });
+  context->run_for(50ms);
+
+  ASSERT_TRUE(inbound);
+  ASSERT_TRUE(outbound);
+  EXPECT_EQ(in, out);
+  EXPECT_TRUE(outbound->isInitiator());
+  EXPECT_FALSE(inbound->isInitiator());
+}
+
+/**
+ * @given two unix listeners
+ * @when they listen on the same path
+ * @then the second one fails, until the first one is closed and its socket
+ * file is removed
+ */
+TEST_F(UnixTransportTest, AddressInUse) {
+  auto listener1 = transport->createListener([](auto &&) {});
+  auto listener2 = transport->createListener([](auto &&) {});
+
+  EXPECT_OUTCOME_TRUE_1(listener1->listen(ma));
+  EXPECT_OUTCOME_FALSE(e, listener2->listen(ma));
+  EXPECT_EQ(e, std::errc::address_in_use);
+
+  EXPECT_OUTCOME_TRUE_1(listener1->close());
+  EXPECT_TRUE(listener1->isClosed());
+  EXPECT_NE(::access(path.c_str(), F_OK), 0);
+  EXPECT_OUTCOME_TRUE_1(listener2->listen(ma));
+}
+
+/**
+ * @given unix socket listener
+ * @when it is connected to by this process
+ * @then credentials of the peer are the ones of this process
+ */
+TEST_F(UnixTransportTest, PeerCredentials) {
+  auto endpoint = detail::makeUnixEndpoint(ma).value();
+  UnixConnection::Protocol::acceptor acceptor{*context, endpoint};
+  std::optional<UnixConnection::Credentials> credentials;
+  acceptor.async_accept(
+      [&](auto &&ec, UnixConnection::Protocol::socket sock) {
+        ASSERT_FALSE(ec);
+        auto conn = std::make_shared<UnixConnection>(*context,
+                                                     std::move(sock), ma);
+        credentials = conn->peerCredentials();
+      });
+
+  auto conn = std::make_shared<UnixConnection>(*context, ma);
+  conn->connect(endpoint, [](auto &&ec) { ASSERT_FALSE(ec); });
+  context->run_for(50ms);
+
+  ASSERT_TRUE(credentials);
+  EXPECT_EQ(credentials->uid, getuid());
+  EXPECT_EQ(credentials->pid, getpid());
+}
+
+/**
+ * @given unix listener, which skips security for processes of the same user
+ * @when it is connected to by this process
+ * @then trusted adaptor secures the connection without negotiation
+ */
+TEST_F(UnixTransportTest, TrustedPeerSkipsNegotiation) {
+  auto adaptor = std::make_shared<security::SecurityAdaptorMock>();
+  EXPECT_CALL(*adaptor, secureInbound(_, _))
+      .WillOnce(UpgradeToSecureInbound([](auto &&raw) {
+        std::shared_ptr<SecureConnection> sec =
+            std::make_shared<CapableConnBasedOnRawConnMock>(raw);
+        return sec;
+      }));
+  EXPECT_CALL(*upgrader, upgradeToSecureInbound(_, _)).Times(0);
+
+  UnixConfig unix_config;
+  unix_config.skip_security_for_trusted = true;
+  bool upgraded = false;
+  auto listener = std::make_shared<UnixListener>(
+      *context, upgrader, adaptor,
+      [&](auto &&rconn) {
+        EXPECT_OUTCOME_TRUE_1(rconn);
+        upgraded = true;
+      },
+      unix_config);
+  EXPECT_OUTCOME_TRUE_1(listener->listen(ma));
+
+  auto conn = std::make_shared<UnixConnection>(*context, ma);
+  conn->connect(detail::makeUnixEndpoint(ma).value(),
+                [](auto &&ec) { ASSERT_FALSE(ec); });
+  context->run_for(50ms);
+
+  EXPECT_TRUE(upgraded);
+}
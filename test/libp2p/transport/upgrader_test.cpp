@@ -12,6 +12,9 @@
 #include <testutil/gmock_actions.hpp>
 #include <testutil/outcome.hpp>
 #include "libp2p/multi/multihash.hpp"
+#include "libp2p/network/impl/blocklist_gater.hpp"
+#include "libp2p/peer/protocol_repository/inmem_protocol_repository.hpp"
+#include "libp2p/transport/error.hpp"
 #include "mock/libp2p/connection/capable_connection_mock.hpp"
 #include "mock/libp2p/connection/raw_connection_mock.hpp"
 #include "mock/libp2p/connection/secure_connection_mock.hpp"
@@ -31,6 +34,7 @@ using namespace libp2p::basic;
 using testing::_;
 using testing::NiceMock;
 using testing::Return;
+using testing::ReturnRef;
 
 using libp2p::outcome::failure;
 using libp2p::outcome::success;
@@ -50,8 +54,10 @@ class UpgraderTest : public testing::Test {
           .WillByDefault(Return(muxer_protos_[i]));
     }
 
-    upgrader_ = std::make_shared<UpgraderImpl>(multiselect_mock_,
-                                               security_mocks_, muxer_mocks_);
+    ON_CALL(*sec_conn_, remotePeer()).WillByDefault(ReturnRef(peer_id_));
+
+    upgrader_ = std::make_shared<UpgraderImpl>(
+        multiselect_mock_, protocol_repo_, security_mocks_, muxer_mocks_);
   }
 
   PeerId peer_id_ = testutil::randomPeerId();
@@ -59,6 +65,9 @@ class UpgraderTest : public testing::Test {
   std::shared_ptr<ProtocolMuxerMock> multiselect_mock_ =
       std::make_shared<ProtocolMuxerMock>();
 
+  std::shared_ptr<ProtocolRepository> protocol_repo_ =
+      std::make_shared<InmemProtocolRepository>();
+
   std::vector<Protocol> security_protos_{"security_proto1", "security_proto2"};
   std::vector<std::shared_ptr<SecurityAdaptor>> security_mocks_{
       std::make_shared<NiceMock<SecurityAdaptorMock>>(),
@@ -162,3 +171,124 @@ TEST_F(UpgraderTest, UpgradeMuxFail) {
     ASSERT_FALSE(upgraded_conn_res);
   });
 }
+
+/**
+ * @given security and muxer protocols, negotiated with the peer before
+ * @when connections to that peer are upgraded again
+ * @then the negotiated protocols are proposed first
+ */
+TEST_F(UpgraderTest, ProposeNegotiatedFirst) {
+  std::vector<Protocol> security_reversed{security_protos_.rbegin(),
+                                          security_protos_.rend()};
+  std::vector<Protocol> muxer_reversed{muxer_protos_.rbegin(),
+                                       muxer_protos_.rend()};
+  ASSERT_TRUE(protocol_repo_->addProtocols(
+      peer_id_, std::vector<Protocol>{security_protos_[1], muxer_protos_[1]}));
+
+  EXPECT_CALL(*raw_conn_, isInitiator_hack()).WillRepeatedly(Return(true));
+  EXPECT_CALL(
+      *multiselect_mock_,
+      selectOneOf(gsl::span<const Protocol>(security_reversed),
+                  std::static_pointer_cast<ReadWriter>(raw_conn_), true, _))
+      .WillOnce(Arg3CallbackWithArg(security_protos_[1]));
+  EXPECT_CALL(
+      *std::static_pointer_cast<SecurityAdaptorMock>(security_mocks_[1]),
+      secureOutbound(std::static_pointer_cast<RawConnection>(raw_conn_),
+                     peer_id_, _))
+      .WillOnce(Arg2CallbackWithArg(sec_conn_));
+  upgrader_->upgradeToSecureOutbound(
+      raw_conn_, peer_id_,
+      [](auto &&upgraded_conn_res) { ASSERT_TRUE(upgraded_conn_res); });
+
+  EXPECT_CALL(*sec_conn_, isInitiatorMock()).WillOnce(Return(true));
+  EXPECT_CALL(
+      *multiselect_mock_,
+      selectOneOf(gsl::span<const Protocol>(muxer_reversed),
+                  std::static_pointer_cast<ReadWriter>(sec_conn_), true, _))
+      .WillOnce(Arg3CallbackWithArg(success(muxer_protos_[1])));
+  EXPECT_CALL(
+      *std::static_pointer_cast<MuxerAdaptorMock>(muxer_mocks_[1]),
+      muxConnection(std::static_pointer_cast<SecureConnection>(sec_conn_), _))
+      .WillOnce(Arg1CallbackWithArg(muxed_conn_));
+  upgrader_->upgradeToMuxed(sec_conn_, [](auto &&upgraded_conn_res) {
+    ASSERT_TRUE(upgraded_conn_res);
+  });
+}
+
+/**
+ * @given peer, which nothing was negotiated with
+ * @when a connection to it is secured
+ * @then the negotiated protocol is remembered for the peer
+ */
+TEST_F(UpgraderTest, RememberNegotiated) {
+  EXPECT_CALL(*raw_conn_, isInitiator_hack()).WillRepeatedly(Return(true));
+  EXPECT_CALL(*multiselect_mock_, selectOneOf(_, _, true, _))
+      .WillOnce(Arg3CallbackWithArg(security_protos_[1]));
+  EXPECT_CALL(
+      *std::static_pointer_cast<SecurityAdaptorMock>(security_mocks_[1]),
+      secureOutbound(_, peer_id_, _))
+      .WillOnce(Arg2CallbackWithArg(sec_conn_));
+  upgrader_->upgradeToSecureOutbound(
+      raw_conn_, peer_id_,
+      [](auto &&upgraded_conn_res) { ASSERT_TRUE(upgraded_conn_res); });
+
+  auto protocols = protocol_repo_->getProtocols(peer_id_);
+  ASSERT_TRUE(protocols);
+  EXPECT_EQ(protocols.value(), std::vector<Protocol>{security_protos_[1]});
+}
+
+/**
+ * @given upgrader with a gater, which blocks the peer
+ * @when an inbound connection from the peer is secured
+ * @then the secured connection is closed @and the upgrade fails before any
+ * muxer is negotiated
+ */
+TEST_F(UpgraderTest, GatedInbound) {
+  auto gater = std::make_shared<libp2p::network::BlocklistGater>();
+  gater->blockPeer(peer_id_);
+  upgrader_ = std::make_shared<UpgraderImpl>(multiselect_mock_, protocol_repo_,
+                                             security_mocks_, muxer_mocks_,
+                                             gater);
+
+  EXPECT_CALL(*raw_conn_, isInitiator_hack()).WillRepeatedly(Return(false));
+  EXPECT_CALL(*multiselect_mock_, selectOneOf(_, _, false, _))
+      .WillOnce(Arg3CallbackWithArg(success(security_protos_[1])));
+  EXPECT_CALL(
+      *std::static_pointer_cast<SecurityAdaptorMock>(security_mocks_[1]),
+      secureInbound(_, _))
+      .WillOnce(Arg1CallbackWithArg(success(sec_conn_)));
+  EXPECT_CALL(*sec_conn_, close()).WillOnce(Return(success()));
+
+  bool called = false;
+  upgrader_->upgradeToSecureInbound(raw_conn_, [&called](auto &&res) {
+    called = true;
+    EXPECT_OUTCOME_FALSE(e, res);
+    EXPECT_EQ(e, TransportError::CONNECTION_GATED);
+  });
+  EXPECT_TRUE(called);
+}
+
+/**
+ * @given upgrader with a gater, which blocks the peer
+ * @when an outbound connection to the peer is to be secured
+ * @then it is closed before any protocol is negotiated
+ */
+TEST_F(UpgraderTest, GatedOutbound) {
+  auto gater = std::make_shared<libp2p::network::BlocklistGater>();
+  gater->blockPeer(peer_id_);
+  upgrader_ = std::make_shared<UpgraderImpl>(multiselect_mock_, protocol_repo_,
+                                             security_mocks_, muxer_mocks_,
+                                             gater);
+
+  EXPECT_CALL(*multiselect_mock_, selectOneOf(_, _, _, _)).Times(0);
+  EXPECT_CALL(*raw_conn_, close()).WillOnce(Return(success()));
+
+  bool called = false;
+  upgrader_->upgradeToSecureOutbound(
+      raw_conn_, peer_id_, [&called](auto &&res) {
+        called = true;
+        EXPECT_OUTCOME_FALSE(e, res);
+        EXPECT_EQ(e, TransportError::CONNECTION_GATED);
+      });
+  EXPECT_TRUE(called);
+}
@@ -20,11 +20,13 @@ namespace libp2p::connection {
 
     MOCK_METHOD1(onStream, void(NewStreamHandlerFunc));
 
+    MOCK_CONST_METHOD0(streamsCount, size_t());
+
     MOCK_METHOD0(start, void());
     MOCK_METHOD0(stop, void());
 
-    MOCK_CONST_METHOD0(localPeer, outcome::result<peer::PeerId>());
-    MOCK_CONST_METHOD0(remotePeer, outcome::result<peer::PeerId>());
+    MOCK_CONST_METHOD0(localPeer, const peer::PeerId &());
+    MOCK_CONST_METHOD0(remotePeer, const peer::PeerId &());
     MOCK_CONST_METHOD0(remotePublicKey, outcome::result<crypto::PublicKey>());
 
     MOCK_CONST_METHOD0(isClosed, bool(void));
@@ -51,7 +53,10 @@ namespace libp2p::connection {
   class CapableConnBasedOnRawConnMock : public CapableConnection {
    public:
     explicit CapableConnBasedOnRawConnMock(std::shared_ptr<RawConnection> c)
-        : real_(std::move(c)) {}
+        : real_(std::move(c)) {
+      ON_CALL(*this, localPeer()).WillByDefault(::testing::ReturnRef(peer_));
+      ON_CALL(*this, remotePeer()).WillByDefault(::testing::ReturnRef(peer_));
+    }
 
     ~CapableConnBasedOnRawConnMock() override = default;
 
@@ -59,13 +64,15 @@ namespace libp2p::connection {
 
     MOCK_METHOD1(onStream, void(NewStreamHandlerFunc));
 
+    MOCK_CONST_METHOD0(streamsCount, size_t());
+
     MOCK_METHOD0(start, void());
 
     MOCK_METHOD0(stop, void());
 
-    MOCK_CONST_METHOD0(localPeer, outcome::result<peer::PeerId>());
+    MOCK_CONST_METHOD0(localPeer, const peer::PeerId &());
 
-    MOCK_CONST_METHOD0(remotePeer, outcome::result<peer::PeerId>());
+    MOCK_CONST_METHOD0(remotePeer, const peer::PeerId &());
 
     MOCK_CONST_METHOD0(remotePublicKey, outcome::result<crypto::PublicKey>());
 
@@ -111,6 +118,9 @@ namespace libp2p::connection {
 
    private:
     std::shared_ptr<RawConnection> real_;
+    /// id of both peers, unless the test sets other ones
+    peer::PeerId peer_ =
+        peer::PeerId::fromPublicKey(crypto::ProtobufKey{{1}}).value();
   };
 }  // namespace libp2p::connection
 
@@ -38,9 +38,9 @@ namespace libp2p::connection {
 
     MOCK_METHOD0(remoteMultiaddr, outcome::result<multi::Multiaddress>(void));
 
-    MOCK_CONST_METHOD0(localPeer, outcome::result<peer::PeerId>(void));
+    MOCK_CONST_METHOD0(localPeer, const peer::PeerId &(void));
 
-    MOCK_CONST_METHOD0(remotePeer, outcome::result<peer::PeerId>(void));
+    MOCK_CONST_METHOD0(remotePeer, const peer::PeerId &(void));
 
     MOCK_CONST_METHOD0(remotePublicKey,
                        outcome::result<crypto::PublicKey>(void));
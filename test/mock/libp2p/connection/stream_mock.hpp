@@ -45,7 +45,7 @@ namespace libp2p::connection {
 
     MOCK_CONST_METHOD0(isInitiator, outcome::result<bool>());
 
-    MOCK_CONST_METHOD0(remotePeerId, outcome::result<peer::PeerId>());
+    MOCK_CONST_METHOD0(remotePeerId, const peer::PeerId &());
 
     MOCK_CONST_METHOD0(localMultiaddr, outcome::result<multi::Multiaddress>());
 
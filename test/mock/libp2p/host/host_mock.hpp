@@ -33,9 +33,16 @@ namespace libp2p {
                       const std::function<connection::Stream::Handler> &,
                       const std::function<bool(const peer::Protocol &)> &));
     MOCK_METHOD1(connect, void(const peer::PeerInfo &));
+    MOCK_METHOD2(keepWarm, void(std::vector<peer::PeerInfo>, size_t));
     MOCK_METHOD3(newStream,
                  void(const peer::PeerInfo &p, const peer::Protocol &protocol,
                       const StreamResultHandler &handler));
+    MOCK_METHOD3(acquireStream,
+                 void(const peer::PeerInfo &p, const peer::Protocol &protocol,
+                      const StreamResultHandler &handler));
+    MOCK_METHOD2(releaseStream,
+                 void(const peer::Protocol &protocol,
+                      std::shared_ptr<connection::Stream> stream));
     MOCK_METHOD1(listen, outcome::result<void>(const multi::Multiaddress &ma));
     MOCK_METHOD1(closeListener,
                  outcome::result<void>(const multi::Multiaddress &ma));
@@ -21,6 +21,8 @@ namespace libp2p::network {
                        std::vector<ConnectionSPtr>(const peer::PeerId &p));
     MOCK_CONST_METHOD1(getBestConnectionForPeer,
                        ConnectionSPtr(const peer::PeerId &p));
+    MOCK_METHOD2(reportRtt,
+                 void(const ConnectionSPtr &c, std::chrono::microseconds rtt));
     MOCK_CONST_METHOD1(connectedness, Connectedness(const peer::PeerInfo &p));
 
     MOCK_METHOD2(addConnectionToPeer,
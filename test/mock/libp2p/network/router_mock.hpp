@@ -23,6 +23,11 @@ namespace libp2p::network {
 
     MOCK_CONST_METHOD0(getSupportedProtocols, std::vector<peer::Protocol>());
 
+    MOCK_CONST_METHOD0(getProtocolsSnapshot,
+                       std::shared_ptr<const ProtocolsSnapshot>());
+
+    MOCK_CONST_METHOD1(canHandle, bool(const peer::Protocol &));
+
     MOCK_METHOD1(removeProtocolHandlers, void(const peer::Protocol &));
 
     MOCK_METHOD0(removeAll, void());
@@ -18,6 +18,16 @@ namespace libp2p::protocol_muxer {
                  void(gsl::span<const peer::Protocol> protocols,
                       std::shared_ptr<basic::ReadWriter> connection,
                       bool is_initiator, ProtocolHandlerFunc cb));
+
+    MOCK_METHOD4(acceptOneOf,
+                 void(Protocols protocols, ProtocolMatcher matcher,
+                      std::shared_ptr<basic::ReadWriter> connection,
+                      ProtocolHandlerFunc cb));
+
+    MOCK_METHOD2(selectOptimistically,
+                 std::shared_ptr<connection::Stream>(
+                     const peer::Protocol &protocol,
+                     std::shared_ptr<connection::Stream> stream));
   };
 }  // namespace libp2p::protocol_muxer
 